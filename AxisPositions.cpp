@@ -59,18 +59,56 @@
  // Precompiled header
 #include "pch.hpp"
 
+// standard c/c++ libraries
+#include <algorithm>
+
 // header file
 #include "gaScsDataConstants.hpp"
 #include "AxisPositions.hpp"
+#include "Metrics.hpp"
+#include "TraceRecorder.hpp"
+#include "ProgressReporter.hpp"
+#include "Checksum.hpp"
+#include "PositionValidator.hpp"
+#include "WriteJournal.hpp"
 
 namespace gaScsData {
 
 // ctors and dtor
   AxisPositions::AxisPositions() : 
-      coilMap_(),
+      ownCoilMap_(),
+      coilMap_(ownCoilMap_),
+      coilAngleMax_(COIL_ANGLE_MAX),
+      isLocalBackend_(false),
       serverText_(DB_SERVER_NAME + "@" + DB_DATABASE_NAME),
-      errorText_("") {
+      errorText_(""),
+      transRo_(TRANS_Ro),
+      maxTransAdj_(0.0),
+      maxJoggleAdj_(0.0),
+      isSkipUnchanged_(false),
+      writerConnections_(DB_WRITER_CONNECTIONS) {
+    Initialize();
+  }
+
+  AxisPositions::AxisPositions(const CoilMap &sharedCoilMap, long coilAngleMax) :
+      ownCoilMap_(),
+      coilMap_(sharedCoilMap),
+      coilAngleMax_(coilAngleMax),
+      isLocalBackend_(false),
+      serverText_(DB_SERVER_NAME + "@" + DB_DATABASE_NAME),
+      errorText_(""),
+      transRo_(TRANS_Ro),
+      maxTransAdj_(0.0),
+      maxJoggleAdj_(0.0),
+      isSkipUnchanged_(false),
+      writerConnections_(DB_WRITER_CONNECTIONS) {
+    Initialize();
+  }
 
+  AxisPositions::~AxisPositions() { }
+
+  // ctor initialization common to both ctors
+  void AxisPositions::Initialize() {
     // initialize member variables
       // vector of axis indexes
       // NOTE: enum value should match vector position (index)
@@ -121,9 +159,110 @@ namespace gaScsData {
 
   }
 
-  AxisPositions::~AxisPositions() { }
-
 // public accessors
+  // number of rows in the SCS position map
+  size_t AxisPositions::GetScsPositionCount() const {
+    return scsAxisPositionMap_.size();
+  }
+
+  const AxisPositions::ScsAxesPositionMap& AxisPositions::GetScsPositionMap() const {
+    return scsAxisPositionMap_;
+  }
+
+  const AxisPositions::key_collision_list& AxisPositions::GetKeyCollisions() const {
+    return keyCollisions_;
+  }
+
+  const CoilMap& AxisPositions::GetCoilMap() const {
+    return coilMap_;
+  }
+
+  // record SCS inserts in memory (true) or write them to the db (false)
+  void AxisPositions::SetLocalBackend(bool isLocalBackend) {
+    isLocalBackend_= isLocalBackend;
+    localRows_.clear();
+  }
+
+  // number of SCS inserts recorded by the local backend
+  size_t AxisPositions::GetLocalRowCount() const {
+    return localRows_.size();
+  }
+
+  // tunable parameters
+  void AxisPositions::SetGenerationParams(const GenerationParams &params) {
+    params_= params;
+    transRo_= params_.GetTransRo();
+  }
+
+  const GenerationParams& AxisPositions::GetGenerationParams() const {
+    return params_;
+  }
+
+  // coil geometry of the own coil map, and its last coil angle
+  long AxisPositions::SetCoilGeometry(const CoilGeometry &geometry) {
+    if (&coilMap_ != &ownCoilMap_) {
+      std::cout << "The coil map is shared, and its geometry can't be set here." << std::endl;
+      return RTN_ERROR;
+    }
+    if (RTN_NO_ERROR != ownCoilMap_.SetGeometry(geometry))
+      return RTN_ERROR;
+    coilAngleMax_= geometry.GetCoilAngleMax();
+    return RTN_NO_ERROR;
+  }
+
+  // largest adjustments made by the last position calculation
+  void AxisPositions::GetMaxAdjustments(double &maxTransAdj, double &maxJoggleAdj) const {
+    maxTransAdj= maxTransAdj_;
+    maxJoggleAdj= maxJoggleAdj_;
+  }
+
+  // checksum of the SCS position map, in angle order. The values written to the table are included.
+  // The logic trace is diagnostic only, and is not included.
+  std::string AxisPositions::GetPositionChecksum() const {
+    Checksum checksum;
+    for (sapm_const_iter mci= scsAxisPositionMap_.begin(); mci != scsAxisPositionMap_.end(); ++mci)
+      AddRowToChecksum(checksum, mci->first, mci->second);
+    return checksum.ToHex();
+  }
+
+  void AxisPositions::AddRowToChecksum(Checksum &checksum, long riaAngle, const SPosDetail &posDetail) {
+    checksum.Add(riaAngle);
+    for (Positions::const_iterator cit= posDetail.get<0>().begin(); cit != posDetail.get<0>().end(); ++cit)
+      checksum.Add(*cit);
+    for (Positions::const_iterator cit= posDetail.get<1>().begin(); cit != posDetail.get<1>().end(); ++cit)
+      checksum.Add(*cit);
+    for (SelectedAxes::const_iterator cit= posDetail.get<2>().begin(); cit != posDetail.get<2>().end(); ++cit)
+      checksum.Add(static_cast<bool>(*cit));
+    checksum.Add(posDetail.get<3>().get<0>());
+    checksum.Add(posDetail.get<3>().get<2>());
+    checksum.Add(posDetail.get<4>().get<1>());
+    checksum.Add(posDetail.get<4>().get<2>());
+    checksum.Add(posDetail.get<4>().get<3>());
+    checksum.Add(posDetail.get<4>().get<4>());
+    checksum.Add(posDetail.get<4>().get<5>());
+    checksum.Add(posDetail.get<4>().get<6>());
+    checksum.Add(posDetail.get<4>().get<7>());
+    checksum.Add(posDetail.get<4>().get<8>());
+    checksum.Add(posDetail.get<5>().get<0>());
+    checksum.Add(posDetail.get<5>().get<1>());
+  }
+
+  uint64_t AxisPositions::GetInputHash() const {
+    Checksum checksum;
+    checksum.Add(GENERATOR_VERSION);
+    coilMap_.AddToChecksum(checksum);
+    params_.AddToChecksum(checksum);
+    checksum.Add(coilAngleMax_);
+    return checksum.GetValue();
+  }
+
+  void AxisPositions::SetSkipUnchanged(bool skipUnchanged) {
+    isSkipUnchanged_= skipUnchanged;
+  }
+
+  void AxisPositions::SetWriterConnections(size_t connections) {
+    writerConnections_= 0 == connections ? 1 : connections;
+  }
 
 // public methods
 
@@ -131,7 +270,51 @@ namespace gaScsData {
     // This is done via the coil map interface
   // return value indicates success or error
   long AxisPositions::GenerateCoilMap() {
-    return coilMap_.PopulateCoilMap();
+    if (&coilMap_ != &ownCoilMap_) {
+      std::cout << "The coil map is shared, and can't be populated here." << std::endl;
+      return RTN_ERROR;
+    }
+    return ownCoilMap_.PopulateCoilMap();
+  }
+
+  // Populate the coil map from the passed in rows (local backend), and set the last coil angle to iterate to.
+  // return value indicates success or error
+  long AxisPositions::GenerateCoilMap(const CoilMap::coil_map &coilRows, long coilAngleMax) {
+    if (&coilMap_ != &ownCoilMap_) {
+      std::cout << "The coil map is shared, and can't be populated here." << std::endl;
+      return RTN_ERROR;
+    }
+    coilAngleMax_= coilAngleMax;
+    return ownCoilMap_.PopulateCoilMap(coilRows);
+  }
+
+  // Calculate the SCS position map only. Nothing is written to the db.
+  // return value indicates success or error
+  long AxisPositions::CalculatePositions() {
+    scsAxisPositionMap_.clear();
+    CalculateAxisMoves();
+    if (scsAxisPositionMap_.empty())
+      return RTN_NO_RESULTS;
+    return RTN_NO_ERROR;
+  }
+
+  // Get the <layer, ria angle> of the new hqp and new layer rows in the SCS position map.
+  void AxisPositions::GetStartAngleSets(layerAngleSetTyp &hqpStarts, layerAngleSetTyp &layerStarts) const {
+    hqpStarts.clear();
+    layerStarts.clear();
+    for (sapm_const_iter cit= scsAxisPositionMap_.begin(); cit != scsAxisPositionMap_.end(); ++cit) {
+      const PosAttributes &attributes= cit->second.get<4>();
+      if (!attributes.get<4>() && !attributes.get<5>())
+        continue;  // not a new hqp or new layer row
+      // the position table view shows the coil map layer at the coil angle plus the layer adjust
+      std::pair<long, double> layerAngle(coilMap_.GetLayerLb(attributes.get<8>()) + cit->second.get<5>().get<1>(),
+                                         static_cast<double>(cit->first));
+      // map is sorted by angle, so the end of the set is the insertion hint
+      if (attributes.get<4>())
+        hqpStarts.insert(hqpStarts.end(), layerAngle);
+      if (attributes.get<5>())
+        layerStarts.insert(layerStarts.end(), layerAngle);
+      }
   }
     
   // 1) Iterate thru azimuth positions, and using the coil map, calculate the CLS move distances and SCS positions.
@@ -144,39 +327,122 @@ namespace gaScsData {
   long AxisPositions::GeneratePositionTables() {
     long connectStatus= 0;
     long insertStatus = 0;
+
+    // a write that did not finish is resumed from its journal, if it is of the same inputs
+    WriteJournal journal(WRITE_JOURNAL_TABLE_SCS);
+    const long journalStatus= isLocalBackend_ ? RTN_NO_RESULTS : OpenJournal(journal);
+
+    // the tables in the db were made from the same inputs by this generator version, and were written completely.
+    // The generation row is read on a connection of its own, so nothing is calculated if the tables are up to date.
+    TableGeneration generation(GENERATION_TABLE_SCS);
+    if (RTN_NO_RESULTS == journalStatus && isSkipUnchanged_ && RTN_NO_ERROR == DbConnect()) {
+      const bool isUpToDate= generation.IsUpToDate(dbCommand_, GetInputHash(), errorText_);
+      DbDisconnect();
+      if (isUpToDate) {
+        std::cout << "The coil map, parameters, and generator version are unchanged. The position tables are not remade." << std::endl;
+        return RTN_NO_RESULTS;
+      }
+    }
     
-    // Make an entry in the Cls and Scs position maps for each foot/column pair (in/out) azimuth
+    Metrics &metrics= Metrics::Instance();
+    if (RTN_NO_ERROR != journalStatus) {
+      // Make an entry in the Cls and Scs position maps for each foot/column pair (in/out) azimuth
+      std::cout << "Calculating Axis Moves for SCS and CLS." << std::endl;
+      const unsigned long long lookupsBefore= CoilMap::GetThreadLookupCount();
+      {
+        Metrics::ScopedTimer timer("positions.calculate_axis_moves");
+        CalculateAxisMoves();
+      }
+      metrics.AddCount("positions.scs_rows", static_cast<long long>(scsAxisPositionMap_.size()));
+      metrics.AddCount("coilmap.lookups", static_cast<long long>(CoilMap::GetThreadLookupCount() - lookupsBefore));
+      std::cout << "Done Calculating Axis Moves." << std::endl << std::endl;
+
+      // check the rows before anything is deleted or written. The tables in the db are left as they are if there are violations.
+      {
+        Metrics::ScopedTimer timer("positions.validate");
+        PositionValidator validator;
+        if (RTN_NO_ERROR != validator.Validate(scsAxisPositionMap_, keyCollisions_)) {
+          std::cout << "The calculated positions have " << validator.GetViolationCount() << " violations. "
+                    << "They are not written to the db. See " << VALIDATION_REPORT_FILE << "." << std::endl;
+          validator.WriteJson(VALIDATION_REPORT_FILE);
+          return RTN_ERROR;
+          }
+      }
 
-    std::cout << "Calculating Axis Moves for SCS and CLS." << std::endl;
-    CalculateAxisMoves();
-    std::cout << "Done Calculating Axis Moves." << std::endl << std::endl;
+      // journal the rows before anything is deleted or written, so a write that fails can be resumed
+      if (!isLocalBackend_) {
+        Metrics::ScopedTimer timer("positions.journal");
+        std::string record;
+        std::vector<bool> isRangeStart;
+        GetJournalRangeStarts(scsAxisPositionMap_, isRangeStart);
+        size_t row= 0;
+        for (sapm_const_iter mci= scsAxisPositionMap_.begin(); mci != scsAxisPositionMap_.end(); ++mci, ++row) {
+          record.clear();
+          PutJournalRow(record, mci->first, mci->second);
+          journal.AddRow(record, isRangeStart[row]);
+          }
+        if (RTN_NO_ERROR != journal.Create(GetInputHash(), WRITE_JOURNAL_BATCH_ROWS, writerConnections_))
+          return RTN_ERROR;
+      }
+    }
     
     // connect to db
-    connectStatus= DbConnect();
+    {
+      Metrics::ScopedTimer timer("positions.connect");
+      connectStatus= DbConnect();
+    }
 
     // if connect status is okay
-      // 3) Delete all the existing (old) rows from the CLS and SCS position tables.
-      // 4) Iterate thru the CLS map, and insert the positions longo a CLS position table in the DB
-      // 5) Iterate thru the SCS map, and insert the positions longo a SCS position table in the DB
+      // 3) Delete all the existing (old) rows from the CLS and SCS position tables, if none of the journal rows are in the db.
+      // 4) Insert the journal rows of the batches not in the db into the SCS position table in the DB, a range per connection
+      // 5) Build the CLS position table from the SCS position table in the DB
     if (RTN_NO_ERROR == connectStatus) {
       // if no error (DB connect was sucessful)
+      WriteJournal::batch_set dbBatches;
+      insertStatus= isLocalBackend_ ? RTN_NO_ERROR : journal.ReadDbBatches(dbCommand_, dbBatches, errorText_);
+      // the journal and the db have to agree on the batches written before anything is deleted
+      if (RTN_NO_ERROR == insertStatus && !isLocalBackend_)
+        insertStatus= journal.SyncDbBatches(dbBatches);
       
-      // delete previous records from CLS and SCS position tables
-      DeleteAllPositions();
+      // delete previous records from CLS and SCS position tables, if none of the journal rows are in the db.
+      // If the delete fails, nothing is written, so the new rows are not mixed with the old ones. The generation
+      // row goes first, since the tables are not up to date until they are written again.
+      if (RTN_NO_ERROR == insertStatus && dbBatches.empty()) {
+        Metrics::ScopedTimer timer("positions.delete");
+        if (!isLocalBackend_)
+          insertStatus= generation.Delete(dbCommand_, errorText_);
+        if (RTN_NO_ERROR == insertStatus)
+          insertStatus= DeleteAllPositions();
+      }
 
       std::cout << "Insert records into SCS position table." << std::endl;
-      insertStatus = InsertIntoScsDb(); 
+      if (RTN_NO_ERROR == insertStatus) {
+        Metrics::ScopedTimer timer("positions.scs_insert");
+        insertStatus = isLocalBackend_ ? InsertIntoScsDb() : InsertIntoScsDb(journal); 
+      }
       std::cout << "Done inserting records into SCS position table." << std::endl << std::endl;
 
-      // Cls table is built from data in the scs table. It must go second.
-      std::cout << "Insert records into CLS position table." << std::endl;
-      insertStatus = InsertIntoClsDb(); 
-      std::cout << "Done inserting records into CLS position table." << std::endl << std::endl;
+      // Cls table is built from data in the scs table. It must go second, after all the SCS rows are in.
+      // The generation row of the tables is written in the same transaction.
+      if (RTN_NO_ERROR == insertStatus) {
+        std::cout << "Insert records into CLS position table." << std::endl;
+        {
+          Metrics::ScopedTimer timer("positions.cls_sproc");
+          insertStatus = isLocalBackend_ ? InsertIntoClsDb() : InsertIntoClsDb(generation); 
+        }
+        std::cout << "Done inserting records into CLS position table." << std::endl << std::endl;
+      }
+
+      // the tables are written, so there is nothing to resume
+      if (RTN_NO_ERROR == insertStatus && !isLocalBackend_)
+        journal.Remove();
       }
       
     // is status is okay (connection was sucessful), disconnect from the db
-    if (RTN_NO_ERROR == connectStatus)
+    if (RTN_NO_ERROR == connectStatus) {
+      Metrics::ScopedTimer timer("positions.disconnect");
       connectStatus= DbDisconnect();
+      }
 
     if (RTN_NO_ERROR == connectStatus && RTN_NO_ERROR == insertStatus)
       return RTN_NO_ERROR;
@@ -260,7 +526,7 @@ namespace gaScsData {
       // Calculate large (r2) and small (r1) radius and RArc
       transR2_= coilMap_.GetRadiusLb(angle); // nominal radius at start of transition
       transR1_= transR2_ - TURN_INDEX_NOMINAL; // nominal radius after the transition (next turn)
-      transRArc_= transR2_ - TRANS_Ro; 
+      transRArc_= transR2_ - transRo_; 
       // Calculate the angle beyond the start of the transition (RIA - beginning of transition angle).
         // The angles in the coil map for transitions are by definition the angles of the
         // start of the transitions, therefore, when in a transition region, the angle of the start
@@ -268,21 +534,21 @@ namespace gaScsData {
       transAngleFromStart_= angle - coilMap_.GetAngleLb(angle); 
       
       // Calculate angle where regions changes from arc to straight
-      transAngleChange_= TRANS_ARC_DEG - (atan(TRANS_STRAIGHT_LENGTH / transR1_) * RADIANS_TO_DEG); 
+      transAngleChange_= params_.transArcDeg - (atan(params_.transStraightLength / transR1_) * RADIANS_TO_DEG); 
       
       // Calculate the radius within the transition region. The formula used depends on if the 
         // angle falls in the straight or arc region of the transition.
       if (0 <= transAngleFromStart_ && transAngleFromStart_ <= transAngleChange_) { // arc region
         // angle is between 0 and the change angle (inclusive)
-        transR_= (TRANS_Ro * cos(transAngleFromStart_ * DEG_TO_RADIANS)) +
-                 sqrt(pow(transRArc_, 2) - (pow(TRANS_Ro, 2) * pow(sin(transAngleFromStart_ * DEG_TO_RADIANS), 2)));
+        transR_= (transRo_ * cos(transAngleFromStart_ * DEG_TO_RADIANS)) +
+                 sqrt(pow(transRArc_, 2) - (pow(transRo_, 2) * pow(sin(transAngleFromStart_ * DEG_TO_RADIANS), 2)));
 
         // return the size of the adjustment
         return transR2_ - transR_; // radius is getting smaller, adjustment should be positive
         }
-      else if (transAngleChange_ < transAngleFromStart_ && transAngleFromStart_ <= TRANS_ARC_DEG ){ // straight region
+      else if (transAngleChange_ < transAngleFromStart_ && transAngleFromStart_ <= params_.transArcDeg ){ // straight region
         // angle greater than change angle and less than or equal to the total transition angle
-        transR_= transR1_ / (cos((TRANS_ARC_DEG - transAngleFromStart_) * DEG_TO_RADIANS));
+        transR_= transR1_ / (cos((params_.transArcDeg - transAngleFromStart_) * DEG_TO_RADIANS));
 
         // return the size of the adjustment
         return transR2_ - transR_; // radius is getting smaller, adjustment should be positive
@@ -299,7 +565,7 @@ namespace gaScsData {
       // Calculate small (r1) and large (r2) radius and RArc
       transR1_= coilMap_.GetRadiusLb(angle); // nominal radius at start of transition
       transR2_= transR1_ + TURN_INDEX_NOMINAL; // nominal radius after the transition (next turn)
-      transRArc_= transR2_ - TRANS_Ro; 
+      transRArc_= transR2_ - transRo_; 
       // Calculate the angle beyond the start of the transition (RIA - beginning of transition angle).
         // The angles in the coil map for transitions are by definition the angles of the
         // start of the transitions, therefore, when in a transition region, the angle of the start
@@ -307,7 +573,7 @@ namespace gaScsData {
       transAngleFromStart_= angle - coilMap_.GetAngleLb(angle); 
       
       // Calculate angle where regions changes from straight to arc
-      transAngleChange_= atan(TRANS_STRAIGHT_LENGTH / transR1_) * RADIANS_TO_DEG; 
+      transAngleChange_= atan(params_.transStraightLength / transR1_) * RADIANS_TO_DEG; 
       
       // Calculate the radius within the transition region. The formula used depends on if the 
         // angle falls in the straight or arc region of the transition.
@@ -318,10 +584,10 @@ namespace gaScsData {
         // return the sizs of the adjustment
         return transR_ - transR1_; // radius is getting larger, adjustment should be positive
         }
-      else if (transAngleChange_ < transAngleFromStart_ && transAngleFromStart_ <= TRANS_ARC_DEG ){ // arc region
+      else if (transAngleChange_ < transAngleFromStart_ && transAngleFromStart_ <= params_.transArcDeg ){ // arc region
         // angle greater than change angle and less than or equal to the total transition angle
-        transR_= (TRANS_Ro * cos((transAngleFromStart_ - TRANS_ARC_DEG) * DEG_TO_RADIANS)) +
-                 sqrt(pow(transRArc_, 2) - (pow(TRANS_Ro, 2) * pow(sin((transAngleFromStart_ - TRANS_ARC_DEG) * DEG_TO_RADIANS), 2)));
+        transR_= (transRo_ * cos((transAngleFromStart_ - params_.transArcDeg) * DEG_TO_RADIANS)) +
+                 sqrt(pow(transRArc_, 2) - (pow(transRo_, 2) * pow(sin((transAngleFromStart_ - params_.transArcDeg) * DEG_TO_RADIANS), 2)));
 
         // return the size of the adjustment
         return transR_ - transR1_; // radius is getting larger, adjustment should be positive
@@ -434,31 +700,31 @@ namespace gaScsData {
     degToPrevJoggle= prevJoggleAngle - angle; // negative value when past a joggle
     double prevJoggleLength= coilMap_.GetJoggleLengthLb(prevJoggleAngle);
     
-    if ((JOGGLE_RETRACT_ADJ_THRESHOLD < degToNextJoggle) && // next is too far ahead for region 1
-        (JOGGLE_ADV_TO_FIRST_THRESHOLD - prevJoggleLength) > degToPrevJoggle) { // previous is too far past for retion 2 or 3
+    if ((params_.joggleRetractAdjThreshold < degToNextJoggle) && // next is too far ahead for region 1
+        (params_.joggleAdvToFirstThreshold - prevJoggleLength) > degToPrevJoggle) { // previous is too far past for retion 2 or 3
       // not close enouth to the next joggle for region 1, and too far past last joggle for region 2 or 3
       // no joggle adjustment and do nominal moves for both advancing and retracting feet
       jAdj= 0;
       return JA_RET_NOM_ADV_NOM;
       }
-    else if (JOGGLE_RETRACT_ADJ_THRESHOLD >= degToNextJoggle && 
-             (JOGGLE_RETRACT_ADJ_THRESHOLD - nextJoggleLength) <= degToNextJoggle) { // within region 1
+    else if (params_.joggleRetractAdjThreshold >= degToNextJoggle && 
+             (params_.joggleRetractAdjThreshold - nextJoggleLength) <= degToNextJoggle) { // within region 1
       // cannot also be in region 2 or 3 because joggles are not very close together
       // joggle adjustment should be half a normal index
       jAdj= TURN_INDEX_NOMINAL / 2.0;
       // adjustment type is to adjust the retreating foot by the adjustment value and to do a nominal index of the advancing foot
       return JA_RET_ADJ_ADV_NOM;
       }
-    else if (JOGGLE_FULL_RETRACT_THRESHOLD >= degToPrevJoggle && 
-             (JOGGLE_FULL_RETRACT_THRESHOLD - prevJoggleLength) <= degToPrevJoggle) { // within region 2
+    else if (params_.joggleFullRetractThreshold >= degToPrevJoggle && 
+             (params_.joggleFullRetractThreshold - prevJoggleLength) <= degToPrevJoggle) { // within region 2
       // cannot also be in region 1 or 3 because joggles are not very close together
       // joggle adjustment not used for this type of joggle adjustment
       jAdj= 0;
       // adjustment type is to fully retract the retreating foot, and do nothing (no move) on the advancing foot
       return JA_RET_FULL_ADV_NOP;
       }
-    else if (JOGGLE_ADV_TO_FIRST_THRESHOLD >= degToPrevJoggle && 
-             (JOGGLE_ADV_TO_FIRST_THRESHOLD - prevJoggleLength) <= degToPrevJoggle) { // within region 3
+    else if (params_.joggleAdvToFirstThreshold >= degToPrevJoggle && 
+             (params_.joggleAdvToFirstThreshold - prevJoggleLength) <= degToPrevJoggle) { // within region 3
       // cannot also be in region 1 or 2 because joggles are not very close together
       // joggle adjustment not used for this type of joggle adjustment
       jAdj= 0;
@@ -482,7 +748,7 @@ namespace gaScsData {
     // Return an (angle,isEven) pair.
   AxisPositions::angleIsEven_pair AxisPositions::CalculateNewLayerRiaAngle(double coilAngle, double joggleAngle) const {
     // Calculate the ria angle where the new layer positions should go.
-    double riaAngle= coilAngle - ADV_FOOT_RIA_OFFSET_ANGLE + NEW_LAYER_OFFSET;
+    double riaAngle= coilAngle - params_.advFootRiaOffsetAngle + params_.newLayerOffset;
     // see if the new layer is even or odd
     bool stat, isEven;
     stat = coilMap_.isEvenLayerLb(joggleAngle, isEven); 
@@ -901,7 +1167,12 @@ namespace gaScsData {
   // Map the specified angle to the position detail in the SCS Axis Position Map
   void AxisPositions::MapScsAxisMoves(long angle, const SPosDetail &posDetail) {
     // add the angle and associated properties to the map
-    scsAxisPositionMap_[angle]=posDetail;
+    std::pair<sapm_iter, bool> inserted= scsAxisPositionMap_.insert(std::make_pair(angle, posDetail));
+    if (!inserted.second) {
+      // there is already a row at this angle. The later row replaces it, and the replaced row is kept for validation.
+      keyCollisions_.push_back(std::make_pair(angle, inserted.first->second.get<4>().get<0>()));
+      inserted.first->second= posDetail;
+      }
     } //  AxesPositions::MapScsAxisMoves()
 
   void AxisPositions::MapScsAxisMoves(double angle, const SPosDetail &posDetail) {
@@ -953,7 +1224,7 @@ namespace gaScsData {
       // Look forward to get the next joggle
       newHqpAngle = coilMap_.GetJoggleUb(angle);
       // calculate the start angle of the HQP = (Joggle + Joggle Window) - Retreating Foot Offset
-      newHqpAngle = (newHqpAngle + JOGGLE_LENGTH_MIN) - RET_FOOT_RIA_OFFSET_ANGLE;
+      newHqpAngle = (newHqpAngle + JOGGLE_LENGTH_MIN) - params_.retFootRiaOffsetAngle;
       // new hqp and not in a joggle. Set adjustment values to +1
       hqpAdj= 1;
       layerAdj= 1;
@@ -965,7 +1236,7 @@ namespace gaScsData {
       newHqpAngle = coilMap_.GetJoggleLb(angle);
       // valid Joggle angle found
       // calculate the start angle of the HQP = (Joggle + Joggle Window) - Retreating Foot Offset
-      newHqpAngle = (newHqpAngle + JOGGLE_LENGTH_MIN) - RET_FOOT_RIA_OFFSET_ANGLE;
+      newHqpAngle = (newHqpAngle + JOGGLE_LENGTH_MIN) - params_.retFootRiaOffsetAngle;
       // new hqp and in a joggle. Set adjustment values to 0
       hqpAdj= 0;
       layerAdj= 0;
@@ -1049,7 +1320,7 @@ namespace gaScsData {
     // use the F column azimuth to figure out the transition amount
     bool stat, result; // local results
     double degToPrevTrans;
-    stat= coilMap_.isInTransitionLb(F_COLUMN_AZIMUTH, result, degToPrevTrans);
+    stat= coilMap_.isInTransitionLb(F_COLUMN_AZIMUTH, result, degToPrevTrans, params_.transArcDeg);
     if (stat && result) { // in a transition window -- this should always be true for the beginning of the coil
 
       // Mark the column as needing adjustment to keep track of this column
@@ -1224,6 +1495,7 @@ namespace gaScsData {
   // In a joggle (that isn't a new layer or new hex), and **only on the last layer** -- Hqp adj is 0 and layer adjust is -1
   // Not in a joggle -- Hqp and layer adjust are both 0
   void AxisPositions::CalculateAxisMoves() {
+    keyCollisions_.clear();
     // keep track of which turn the feet are under
     long retreatingColumnTurn= 0;
     long advancingColumnTurn= 0;
@@ -1276,21 +1548,34 @@ namespace gaScsData {
     bool result; // the results of the tested condition
     bool stat; // indicates status
 
-    // variables to deal with displaying progress
-    double iterations = COIL_ANGLE_MAX / COLUMN_INCREMENT;  // number of loop iterations for display purposes -- use double so pctDone does not use interger math
-    long count= 0;  // loop counter for display purposes
-    long pctDone= 0;  // percent done
+    // number of loop iterations for display purposes
+    const long iterations= static_cast<long>(coilAngleMax_ / COLUMN_INCREMENT);
 
     // display progress
-    std::cout << "Approximately " << static_cast<long>(iterations) << " angles to iterate" << std::endl;
-    std::cout << "between " << INITIAL_COLUMN_ANGLE << " and " << COIL_ANGLE_MAX << "." << std::endl;
+    std::cout << "Approximately " << iterations << " angles to iterate" << std::endl;
+    std::cout << "between " << INITIAL_COLUMN_ANGLE << " and " << coilAngleMax_ << "." << std::endl;
     std::cout << "Only angles falling on column azimuths are processed." << std::endl;
 
-    for (long currentAngle= INITIAL_COLUMN_ANGLE; currentAngle <= COIL_ANGLE_MAX; currentAngle += COLUMN_INCREMENT) {
-      // display progress
-      ++count;
-      pctDone= static_cast<long>(100 * (count / iterations));  // truncate fractional percentages
-      std::cout << "On angle " << currentAngle << " of " << COIL_ANGLE_MAX << " (" << pctDone << " %)\r" << std::flush; // no linefeed so this line will be overwritten next time thru
+    // trace timeline, one span per layer. Nominal layer boundaries from the angle, so no coil map lookups are added.
+    TraceRecorder::SpanSequence layerSpans("calculate_axis_moves");
+    const bool isTracing= TraceRecorder::Instance().IsEnabled();
+    long traceLayer= 0;
+    const long turnsPerLayer= coilMap_.GetGeometry().turnsPerLayer;
+
+    // largest adjustments, for the parameter sweep summary
+    maxTransAdj_= 0.0;
+    maxJoggleAdj_= 0.0;
+
+    // the loop only counts. The display is redrawn by the reporter at a fixed rate.
+    ProgressReporter progress("Angles", static_cast<size_t>(iterations));
+
+    for (long currentAngle= INITIAL_COLUMN_ANGLE; currentAngle <= coilAngleMax_; currentAngle += COLUMN_INCREMENT) {
+      // count progress
+      progress.Add();
+      if (isTracing && currentAngle / (360 * turnsPerLayer) + 1 != traceLayer) {
+        traceLayer= currentAngle / (360 * turnsPerLayer) + 1;
+        layerSpans.Next("layer " + std::to_string(static_cast<long long>(traceLayer)));
+        }
 
       // capture current angle in logic trace
       logicTrace= "Column Ang: " + std::to_string(static_cast<long long>(currentAngle)) + ", ";
@@ -1419,7 +1704,7 @@ namespace gaScsData {
         // of the previous accumulated adjustments until the foot was out of the window
         // on the previous turn or the layer ends.
         
-        stat= coilMap_.isInTransitionLb(currentAngle, result, degToPrevTrans);
+        stat= coilMap_.isInTransitionLb(currentAngle, result, degToPrevTrans, params_.transArcDeg);
         if (stat && result) { // in a transition window
           // Mark the column as needing adjustment to keep track of this column
           // the the next time through (vs other columns no near the transition) and
@@ -1471,6 +1756,12 @@ namespace gaScsData {
           }
         }
 
+      // keep the largest adjustments
+      if (JA_RET_ADJ_ADV_NOM == jAdjType && std::abs(jAdj) > maxJoggleAdj_)
+        maxJoggleAdj_= std::abs(jAdj);
+      if (std::abs(tThisAdj) > maxTransAdj_)
+        maxTransAdj_= std::abs(tThisAdj);
+
       // Get layer number and even or odd layer
       // need to consider the joggle adjustment type because the layer number lookup
       // when the angle is at or near a joggle (Region 2, JA_RET_FULL_ADV_NOP) gives the layer number 1 too many
@@ -1560,7 +1851,7 @@ namespace gaScsData {
       if (!isLastLayer) {
         // not the last layer
         // Capture RIA angle for advancing feet
-        riaAngle= currentAngle - static_cast<long>(round(ADV_FOOT_RIA_OFFSET_ANGLE));
+        riaAngle= currentAngle - static_cast<long>(round(params_.advFootRiaOffsetAngle));
         
         // Look at the last turn staus and the joggle adjustment type (determined above) to figure out what the advancing
         // foot should do
@@ -1640,7 +1931,7 @@ namespace gaScsData {
 
       // calculate retreating column position
       // Capture RIA angle for retreating feet
-      riaAngle= currentAngle - static_cast<long>(round(RET_FOOT_RIA_OFFSET_ANGLE));
+      riaAngle= currentAngle - static_cast<long>(round(params_.retFootRiaOffsetAngle));
 
       // It not the last turn, then look at the joggle adjustment type (determined above) to figure out what the retreating 
       // foot position should be.
@@ -1713,8 +2004,9 @@ namespace gaScsData {
 
       } // for currentAngle
     
-    // end the line and add an extra line after the output in the for loop.
-    std::cout << std::endl << std::endl;
+    // final progress display, then add an extra line after it.
+    progress.Finish();
+    std::cout << std::endl;
 
     } // AxisPositions::CalculateAxisMoves()
     
@@ -1769,6 +2061,7 @@ namespace gaScsData {
         // (there are not any input parameters for this stored procedure)
         
       // execute the command
+      Metrics::ScopedTimer latency("sproc." + SPNAME_CALC_CLS_POS, Metrics::TK_LATENCY);
       dbCommand_.Execute();
       // set return value for all okay
       rtnValue= RTN_NO_ERROR;
@@ -1783,26 +2076,72 @@ namespace gaScsData {
     return rtnValue;
     } // AxisPositions::InsertIntoClsDb(double angle, const CPosDetail &posDetail)
 
+  // Create Cls moves from the Scs Position table, and write the generation row of the tables, in one transaction
+  // assumes valid connection has been made
+  // return value indicates success or error
+  long AxisPositions::InsertIntoClsDb(const TableGeneration &generation) {
+    long rtnValue= RTN_ERROR;
+    try {
+      dbConnection_.setAutoCommit(SA_AutoCommitOff);
+      rtnValue= InsertIntoClsDb();
+      if (RTN_NO_ERROR == rtnValue)
+        rtnValue= generation.Write(dbCommand_, GetInputHash(), errorText_);
+      if (RTN_NO_ERROR == rtnValue)
+        dbConnection_.Commit();
+      else
+        dbConnection_.Rollback();
+      dbConnection_.setAutoCommit(SA_AutoCommitOn);
+      }
+    catch(SAException &ex) {
+      // get error message
+      errorText_= (const char*)ex.ErrText();
+      std::cout << errorText_ << std::endl;
+      try {
+        dbConnection_.Rollback();
+        dbConnection_.setAutoCommit(SA_AutoCommitOn);
+        }
+      catch(SAException &) {
+        }
+      rtnValue= RTN_ERROR;
+      }
+    return rtnValue;
+    } // AxisPositions::InsertIntoClsDb(const TableGeneration &generation)
+
   // insert a row into the SCS db table at the Ria angle. Use values from the SCS Position Detail
   // assumes valid connection has been made
   // return value indicates success or error
-  long AxisPositions::InsertIntoScsDb(double riaAngle, const SPosDetail &posDetail) {
+  long AxisPositions::InsertIntoScsDb(long sequence, double riaAngle, const SPosDetail &posDetail) {
+
+    // local backend, record the row instead of writing it to the db
+    if (isLocalBackend_) {
+      // Construct the move summary string from the logic trace.
+      GetMoveSummary(posDetail.get<4>().get<0>(), moveSum_);
+      localRows_.push_back(LocalRowTyp(riaAngle, moveSum_));
+      return RTN_NO_ERROR;
+      }
+
+    const long rtnValue= InsertIntoScsDb(dbCommand_, sequence, riaAngle, posDetail, errorText_);
+    // output the error text
+    if (RTN_NO_ERROR != rtnValue)
+      std::cout << errorText_ << std::endl;
+    return rtnValue;
+    } // AxisPositions::InsertIntoScsDb(long sequence, double angle, const SPosDetail &posDetail)
+
+  // insert a row into the SCS db table with the passed in command. Called from the journal range threads,
+  // so only the command and the error text are changed.
+  // assumes valid connection has been made
+  // return value indicates success or error
+  long AxisPositions::InsertIntoScsDb(SACommand &command, long sequence, double riaAngle, const SPosDetail &posDetail,
+                                      std::string &errorText) const {
 
     // variable to hold return value
     long rtnValue= 0;
     
     // Construct the move summary string from the logic trace.
     // It will populate the action description field below.
-    msPos_= posDetail.get<4>().get<0>().find(MS_TOKEN); // look for the move summary token
-    if (msPos_ != std::string::npos) {
-      // move summary token was found. Ignore the first character, and put it in the move summary string.
-      moveSum_= posDetail.get<4>().get<0>().substr(msPos_ + 1);
-      }
-    else {
-      // move summary string not found. Make the move summary the entire logic trace.
-      moveSum_= posDetail.get<4>().get<0>();
-      }
-    
+    std::string moveSum;
+    GetMoveSummary(posDetail.get<4>().get<0>(), moveSum);
+
     // Look at the isSelectedAxes flag (element 0 in the SelectedAxes vector),
       // in the posDetail to know which SQL procedure to call, 
       // and which parameters are used.
@@ -1816,69 +2155,70 @@ namespace gaScsData {
         // look at the absolute adjust flag to know which procedure to call
         if (posDetail.get<3>().get<2>()) {  // absolute adjust flag is true
           // this procedure always inserts an absolute row for the selected axes.
-          dbCommand_.setCommandText(SPNAME_INSERT_SEL_ADJ_ABS_SCS_POS.c_str(), SA_CmdStoredProc);
+          command.setCommandText(SPNAME_INSERT_SEL_ADJ_ABS_SCS_POS.c_str(), SA_CmdStoredProc);
           // the absolute flag is not used
           // set the distance parameter name and value
-          dbCommand_.Param(SAP_ABS_ADJ_DIST_SEL_PARAM.c_str()).setAsDouble() = posDetail.get<3>().get<0>();    // distance from SelectedDetail tuple
+          command.Param(SAP_ABS_ADJ_DIST_SEL_PARAM.c_str()).setAsDouble() = posDetail.get<3>().get<0>();    // distance from SelectedDetail tuple
           }
         else { // absolute adjust flag is false
           // this procedure inserts a relative or absolute row based on the parameter for the selected axes
-          dbCommand_.setCommandText(SPNAME_INSERT_SEL_SCS_POS.c_str(), SA_CmdStoredProc);
+          command.setCommandText(SPNAME_INSERT_SEL_SCS_POS.c_str(), SA_CmdStoredProc);
           // set the isAbsolute parameter name and value
-          dbCommand_.Param(SAP_ISABSOLUTE_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<1>();    // isAbsolute flag
+          command.Param(SAP_ISABSOLUTE_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<1>();    // isAbsolute flag
           // set the distance/position parameter name
-          dbCommand_.Param(SAP_POSDIST_SEL_PARAM.c_str()).setAsDouble() = posDetail.get<3>().get<0>(); // position / distance from SelectedDetail tuple
+          command.Param(SAP_POSDIST_SEL_PARAM.c_str()).setAsDouble() = posDetail.get<3>().get<0>(); // position / distance from SelectedDetail tuple
           }
 
           // construct the 
           // set the input parameters
-          dbCommand_.Param(SAP_RIAANGLE_PARAM.c_str()).setAsDouble() = riaAngle;                      // ria angle
-          dbCommand_.Param(SAP_COILANGLE_PARAM.c_str()).setAsDouble() = posDetail.get<4>().get<8>();  // coil angle
-          dbCommand_.Param(SAP_LOGICTRACE_PARAM.c_str()).setAsString() = posDetail.get<4>().get<0>().c_str();  // logic trace
-          dbCommand_.Param(SAP_ACTIONDESC_PARAM.c_str()).setAsString() = moveSum_.c_str();  // action description - part of the logic trace
-          dbCommand_.Param(SAP_ISTRANSITION_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<2>(); // isInTransition
-          dbCommand_.Param(SAP_ISJOGGLE_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<3>();     // isInJoggle
-          dbCommand_.Param(SAP_ISNEWHQP_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<4>();     // isNewHqp
-          dbCommand_.Param(SAP_ISNEWLAYER_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<5>();   // isNewLayer
-          dbCommand_.Param(SAP_ISLASTTURN_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<6>();   // isLastTurn
-          dbCommand_.Param(SAP_ISLASTLAYER_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<7>();   // isLastLayer
-          dbCommand_.Param(SAP_HQPADJ_PARAM.c_str()).setAsLong() = posDetail.get<5>().get<0>();   // hqpAdjust
-          dbCommand_.Param(SAP_LAYERADJ_PARAM.c_str()).setAsLong() = posDetail.get<5>().get<1>();   // layerAdjust
-          dbCommand_.Param(SAP_FTAIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[1];          // axis selections
-          dbCommand_.Param(SAP_FTAOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[2];
-          dbCommand_.Param(SAP_FTBIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[3];
-          dbCommand_.Param(SAP_FTBOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[4];
-          dbCommand_.Param(SAP_FTCIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[5];
-          dbCommand_.Param(SAP_FTCOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[6];
-          dbCommand_.Param(SAP_FTDIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[7];
-          dbCommand_.Param(SAP_FTDOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[8];
-          dbCommand_.Param(SAP_FTEIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[9];
-          dbCommand_.Param(SAP_FTEOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[10];
-          dbCommand_.Param(SAP_FTFIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[11];
-          dbCommand_.Param(SAP_FTFOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[12];
-          dbCommand_.Param(SAP_COLAIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[13];
-          dbCommand_.Param(SAP_COLAOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[14];
-          dbCommand_.Param(SAP_COLBIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[15];
-          dbCommand_.Param(SAP_COLBOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[16];
-          dbCommand_.Param(SAP_COLCIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[17];
-          dbCommand_.Param(SAP_COLCOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[18];
-          dbCommand_.Param(SAP_COLDIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[19];
-          dbCommand_.Param(SAP_COLDOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[20];
-          dbCommand_.Param(SAP_COLEIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[21];
-          dbCommand_.Param(SAP_COLEOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[22];
-          dbCommand_.Param(SAP_COLFIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[23];
-          dbCommand_.Param(SAP_COLFOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[24];
+          command.Param(WJ_SEQUENCE_PARAM.c_str()).setAsLong() = sequence;                        // write order
+          command.Param(SAP_RIAANGLE_PARAM.c_str()).setAsDouble() = riaAngle;                      // ria angle
+          command.Param(SAP_COILANGLE_PARAM.c_str()).setAsDouble() = posDetail.get<4>().get<8>();  // coil angle
+          command.Param(SAP_LOGICTRACE_PARAM.c_str()).setAsString() = posDetail.get<4>().get<0>().c_str();  // logic trace
+          command.Param(SAP_ACTIONDESC_PARAM.c_str()).setAsString() = moveSum.c_str();  // action description - part of the logic trace
+          command.Param(SAP_ISTRANSITION_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<2>(); // isInTransition
+          command.Param(SAP_ISJOGGLE_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<3>();     // isInJoggle
+          command.Param(SAP_ISNEWHQP_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<4>();     // isNewHqp
+          command.Param(SAP_ISNEWLAYER_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<5>();   // isNewLayer
+          command.Param(SAP_ISLASTTURN_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<6>();   // isLastTurn
+          command.Param(SAP_ISLASTLAYER_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<7>();   // isLastLayer
+          command.Param(SAP_HQPADJ_PARAM.c_str()).setAsLong() = posDetail.get<5>().get<0>();   // hqpAdjust
+          command.Param(SAP_LAYERADJ_PARAM.c_str()).setAsLong() = posDetail.get<5>().get<1>();   // layerAdjust
+          command.Param(SAP_FTAIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[1];          // axis selections
+          command.Param(SAP_FTAOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[2];
+          command.Param(SAP_FTBIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[3];
+          command.Param(SAP_FTBOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[4];
+          command.Param(SAP_FTCIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[5];
+          command.Param(SAP_FTCOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[6];
+          command.Param(SAP_FTDIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[7];
+          command.Param(SAP_FTDOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[8];
+          command.Param(SAP_FTEIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[9];
+          command.Param(SAP_FTEOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[10];
+          command.Param(SAP_FTFIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[11];
+          command.Param(SAP_FTFOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[12];
+          command.Param(SAP_COLAIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[13];
+          command.Param(SAP_COLAOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[14];
+          command.Param(SAP_COLBIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[15];
+          command.Param(SAP_COLBOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[16];
+          command.Param(SAP_COLCIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[17];
+          command.Param(SAP_COLCOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[18];
+          command.Param(SAP_COLDIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[19];
+          command.Param(SAP_COLDOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[20];
+          command.Param(SAP_COLEIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[21];
+          command.Param(SAP_COLEOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[22];
+          command.Param(SAP_COLFIN_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[23];
+          command.Param(SAP_COLFOUT_SEL_PARAM.c_str()).setAsBool() = posDetail.get<2>()[24];
 
           // execute the command
-          dbCommand_.Execute();
+          Metrics::ScopedTimer latency(posDetail.get<3>().get<2>() ? "sproc." + SPNAME_INSERT_SEL_ADJ_ABS_SCS_POS : "sproc." + SPNAME_INSERT_SEL_SCS_POS,
+                                       Metrics::TK_LATENCY);
+          command.Execute();
           // set return value for all okay
           rtnValue= RTN_NO_ERROR;
           } // try block
       catch(SAException &ex) {
         // get error message
-        errorText_= (const char*)ex.ErrText();
-        // output the error text
-        std::cout << errorText_ << std::endl;
+        errorText= (const char*)ex.ErrText();
         // set return value to indicate an error
         rtnValue= RTN_ERROR;
         }
@@ -1888,63 +2228,63 @@ namespace gaScsData {
 
       try {    
         // Set the command text of the command object
-        dbCommand_.setCommandText(SPNAME_INSERT_ALL_SCS_POS.c_str(), SA_CmdStoredProc);
+        command.setCommandText(SPNAME_INSERT_ALL_SCS_POS.c_str(), SA_CmdStoredProc);
 
         // set the input parameters
-        dbCommand_.Param(SAP_RIAANGLE_PARAM.c_str()).setAsDouble() = riaAngle;                      // ria Angle
-        dbCommand_.Param(SAP_COILANGLE_PARAM.c_str()).setAsDouble() = posDetail.get<4>().get<8>();  // coil angle
-        dbCommand_.Param(SAP_ISABSOLUTE_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<1>();   // isAbsolute flag
-        dbCommand_.Param(SAP_LOGICTRACE_PARAM.c_str()).setAsString() = posDetail.get<4>().get<0>().c_str();  // logic trace
-        dbCommand_.Param(SAP_ACTIONDESC_PARAM.c_str()).setAsString() = moveSum_.c_str();  // action description - part of the logic trace
-        dbCommand_.Param(SAP_ISTRANSITION_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<2>(); // isInTransition
-        dbCommand_.Param(SAP_ISJOGGLE_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<3>();     // isInJoggle
-        dbCommand_.Param(SAP_ISNEWHQP_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<4>();     // isNewHqp
-        dbCommand_.Param(SAP_ISNEWLAYER_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<5>();   // isNewLayer
-        dbCommand_.Param(SAP_ISLASTTURN_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<6>();   // isLastTurn
-        dbCommand_.Param(SAP_ISLASTLAYER_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<7>();   // isLastLayer
-        dbCommand_.Param(SAP_HQPADJ_PARAM.c_str()).setAsLong() = posDetail.get<5>().get<0>();   // hqpAdjust
-        dbCommand_.Param(SAP_LAYERADJ_PARAM.c_str()).setAsLong() = posDetail.get<5>().get<1>();   // layerAdjust
-        dbCommand_.Param(SAP_FTAIN_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[0];            // Distance position values
-        dbCommand_.Param(SAP_FTAOUT_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[1];
-        dbCommand_.Param(SAP_FTBIN_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[2];
-        dbCommand_.Param(SAP_FTBOUT_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[3];
-        dbCommand_.Param(SAP_FTCIN_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[4];
-        dbCommand_.Param(SAP_FTCOUT_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[5];
-        dbCommand_.Param(SAP_FTDIN_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[6];
-        dbCommand_.Param(SAP_FTDOUT_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[7];
-        dbCommand_.Param(SAP_FTEIN_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[8];
-        dbCommand_.Param(SAP_FTEOUT_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[9];
-        dbCommand_.Param(SAP_FTFIN_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[10];
-        dbCommand_.Param(SAP_FTFOUT_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[11];
-        dbCommand_.Param(SAP_COLAIN_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[0];
-        dbCommand_.Param(SAP_COLAOUT_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[1];
-        dbCommand_.Param(SAP_COLBIN_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[2];
-        dbCommand_.Param(SAP_COLBOUT_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[3];
-        dbCommand_.Param(SAP_COLCIN_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[4];
-        dbCommand_.Param(SAP_COLCOUT_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[5];
-        dbCommand_.Param(SAP_COLDIN_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[6];
-        dbCommand_.Param(SAP_COLDOUT_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[7];
-        dbCommand_.Param(SAP_COLEIN_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[8];
-        dbCommand_.Param(SAP_COLEOUT_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[9];
-        dbCommand_.Param(SAP_COLFIN_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[10];
-        dbCommand_.Param(SAP_COLFOUT_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[11];
+        command.Param(WJ_SEQUENCE_PARAM.c_str()).setAsLong() = sequence;                        // write order
+        command.Param(SAP_RIAANGLE_PARAM.c_str()).setAsDouble() = riaAngle;                      // ria Angle
+        command.Param(SAP_COILANGLE_PARAM.c_str()).setAsDouble() = posDetail.get<4>().get<8>();  // coil angle
+        command.Param(SAP_ISABSOLUTE_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<1>();   // isAbsolute flag
+        command.Param(SAP_LOGICTRACE_PARAM.c_str()).setAsString() = posDetail.get<4>().get<0>().c_str();  // logic trace
+        command.Param(SAP_ACTIONDESC_PARAM.c_str()).setAsString() = moveSum.c_str();  // action description - part of the logic trace
+        command.Param(SAP_ISTRANSITION_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<2>(); // isInTransition
+        command.Param(SAP_ISJOGGLE_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<3>();     // isInJoggle
+        command.Param(SAP_ISNEWHQP_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<4>();     // isNewHqp
+        command.Param(SAP_ISNEWLAYER_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<5>();   // isNewLayer
+        command.Param(SAP_ISLASTTURN_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<6>();   // isLastTurn
+        command.Param(SAP_ISLASTLAYER_PARAM.c_str()).setAsBool() = posDetail.get<4>().get<7>();   // isLastLayer
+        command.Param(SAP_HQPADJ_PARAM.c_str()).setAsLong() = posDetail.get<5>().get<0>();   // hqpAdjust
+        command.Param(SAP_LAYERADJ_PARAM.c_str()).setAsLong() = posDetail.get<5>().get<1>();   // layerAdjust
+        command.Param(SAP_FTAIN_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[0];            // Distance position values
+        command.Param(SAP_FTAOUT_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[1];
+        command.Param(SAP_FTBIN_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[2];
+        command.Param(SAP_FTBOUT_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[3];
+        command.Param(SAP_FTCIN_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[4];
+        command.Param(SAP_FTCOUT_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[5];
+        command.Param(SAP_FTDIN_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[6];
+        command.Param(SAP_FTDOUT_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[7];
+        command.Param(SAP_FTEIN_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[8];
+        command.Param(SAP_FTEOUT_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[9];
+        command.Param(SAP_FTFIN_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[10];
+        command.Param(SAP_FTFOUT_PARAM.c_str()).setAsDouble() = posDetail.get<0>()[11];
+        command.Param(SAP_COLAIN_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[0];
+        command.Param(SAP_COLAOUT_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[1];
+        command.Param(SAP_COLBIN_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[2];
+        command.Param(SAP_COLBOUT_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[3];
+        command.Param(SAP_COLCIN_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[4];
+        command.Param(SAP_COLCOUT_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[5];
+        command.Param(SAP_COLDIN_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[6];
+        command.Param(SAP_COLDOUT_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[7];
+        command.Param(SAP_COLEIN_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[8];
+        command.Param(SAP_COLEOUT_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[9];
+        command.Param(SAP_COLFIN_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[10];
+        command.Param(SAP_COLFOUT_PARAM.c_str()).setAsDouble() = posDetail.get<1>()[11];
 
         // execute the command
-        dbCommand_.Execute();
+        Metrics::ScopedTimer latency("sproc." + SPNAME_INSERT_ALL_SCS_POS, Metrics::TK_LATENCY);
+        command.Execute();
         // set return value for all okay
         rtnValue= RTN_NO_ERROR;
         } // try block
       catch(SAException &ex) {
         // get error message
-        errorText_= (const char*)ex.ErrText();
-        // output the error text
-        std::cout << errorText_ << std::endl;
+        errorText= (const char*)ex.ErrText();
         // set return value to indicate an error
         rtnValue= RTN_ERROR;
         }
       return rtnValue;
       }
-    } // AxisPositions::InsertIntoScsDb(double angle, const SPosDetail &posDetail)
+    } // AxisPositions::InsertIntoScsDb(SACommand &command, long sequence, double angle, const SPosDetail &posDetail)
 
   // Iterate thru Axis position map and insert a row for each map entry
   // assumes valid connection has been made
@@ -1953,27 +2293,28 @@ namespace gaScsData {
     bool errorFlag = false;
     // variable to hold return value
     long rtnValue= 0;
-    // variables to deal with displaying progress
-    double records= static_cast<double>(scsAxisPositionMap_.size()); // number of records to insert -- use double so pctDone does not use interger math
-    long count= 0;  // loop counter for display purposes
-    double pctDone= 0;  // percent done
-
-    std::cout << "There are " << static_cast<long>(records) << " to insert." << std::endl;
+    // write order of the rows
+    long sequence= 0;
+    std::cout << "There are " << scsAxisPositionMap_.size() << " to insert." << std::endl;
+    ProgressReporter progress("Records", scsAxisPositionMap_.size());
+    if (isLocalBackend_) {
+      localRows_.clear();
+      localRows_.reserve(scsAxisPositionMap_.size());
+      }
 
     for(sapm_const_iter mci = scsAxisPositionMap_.begin(); mci != scsAxisPositionMap_.end(); ++mci) {
-      // display progress
-      ++count;
-      pctDone = static_cast<long>(100 * (count / records));
-      std::cout << "On record " << count << " of " << records << " (" << pctDone << " %)\r" << std::flush;
+      // count progress
+      progress.Add();
 
       // do the insert
-      rtnValue = InsertIntoScsDb(mci->first, mci->second);
+      rtnValue = InsertIntoScsDb(++sequence, mci->first, mci->second);
       if (rtnValue != RTN_NO_ERROR)
         errorFlag = true;
       } // for loop
 
-    // end the line and add an extra spece after the output in the for loop.
-    std::cout << std::endl << std::endl;
+    // final progress display, then add an extra line after it.
+    progress.Finish();
+    std::cout << std::endl;
 
     // check for an error
     if (!errorFlag) // no error flag, return ok
@@ -1982,6 +2323,170 @@ namespace gaScsData {
       return RTN_ERROR;
     } // AxisPositions::InsertIntoScsDb()
 
+  // Insert the journal rows of the batches not in the db, in batches, a range per connection, using the overload
+  // assumes valid connection has been made
+  // return value indicates success or error
+  long AxisPositions::InsertIntoScsDb(WriteJournal &journal) {
+    return journal.WriteBatches(serverText_, dbConnection_, dbCommand_,
+                                [this](SACommand &command, long sequence, const std::string &record, std::string &errorText) {
+                                  long riaAngle= 0;
+                                  SPosDetail posDetail;
+                                  if (RTN_NO_ERROR != GetJournalRow(record, riaAngle, posDetail)) {
+                                    errorText= "Error reading an SCS write journal row.";
+                                    return RTN_ERROR;
+                                    }
+                                  return InsertIntoScsDb(command, sequence, static_cast<double>(riaAngle), posDetail, errorText);
+                                  },
+                                errorText_);
+    } // AxisPositions::InsertIntoScsDb(WriteJournal &journal)
+
+  // move summary portion of the logic trace
+  void AxisPositions::GetMoveSummary(const std::string &logicTrace, std::string &moveSum) {
+    const std::size_t msPos= logicTrace.find(MS_TOKEN); // look for the move summary token
+    if (msPos != std::string::npos) {
+      // move summary token was found. Ignore the first character, and put it in the move summary string.
+      moveSum= logicTrace.substr(msPos + 1);
+      }
+    else {
+      // move summary string not found. Make the move summary the entire logic trace.
+      moveSum= logicTrace;
+      }
+    }
+
+  // journal record of one SCS row, in tuple order
+  void AxisPositions::PutJournalRow(std::string &record, long riaAngle, const SPosDetail &posDetail) {
+    WriteJournal::PutLong(record, riaAngle);
+    WriteJournal::PutLong(record, static_cast<long>(posDetail.get<0>().size()));
+    for (Positions::const_iterator cit= posDetail.get<0>().begin(); cit != posDetail.get<0>().end(); ++cit)
+      WriteJournal::PutDouble(record, *cit);
+    WriteJournal::PutLong(record, static_cast<long>(posDetail.get<1>().size()));
+    for (Positions::const_iterator cit= posDetail.get<1>().begin(); cit != posDetail.get<1>().end(); ++cit)
+      WriteJournal::PutDouble(record, *cit);
+    WriteJournal::PutLong(record, static_cast<long>(posDetail.get<2>().size()));
+    for (SelectedAxes::const_iterator cit= posDetail.get<2>().begin(); cit != posDetail.get<2>().end(); ++cit)
+      WriteJournal::PutBool(record, *cit);
+    WriteJournal::PutDouble(record, posDetail.get<3>().get<0>());
+    WriteJournal::PutLong(record, static_cast<long>(posDetail.get<3>().get<1>()));
+    WriteJournal::PutBool(record, posDetail.get<3>().get<2>());
+    WriteJournal::PutString(record, posDetail.get<4>().get<0>());
+    WriteJournal::PutBool(record, posDetail.get<4>().get<1>());
+    WriteJournal::PutBool(record, posDetail.get<4>().get<2>());
+    WriteJournal::PutBool(record, posDetail.get<4>().get<3>());
+    WriteJournal::PutBool(record, posDetail.get<4>().get<4>());
+    WriteJournal::PutBool(record, posDetail.get<4>().get<5>());
+    WriteJournal::PutBool(record, posDetail.get<4>().get<6>());
+    WriteJournal::PutBool(record, posDetail.get<4>().get<7>());
+    WriteJournal::PutDouble(record, posDetail.get<4>().get<8>());
+    WriteJournal::PutLong(record, posDetail.get<5>().get<0>());
+    WriteJournal::PutLong(record, posDetail.get<5>().get<1>());
+    }
+
+  // rows a journal range can start at. Scan from the end, keeping the axes read before they are set.
+  void AxisPositions::GetJournalRangeStarts(const ScsAxesPositionMap &positionMap, std::vector<bool> &isRangeStart) {
+    const size_t axisCount= COLUMN_COUNT * 2;
+    std::vector<bool> isRead(axisCount, false);
+    size_t readCount= 0;
+    isRangeStart.assign(positionMap.size(), false);
+    size_t row= positionMap.size();
+    for (ScsAxesPositionMap::const_reverse_iterator crit= positionMap.rbegin(); crit != positionMap.rend(); ++crit) {
+      --row;
+      const SPosDetail &posDetail= crit->second;
+      const bool isSelected= posDetail.get<2>()[0];
+      const bool isAbsolute= posDetail.get<4>().get<1>();
+      for (size_t axis= 0; axis < axisCount; ++axis) {
+        // the same axis values as the position table view (PositionResolver::ApplyRow())
+        double value;
+        bool isAdjust= false;
+        if (!isSelected)
+          value= axis < static_cast<size_t>(COLUMN_COUNT) ? posDetail.get<0>()[axis] : posDetail.get<1>()[axis - COLUMN_COUNT];
+        else if (posDetail.get<2>()[axis + 1]) {
+          value= posDetail.get<3>().get<0>();
+          isAdjust= posDetail.get<3>().get<2>();
+          }
+        else
+          continue;  // not a selected axis
+        if (INITIAL_NO_POSITION == value || POSITION_NOT_CALCULATED == value)
+          continue;  // no position for this axis
+        if (isAdjust && !isRead[axis]) {
+          isRead[axis]= true;
+          ++readCount;
+          }
+        else if (!isAdjust && isAbsolute && isRead[axis]) {
+          isRead[axis]= false;
+          --readCount;
+          }
+        }
+      isRangeStart[row]= 0 == readCount;
+      }
+    }
+
+  long AxisPositions::GetJournalRow(const std::string &record, long &riaAngle, SPosDetail &posDetail) {
+    // return value indicates success or error
+    WriteJournal::RecordReader reader(record);
+    riaAngle= reader.GetLong();
+    // the vector sizes are checked against the record size, so a bad size can't make a huge allocation
+    posDetail.get<0>().resize(std::min(static_cast<size_t>(reader.GetLong()), record.size()));
+    for (Positions::iterator it= posDetail.get<0>().begin(); it != posDetail.get<0>().end(); ++it)
+      *it= reader.GetDouble();
+    posDetail.get<1>().resize(std::min(static_cast<size_t>(reader.GetLong()), record.size()));
+    for (Positions::iterator it= posDetail.get<1>().begin(); it != posDetail.get<1>().end(); ++it)
+      *it= reader.GetDouble();
+    posDetail.get<2>().resize(std::min(static_cast<size_t>(reader.GetLong()), record.size()));
+    for (size_t i= 0; i < posDetail.get<2>().size(); ++i)
+      posDetail.get<2>()[i]= reader.GetBool();
+    posDetail.get<3>().get<0>()= reader.GetDouble();
+    posDetail.get<3>().get<1>()= static_cast<AxisIndexes>(reader.GetLong());
+    posDetail.get<3>().get<2>()= reader.GetBool();
+    posDetail.get<4>().get<0>()= reader.GetString();
+    posDetail.get<4>().get<1>()= reader.GetBool();
+    posDetail.get<4>().get<2>()= reader.GetBool();
+    posDetail.get<4>().get<3>()= reader.GetBool();
+    posDetail.get<4>().get<4>()= reader.GetBool();
+    posDetail.get<4>().get<5>()= reader.GetBool();
+    posDetail.get<4>().get<6>()= reader.GetBool();
+    posDetail.get<4>().get<7>()= reader.GetBool();
+    posDetail.get<4>().get<8>()= reader.GetDouble();
+    posDetail.get<5>().get<0>()= reader.GetLong();
+    posDetail.get<5>().get<1>()= reader.GetLong();
+    return reader.IsOk() ? RTN_NO_ERROR : RTN_ERROR;
+    }
+
+  // Open the SCS write journal. Resume it if it is of the same inputs.
+  long AxisPositions::OpenJournal(WriteJournal &journal) {
+    // return value is RTN_NO_ERROR to resume, RTN_NO_RESULTS if there is no journal, and RTN_ERROR if it can't be resumed
+    const long openStatus= journal.Open();
+    if (RTN_NO_RESULTS == openStatus)
+      return RTN_NO_RESULTS;
+    if (RTN_NO_ERROR != openStatus || journal.GetInputHash() != GetInputHash()) {
+      std::cout << "The SCS write journal " << journal.GetFileName() << " is of a write that did not finish, with other inputs. "
+                << "The position tables are written again." << std::endl;
+      journal.Clear();
+      return RTN_ERROR;
+      }
+
+    scsAxisPositionMap_.clear();
+    keyCollisions_.clear();
+    long riaAngle= 0;
+    SPosDetail posDetail;
+    for (size_t row= 0; row < journal.GetRowCount(); ++row) {
+      if (RTN_NO_ERROR != GetJournalRow(journal.GetRow(row), riaAngle, posDetail)) {
+        std::cout << "Error reading row " << row << " of the SCS write journal " << journal.GetFileName()
+                  << ". The position tables are written again." << std::endl;
+        scsAxisPositionMap_.clear();
+        journal.Clear();
+        return RTN_ERROR;
+        }
+      // journal rows are in angle order, so the end of the map is the insertion hint
+      scsAxisPositionMap_.insert(scsAxisPositionMap_.end(), ScsAxesPositionMap::value_type(riaAngle, posDetail));
+      }
+    std::cout << "Resuming the SCS write journal " << journal.GetFileName() << ": " << journal.GetRowCount() << " rows, "
+              << journal.GetCommittedCount() << " of " << journal.GetBatchCount() << " batches committed, in "
+              << journal.GetRangeCount() << " ranges. "
+              << "The positions are not calculated again." << std::endl;
+    Metrics::Instance().AddCount("positions.scs_rows", static_cast<long long>(scsAxisPositionMap_.size()));
+    return RTN_NO_ERROR;
+    }
+
   // delete all rows from CLS and SCS position tables
   // assumes valid connection has been made
   // return value indicates success or error
@@ -1997,6 +2502,7 @@ namespace gaScsData {
       // there are no input parameters
 
       // execute the command
+      Metrics::ScopedTimer latency("sproc." + SPNAME_DELETE_ALL_POS, Metrics::TK_LATENCY);
       dbCommand_.Execute();
       // set return value for all okay
       rtnValue= RTN_NO_ERROR;
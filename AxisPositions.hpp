@@ -17,6 +17,7 @@
   *    go every 60 degrees (next column) until the end of the coil (max angle ~200,000 degrees).
   *     * At every angle, calculate the position for each foot.
   *     * Put the data into a member map scsAxisPositionMap_
+  *    Check the map (PositionValidator). If it is not valid, write the violation report and stop.
   * 6) Connect to the DB
   * 7) Delete all rows from the Scs and Cls position tables, using a sql stored procedure
   * 8) For each row in the Scs position map, insert a row in the corresponding
@@ -61,15 +62,23 @@
 #define GA_AxesPositions_H_
 
 // standard c/c++ libraries
+#include <cstdint>
 
 // GA headers
 #include "gaScsDataConstants.hpp"
 #include "CoilMap.hpp"
+#include "GenerationParams.hpp"
+#include "TableGeneration.hpp"
+#include "WriteJournal.hpp"
 
 
 namespace gaScsData {
 
+class Checksum;
+
 class AxisPositions : private boost::noncopyable {  
+  // the benchmark times the private calculation and insert functions
+  friend class PipelineBenchmark;
 
 public:
   // typedefs and enums
@@ -155,6 +164,17 @@ public:
       // Define a (angle, isEven) pair
       typedef std::pair<double,bool> angleIsEven_pair;
 
+      // Set of <layer, ria angle> pairs. Same as EventMap::layerAngleSetTyp, so the hqp and layer start
+      // angles calculated here can be used by the event map without reading them back from the db.
+      typedef boost::container::flat_set<std::pair<long, double> > layerAngleSetTyp;
+
+      // Row recorded by the local (in memory) insert backend: <ria angle, action description>
+      typedef std::pair<double, std::string> LocalRowTyp;
+
+      // Rows replaced in the SCS position map by a later row at the same (rounded) RIA angle:
+      // <ria angle, logic trace of the replaced row>
+      typedef std::vector<std::pair<long, std::string> > key_collision_list;
+
       enum footRole { FOOT_ROLE_ADVANCING=1, FOOT_ROLE_RETREATING };
       
       enum insertMode {IM_REL_SEL,  // use Insert Select Pos Dist SQL procedure
@@ -174,14 +194,66 @@ public:
 
     // ctors and dtor
     AxisPositions();
+    // Use a coil map that is already populated, and shared (read only) with other objects, instead of
+    // populating a coil map of our own. Used to calculate many parameter sets against one coil map.
+    // coilMaxAngle is the last coil angle to iterate to.
+    AxisPositions(const CoilMap &sharedCoilMap, long coilAngleMax);
     ~AxisPositions();
 
   // accessors
+    // number of rows in the SCS position map
+    size_t GetScsPositionCount() const;
+    // the SCS position map, by RIA angle
+    const ScsAxesPositionMap& GetScsPositionMap() const;
+    // rows replaced by another row at the same RIA angle, while the map was calculated
+    const key_collision_list& GetKeyCollisions() const;
+    // the coil map the positions are calculated from
+    const CoilMap& GetCoilMap() const;
+    // false (default) -- SCS inserts are written to the db
+    // true -- SCS inserts are recorded in memory (local backend). No db connection is needed.
+    void SetLocalBackend(bool isLocalBackend);
+    // number of SCS inserts recorded by the local backend
+    size_t GetLocalRowCount() const;
+    // checksum of the SCS position map (16 hex digits), to compare the output of two runs
+    std::string GetPositionChecksum() const;
+    // add one SCS row to a checksum: the values written to the table (not the logic trace), as GetPositionChecksum()
+    static void AddRowToChecksum(Checksum &checksum, long riaAngle, const SPosDetail &posDetail);
+    // hash of the inputs the positions are calculated from: GENERATOR_VERSION, the coil map, the parameters,
+    // and the last coil angle. The same inputs calculate the same positions.
+    uint64_t GetInputHash() const;
+    // When true, GeneratePositionTables() reads the generation row of the tables from the db (TableGeneration class),
+    // and does nothing if they were written completely from GetInputHash() by this GENERATOR_VERSION.
+    void SetSkipUnchanged(bool skipUnchanged);
+    // db connections the SCS rows are written on at once. Defaults to DB_WRITER_CONNECTIONS. A resumed write
+    // keeps the ranges of its journal.
+    void SetWriterConnections(size_t connections);
+    // tunable parameters. The defaults are the gaScsDataConstants.hpp values.
+    void SetGenerationParams(const GenerationParams &params);
+    const GenerationParams& GetGenerationParams() const;
+    // coil geometry. Defaults to the standard coil. Set it before the coil map is populated.
+    // Also sets the last coil angle to the geometry coil angle max.
+    // return value indicates success or error (invalid geometry, or a shared coil map)
+    long SetCoilGeometry(const CoilGeometry &geometry);
+    // largest transition and joggle adjustments (mm) made by the last position calculation
+    void GetMaxAdjustments(double &maxTransAdj, double &maxJoggleAdj) const;
 
   // public methods
     // Connects to the Db, retrieves the coil map and populates the member data structure
     // return value indicates success or error
     long GenerateCoilMap();
+    // Populate the coil map from the passed in rows instead of the db (local backend), and
+    // set the last coil angle to iterate to. Used with CoilMapGenerator rows for scale testing.
+    // return value indicates success or error
+    long GenerateCoilMap(const CoilMap::coil_map &coilRows, long coilAngleMax);
+
+    // Calculate the CLS move distances and SCS positions into the SCS position map only.
+    // Nothing is written to the db.
+    // return value indicates success or error
+    long CalculatePositions();
+
+    // Get the <layer, ria angle> of the rows in the SCS position map marked as new hqp and new layer.
+    // These are what the hqp and layer start angle queries return from the position table view.
+    void GetStartAngleSets(layerAngleSetTyp &hqpStarts, layerAngleSetTyp &layerStarts) const;
 
     // 1) Iterate thru azimuth positions, and using the coil map, calculate the CLS move distances and SCS positions.
     // 2) Add them to the SCS position map. 
@@ -189,7 +261,13 @@ public:
     // This also resets the identity index so rows will start at id = 1
     // 4) Iterate thru the SCS map, and insert the positions in the SCS position map into the SCS position table in the DB
     // 5) Build the db CLS positon table from the SCS position table. 
-    // Return value indicates success or error
+    // The SCS rows are journaled (WriteJournal class) before they are written, and written in batches. A write that
+    // did not finish is resumed by the next call, from its journal, if the inputs are the same.
+    // The rows are split into RIA angle ranges at rows that do not depend on the rows before them
+    // (GetJournalRangeStarts()), and the ranges are written at once, one per connection (SetWriterConnections()),
+    // with the sequence number of a serial write.
+    // Return value indicates success or error, or RTN_NO_RESULTS if the inputs are the same as the generation row
+    // of the tables in the db (SetSkipUnchanged()), and nothing was done
     long GeneratePositionTables();
 
     // convert an axis index to a string
@@ -198,6 +276,9 @@ public:
 
   private:
     // helper functions
+      // ctor initialization common to both ctors
+      void Initialize();
+
       // Calculate the transition adjustment (return value)
       // This is dependent on where in the transition window the passed in angle falls,
       // and on odd or even layer. The transition past the start (transAngleChange_) could have been passed
@@ -286,12 +367,41 @@ public:
        // insert a row into the SCS db table at the Ria angle. Use values from the SCS Position Detail
       // assumes valid connection has been made
       // return value indicates success or error
-      long InsertIntoScsDb(double riaAngle, const SPosDetail& posDetail);
+      // sequence is the write order of the row, 1 for the first row.
+      long InsertIntoScsDb(long sequence, double riaAngle, const SPosDetail& posDetail);
+      // The same with the passed in command, so it can be called from the journal range threads. The error
+      // is returned in errorText, not displayed.
+      long InsertIntoScsDb(SACommand &command, long sequence, double riaAngle, const SPosDetail& posDetail,
+                           std::string &errorText) const;
       // Iterate thru Axis position map and insert a row for each map entry using the overload.
       long InsertIntoScsDb(); 
+      // Insert the journal rows of the batches not in the db, in batches (one transaction each), using the overload.
+      // The journal ranges are written at once, on their own connections.
+      // assumes valid connection has been made
+      // return value indicates success or error
+      long InsertIntoScsDb(WriteJournal &journal);
+      // move summary portion of the logic trace, the action description of the row
+      static void GetMoveSummary(const std::string &logicTrace, std::string &moveSum);
+
+      // journal record of one SCS row: the ria angle and the position detail
+      static void PutJournalRow(std::string &record, long riaAngle, const SPosDetail &posDetail);
+      // Rows of the map a journal range can start at, in map order. An adjust row reads the previous position of
+      // its axes from the db when it is inserted. A range can start at a row if each axis is set by an absolute row
+      // of the range before it is read, so the rows of the range do not depend on the rows before it.
+      static void GetJournalRangeStarts(const ScsAxesPositionMap &positionMap, std::vector<bool> &isRangeStart);
+      // return value indicates success or error (a cut off record)
+      static long GetJournalRow(const std::string &record, long &riaAngle, SPosDetail &posDetail);
+      // Open the SCS write journal of a write that did not finish. If it is of the same inputs, its rows are
+      // put in the SCS position map, so they are not calculated again.
+      // return value is RTN_NO_ERROR to resume the journal, RTN_NO_RESULTS if there is none, and RTN_ERROR if it is
+      // of other inputs or can't be read (the tables in the db are partial, and are written again).
+      long OpenJournal(WriteJournal &journal);
 
       // Create Cls moves from the Scs Position table, and populate the Cls position table.
       long InsertIntoClsDb(); 
+      // Same, and write the generation row of the tables in the same transaction.
+      // return value indicates success or error
+      long InsertIntoClsDb(const TableGeneration &generation);
      
       // delete all rows from CLS and SCS position tables
       // assumes valid connection has been made
@@ -303,8 +413,15 @@ public:
 
     // member variables
 
-      // coil map
-      CoilMap coilMap_;
+      // coil map. coilMap_ refers to ownCoilMap_, or to a shared coil map passed to the ctor.
+      CoilMap ownCoilMap_;
+      const CoilMap &coilMap_;
+      // last coil angle to calculate moves for. COIL_ANGLE_MAX unless a generated coil map or another geometry is used.
+      long coilAngleMax_;
+
+      // local backend -- record SCS inserts here instead of writing them to the db
+      bool isLocalBackend_;
+      std::vector<LocalRowTyp> localRows_;
 
       // vector of axis enumerations to allow iterating over
       std::vector<AxisIndexes> vAxisIndexes_;
@@ -313,6 +430,8 @@ public:
       SPosDetail scsPosDetail_;
       // Scs Axis Position Map
       ScsAxesPositionMap scsAxisPositionMap_;
+      // rows replaced in the map
+      key_collision_list keyCollisions_;
 
       // specify server and db string
       std::string serverText_;
@@ -325,6 +444,17 @@ public:
       SAConnection dbConnection_; // create connection object
       SACommand dbCommand_; // create connection object
       
+      // tunable parameters, and the transition arc radius calculated from them
+      GenerationParams params_;
+      double transRo_;
+      // largest adjustments made by the last position calculation
+      double maxTransAdj_;
+      double maxJoggleAdj_;
+      // skip the tables if the generation row in the db has the same inputs
+      bool isSkipUnchanged_;
+      // db connections the SCS rows are written on
+      size_t writerConnections_;
+
       // Member variables for calculating transition adjustments.
       std::vector<bool> arrAdjMark_;
       
@@ -339,8 +469,7 @@ public:
       double transR_; // calculated radius within the transition
       bool transResult_, transStat_;  // result and status of a boolean check
       
-      // similarly, I don't want to make these for each row insertion
-      std::size_t msPos_; // move summary position with in the logic trace
+      // similarly, I don't want to make this for each row insertion
       std::string moveSum_; // move summary string portion of the logic trace
 
 };
@@ -0,0 +1,191 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: AxisTrajectories.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Per axis change point series of the absolute positions, and the compact file they are written to.
+ *
+ * Libraries used:  string
+ *                  vector
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "AxisTrajectories.hpp"
+#include "PositionResolver.hpp"
+
+namespace gaScsData {
+
+static void PutVarint(std::string &out, uint64_t value) {
+  while (0x80 <= value) {
+    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value>>= 7;
+    }
+  out.push_back(static_cast<char>(value));
+  }
+
+// return value is false if the data ends first
+static bool GetVarint(const char *&in, const char *end, uint64_t &value) {
+  value= 0;
+  for (unsigned shift= 0; in != end && shift < 64; shift+= 7) {
+    const unsigned char byte= static_cast<unsigned char>(*in++);
+    value|= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (0 == (byte & 0x80))
+      return true;
+    }
+  return false;
+  }
+
+// signed to unsigned, so small negative deltas are short varints too
+static uint64_t ZigZag(long long value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+  }
+
+static long long UnZigZag(uint64_t value) {
+  return static_cast<long long>(value >> 1) ^ -static_cast<long long>(value & 1);
+  }
+
+// ctors and dtor
+AxisTrajectories::AxisTrajectories() :
+    rowCount_(0) { }
+
+AxisTrajectories::~AxisTrajectories() { }
+
+// public member functions
+void AxisTrajectories::Build(const AxisPositions::ScsAxesPositionMap &scsRows) {
+  const size_t axisCount= COLUMN_COUNT * 2;
+  series_.assign(axisCount, SeriesTyp());
+  rowCount_= scsRows.size();
+
+  AxisPositions::Positions current(axisCount, INITIAL_NO_POSITION);
+  for (AxisPositions::sapm_const_iter cit= scsRows.begin(); cit != scsRows.end(); ++cit) {
+    PositionResolver::ApplyRow(cit->second, current);
+    for (size_t axis= 0; axis < axisCount; ++axis) {
+      SeriesTyp &series= series_[axis];
+      // every axis has a point at the first row, so a lookup in range always has a position
+      if (series.positions.empty() || series.positions.back() != current[axis]) {
+        series.angles.push_back(cit->first);
+        series.positions.push_back(current[axis]);
+        }
+      }
+    }
+  }
+
+long AxisTrajectories::Write(const std::string &fileName) const {
+  // return value indicates success or error
+  std::string data(TRAJECTORY_MAGIC, sizeof(TRAJECTORY_MAGIC));
+  data.reserve(data.size() + GetPointCount() * 10);
+  PutVarint(data, TRAJECTORY_LAYOUT_VERSION);
+  PutVarint(data, rowCount_);
+  PutVarint(data, series_.size());
+  for (series_list::const_iterator cit= series_.begin(); cit != series_.end(); ++cit) {
+    PutVarint(data, cit->angles.size());
+    long previousAngle= 0;
+    for (size_t i= 0; i < cit->angles.size(); ++i) {
+      PutVarint(data, ZigZag(static_cast<long long>(cit->angles[i]) - previousAngle));
+      previousAngle= cit->angles[i];
+      char bytes[sizeof(double)];
+      std::memcpy(bytes, &cit->positions[i], sizeof(double));
+      data.append(bytes, sizeof(double));
+      }
+    }
+
+  std::ofstream file(fileName.c_str(), std::ios::binary | std::ios::trunc);
+  file.write(data.data(), data.size());
+  if (!file) {
+    std::cout << "Error writing the axis trajectories to " << fileName << "." << std::endl;
+    return RTN_ERROR;
+    }
+  return RTN_NO_ERROR;
+  }
+
+long AxisTrajectories::Read(const std::string &fileName) {
+  // return value indicates success or error
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  const char *in= data.data();
+  const char *end= in + data.size();
+
+  uint64_t version= 0;
+  uint64_t rowCount= 0;
+  uint64_t axisCount= 0;
+  bool isOk= data.size() >= sizeof(TRAJECTORY_MAGIC) && 0 == std::memcmp(in, TRAJECTORY_MAGIC, sizeof(TRAJECTORY_MAGIC));
+  if (isOk) {
+    in+= sizeof(TRAJECTORY_MAGIC);
+    isOk= GetVarint(in, end, version) && TRAJECTORY_LAYOUT_VERSION == version && GetVarint(in, end, rowCount) &&
+          GetVarint(in, end, axisCount) && static_cast<uint64_t>(COLUMN_COUNT * 2) == axisCount;
+    }
+
+  series_list series(isOk ? static_cast<size_t>(axisCount) : 0);
+  for (series_list::iterator it= series.begin(); isOk && it != series.end(); ++it) {
+    uint64_t pointCount= 0;
+    // each point is at least 9 bytes, so a bad count can't make a huge allocation
+    isOk= GetVarint(in, end, pointCount) && pointCount <= static_cast<uint64_t>(end - in) / (1 + sizeof(double));
+    if (!isOk)
+      break;
+    it->angles.resize(static_cast<size_t>(pointCount));
+    it->positions.resize(static_cast<size_t>(pointCount));
+    long long angle= 0;
+    for (size_t i= 0; isOk && i < pointCount; ++i) {
+      uint64_t delta;
+      isOk= GetVarint(in, end, delta) && static_cast<size_t>(end - in) >= sizeof(double);
+      if (isOk) {
+        angle+= UnZigZag(delta);
+        it->angles[i]= static_cast<long>(angle);
+        std::memcpy(&it->positions[i], in, sizeof(double));
+        in+= sizeof(double);
+        }
+      }
+    }
+
+  if (!isOk) {
+    std::cout << "Error reading the axis trajectories from " << fileName << ": not a trajectory file of layout version "
+              << TRAJECTORY_LAYOUT_VERSION << ", or it is cut off." << std::endl;
+    return RTN_ERROR;
+    }
+  series_.swap(series);
+  rowCount_= static_cast<size_t>(rowCount);
+  return RTN_NO_ERROR;
+  }
+
+double AxisTrajectories::GetPosition(long axis, long riaAngle) const {
+  const SeriesTyp &series= GetSeries(axis);
+  std::vector<long>::const_iterator cit= std::upper_bound(series.angles.begin(), series.angles.end(), riaAngle);
+  if (series.angles.begin() == cit)
+    return INITIAL_NO_POSITION;
+  return series.positions[(cit - series.angles.begin()) - 1];
+  }
+
+const AxisTrajectories::SeriesTyp& AxisTrajectories::GetSeries(long axis) const {
+  return series_.at(static_cast<size_t>(axis));
+  }
+
+size_t AxisTrajectories::GetAxisCount() const {
+  return series_.size();
+  }
+
+size_t AxisTrajectories::GetRowCount() const {
+  return rowCount_;
+  }
+
+size_t AxisTrajectories::GetPointCount() const {
+  size_t pointCount= 0;
+  for (series_list::const_iterator cit= series_.begin(); cit != series_.end(); ++cit) {
+    pointCount+= cit->angles.size();
+    }
+  return pointCount;
+  }
+
+} // namespace gaScsData
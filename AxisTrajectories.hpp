@@ -0,0 +1,80 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: AxisTrajectories.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Each of the 24 axes as its own series over RIA angle, for analysis and plots of the whole coil.
+ *            The absolute positions are resolved from the SCS rows (PositionResolver::ApplyRow()), and each axis
+ *            keeps only its change points (the RIA angle where the position changes, and the new position).
+ *            Most rows move one or two selected axes, so this is a small part of the row by row table.
+ *
+ *            File format (TRAJECTORY_FILE, little endian):
+ *              magic                 -- TRAJECTORY_MAGIC, 8 bytes
+ *              layout version        -- varint, TRAJECTORY_LAYOUT_VERSION
+ *              row count             -- varint, SCS rows the series were made from
+ *              axis count            -- varint, 24
+ *              for each axis, in the AxisIndexes order:
+ *                point count         -- varint
+ *                for each point:
+ *                  angle delta       -- zigzag varint, from the previous point of the axis (the first is from 0)
+ *                  position          -- 8 byte double
+ *            A varint is 7 bits per byte, low bits first, with the high bit set on all but the last byte.
+ *            The first point of each axis is the first SCS row. INITIAL_NO_POSITION is no absolute position yet.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_AxisTrajectories_H_
+#define GA_AxisTrajectories_H_
+
+// standard c/c++ libraries
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+#include "AxisPositions.hpp"
+
+namespace gaScsData {
+
+class AxisTrajectories : private boost::noncopyable {
+
+public:
+  // typedefs and enums
+    // change points of one axis, by RIA angle
+    struct SeriesTyp {
+      std::vector<long> angles;
+      std::vector<double> positions;
+      };
+    typedef std::vector<SeriesTyp> series_list;  // by axis index
+
+  // ctors and dtor
+    AxisTrajectories();
+    ~AxisTrajectories();
+
+  // public member functions
+    // make the series from the SCS rows, in one pass
+    void Build(const AxisPositions::ScsAxesPositionMap &scsRows);
+    // Return value indicates success or error
+    long Write(const std::string &fileName) const;
+    long Read(const std::string &fileName);
+
+    // Position of the axis at the RIA angle. INITIAL_NO_POSITION if before the first row.
+    double GetPosition(long axis, long riaAngle) const;
+    const SeriesTyp& GetSeries(long axis) const;
+    size_t GetAxisCount() const;
+    size_t GetRowCount() const;
+    // change points of all the axes
+    size_t GetPointCount() const;
+
+  private:
+    // member variables
+      series_list series_;
+      size_t rowCount_;
+};
+
+} // namespace gaScsData
+#endif // GA_AxisTrajectories_H_
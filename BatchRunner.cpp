@@ -0,0 +1,438 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: BatchRunner.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Headless batch runs of many coils/scenarios, with a
+ *            consolidated JSON results report.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  thread
+ *                  mutex
+ *                  atomic
+ *                  chrono
+ *                  Boost Property Tree (JSON parser)
+ *                  Boost Non-copyable
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <thread>
+#include <sstream>
+#include <fstream>
+
+// boost libraries
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "BatchRunner.hpp"
+#include "CoilMapGenerator.hpp"
+#include "AxisPositions.hpp"
+#include "EventMap.hpp"
+#include "PositionValidator.hpp"
+#include "EventCrossCheck.hpp"
+#include "OutputFingerprint.hpp"
+#include "DbSchemaCheck.hpp"
+#include "Metrics.hpp"
+#include "TraceRecorder.hpp"
+#include "ProgressReporter.hpp"
+
+namespace gaScsData {
+
+// ctors and dtor
+BatchRunner::BatchRunner() :
+    workers_(0),
+    nextGenerated_(0),
+    console_(&std::cout),
+    elapsedMs_(0.0) { }
+
+BatchRunner::~BatchRunner() { }
+
+// accessors
+void BatchRunner::SetGeometry(const CoilGeometry &geometry) { geometry_= geometry; }
+const BatchRunner::scenario_list& BatchRunner::GetScenarios() const { return scenarios_; }
+const BatchRunner::result_list& BatchRunner::GetResults() const { return results_; }
+
+size_t BatchRunner::GetFailedCount() const {
+  size_t failed= 0;
+  for (result_list::const_iterator cit= results_.begin(); cit != results_.end(); ++cit) {
+    if (RTN_NO_ERROR != cit->status)
+      ++failed;
+    }
+  return failed;
+  }
+
+// public member functions
+long BatchRunner::LoadManifest(const std::string &fileName) {
+  // return value indicates success or error
+  scenarios_.clear();
+  results_.clear();
+  try {
+    boost::property_tree::ptree manifest;
+    boost::property_tree::read_json(fileName, manifest);
+
+    workers_= manifest.get<size_t>("workers", 0);
+    for (boost::property_tree::ptree::const_iterator cit= manifest.get_child("scenarios").begin();
+         cit != manifest.get_child("scenarios").end(); ++cit) {
+      const boost::property_tree::ptree &entry= cit->second;
+      ScenarioTyp scenario;
+      scenario.name= entry.get<std::string>("name", "scenario " + std::to_string(static_cast<long long>(scenarios_.size() + 1)));
+      scenario.source= entry.get<std::string>("source", BATCH_SOURCE_GENERATED);
+      scenario.runPositions= entry.get<bool>("positions", true);
+      scenario.runEvents= entry.get<bool>("events", true);
+      scenario.scale= entry.get<long>("scale", 1);
+      scenario.turnsPerLayer= entry.get<long>("turns_per_layer", 0);
+      scenario.layerCount= entry.get<long>("layer_count", 0);
+      scenario.shortTurns= entry.get<long>("short_turns", 0);
+      scenario.fingerprintFile= entry.get<std::string>("fingerprint", "");
+      if (entry.get_child_optional("params")) {
+        for (boost::property_tree::ptree::const_iterator pcit= entry.get_child("params").begin();
+             pcit != entry.get_child("params").end(); ++pcit) {
+          if (RTN_NO_ERROR != scenario.params.SetValue(pcit->first, pcit->second.get_value<double>())) {
+            std::cout << "Manifest " << fileName << ": scenario \"" << scenario.name << "\" has an unknown parameter \""
+                      << pcit->first << "\"." << std::endl;
+            scenarios_.clear();
+            return RTN_ERROR;
+            }
+          }
+        }
+      if (BATCH_SOURCE_DB != scenario.source && BATCH_SOURCE_GENERATED != scenario.source) {
+        std::cout << "Manifest " << fileName << ": scenario \"" << scenario.name << "\" has an unknown source \""
+                  << scenario.source << "\". Use \"" << BATCH_SOURCE_DB << "\" or \"" << BATCH_SOURCE_GENERATED << "\"." << std::endl;
+        scenarios_.clear();
+        return RTN_ERROR;
+        }
+      if (scenario.scale < 1 || scenario.turnsPerLayer < 0 || scenario.layerCount < 0 || scenario.shortTurns < 0) {
+        std::cout << "Manifest " << fileName << ": scenario \"" << scenario.name << "\" has a negative or zero size." << std::endl;
+        scenarios_.clear();
+        return RTN_ERROR;
+        }
+      scenarios_.push_back(scenario);
+      }
+    }
+  catch (const boost::property_tree::ptree_error &ex) {
+    std::cout << "Error reading the manifest " << fileName << ": " << ex.what() << std::endl;
+    scenarios_.clear();
+    return RTN_ERROR;
+    }
+
+  if (scenarios_.empty()) {
+    std::cout << "Manifest " << fileName << " has no scenarios." << std::endl;
+    return RTN_NO_RESULTS;
+    }
+  return RTN_NO_ERROR;
+  }
+
+long BatchRunner::Run() {
+  // return value is RTN_NO_ERROR if every scenario finished without error
+  const clock::time_point start= clock::now();
+  const ResultTyp empty= { RTN_NO_ERROR, "", 0, 0, 0, 0, 0, "", "", 0.0, 0.0, 0.0, 0.0 };
+  results_.assign(scenarios_.size(), empty);
+  generatedIndexes_.clear();
+  for (size_t i= 0; i < scenarios_.size(); ++i) {
+    if (BATCH_SOURCE_GENERATED == scenarios_[i].source)
+      generatedIndexes_.push_back(i);
+    }
+  nextGenerated_.store(0);
+
+  size_t workers= 0 != workers_ ? workers_ : std::thread::hardware_concurrency();
+  if (0 == workers)
+    workers= 1;
+  if (workers > generatedIndexes_.size())
+    workers= generatedIndexes_.size();
+
+  std::cout << "Batch: " << scenarios_.size() << " scenarios (" << generatedIndexes_.size() << " generated on "
+            << workers << " workers, " << scenarios_.size() - generatedIndexes_.size() << " db)." << std::endl;
+
+  // Discard the console output of the generation code, and turn off the progress display.
+  // Scenario results go to the real console.
+  const bool wasHeadless= ProgressReporter::IsHeadless();
+  ProgressReporter::SetHeadless(true);
+  std::ostream console(std::cout.rdbuf());
+  console_= &console;
+  std::streambuf *coutBuffer= std::cout.rdbuf(nullptr);
+
+  // generated scenarios on the workers
+  std::vector<std::thread> threads;
+  for (size_t i= 0; i < workers; ++i) {
+    threads.push_back(std::thread(&BatchRunner::GeneratedWorker, this));
+    }
+
+  // db scenarios on this thread, one at a time, if the db has the procedures the table writes use
+  std::string schemaMessage;
+  if (generatedIndexes_.size() < scenarios_.size()) {
+    DbSchemaCheck schemaCheck;
+    if (RTN_NO_ERROR != schemaCheck.Check())
+      schemaMessage= schemaCheck.GetMessage();
+    }
+  for (size_t i= 0; i < scenarios_.size(); ++i) {
+    if (BATCH_SOURCE_DB == scenarios_[i].source) {
+      if (schemaMessage.empty())
+        RunDbScenario(scenarios_[i], results_[i]);
+      else {
+        results_[i].status= RTN_ERROR;
+        results_[i].error= schemaMessage;
+        }
+      Report(scenarios_[i], results_[i]);
+      }
+    }
+
+  for (size_t i= 0; i < threads.size(); ++i) {
+    threads[i].join();
+    }
+
+  // restore console output
+  std::cout.rdbuf(coutBuffer);
+  std::cout.clear();
+  console_= &std::cout;
+  ProgressReporter::SetHeadless(wasHeadless);
+  elapsedMs_= MsSince(start);
+
+  const size_t failed= GetFailedCount();
+  std::cout << "Batch done: " << scenarios_.size() - failed << " ok, " << failed << " failed, "
+            << elapsedMs_ << " ms." << std::endl;
+  return 0 == failed ? RTN_NO_ERROR : RTN_ERROR;
+  }
+
+std::string BatchRunner::ToJson() const {
+  std::ostringstream json;
+  json.precision(3);
+  json << std::fixed;
+  const size_t failed= GetFailedCount();
+  json << "{" << std::endl
+       << "  \"elapsed_ms\": " << elapsedMs_ << "," << std::endl
+       << "  \"scenario_count\": " << scenarios_.size() << "," << std::endl
+       << "  \"failed_count\": " << failed << "," << std::endl
+       << "  \"scenarios\": [";
+  for (size_t i= 0; i < scenarios_.size() && i < results_.size(); ++i) {
+    const ScenarioTyp &scenario= scenarios_[i];
+    const ResultTyp &result= results_[i];
+    json << (0 == i ? "" : ",") << std::endl
+         << "    { \"name\": \"" << TraceRecorder::JsonEscape(scenario.name) << "\", \"source\": \"" << scenario.source << "\"";
+    if (BATCH_SOURCE_GENERATED == scenario.source)
+      json << ", \"scale\": " << scenario.scale << ", \"coil_rows\": " << result.coilRows << ", \"violations\": " << result.violations
+           << ", \"cross_check_issues\": " << result.crossCheckIssues;
+    json << "," << std::endl
+         << "      \"params\": " << scenario.params.ToJson() << "," << std::endl
+         << "      \"status\": \"" << (RTN_NO_ERROR == result.status ? "ok" : "error") << "\", \"error\": \""
+         << TraceRecorder::JsonEscape(result.error) << "\"," << std::endl
+         << "      \"position_rows\": " << result.positionRows << ", \"position_checksum\": \"" << result.positionChecksum << "\","
+         << " \"event_rows\": " << result.eventRows << ", \"event_checksum\": \"" << result.eventChecksum << "\"," << std::endl
+         << "      \"generate_ms\": " << result.generateMs << ", \"positions_ms\": " << result.positionMs
+         << ", \"events_ms\": " << result.eventMs << ", \"total_ms\": " << result.totalMs << " }";
+    }
+  json << std::endl << "  ]" << std::endl << "}" << std::endl;
+  return json.str();
+  }
+
+long BatchRunner::WriteJson(const std::string &fileName) const {
+  // return value indicates success or error
+  std::ofstream output(fileName.c_str());
+  output << ToJson();
+  output.close();
+  if (!output) {
+    std::cout << "Error writing the batch report to " << fileName << std::endl;
+    return RTN_ERROR;
+    }
+  return RTN_NO_ERROR;
+  }
+
+// private helper functions
+double BatchRunner::MsSince(clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(clock::now() - start).count();
+  }
+
+void BatchRunner::GeneratedWorker() {
+  TraceRecorder::Instance().SetThreadName("batch worker");
+  for (size_t next= nextGenerated_.fetch_add(1); next < generatedIndexes_.size(); next= nextGenerated_.fetch_add(1)) {
+    const size_t index= generatedIndexes_[next];
+    RunGeneratedScenario(scenarios_[index], results_[index]);
+    Report(scenarios_[index], results_[index]);
+    }
+  }
+
+void BatchRunner::RunDbScenario(const ScenarioTyp &scenario, ResultTyp &result) {
+  // same steps as the -p and -e arguments
+  Metrics::ScopedTimer timer("batch.scenario");
+  const clock::time_point start= clock::now();
+  AxisPositions axPos;
+  OutputFingerprint fingerprint;
+  if (scenario.runPositions) {
+    const clock::time_point positionStart= clock::now();
+    axPos.SetGenerationParams(scenario.params);
+    long status= axPos.SetCoilGeometry(geometry_);
+    if (RTN_NO_ERROR == status)
+      status= axPos.GenerateCoilMap();
+    if (RTN_NO_ERROR != status)
+      result.error= "Error when populating the coil map from the db.";
+    else {
+      status= axPos.GeneratePositionTables();
+      if (RTN_NO_ERROR != status)
+        result.error= "Error when generating the position tables.";
+      }
+    result.positionRows= axPos.GetScsPositionCount();
+    if (RTN_NO_ERROR == status) {
+      result.positionChecksum= axPos.GetPositionChecksum();
+      fingerprint.SetScsRows(axPos.GetScsPositionMap(), axPos.GetCoilMap());
+      fingerprint.SetInputHash(OutputFingerprint::TABLE_SCS, axPos.GetInputHash());
+      fingerprint.SetInputHash(OutputFingerprint::TABLE_CLS, axPos.GetInputHash());
+      RecordDbTables(fingerprint, result);
+      }
+    else
+      result.status= RTN_ERROR;
+    result.positionMs= MsSince(positionStart);
+    }
+  // events use the new layer starts from the SCS position table, so skip them if the positions failed
+  if (scenario.runEvents && RTN_NO_ERROR == result.status) {
+    const clock::time_point eventStart= clock::now();
+    EventMap eventMap;
+    eventMap.SetGenerationParams(scenario.params);
+    // the events have to agree with the positions they are made from before they are written
+    EventCrossCheck crossCheck;
+    if (scenario.runPositions)
+      eventMap.SetCrossCheck(&crossCheck, &axPos.GetScsPositionMap());
+    if (RTN_NO_ERROR == eventMap.SetCoilGeometry(geometry_) && RTN_NO_ERROR == eventMap.GenerateEventMapTable()) {
+      result.eventChecksum= eventMap.GetEventChecksum();
+      fingerprint.SetEvents(eventMap.GetEventMap(), eventMap.GetCoilMap());
+      fingerprint.SetInputHash(OutputFingerprint::TABLE_EVENTS, eventMap.GetInputHash());
+      RecordDbTables(fingerprint, result);
+      }
+    else {
+      result.status= RTN_ERROR;
+      if (0 < crossCheck.GetIssueCount())
+        result.error= "The events and positions have " + std::to_string(static_cast<unsigned long long>(crossCheck.GetIssueCount())) + " cross check issues. The event table was not written.";
+      else
+        result.error= "Error when generating the event table.";
+      }
+    result.crossCheckIssues= crossCheck.GetIssueCount();
+    result.eventRows= eventMap.GetEventCount();
+    result.eventMs= MsSince(eventStart);
+    }
+  result.totalMs= MsSince(start);
+  }
+
+long BatchRunner::RecordDbTables(OutputFingerprint &fingerprint, ResultTyp &result) {
+  // return value indicates success or error
+  const long status= fingerprint.Record(FINGERPRINT_FILE, FINGERPRINT_PREVIOUS_FILE);
+  if (RTN_NO_ERROR != status) {
+    result.status= RTN_ERROR;
+    result.error= "Error when recording the fingerprint of the tables.";
+    }
+  return status;
+  }
+
+void BatchRunner::RunGeneratedScenario(const ScenarioTyp &scenario, ResultTyp &result) {
+  // same steps as the -s argument, for one coil
+  Metrics::ScopedTimer timer("batch.scenario");
+  const clock::time_point start= clock::now();
+
+  // generate the coil map rows
+  CoilMapGenerator generator;
+  generator.SetScale(scenario.scale);
+  if (0 != scenario.turnsPerLayer)
+    generator.SetTurnsPerLayer(scenario.turnsPerLayer);
+  if (0 != scenario.layerCount)
+    generator.SetLayerCount(scenario.layerCount);
+  if (0 != scenario.shortTurns)
+    generator.SetShortTurns(scenario.shortTurns);
+  CoilMap::coil_map coilRows;
+  long status= generator.Generate(coilRows);
+  result.coilRows= coilRows.size();
+  result.generateMs= MsSince(start);
+  if (RTN_NO_ERROR != status) {
+    result.status= RTN_ERROR;
+    result.error= "Error when generating the coil map.";
+    result.totalMs= MsSince(start);
+    return;
+    }
+
+  // calculate the positions. Events need the hqp and layer starts, so this is always done.
+  AxisPositions::layerAngleSetTyp hqpStarts;
+  AxisPositions::layerAngleSetTyp layerStarts;
+  const clock::time_point positionStart= clock::now();
+  AxisPositions axPos;
+  axPos.SetGenerationParams(scenario.params);
+  status= axPos.SetCoilGeometry(generator.GetGeometry());
+  if (RTN_NO_ERROR == status)
+    status= axPos.GenerateCoilMap(coilRows, generator.GetCoilAngleMax());
+  if (RTN_NO_ERROR == status)
+    status= axPos.CalculatePositions();
+  if (RTN_NO_ERROR != status) {
+    result.status= RTN_ERROR;
+    result.error= "Error when calculating the positions.";
+    }
+  else {
+    // the same check as before a db write. Scenarios run in parallel already, so the validator uses this thread only.
+    PositionValidator validator;
+    validator.SetThreads(1);
+    if (RTN_NO_ERROR != validator.Validate(axPos.GetScsPositionMap(), axPos.GetKeyCollisions())) {
+      status= RTN_ERROR;
+      result.status= RTN_ERROR;
+      result.error= "The positions have " + std::to_string(static_cast<unsigned long long>(validator.GetViolationCount())) + " violations.";
+      }
+    result.violations= validator.GetViolationCount();
+    }
+  if (scenario.runPositions) {
+    result.positionRows= axPos.GetScsPositionCount();
+    if (RTN_NO_ERROR == status)
+      result.positionChecksum= axPos.GetPositionChecksum();
+    }
+  axPos.GetStartAngleSets(hqpStarts, layerStarts);
+  result.positionMs= MsSince(positionStart);
+  OutputFingerprint fingerprint;
+  if (!scenario.fingerprintFile.empty() && scenario.runPositions)
+    fingerprint.SetScsRows(axPos.GetScsPositionMap(), axPos.GetCoilMap());
+
+  // create the events
+  if (scenario.runEvents && RTN_NO_ERROR == result.status) {
+    const clock::time_point eventStart= clock::now();
+    EventMap eventMap;
+    eventMap.SetGenerationParams(scenario.params);
+    if (RTN_NO_ERROR == eventMap.SetCoilGeometry(generator.GetGeometry()) &&
+        RTN_NO_ERROR == eventMap.GenerateEventMap(coilRows, hqpStarts, layerStarts))
+      result.eventChecksum= eventMap.GetEventChecksum();
+    else {
+      result.status= RTN_ERROR;
+      result.error= "Error when creating the event map.";
+      }
+    // the events have to agree with the positions they were made from
+    if (RTN_NO_ERROR == result.status) {
+      EventCrossCheck crossCheck;
+      if (RTN_NO_ERROR != crossCheck.Check(axPos.GetScsPositionMap(), axPos.GetCoilMap(), eventMap.GetEventMap())) {
+        result.status= RTN_ERROR;
+        result.error= "The events and positions have " + std::to_string(static_cast<unsigned long long>(crossCheck.GetIssueCount())) + " cross check issues.";
+        }
+      result.crossCheckIssues= crossCheck.GetIssueCount();
+      }
+    if (!scenario.fingerprintFile.empty())
+      fingerprint.SetEvents(eventMap.GetEventMap(), eventMap.GetCoilMap());
+    result.eventRows= eventMap.GetEventCount();
+    result.eventMs= MsSince(eventStart);
+    }
+  if (!scenario.fingerprintFile.empty() && RTN_NO_ERROR == result.status &&
+      RTN_NO_ERROR != fingerprint.Write(scenario.fingerprintFile)) {
+    result.status= RTN_ERROR;
+    result.error= "Error when writing the fingerprint to " + scenario.fingerprintFile + ".";
+    }
+  result.totalMs= MsSince(start);
+  }
+
+void BatchRunner::Report(const ScenarioTyp &scenario, const ResultTyp &result) {
+  std::lock_guard<std::mutex> lock(consoleMutex_);
+  *console_ << "  " << scenario.name << " (" << scenario.source << "): ";
+  if (RTN_NO_ERROR == result.status)
+    *console_ << "ok, ";
+  else
+    *console_ << "ERROR -- " << result.error << " ";
+  *console_ << result.positionRows << " positions, " << result.eventRows << " events, "
+            << result.totalMs << " ms." << std::endl;
+  }
+
+} // namespace gaScsData
@@ -0,0 +1,155 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: BatchRunner.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Headless batch runs of many coils/scenarios, for regenerating tables overnight.
+ *            Reads a JSON manifest of scenarios, runs each one, and writes a consolidated
+ *            JSON report with timings, row counts, errors, and output checksums per scenario.
+ *
+ *            Manifest example:
+ *              {
+ *                "workers": 4,
+ *                "scenarios": [
+ *                  { "name": "stn06 coil", "source": "db", "positions": true, "events": true },
+ *                  { "name": "10x coil", "source": "generated", "scale": 10 },
+ *                  { "name": "short coil", "source": "generated", "layer_count": 12, "short_turns": 2, "events": false },
+ *                  { "name": "wide arc", "source": "generated", "params": { "trans_arc_deg": 12.0 } }
+ *                ]
+ *              }
+ *
+ *            source "db" -- the coil map in the configured db. The position and/or event tables are written,
+ *                           the same as the -p and -e arguments, and each one is recorded in the generation
+ *                           fingerprint (FINGERPRINT_FILE) when it is committed. The tables are shared, so db
+ *                           scenarios run one at a time, in manifest order.
+ *            source "generated" -- a CoilMapGenerator coil map, all in memory. No db access, and nothing is written.
+ *                                  Optional generator settings: scale, turns_per_layer, layer_count, short_turns.
+ *                                  Events need the hqp and layer starts from the positions, so the positions
+ *                                  are always calculated. Generated scenarios run in parallel on "workers" threads
+ *                                  (default: one per core), alongside the db scenarios.
+ *                                  "fingerprint": "<file>" writes the OutputFingerprint of the generation, so two
+ *                                  generator versions can be compared with the -v argument.
+ *            positions and events default to true.
+ *            "params" is an optional object of GenerationParams values by name (see GenerationParams::SetValue()),
+ *            for either source. Parameters not listed keep their defaults. The applied parameters are in the report.
+ *
+ *            Console output of the generation code is discarded during the run, and the progress display
+ *            is turned off. One line is displayed per finished scenario.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  thread
+ *                  mutex
+ *                  atomic
+ *                  chrono
+ *                  Boost Property Tree (JSON parser)
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_BatchRunner_H_
+#define GA_BatchRunner_H_
+
+// standard c/c++ libraries
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+#include "GenerationParams.hpp"
+#include "CoilGeometry.hpp"
+#include "OutputFingerprint.hpp"
+
+namespace gaScsData {
+
+class BatchRunner : private boost::noncopyable {
+
+public:
+  // typedefs and enums
+    // One manifest entry. Generator settings of 0 use the generator defaults.
+    struct ScenarioTyp {
+      std::string name;
+      std::string source;   // BATCH_SOURCE_DB or BATCH_SOURCE_GENERATED
+      bool runPositions;
+      bool runEvents;
+      long scale;
+      long turnsPerLayer;
+      long layerCount;
+      long shortTurns;
+      std::string fingerprintFile;  // generated only. Empty if not written.
+      GenerationParams params;      // the defaults, with the manifest "params" values applied
+      };
+    typedef std::vector<ScenarioTyp> scenario_list;
+
+    // Results of one scenario
+    struct ResultTyp {
+      long status;          // RTN_NO_ERROR or RTN_ERROR
+      std::string error;    // what failed, empty if nothing did
+      size_t coilRows;      // generated coil map rows (0 for db)
+      size_t positionRows;
+      size_t eventRows;
+      size_t violations;    // PositionValidator violations of the positions (generated only)
+      size_t crossCheckIssues;  // EventCrossCheck issues of the events (db scenarios: when run with the positions)
+      std::string positionChecksum;  // empty if not run
+      std::string eventChecksum;
+      double generateMs;
+      double positionMs;
+      double eventMs;
+      double totalMs;
+      };
+    typedef std::vector<ResultTyp> result_list;
+
+  // ctors and dtor
+    BatchRunner();
+    ~BatchRunner();
+
+  // accessors
+    // geometry of the db coil map, for the db scenarios. Defaults to the standard coil (-g argument)
+    void SetGeometry(const CoilGeometry &geometry);
+    const scenario_list& GetScenarios() const;
+    const result_list& GetResults() const;
+    // number of scenarios that did not finish without error
+    size_t GetFailedCount() const;
+
+  // public member functions
+    // read the scenarios from a JSON manifest. Return value indicates success or error
+    long LoadManifest(const std::string &fileName);
+    // run all the scenarios. Return value is RTN_NO_ERROR if every scenario finished without error
+    long Run();
+    // results as a JSON document
+    std::string ToJson() const;
+    // write ToJson() to the file. return value indicates success or error
+    long WriteJson(const std::string &fileName) const;
+
+  private:
+    typedef std::chrono::steady_clock clock;
+
+    // helper functions
+      static double MsSince(clock::time_point start);
+      // worker thread. Runs generated scenarios until there are none left.
+      void GeneratedWorker();
+      void RunDbScenario(const ScenarioTyp &scenario, ResultTyp &result);
+      // record the db tables that were just committed in the generation fingerprint, as the -p and -e arguments.
+      // return value indicates success or error
+      static long RecordDbTables(OutputFingerprint &fingerprint, ResultTyp &result);
+      void RunGeneratedScenario(const ScenarioTyp &scenario, ResultTyp &result);
+      // display one finished scenario
+      void Report(const ScenarioTyp &scenario, const ResultTyp &result);
+
+    // member variables
+      scenario_list scenarios_;
+      result_list results_;  // by scenario index
+      size_t workers_;
+      CoilGeometry geometry_;  // db coil map
+      std::vector<size_t> generatedIndexes_;  // scenarios run by the workers
+      std::atomic<size_t> nextGenerated_;     // next entry of generatedIndexes_ to run
+      std::ostream *console_;  // console, while std::cout output is discarded
+      std::mutex consoleMutex_;
+      double elapsedMs_;
+};
+
+} // namespace gaScsData
+#endif // GA_BatchRunner_H_
@@ -0,0 +1,86 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: Checksum.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  64 bit FNV-1a checksum of generated table contents.
+ *
+ * Libraries used:  string
+ *                  Boost Non-copyable
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <cstring>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "Checksum.hpp"
+
+namespace gaScsData {
+
+// ctors and dtor
+Checksum::Checksum() :
+    value_(CHECKSUM_FNV_OFFSET_BASIS) { }
+
+Checksum::~Checksum() { }
+
+// public member functions
+void Checksum::Add(const void *data, size_t size) {
+  const unsigned char *bytes= static_cast<const unsigned char*>(data);
+  for (size_t i= 0; i < size; ++i) {
+    value_^= bytes[i];
+    value_*= CHECKSUM_FNV_PRIME;
+    }
+  }
+
+void Checksum::Add(double value) {
+  // -0.0 and 0.0 are the same position
+  if (0.0 == value)
+    value= 0.0;
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  Add(&bits, sizeof(bits));
+  }
+
+void Checksum::Add(long value) {
+  // fixed width, so the checksum does not depend on the size of long
+  const int64_t wide= value;
+  Add(&wide, sizeof(wide));
+  }
+
+void Checksum::Add(bool value) {
+  const unsigned char byte= value ? 1 : 0;
+  Add(&byte, sizeof(byte));
+  }
+
+void Checksum::Add(const std::string &value) {
+  // include the length so adjacent strings can't run together
+  Add(static_cast<long>(value.size()));
+  Add(value.data(), value.size());
+  }
+
+void Checksum::Reset() {
+  value_= CHECKSUM_FNV_OFFSET_BASIS;
+  }
+
+uint64_t Checksum::GetValue() const {
+  return value_;
+  }
+
+std::string Checksum::ToHex() const {
+  static const char digits[]= "0123456789abcdef";
+  std::string hex(16, '0');
+  uint64_t value= value_;
+  for (size_t i= 0; i < hex.size(); ++i) {
+    hex[hex.size() - 1 - i]= digits[value & 0xf];
+    value>>= 4;
+    }
+  return hex;
+  }
+
+} // namespace gaScsData
@@ -0,0 +1,55 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: Checksum.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  64 bit FNV-1a checksum of generated table contents.
+ *            Used to tell if two runs produced the same rows, without keeping or comparing the rows.
+ *            Values are added in row order. Doubles are added by their bit pattern
+ *            (with -0.0 the same as 0.0), so any change to a calculated position changes the checksum.
+ *
+ * Libraries used:  string
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_Checksum_H_
+#define GA_Checksum_H_
+
+// standard c/c++ libraries
+#include <cstdint>
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+
+namespace gaScsData {
+
+class Checksum : private boost::noncopyable {
+
+public:
+  // ctors and dtor
+    Checksum();
+    ~Checksum();
+
+  // public member functions
+    void Add(const void *data, size_t size);
+    void Add(double value);
+    void Add(long value);
+    void Add(bool value);
+    void Add(const std::string &value);
+    // start over
+    void Reset();
+
+    uint64_t GetValue() const;
+    // the value as 16 hex digits
+    std::string ToHex() const;
+
+  private:
+    // member variables
+      uint64_t value_;
+};
+
+} // namespace gaScsData
+#endif // GA_Checksum_H_
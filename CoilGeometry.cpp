@@ -0,0 +1,179 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: CoilGeometry.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  The coil geometry as a runtime object, and the standard coil compile time kernel.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  Boost Property Tree (JSON parser)
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <sstream>
+#include <algorithm>
+
+// Boost libraries
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "CoilGeometry.hpp"
+
+namespace gaScsData {
+
+// StandardGeometry class constants
+constexpr StandardGeometry::layer_mask StandardGeometry::LAST_HQ_MASK;
+constexpr StandardGeometry::layer_mask StandardGeometry::LA_ME_CO_MASK;
+
+// read a list of layer numbers, and sort it
+static void ReadLayerList(const boost::property_tree::ptree &tree, const std::string &key, CoilGeometry::layer_list &layers) {
+  boost::optional<const boost::property_tree::ptree&> list= tree.get_child_optional(key);
+  if (!list)
+    return;  // keep the current list
+  layers.clear();
+  for (boost::property_tree::ptree::const_iterator cit= list->begin(); cit != list->end(); ++cit) {
+    layers.push_back(cit->second.get_value<long>());
+    }
+  std::sort(layers.begin(), layers.end());
+  layers.erase(std::unique(layers.begin(), layers.end()), layers.end());
+  }
+
+static void LayerListToJson(std::ostringstream &json, const CoilGeometry::layer_list &layers) {
+  json << "[";
+  for (size_t i= 0; i < layers.size(); ++i) {
+    json << (0 == i ? " " : ", ") << layers[i];
+    }
+  json << " ]";
+  }
+
+// ctors and dtor
+CoilGeometry::CoilGeometry() :
+    turnsPerLayer(TURNS_PER_LAYER),
+    layersPerCoil(LAYERS_PER_COIL),
+    shortTurns(COIL_SHORT_TURNS),
+    columnCount(COLUMN_COUNT),
+    lastHqLayers(LAST_HQ_LAYERS, LAST_HQ_LAYERS + NUM_OF_LAST_HQ_LAYERS),
+    laMeCo(LA_ME_CO, LA_ME_CO + NUM_OF_LA_ME_CO) { }
+
+CoilGeometry CoilGeometry::Mockup() {
+  CoilGeometry geometry;
+  geometry.layersPerCoil= MOCKUP_LAYERS_PER_COIL;
+  geometry.shortTurns= MOCKUP_SHORT_TURNS;
+  geometry.lastHqLayers.assign(MOCKUP_LAST_HQ_LAYERS, MOCKUP_LAST_HQ_LAYERS + MOCKUP_NUM_OF_LAST_HQ_LAYERS);
+  geometry.laMeCo.assign(MOCKUP_LA_ME_CO, MOCKUP_LA_ME_CO + MOCKUP_NUM_OF_LA_ME_CO);
+  return geometry;
+  }
+
+// public member functions
+long CoilGeometry::Validate(std::string &errorText) const {
+  // return value indicates success or error
+  std::ostringstream error;
+  if (turnsPerLayer < 1 || layersPerCoil < 1 || shortTurns < 0 || layersPerCoil * turnsPerLayer - shortTurns < 1)
+    error << "Invalid coil geometry. Turns per layer: " << turnsPerLayer << ", layers: " << layersPerCoil
+          << ", short turns: " << shortTurns << ".";
+  else if (COLUMN_COUNT != columnCount)
+    error << "Invalid coil geometry. Column count " << columnCount << " is not supported, only " << COLUMN_COUNT << ".";
+  errorText= error.str();
+  return errorText.empty() ? RTN_NO_ERROR : RTN_ERROR;
+  }
+
+bool CoilGeometry::isStandard() const {
+  // the short turns only change the coil angle max, which is passed to AxisPositions separately
+  return TURNS_PER_LAYER == turnsPerLayer && LAYERS_PER_COIL == layersPerCoil && COLUMN_COUNT == columnCount &&
+         lastHqLayers.size() == NUM_OF_LAST_HQ_LAYERS && std::equal(lastHqLayers.begin(), lastHqLayers.end(), LAST_HQ_LAYERS) &&
+         laMeCo.size() == NUM_OF_LA_ME_CO && std::equal(laMeCo.begin(), laMeCo.end(), LA_ME_CO);
+  }
+
+long CoilGeometry::GetCoilAngleMax() const {
+  // same as COIL_ANGLE_MAX for the standard coil
+  return (layersPerCoil * turnsPerLayer * 360) - (360 * shortTurns);
+  }
+
+void CoilGeometry::Scale(long scale) {
+  if (scale <= 1)
+    return;
+  const layer_list lastHq(lastHqLayers);
+  const layer_list meCo(laMeCo);
+  lastHqLayers.clear();
+  laMeCo.clear();
+  for (long copy= 0; copy < scale; ++copy) {
+    for (size_t i= 0; i < lastHq.size(); ++i)
+      lastHqLayers.push_back(lastHq[i] + copy * layersPerCoil);
+    for (size_t i= 0; i < meCo.size(); ++i)
+      laMeCo.push_back(meCo[i] + copy * layersPerCoil);
+    }
+  // a measurement layer past the end of one copy can be the same as one of the next copy
+  std::sort(laMeCo.begin(), laMeCo.end());
+  laMeCo.erase(std::unique(laMeCo.begin(), laMeCo.end()), laMeCo.end());
+  layersPerCoil*= scale;
+  }
+
+long CoilGeometry::Load(const std::string &source) {
+  // return value indicates success or error
+  if (GEOMETRY_STANDARD == source) {
+    *this= CoilGeometry();
+    return RTN_NO_ERROR;
+    }
+  if (GEOMETRY_MOCKUP == source) {
+    *this= Mockup();
+    return RTN_NO_ERROR;
+    }
+
+  CoilGeometry geometry;
+  try {
+    boost::property_tree::ptree tree;
+    boost::property_tree::read_json(source, tree);
+    geometry.turnsPerLayer= tree.get<long>("turns_per_layer", geometry.turnsPerLayer);
+    geometry.layersPerCoil= tree.get<long>("layers_per_coil", geometry.layersPerCoil);
+    geometry.shortTurns= tree.get<long>("short_turns", geometry.shortTurns);
+    geometry.columnCount= tree.get<long>("column_count", geometry.columnCount);
+    ReadLayerList(tree, "last_hq_layers", geometry.lastHqLayers);
+    ReadLayerList(tree, "la_me_co", geometry.laMeCo);
+    }
+  catch (const boost::property_tree::ptree_error &ex) {
+    std::cout << "Error reading the coil geometry " << source << ": " << ex.what() << std::endl;
+    return RTN_ERROR;
+    }
+
+  std::string errorText;
+  if (RTN_NO_ERROR != geometry.Validate(errorText)) {
+    std::cout << "Coil geometry " << source << ": " << errorText << std::endl;
+    return RTN_ERROR;
+    }
+  *this= geometry;
+  return RTN_NO_ERROR;
+  }
+
+std::string CoilGeometry::ToJson() const {
+  std::ostringstream json;
+  json << "{ \"turns_per_layer\": " << turnsPerLayer << ", \"layers_per_coil\": " << layersPerCoil
+       << ", \"short_turns\": " << shortTurns << ", \"column_count\": " << columnCount << ", \"last_hq_layers\": ";
+  LayerListToJson(json, lastHqLayers);
+  json << ", \"la_me_co\": ";
+  LayerListToJson(json, laMeCo);
+  json << " }";
+  return json.str();
+  }
+
+bool CoilGeometry::isLastTurn(long turn, bool isEvenLayer) const {
+  return isEvenLayer ? 1 == turn : turnsPerLayer == turn;
+  }
+
+bool CoilGeometry::isLastHqLayer(long layer) const {
+  // the last layer of the coil, or anything past it, always ends a hex/quad
+  return layersPerCoil <= layer || std::binary_search(lastHqLayers.begin(), lastHqLayers.end(), layer);
+  }
+
+bool CoilGeometry::isInLaMeCo(long layer) const {
+  return std::binary_search(laMeCo.begin(), laMeCo.end(), layer);
+  }
+
+} // namespace gaScsData
@@ -0,0 +1,114 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: CoilGeometry.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  The coil geometry (turns per layer, layers, short turns, column count, last hex/quad layers,
+ *            and the measurement and compression layers), as a runtime object instead of constants.
+ *            The mockup, production, and future coil designs can use the same build.
+ *            A default constructed CoilGeometry is the standard (production) coil, from gaScsDataConstants.hpp.
+ *            CoilMap holds the geometry of the coil it was populated with (CoilMap::SetGeometry()).
+ *
+ *            StandardGeometry is the compile time version of the standard coil. The turn and layer numbers
+ *            are template arguments, and the layer lists are constexpr bit masks, so the tests fold to
+ *            a compare or a bit test. CoilMap uses it when its geometry isStandard(), so the standard
+ *            coil does not pay for the runtime geometry.
+ *
+ *            Geometry file example (missing values are the standard coil values):
+ *              {
+ *                "turns_per_layer": 14, "layers_per_coil": 16, "short_turns": 3, "column_count": 12,
+ *                "last_hq_layers": [ 6, 10, 16 ], "la_me_co": [ 4, 7, 9, 11, 14, 17 ]
+ *              }
+ *
+ *            NOTE: The column count is the SCS axis count. The axis enumeration and the 60 degree column
+ *            symmetry are fixed, so only COLUMN_COUNT is valid for now.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  Boost Property Tree (JSON parser)
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_CoilGeometry_H_
+#define GA_CoilGeometry_H_
+
+// standard c/c++ libraries
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+
+namespace gaScsData {
+
+struct CoilGeometry {
+  // typedefs and enums
+    // list of layer numbers, ascending
+    typedef std::vector<long> layer_list;
+
+  // ctors and dtor
+    // the standard coil
+    CoilGeometry();
+    // the mockup coil
+    static CoilGeometry Mockup();
+
+  // public member functions
+    // Return value is RTN_ERROR if the geometry can't be used, with the reason in errorText
+    long Validate(std::string &errorText) const;
+    // true if this is the standard coil, so the StandardGeometry kernel can be used
+    bool isStandard() const;
+    // last coil angle
+    long GetCoilAngleMax() const;
+    // Make a coil scale times as long, by repeating the layer, hex/quad, and measurement layer pattern scale times.
+    void Scale(long scale);
+    // GEOMETRY_STANDARD, GEOMETRY_MOCKUP, or a JSON geometry file. Return value indicates success or error
+    long Load(const std::string &source);
+    // the geometry as a JSON object
+    std::string ToJson() const;
+
+    // general versions of the StandardGeometry tests
+    // last turn is turn 1 of even layers, and the last turn of odd layers
+    bool isLastTurn(long turn, bool isEvenLayer) const;
+    bool isLastHqLayer(long layer) const;
+    bool isInLaMeCo(long layer) const;
+
+  // geometry
+    long turnsPerLayer;     // TURNS_PER_LAYER
+    long layersPerCoil;     // LAYERS_PER_COIL
+    long shortTurns;        // COIL_SHORT_TURNS, turns missing from the last layer
+    long columnCount;       // COLUMN_COUNT
+    layer_list lastHqLayers;  // LAST_HQ_LAYERS
+    layer_list laMeCo;        // LA_ME_CO
+};
+
+// Turn and layer tests with the geometry as template arguments, so the compiler folds them.
+template <long TurnsPerLayer, long LayersPerCoil>
+struct GeometryKernel {
+  static bool isLastTurn(long turn, bool isEvenLayer) {
+    return isEvenLayer ? 1 == turn : TurnsPerLayer == turn;
+    }
+  static bool isPastLastLayer(long layer) { return LayersPerCoil <= layer; }
+};
+
+// bit mask of a list of layer numbers (1 to 63), at compile time
+constexpr unsigned long long LayerMask(const long *layers, size_t count) {
+  return 0 == count ? 0ULL : (1ULL << layers[count - 1]) | LayerMask(layers, count - 1);
+  }
+
+// The standard coil. The layer lists are bit masks made at compile time from LAST_HQ_LAYERS and LA_ME_CO.
+struct StandardGeometry : GeometryKernel<TURNS_PER_LAYER, LAYERS_PER_COIL> {
+  typedef unsigned long long layer_mask;
+  static constexpr layer_mask LAST_HQ_MASK= LayerMask(LAST_HQ_LAYERS, NUM_OF_LAST_HQ_LAYERS);
+  static constexpr layer_mask LA_ME_CO_MASK= LayerMask(LA_ME_CO, NUM_OF_LA_ME_CO);
+
+  static bool isLastHqLayer(long layer) {
+    return isPastLastLayer(layer) || (0 < layer && 0 != (LAST_HQ_MASK & (1ULL << layer)));
+    }
+  static bool isInLaMeCo(long layer) {
+    return 0 < layer && 64 > layer && 0 != (LA_ME_CO_MASK & (1ULL << layer));
+    }
+};
+static_assert(LAYERS_PER_COIL < 64 && LA_ME_CO[NUM_OF_LA_ME_CO - 1] < 64, "StandardGeometry layer masks hold layers 1 to 63");
+
+} // namespace gaScsData
+#endif // GA_CoilGeometry_H_
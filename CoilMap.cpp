@@ -7,7 +7,7 @@
  * Created: March 05, 2014
   *******************************************************************
  * Function:  The CoilMap class connects to the database, and queries the coil map table
- *            populating a boost library map with the coil map data.  The map uses the coil
+ *            populating a boost library flat map with the coil map data.  The map uses the coil
  *            angle as the key, and a tuple as the value.  The tuple holds in order:
  *            the feature code, hex/quad pancake, layer, turn, azimuth, nominal radius
  *        BUG: LB logic is erronous in the case where the passed in angle matches the last angle (row) in the map.
@@ -16,7 +16,7 @@
  * Libraries used:  string
  *                  SQLAPI.h
  *                  Boost Non-copyable
- *                  Boost Map Container
+ *                  Boost Flat Map Container
  *                  Boost tuple
  *******************************************************************/
 
@@ -26,21 +26,25 @@
 // header file
 #include "gaScsDataConstants.hpp"
 #include "CoilMap.hpp"
+#include "ConcurrentQueryLoader.hpp"
+#include "Metrics.hpp"
+#include "Checksum.hpp"
 
 namespace gaScsData {
 
+// Lb/Ub lookups done on this thread, for the metrics report
+static thread_local unsigned long long threadLookupCount= 0;
+
 // ctors and dtor
 CoilMap::CoilMap() :
 //    hqpStartPrev_(INITIAL_NO_POSITION), // first hqp will be start at 0, so set the previous so 0 will be seen as a new start
-    serverText_(DB_SERVER_NAME + "@" + DB_DATABASE_NAME),
+    geometry_(),
+    isStandardGeometry_(true),
+    bucketRowCount_(0),
+    verifyDerivedIndexes_(VERIFY_DERIVED_INDEXES),
     errorText_("") {
-  // initalize container of layer numbers indicating when coil measurement and compression occur
-  // allocate space for best performance
-  laMeCo_.reserve(NUM_OF_LA_ME_CO);
-  // assign the array elements to the member container
-  for (size_t i = 0; i < NUM_OF_LA_ME_CO; ++i) { // go thru list of layers, and insert into the set with a hint
-    laMeCo_.insert(laMeCo_.end(), LA_ME_CO[i]);
-    }
+  // reserve space for the coil map rows
+  mapCoil_.reserve(MAX_NUM_OF_COIL_MAP_ROWS);
 
   // reserve space for the number of odd layer turn 14 transitions
   mapOl14T_.reserve(MAX_NUM_OF_CNOLT14FCT);
@@ -48,82 +52,32 @@ CoilMap::CoilMap() :
   // reserve space for number of joggle angles
   setJoggleAngles_.reserve(MAX_NUM_OF_JOGGLE_ANGLES);
 
-  // initialize database connectivity parameters
-  // use SQL server native client
-  dbConnection_.setClient(SA_SQLServer_Client);
-  // Set the connection to use the ODBC API
-  // ODBC is default API, so this is only being specified for backward compatibility and documentation.
-  dbConnection_.setOption( "UseAPI" ) = "ODBC";
-  // Set the commnad object to use the connection
-  dbCommand_.setConnection(&dbConnection_);
+  // same for the server copies used to verify them
+  serverOl14T_.reserve(MAX_NUM_OF_CNOLT14FCT);
+  serverJoggleAngles_.reserve(MAX_NUM_OF_JOGGLE_ANGLES);
+
+  // The database connections are made by the ConcurrentQueryLoader, one per query.
   }
   
 CoilMap::~CoilMap() { }
 
 long CoilMap::PopulateCoilMap() {
   // return value indicates success or error
-  long connectStatus= 0;
-  long queryStatus= 0;
+  // The queries run concurrently, each on its own connection
+  ConcurrentQueryLoader loader;
+  AddLoadQueries(loader);
+  long queryStatus= loader.Run();
   long opStatus= 0; // operation status
-  long disconnectStatus= 0;
-  
-  // connect to db
-  connectStatus= DbConnect();
-
-  // if connect status is okay, query the db to get the coil map
-  if (RTN_NO_ERROR == connectStatus) {
-    queryStatus= QueryDb(SPNAME_SELECT_COIL_MAP);
+  if (RTN_NO_ERROR == queryStatus) {
+    opStatus= FinishLoad();
     }
-  // if connect and query status is okay, fetch the data from the query
-  // and put it into the coil map
-  if (RTN_NO_ERROR == connectStatus && 
-      RTN_NO_ERROR == queryStatus) {
-    opStatus= MapFeature();
-    }
-    
-  // if connect status, previous query, and previous operation were all okay,
-    // continue and query the db to get the turnAngle map (odd layer, 14th turns, Feature Code = T only)
-  if (RTN_NO_ERROR == connectStatus &&
-      RTN_NO_ERROR == queryStatus &&
-      RTN_NO_ERROR == opStatus) {
-    queryStatus= QueryDb(SPNAME_SELECT_CMOLT14FCT);
-    }
-    
-  // if connect status, previous query, and previous operation were all okay,
-    // continue and fetch the data from the query and put it into the turnAngle map
-  if (RTN_NO_ERROR == connectStatus &&
-      RTN_NO_ERROR == queryStatus &&
-      RTN_NO_ERROR == opStatus) {
-    opStatus= MapCmOlT14FcT();
+  else {
+    errorText_= loader.GetErrorText();
     }
 
-  // if connect status, previous query, and previous operation were all okay,
-  // continue and query the db to get the joggle angles
-  if (RTN_NO_ERROR == connectStatus &&
-      RTN_NO_ERROR == queryStatus &&
-      RTN_NO_ERROR == opStatus) {
-    queryStatus= QueryDb(SPNAME_SELECT_JOGGLE_ANGLES);
-    }
-    
-  // if connect status, previous query, and previous operation were all okay,
-  // continue and put it into the Joggle Angles set
-  if (RTN_NO_ERROR == connectStatus &&
-      RTN_NO_ERROR == queryStatus &&
-      RTN_NO_ERROR == opStatus) {
-    opStatus= PopulateJoggleAngleSet();
-    }
-    
-    
-  // disconnect from the db if connection was successful
-  if (RTN_NO_ERROR == connectStatus) {
-    disconnectStatus= DbDisconnect();
-    }
-    
   // if all status is okay, return no error, otherwise return error
-  if (RTN_NO_ERROR == connectStatus &&
-    RTN_NO_ERROR == queryStatus &&
-    RTN_NO_ERROR == opStatus &&
-    RTN_NO_ERROR == disconnectStatus) {
+  if (RTN_NO_ERROR == queryStatus &&
+    RTN_NO_ERROR == opStatus) {
     std::cout << "Done with no errors." << std::endl;
     return RTN_NO_ERROR;
     }
@@ -133,8 +87,108 @@ long CoilMap::PopulateCoilMap() {
     }
   } // PopulateCoilMap
 
+// Local (in memory) backend. Populate from coil map rows already in memory.
+long CoilMap::PopulateCoilMap(const coil_map &coilRows) {
+  // return value indicates success or error
+  mapCoil_= coilRows;
+  serverOl14T_.clear();
+  serverJoggleAngles_.clear();
+  BuildBucketIndex();
+  return BuildDerivedIndexes();
+  } // PopulateCoilMap(const coil_map &coilRows)
+
+// Queue the coil map queries on a loader owned by the caller, so they can run along side other queries.
+void CoilMap::AddLoadQueries(ConcurrentQueryLoader &loader) {
+  // start from empty containers. The fetch functions run on worker threads,
+  // and each one only touches its own container.
+  mapCoil_.clear();
+  bucketIndex_.clear();
+  serverOl14T_.clear();
+  serverJoggleAngles_.clear();
+
+  // the coil map is a few thousand rows. Have the client fetch them in blocks
+  // instead of one row per round trip.
+  loader.AddQuery(SPNAME_SELECT_COIL_MAP,
+                  [this](SACommand &command, std::string &errorText) { return MapFeature(command, errorText); },
+                  COIL_MAP_PREFETCH_ROWS);
+
+  // if requested, also get the server's version of the derived indexes to check against
+  if (verifyDerivedIndexes_) {
+    loader.AddQuery(SPNAME_SELECT_CMOLT14FCT,
+                    [this](SACommand &command, std::string &errorText) { return MapCmOlT14FcT(command, errorText, serverOl14T_); });
+    loader.AddQuery(SPNAME_SELECT_JOGGLE_ANGLES,
+                    [this](SACommand &command, std::string &errorText) { return PopulateJoggleAngleSet(command, errorText, serverJoggleAngles_); });
+    }
+  }
+
+// Once the loader has run, build the turnAngle map (odd layer, 14th turns, Feature Code = T only)
+// and the joggle angle set from the coil map rows, and check them if requested
+long CoilMap::FinishLoad() {
+  // return value indicates success or error
+  Metrics::ScopedTimer timer("coilmap.build_indexes");
+  Metrics::Instance().AddCount("coilmap.rows", static_cast<long long>(mapCoil_.size()));
+  BuildBucketIndex();
+  long opStatus= BuildDerivedIndexes();
+  if (verifyDerivedIndexes_ && RTN_NO_ERROR == opStatus) {
+    opStatus= VerifyDerivedIndexes();
+    }
+  return opStatus;
+  }
+
+// feature code conversion
+FeatureCode CoilMap::FcFromString(const std::string &fcText) {
+  if (fcText.empty() || NO_FEATURE_STR == fcText)
+    return FC_NONE;
+  return static_cast<FeatureCode>(fcText[0]);
+  }
+
+std::string CoilMap::FcToString(FeatureCode fc) {
+  if (FC_NONE == fc)
+    return NO_FEATURE_STR;
+  return std::string(1, static_cast<char>(fc));
+  }
+
 // accessor functions
 std::string CoilMap::GetErrorText() const { return errorText_; }
+void CoilMap::SetVerifyDerivedIndexes(bool verify) { verifyDerivedIndexes_= verify; }
+unsigned long long CoilMap::GetThreadLookupCount() { return threadLookupCount; }
+
+long CoilMap::SetGeometry(const CoilGeometry &geometry) {
+  // return value indicates success or error
+  if (RTN_NO_ERROR != geometry.Validate(errorText_)) {
+    std::cout << errorText_ << std::endl;
+    return RTN_ERROR;
+    }
+  geometry_= geometry;
+  isStandardGeometry_= geometry_.isStandard();
+  return RTN_NO_ERROR;
+  }
+
+const CoilGeometry& CoilMap::GetGeometry() const { return geometry_; }
+
+const CoilMap::coil_map& CoilMap::GetRows() const { return mapCoil_; }
+
+void CoilMap::AddToChecksum(Checksum &checksum) const {
+  checksum.Add(static_cast<long>(mapCoil_.size()));
+  for (cm_cit cit= mapCoil_.begin(); cit != mapCoil_.end(); ++cit) {
+    checksum.Add(cit->first);
+    checksum.Add(static_cast<long>(cit->second.get<0>()));
+    checksum.Add(cit->second.get<1>());
+    checksum.Add(cit->second.get<2>());
+    checksum.Add(cit->second.get<3>());
+    checksum.Add(cit->second.get<4>());
+    checksum.Add(cit->second.get<5>());
+    }
+  checksum.Add(static_cast<long>(mapOl14T_.size()));
+  for (lam_cit cit= mapOl14T_.begin(); cit != mapOl14T_.end(); ++cit) {
+    checksum.Add(cit->first);
+    checksum.Add(cit->second);
+    }
+  checksum.Add(static_cast<long>(setJoggleAngles_.size()));
+  for (as_cit cit= setJoggleAngles_.begin(); cit != setJoggleAngles_.end(); ++cit)
+    checksum.Add(*cit);
+  checksum.Add(geometry_.ToJson());
+  }
 
 // these accessor functions get property for the row with the specified angle, or 
 // the previous or equal to the passed in angle (i.e. "not after", or the Lower Bound, Hence the Lb ending), 
@@ -149,9 +203,7 @@ CoilMap::fhltar CoilMap::GetFhltar(double angle) const {
   }
 
 CoilMap::fhltar CoilMap::GetFhltarLb(double angle) const {
-  CoilMap::cm_cit cit= mapCoil_.upper_bound(angle);  // Get the position past the specified angle
-  if (cit != mapCoil_.begin())  // if not at the beginning
-    --cit;                            // decrement the iterator to get the previous position
+  CoilMap::cm_cit cit= LbIterator(angle);  // Get the position at or before the specified angle
   // pass the iterator to the overload
   return GetFhltar(cit);
   } 
@@ -183,9 +235,7 @@ double CoilMap::GetPrevAngle(double angle) const {
  
 double CoilMap::GetAngleLb(double angle) const { // previous angle
   // return value indicates success or error
-  CoilMap::cm_cit cit= mapCoil_.upper_bound(angle);  // Get the position past the specified angle
-  if (cit != mapCoil_.begin())  // if not at the beginning
-    --cit;                            // decrement the iterator to get the previous position
+  CoilMap::cm_cit cit= LbIterator(angle);  // Get the position at or before the specified angle
   // pass the iterator to the overload
   return GetAngle(cit);
 } 
@@ -194,21 +244,19 @@ double CoilMap::GetAngleLb(double angle) const { // previous angle
 // Get angle after the passed in angle. (i.e. Upper bound, hence the Ub ending)
 double CoilMap::GetAngleUb(double angle) const { // previous angle
   // return value indicates success or error
-  return GetAngle(mapCoil_.upper_bound(angle));  // Get the position past the specified angle
+  return GetAngle(UbIterator(angle));  // Get the position past the specified angle
 } 
 
-std::string CoilMap::GetFc(double angle) const {
+FeatureCode CoilMap::GetFc(double angle) const {
   CoilMap::cm_cit cit= mapCoil_.find(angle);  // Get the iterator for the specified angle
   // pass the iterator to the overload
   return GetFc(cit);
   }
 
 // Get Feature code Lower Bound
-std::string CoilMap::GetFcLb(double angle) const {
+FeatureCode CoilMap::GetFcLb(double angle) const {
   // return value indicates success or error
-  CoilMap::cm_cit cit= mapCoil_.upper_bound(angle);  // Get the position past the specified angle
-  if (cit != mapCoil_.begin())  // if not at the beginning
-    --cit;                            // decrement the iterator to get the previous position
+  CoilMap::cm_cit cit= LbIterator(angle);  // Get the position at or before the specified angle
   // pass the iterator to the overload
   return GetFc(cit);
   }
@@ -222,9 +270,7 @@ long CoilMap::GetHexQuadNumber(double angle) const {
 // Get HexQuad number Lower Bound
 long CoilMap::GetHexQuadNumberLb(double angle) const {
   // return value indicates success or error
-  CoilMap::cm_cit cit= mapCoil_.upper_bound(angle);  // Get the position past the specified angle
-  if (cit != mapCoil_.begin())  // if not at the beginning
-    --cit;                            // decrement the iterator to get the previous position
+  CoilMap::cm_cit cit= LbIterator(angle);  // Get the position at or before the specified angle
   // pass the iterator to the overload
   return GetHexQuadNumber(cit);
 }
@@ -238,9 +284,7 @@ long CoilMap::GetLayer(double angle) const {
 // Get Layer number Lower Bound
 long CoilMap::GetLayerLb(double angle) const {
   // return value indicates success or error
-  CoilMap::cm_cit cit= mapCoil_.upper_bound(angle);  // Get the position past the specified angle
-  if (cit != mapCoil_.begin())  // if not at the beginning
-    --cit;                            // decrement the iterator to get the previous position
+  CoilMap::cm_cit cit= LbIterator(angle);  // Get the position at or before the specified angle
   // pass the iterator to the overload
   return GetLayer(cit);
   }
@@ -254,9 +298,7 @@ long CoilMap::GetTurn(double angle) const {
 // Get Turn Lower bound
 long CoilMap::GetTurnLb(double angle) const {
   // return value indicates success or error
-  CoilMap::cm_cit cit= mapCoil_.upper_bound(angle);  // Get the position past the specified angle
-  if (cit != mapCoil_.begin())  // if not at the beginning
-    --cit;                            // decrement the iterator to get the previous position
+  CoilMap::cm_cit cit= LbIterator(angle);  // Get the position at or before the specified angle
   // pass the iterator to the overload
   return GetTurn(cit);
   }
@@ -270,9 +312,7 @@ double CoilMap::GetAzimuth(double angle) const {
 // Get Azimuth Lower Bound
 double CoilMap::GetAzimuthLb(double angle) const {
   // return value indicates success or error
-  CoilMap::cm_cit cit= mapCoil_.upper_bound(angle);  // Get the position past the specified angle
-  if (cit != mapCoil_.begin())  // if not at the beginning
-    --cit;                            // decrement the iterator to get the previous position
+  CoilMap::cm_cit cit= LbIterator(angle);  // Get the position at or before the specified angle
   // pass the iterator to the overload
   return GetAzimuth(cit);
   }
@@ -286,9 +326,7 @@ double CoilMap::GetRadius(double angle) const {
 // Get Radius Lower bound
 double CoilMap::GetRadiusLb(double angle) const {
   // return value indicates success or error
-  CoilMap::cm_cit cit= mapCoil_.upper_bound(angle);  // Get the position past the specified angle
-  if (cit != mapCoil_.begin())  // if not at the beginning
-    --cit;                            // decrement the iterator to get the previous position
+  CoilMap::cm_cit cit= LbIterator(angle);  // Get the position at or before the specified angle
   // pass the iterator to the overload
   return GetRadius(cit);
   }
@@ -312,7 +350,7 @@ double CoilMap::GetJoggleLengthLb(double angle) const {
   double jAngle= 0.0;
   if (1 == turn)  // turn 1
     jAngle= JOGGLE_LENGTH_MIN;
-  else if (TURNS_PER_LAYER == turn) // turn 14
+  else if (geometry_.turnsPerLayer == turn) // turn 14
     jAngle= JOGGLE_LENGTH_MAX;
   return jAngle;
   }
@@ -350,7 +388,7 @@ CoilMap::fhltar CoilMap::GetFhltar(CoilMap::cm_cit cit) const {
     }
   else {                            // iterator is at the end
     // return sentinel values
-    features.get<0>()= NO_FEATURE_STR; // feature code
+    features.get<0>()= FC_NONE; // feature code
     features.get<1>()= NO_FEATURE; // hex quand pancake number
     features.get<2>()= NO_FEATURE; // layer
     features.get<3>()= NO_FEATURE; // turn
@@ -383,14 +421,14 @@ double CoilMap::GetAngle(CoilMap::cm_crit crit) const {
 }
 
 
-std::string CoilMap::GetFc(CoilMap::cm_cit cit) const {
+FeatureCode CoilMap::GetFc(CoilMap::cm_cit cit) const {
   // return value indicates success or error
   if (cit != mapCoil_.end()) {  // if not at the end
     // get the properties at the iterator
     return cit->second.get<0>(); // feature code
     }
   else                            // iterator is at the end
-    return NO_FEATURE_STR;    // return sentinel value
+    return FC_NONE;    // return sentinel value
   }
 
 long CoilMap::GetHexQuadNumber(CoilMap::cm_cit cit) const {
@@ -515,7 +553,7 @@ CoilMap::fc_pair CoilMap::GetCurrentNextFc(CoilMap::cm_cit cit) const {
   if (cit != mapCoil_.end()) // if there is an element here
     fcpr.second= GetFc(cit); // get the next element feature code
   else  // there are no elements after the one which was referenced
-    fcpr.second= NO_FEATURE_STR;    // use sentinel value
+    fcpr.second= FC_NONE;    // use sentinel value
   return fcpr;
   }
 
@@ -585,12 +623,12 @@ bool CoilMap::isLastMoveOfLayer(double angle, bool &condition, double &joggleAng
 bool CoilMap::isLocalZeroLb(double angle, bool &condition) const {
   // return value true or false to indicate ok or error
   // condition indicates local zero (true) or not (false)
-  std::string fc= GetFcLb(angle); // get lower bound feature code
+  FeatureCode fc= GetFcLb(angle); // get lower bound feature code
   if (FC_LOCAL == fc) { // fc is the Local Zero
     condition = true;
     return true;
     }
-  else if (NO_FEATURE_STR != fc && FC_LOCAL != fc) { // fc is not an error and is not the local zero
+  else if (FC_NONE != fc && FC_LOCAL != fc) { // fc is not an error and is not the local zero
     condition = false;
     return true;
     }
@@ -611,9 +649,7 @@ bool CoilMap::isEvenLayer(double angle, bool &condition) const {
 bool CoilMap::isEvenLayerLb(double angle, bool &condition) const {
   // return value true or false to indicate ok or error
   // condition indicates odd (false) or even (true)
-  CoilMap::cm_cit cit= mapCoil_.upper_bound(angle);  // Get the position past the specified angle
-  if (cit != mapCoil_.begin())  // if not at the beginning
-    --cit;                            // decrement the iterator to get the previous position
+  CoilMap::cm_cit cit= LbIterator(angle);  // Get the position at or before the specified angle
   // pass the iterator to the overload
   return isEvenLayer(cit, condition);
   }
@@ -629,9 +665,7 @@ bool CoilMap::isOddLayer(double angle, bool &condition) const {
 bool CoilMap::isOddLayerLb(double angle, bool &condition) const {
   // return value true or false to indicate ok or error
   // condition indicates odd (true) or even (false)
-  CoilMap::cm_cit cit= mapCoil_.upper_bound(angle);  // Get the position past the specified angle
-  if (cit != mapCoil_.begin())  // if not at the beginning
-    --cit;                            // decrement the iterator to get the previous position
+  CoilMap::cm_cit cit= LbIterator(angle);  // Get the position at or before the specified angle
   // pass the iterator to the overload
   return isOddLayer(cit, condition);
   }
@@ -640,15 +674,15 @@ bool CoilMap::isOddLayerLb(double angle, bool &condition) const {
   // if previous angle was a transition AND
   // foot angle - angle of previous transition <= the transition window (in the window)
   // then the passed in angle is one where a transition adjustment needs to happen
-bool CoilMap::isInTransitionLb(double angle, bool &condition, double &degtoPrevTrans) const {
+bool CoilMap::isInTransitionLb(double angle, bool &condition, double &degtoPrevTrans, double transArcDeg) const {
   long turn= GetTurnLb(angle);
-  std::string fc= GetFcLb(angle);
+  FeatureCode fc= GetFcLb(angle);
   double anglePast = angle - GetAngleLb(angle);
   
-  if (NO_FEATURE != turn && NO_FEATURE_STR != fc) {
+  if (NO_FEATURE != turn && FC_NONE != fc) {
     // looked up details are good so no errors. Proceed ...
     if  (FC_TRANSITION == fc &&  // previous row was a transition AND
-        (TRANS_ARC_DEG >= anglePast)) { // within the transition window
+        (transArcDeg >= anglePast)) { // within the transition window
       // in transition case
       condition= true;
       degtoPrevTrans= anglePast;
@@ -672,15 +706,15 @@ bool CoilMap::isInJoggleLb(double angle, bool &condition) const {
   // Jog angle length (the joggle window) is min at turn 1 and max at turn 14, otherwise it is zero
   // get the turn number, and set the joggle angle length accordingly
   long turn= GetTurnLb(angle);
-  std::string fc= GetFcLb(angle);
+  FeatureCode fc= GetFcLb(angle);
   double featureAngle= GetAngleLb(angle); // previous angle
   double jAngle= 0.0;
   
-  if (NO_FEATURE != turn && NO_FEATURE_STR != fc && NO_FEATURE !=featureAngle) {
+  if (NO_FEATURE != turn && FC_NONE != fc && NO_FEATURE !=featureAngle) {
     // looked up details are good so no errors. Proceed ...
     if (1 == turn)
       jAngle= JOGGLE_LENGTH_MIN;
-    else if (TURNS_PER_LAYER == turn)
+    else if (geometry_.turnsPerLayer == turn)
       jAngle= JOGGLE_LENGTH_MAX;
 
     // if previous angle was a joggle, and foot angle - angle of previous joggle position <= adjusted joggle angle length (jAngle),
@@ -705,13 +739,9 @@ bool CoilMap::isInJoggleLb(double angle, bool &condition) const {
 bool CoilMap::isLastTurnLb(long turn, bool isEvenLayer) const {
   // last turn if odd layer and turn is 14 OR
   // even layer and turn is 1
-  if ((isEvenLayer && 1 == turn) ||               // even layer and turn 1 OR
-     (!isEvenLayer && TURNS_PER_LAYER == turn)) { // odd layer and turn 14 OR
-    // this is the last layer
-    return true;
-    }
-  else  // not the last layer
-    return false;
+  if (isStandardGeometry_)
+    return StandardGeometry::isLastTurn(turn, isEvenLayer);
+  return geometry_.isLastTurn(turn, isEvenLayer);
   }
 
 // determine if a angle corresponds to the last turn of a layer
@@ -723,14 +753,12 @@ bool CoilMap::isLastTurnLb(double angle, bool &condition) const {
   bool isOdd;
   bool stat= isOddLayerLb(angle, isOdd);
   
-  if (stat && ((isOdd && TURNS_PER_LAYER == turn) || // no lookup error AND ((odd layer, and turn 14) OR
-               (!isOdd && 1 == turn))) {                                  // (even layer and turn 1))
+  if (stat && isLastTurnLb(turn, !isOdd)) { // no lookup error AND ((odd layer, and turn 14) OR (even layer and turn 1))
     // no errors and this is the last layer
     condition = true;
     return true;
       }
-  else if (stat && !((isOdd && TURNS_PER_LAYER == turn) || // no lookup error AND NOT ((odd layer, and turn 14) OR
-                     (!isOdd && 1 == turn))) {                                        // (even layer and turn 1))
+  else if (stat) { // no lookup error AND NOT ((odd layer, and turn 14) OR (even layer and turn 1))
     // no erros and not the last layer
     condition = false;
     return true;
@@ -742,30 +770,16 @@ bool CoilMap::isLastTurnLb(double angle, bool &condition) const {
   }
   
 // determine if the angle or layer corresponds to the last hex/quad layer
-  // Last layer of a hex/quad is when layer
-  // is 6, 12, 18, 22, 28, 34, or 40
+  // Last layer of a hex/quad is a geometry last hex/quad layer, or the last layer of the coil.
+  // Standard coil is 6, 12, 18, 22, 28, 34, or 40
   // Mockup is 6, 10, and 16
   // return value true or false to indicate ok or error (except in long override)
   // condition indicates last layer (true) or not the last layer (false)
 // NOTE: Unlike other boolean tests, return value indicates test result (not status)
-// Mockup coil
-/*
 bool CoilMap::isLastHqLayer(long layer) const {
-  if (6 == layer || 10 == layer || 16 == layer) {  // Last layer
-    return true;
-  }
-  else  // not the last layer
-    return false;
-}
-*/
-// Normal coil
-bool CoilMap::isLastHqLayer(long layer) const {
-  if (6 == layer || 12 == layer || 18 == layer || 22 == layer ||
-    28 == layer || 34 == layer || 40 <= layer) {  // Last layer
-    return true;
-  }
-  else  // not the last layer
-    return false;
+  if (isStandardGeometry_)
+    return StandardGeometry::isLastHqLayer(layer);
+  return geometry_.isLastHqLayer(layer);
 }
 
 bool CoilMap::isLastHqLayer(double angle, bool &condition) const {
@@ -785,21 +799,16 @@ bool CoilMap::isLastHqLayerLb(double angle, bool &condition) const {
   // Last layer of a hex/quad is when layer
   // is 6, 12, 18, 22, 28, 34, or 40
   // TODO: Deal with errors?  3-state bool?
-  CoilMap::cm_cit cit= mapCoil_.upper_bound(angle);  // Get the position past the specified angle
-  if (cit != mapCoil_.begin())  // if not at the beginning
-    --cit;                            // decrement the iterator to get the previous position
+  CoilMap::cm_cit cit= LbIterator(angle);  // Get the position at or before the specified angle
   // pass the iterator to the overload
   return isLastHqLayer(cit, condition);
 }
   
 // looks for a value in the list of measurement and compression layers and returns true if the value was found
 bool CoilMap::isInLaMeCo(long layer) const {
-  lc_cit cit;  // make a iterator for the layer container
- cit = laMeCo_.find(layer); // look for the value
- if (cit != laMeCo_.end())  // found the value
-   return true;
- else // value not found
-   return false;
+  if (isStandardGeometry_)
+    return StandardGeometry::isInLaMeCo(layer);
+  return geometry_.isInLaMeCo(layer);
  }
 
 // Given an angle, get the current Lb angle and the next angle.
@@ -827,7 +836,7 @@ CoilMap::fc_pair CoilMap::GetCurrentNextFcLb(double angle) const {
     return GetCurrentNextFc(angLb);
     }
   else // no Lb angle. Return sentinel values
-    return std::make_pair(NO_FEATURE_STR, NO_FEATURE_STR);
+    return std::make_pair(FC_NONE, FC_NONE);
   }
 
 // Given an angle, get the current Lb layer and the next layer.
@@ -856,120 +865,51 @@ double CoilMap::GetAngleOl14T(long turn) const {
 // private helper functions
 
 // database functions
-long CoilMap::DbConnect() {
-  // connects to the database
-
-  // variable to hold return value
-  long rtnValue= 0;
-  try {
-    // connect to database
-    // Client type was specified in constructor
-    dbConnection_.Connect(serverText_.c_str(),     // server_name@database_name
-                          DB_USER_NAME.c_str(),   // user name
-                          DB_PASSWORD.c_str());   // password
-    // set return value for all okay
-    rtnValue= RTN_NO_ERROR;
-    }
-  catch(SAException &ex) {
-    // SAConnection::Rollback()
-    // can also throw an exception
-    // (if a network error for example),
-    // we will be ready
-    try {
-      // on error rollback changes
-      dbConnection_.Rollback();
-      }
-    catch(SAException &) {
-      }
-    // get error message
-    errorText_= (const char*)ex.ErrText();
-      // output the error text
-      std::cout << errorText_ << std::endl;
-    // set return value to indicate an error
-    rtnValue= RTN_ERROR;
-    }
-  return rtnValue;
-  }
-
-long CoilMap::DbDisconnect() {
-  // return value indicates success or error
-
-  // disconnects from the data base
-
-  // variable to hold return value
-  long rtnValue= 0;
-  try {
-    // disconnect
-    dbConnection_.Disconnect();
-    // set return value for all okay
-    rtnValue= RTN_NO_ERROR;
-    }
-  catch(SAException &ex) {
-    // get error message
-    errorText_= (const char*)ex.ErrText();
-    // output the error text
-    std::cout << errorText_ << std::endl;
-    // set return value to indicate an error
-    rtnValue= RTN_ERROR;
-    }
-  return rtnValue;
-  }
-
-// executes the specified stored procedure, which is expected to return results (SELECT...) 
-long CoilMap::QueryDb(const std::string &sprocName) {
-  // return value indicates success or error
-
-  // query the db using teh specified stored procedure, 
-  // presumably a SELECT command to fetch data
-
-  // variable to hold return value
-  long rtnValue= 0;
-
-  // Set the command text of the command object
-  dbCommand_.setCommandText(sprocName.c_str(), SA_CmdStoredProc);
-
-  try {
-    // execute the command
-    dbCommand_.Execute();
-    // set return value for all okay
-    rtnValue= RTN_NO_ERROR;
-    }
-  catch(SAException &ex) {
-    // get error message
-    errorText_= (const char*)ex.ErrText();
-    // output the error text
-    std::cout << errorText_ << std::endl;
-    // set return value to indicate an error
-    rtnValue= RTN_ERROR;
-    }
-  return rtnValue;
-  }
-
-long CoilMap::MapFeature() {
+long CoilMap::MapFeature(SACommand &command, std::string &errorText) {
   // return value indicates success or error
 
-  // put the values fetched by the QueryDb() into the coil map.
-  // QueryDb() should return one or more rows.  Map every row returned.
+  // put the values fetched by the the query into the coil map.
+  // the query should return one or more rows.  Map every row returned.
 
   // variable to hold return value
   long rtnValue= 0;
   try {
-    if (dbCommand_.isResultSet() ) {
+    if (command.isResultSet() ) {
       // if there is a result set
+      // look up the column positions once, rather than searching the fields by name for every row
+      const int angleIdx= GetFieldOrdinal(command, CM_ANGLE_PARAM);
+      const int fcIdx= GetFieldOrdinal(command, CM_FEATURECODE_PARAM);
+      const int hqpIdx= GetFieldOrdinal(command, CM_HQP_PARAM);
+      const int layerIdx= GetFieldOrdinal(command, CM_LAYER_PARAM);
+      const int turnIdx= GetFieldOrdinal(command, CM_TURN_PARAM);
+      const int azimuthIdx= GetFieldOrdinal(command, CM_AZIMUTH_PARAM);
+      const int radiusIdx= GetFieldOrdinal(command, CM_RADIUS_PARAM);
+      if (0 == angleIdx || 0 == fcIdx || 0 == hqpIdx || 0 == layerIdx ||
+          0 == turnIdx || 0 == azimuthIdx || 0 == radiusIdx) {
+        // a column is missing from the result set
+        errorText= "Coil map result set is missing one or more expected columns.";
+        return RTN_ERROR;
+        }
+
       // create local tuple and angle variables to hold properties
       double angle;
       angle_properties tpAp; // tuple of angle properties
-      while(dbCommand_.FetchNext() ) {
+      while(command.FetchNext() ) {
         // get angle, feature code, hqp number, layer, turn, azimuth, radius
-        angle= dbCommand_.Field(CM_ANGLE_PARAM.c_str()).asDouble();                // angle
-        tpAp.get<0>()= dbCommand_.Field(CM_FEATURECODE_PARAM.c_str()).asString();  // feature code
-        tpAp.get<1>()= dbCommand_.Field(CM_HQP_PARAM.c_str()).asLong();            // hex/quad pancake number
-        tpAp.get<2>()= dbCommand_.Field(CM_LAYER_PARAM.c_str()).asLong();          // layer
-        tpAp.get<3>()= dbCommand_.Field(CM_TURN_PARAM.c_str()).asLong();           // turn
-        tpAp.get<4>()= dbCommand_.Field(CM_AZIMUTH_PARAM.c_str()).asDouble();      // azimuth
-        tpAp.get<5>()= dbCommand_.Field(CM_RADIUS_PARAM.c_str()).asDouble();       // radius
+        angle= command.Field(angleIdx).asDouble();                // angle
+        tpAp.get<0>()= FcFromString((const char*)command.Field(fcIdx).asString()); // feature code, decoded once here
+        tpAp.get<1>()= command.Field(hqpIdx).asLong();            // hex/quad pancake number
+        tpAp.get<2>()= command.Field(layerIdx).asLong();          // layer
+        tpAp.get<3>()= command.Field(turnIdx).asLong();           // turn
+        tpAp.get<4>()= command.Field(azimuthIdx).asDouble();      // azimuth
+        tpAp.get<5>()= command.Field(radiusIdx).asDouble();       // radius
         // add the angle and associated properties to the map
-        mapCoil_[angle]=tpAp;
+        // The rows come back sorted by angle, so normally this is an append to the end of the flat map.
+        // If a row is ever out of order or repeated, fall back to a normal insert (last row wins, as before).
+        if (mapCoil_.empty() || angle > mapCoil_.rbegin()->first)
+          mapCoil_.emplace_hint(mapCoil_.end(), angle, tpAp);
+        else
+          mapCoil_[angle]= tpAp;
         }
       // set return value for all okay
       rtnValue= RTN_NO_ERROR;
@@ -981,38 +921,48 @@ long CoilMap::MapFeature() {
     }
   catch(SAException &ex) {
     // get error message
-    errorText_= (const char*)ex.ErrText();
-    // output the error text
-    std::cout << errorText_ << std::endl;
+    errorText= (const char*)ex.ErrText();
+    // the caller (loader) outputs the error text
     // set return value to indicate an error
     rtnValue= RTN_ERROR;
     }
   return rtnValue;
   }
 
-long CoilMap::MapCmOlT14FcT() {
+// returns the ordinal (1 based) of the named field in the current result set, or 0 if the field is not found.
+int CoilMap::GetFieldOrdinal(SACommand &command, const std::string &fieldName) {
+  // SQL Server column names are not case sensitive, so do not compare them that way here either
+  SAString name(fieldName.c_str());
+  for (int i= 1; i <= command.FieldCount(); ++i) {
+    if (0 == command.Field(i).Name().CompareNoCase(name))
+      return i;
+    }
+  return 0;
+  }
+
+long CoilMap::MapCmOlT14FcT(SACommand &command, std::string &errorText, layerAngle_map &mapOl14T) {
   // maps Coil map rows of Turn 14 odd layers with feature codes of "T". Used for odd layer consolidation.
   // return value indicates success or error
 
-  // QueryDb() is called with the correct stored procedure name prior to this function being called.
+  // the query is called with the correct stored procedure name prior to this function being called.
   // The query returns a set of layer numbers and corresponding angles for each odd layer turn 14 wiht a feature code of Transition(T)
-  // put the values fetched by the QueryDb() into a layerAngle map
-  // QueryDb() should return one or more rows.  Map every row returned.
+  // put the values fetched by the the query into a layerAngle map
+  // the query should return one or more rows.  Map every row returned.
 
   // variable to hold return value
   long rtnValue= 0;
   try {
-    if (dbCommand_.isResultSet() ) {
+    if (command.isResultSet() ) {
       // if there is a result set
       // create local variables to hold layer and angle
       long layer;
       double angle;
-      while(dbCommand_.FetchNext() ) {
+      while(command.FetchNext() ) {
         // get layer and angle
-        layer= dbCommand_.Field(CM_LAYER_PARAM.c_str()).asLong();    // layer
-        angle= dbCommand_.Field(CM_ANGLE_PARAM.c_str()).asDouble();  // angle
+        layer= command.Field(CM_LAYER_PARAM.c_str()).asLong();    // layer
+        angle= command.Field(CM_ANGLE_PARAM.c_str()).asDouble();  // angle
         // add the layer and associated angle to the map
-        mapOl14T_[layer]= angle;
+        mapOl14T[layer]= angle;
         }
       // set return value for all okay
       rtnValue= RTN_NO_ERROR;
@@ -1024,34 +974,33 @@ long CoilMap::MapCmOlT14FcT() {
     }
   catch(SAException &ex) {
     // get error message
-    errorText_= (const char*)ex.ErrText();
-    // output the error text
-    std::cout << errorText_ << std::endl;
+    errorText= (const char*)ex.ErrText();
+    // the caller (loader) outputs the error text
     // set return value to indicate an error
     rtnValue= RTN_ERROR;
     }
   return rtnValue;
   }
 
-long CoilMap::PopulateJoggleAngleSet() {
+long CoilMap::PopulateJoggleAngleSet(SACommand &command, std::string &errorText, angle_set &setJoggleAngles) {
   // Populates a set of joggle angles sorted ascendingly
   // return value indicates success or error
 
-  // QueryDb() is called with the correct stored procedure name prior to this function being called.
+  // the query is called with the correct stored procedure name prior to this function being called.
   // The query returns a sorted list of angles which correspond to joggles
-  // Put the values fetched by the QueryDb() into a set
-  // QueryDb() should return one or more rows.  Map every row returned.
+  // Put the values fetched by the the query into a set
+  // the query should return one or more rows.  Map every row returned.
 
   // variable to hold return value
   long rtnValue= 0;
   try {
-    if (dbCommand_.isResultSet() ) {
+    if (command.isResultSet() ) {
       // if there is a result set
       // create local variables to the angle
-      while(dbCommand_.FetchNext() ) {
+      while(command.FetchNext() ) {
         // get angle
         // add the layer and associated angle to the map
-        setJoggleAngles_.insert(dbCommand_.Field(CM_ANGLE_PARAM.c_str()).asDouble());  // insert the retreived angle into the set
+        setJoggleAngles.insert(command.Field(CM_ANGLE_PARAM.c_str()).asDouble());  // insert the retreived angle into the set
         }
       // set return value for all okay
       rtnValue= RTN_NO_ERROR;
@@ -1063,13 +1012,128 @@ long CoilMap::PopulateJoggleAngleSet() {
     }
   catch(SAException &ex) {
     // get error message
-    errorText_= (const char*)ex.ErrText();
-    // output the error text
-    std::cout << errorText_ << std::endl;
+    errorText= (const char*)ex.ErrText();
+    // the caller (loader) outputs the error text
     // set return value to indicate an error
     rtnValue= RTN_ERROR;
     }
   return rtnValue;
   }
+
+// Angle bucket of a coil angle. Used to build and to search the bucket index, so both use the exact same arithmetic.
+// Angle must be >= 0.
+size_t CoilMap::GetBucket(double angle) {
+  return static_cast<size_t>(angle / COIL_MAP_BUCKET_SIZE);
+  }
+
+void CoilMap::BuildBucketIndex() {
+  // Build the angle bucket index.
+  // bucketIndex_[b] is the row number (position in the flat map) of the first row in bucket b or later.
+  // There is one extra entry at the end holding the number of rows, so bucket b's rows are always
+  // bucketIndex_[b] up to (not including) bucketIndex_[b + 1].
+  bucketIndex_.clear();
+  bucketRowCount_= 0;
+  // only index non-negative angles. Otherwise leave the index empty, and the lookups will use the map search.
+  if (mapCoil_.empty() || mapCoil_.begin()->first < 0.0)
+    return;
+
+  const size_t bucketCount= GetBucket(mapCoil_.rbegin()->first) + 1;
+  bucketIndex_.reserve(bucketCount + 1);
+  size_t row= 0;
+  cm_cit cit= mapCoil_.begin();
+  for (size_t bucket= 0; bucket <= bucketCount; ++bucket) {
+    // skip the rows of the previous buckets
+    while (cit != mapCoil_.end() && GetBucket(cit->first) < bucket) {
+      ++cit;
+      ++row;
+      }
+    bucketIndex_.push_back(row);
+    }
+  bucketRowCount_= mapCoil_.size();
+  }
+
+// Same as mapCoil_.upper_bound(angle), using the bucket index.
+CoilMap::cm_cit CoilMap::UbIterator(double angle) const {
+  // Lb lookups come through here too
+  ++threadLookupCount;
+  // Use the map search if there is no index, the coil map has changed since the index was built (it is public),
+  // or the angle is outside the indexed range. !(angle >= 0) also catches NaN.
+  if (bucketIndex_.empty() || bucketRowCount_ != mapCoil_.size() || !(angle >= 0.0))
+    return mapCoil_.upper_bound(angle);
+  const size_t bucket= GetBucket(angle);
+  if (bucket + 1 >= bucketIndex_.size())
+    return mapCoil_.upper_bound(angle);  // past the last row
+
+  // Rows in earlier buckets are all <= angle, and rows in later buckets are all > angle,
+  // so the answer is in this bucket, or is the first row of the next one.
+  // Buckets only hold a few rows, so a scan beats a search here.
+  cm_cit cit= mapCoil_.nth(bucketIndex_[bucket]);
+  const cm_cit citEnd= mapCoil_.nth(bucketIndex_[bucket + 1]);
+  while (cit != citEnd && cit->first <= angle)
+    ++cit;
+  return cit;
+  }
+
+// Row at or before the angle (Lower Bound, hence the Lb ending).
+// Same as the upper_bound, then back up one, if not at the beginning.
+CoilMap::cm_cit CoilMap::LbIterator(double angle) const {
+  CoilMap::cm_cit cit= UbIterator(angle);  // Get the position past the specified angle
+  if (cit != mapCoil_.begin())  // if not at the beginning
+    --cit;                            // decrement the iterator to get the previous position
+  return cit;
+  }
+
+long CoilMap::BuildDerivedIndexes() {
+  // Build the odd layer turn 14 transition map and the joggle angle set in one pass over the loaded coil map.
+  // return value indicates success or error
+
+  // Same filters the sprocs use:
+    // odd layer turn 14 transitions -- odd layer, turn 14, feature code of Transition(T)
+    // joggle angles -- feature code of Joggle(J)
+  // The coil map is sorted by angle, so both containers are filled in sorted order
+  // and can be appended to with an end() hint.
+  if (mapCoil_.empty()) {
+    errorText_= "Coil map is empty. Cannot build the joggle and odd layer transition indexes.";
+    std::cout << errorText_ << std::endl;
+    return RTN_NO_RESULTS;
+    }
+
+  mapOl14T_.clear();
+  setJoggleAngles_.clear();
+  for (cm_cit cit= mapCoil_.begin(); cit != mapCoil_.end(); ++cit) {
+    if (FC_JOGGLE == GetFc(cit)) {
+      setJoggleAngles_.insert(setJoggleAngles_.end(), GetAngle(cit));
+      }
+    else if (FC_TRANSITION == GetFc(cit) &&
+             geometry_.turnsPerLayer == GetTurn(cit) &&
+             1 == GetLayer(cit) % 2) {
+      // if there is more than one, keep the last one (same as mapping the query rows)
+      mapOl14T_[GetLayer(cit)]= GetAngle(cit);
+      }
+    }
+  return RTN_NO_ERROR;
+  }
+
+long CoilMap::VerifyDerivedIndexes() {
+  // Compare the odd layer turn 14 transitions and joggle angles fetched from the server
+  // (see AddLoadQueries()) to the indexes built by BuildDerivedIndexes().
+  // return value indicates success or error. A mismatch is an error.
+
+  // compare. Both sides come from the same table, so the angles should match exactly.
+  if (serverOl14T_ != mapOl14T_) {
+    errorText_= "Odd layer turn 14 transitions built from the coil map (" + std::to_string(mapOl14T_.size()) +
+                ") do not match the server (" + std::to_string(serverOl14T_.size()) + ").";
+    std::cout << errorText_ << std::endl;
+    return RTN_ERROR;
+    }
+  if (serverJoggleAngles_ != setJoggleAngles_) {
+    errorText_= "Joggle angles built from the coil map (" + std::to_string(setJoggleAngles_.size()) +
+                ") do not match the server (" + std::to_string(serverJoggleAngles_.size()) + ").";
+    std::cout << errorText_ << std::endl;
+    return RTN_ERROR;
+    }
+  std::cout << "Joggle and odd layer transition indexes match the server." << std::endl;
+  return RTN_NO_ERROR;
+  }
  
 } // namsepace gaScsData
\ No newline at end of file
@@ -6,17 +6,17 @@
  * Author: J. Sheeron (x2315)
  * Created: March 05, 2014
   *******************************************************************
- * Function:  The CoilMap class connects to the database, and queries the coil map table
- *            populating a boost library map with the coil map data.  The map uses the coil
+ * Function:  The CoilMap class connects to the database (thru a ConcurrentQueryLoader), and queries the coil map table
+ *            populating a boost library flat map with the coil map data.  The map uses the coil
  *            angle as the key, and a tuple as the value.  The tuple holds in order:
- *            the feature code, hex/quad pancake, layer, turn, azimuth, nominal radius
+ *            the feature code (FeatureCode), hex/quad pancake, layer, turn, azimuth, nominal radius
  *        BUG: LB logic is erronous in the case where the passed in angle matches the last angle (row) in the map.
  *             in this case, the LB functions behave as if there is no LB, but really this last row should count
  *
  * Libraries used:  string
  *                  SQLAPI.h
  *                  Boost Non-copyable
- *                  Boost Map Container
+ *                  Boost Flat Map Container
  *                  Boost tuple
  *******************************************************************/
 #pragma once
@@ -30,23 +30,30 @@
 // GA headers
 
 #include "gaScsDataConstants.hpp"
+#include "CoilGeometry.hpp"
 
 namespace gaScsData {
 
+class ConcurrentQueryLoader;
+class Checksum;
+
 class CoilMap : private boost::noncopyable { 
 
 public:
   // typedefs and enums
 
-    // tuple to hold the feature code (0 string), hex/quad number (1 long), layer (2 long), turn (3 long), azimuth (4 double), nominal radius (5 double)
-      typedef boost::tuple<std::string, long, long, long, double, double> fhltar;
+    // tuple to hold the feature code (0 FeatureCode), hex/quad number (1 long), layer (2 long), turn (3 long), azimuth (4 double), nominal radius (5 double)
+      typedef boost::tuple<FeatureCode, long, long, long, double, double> fhltar;
 
      // coil map tuble and map structure
       // same structure as defined above
       typedef fhltar angle_properties;
         
-      // the coil map is implemented as a map of <angle, angle_properties>
-      typedef boost::container::map<double, angle_properties> coil_map;
+      // the coil map is implemented as a flat map of <angle, angle_properties>
+      // The coil map is loaded once, in angle order, and then only read, so a flat_map
+      // (sorted vector) is used. Rows are contiguous, which makes the lookups cache friendly,
+      // and appending in angle order is cheap. Reserve size in the ctor so the load never reallocates.
+      typedef boost::container::flat_map<double, angle_properties> coil_map;
       // define iterators to allow iterating over the var_map
       typedef coil_map::const_iterator cm_cit;
       typedef coil_map::const_reverse_iterator cm_crit;
@@ -54,7 +61,7 @@ public:
     // pair to hold an angle pair
       typedef std::pair<double, double> angle_pair;
     // pair to hold a feature code pair
-      typedef std::pair<std::string, std::string> fc_pair;
+      typedef std::pair<FeatureCode, FeatureCode> fc_pair;
     // pair to hold a layer number pair
       typedef std::pair<long, long> layer_pair;
 
@@ -68,12 +75,6 @@ public:
       typedef boost::container::flat_map<long, double> layerAngle_map;  // for best performance, reserve size in ctor
       typedef layerAngle_map::const_iterator lam_cit;
 
-  // Define a set to hold the layer numbers corresponding when to perform a layer compression and measurement
-  // Use a flat_set here becuase the size is fixed (set it in the ctor to num of add layers),
-  // and to optimize lookups. Google research shows insert performance over map is better (surprisingly) under about 256 elements.
-      typedef boost::container::flat_set<long> layer_container;  // for best performance, reserve size in ctor
-      typedef layer_container::const_iterator lc_cit;
-      
   // Define a set to contain a list of angles.
     typedef boost::container::flat_set<double> angle_set;  // for best performance, reserve size in ctor
     typedef angle_set::const_iterator as_cit;
@@ -90,9 +91,37 @@ public:
   
   // public member functions
   long PopulateCoilMap();
+  // Local (in memory) backend. Populate from coil map rows already in memory (from the CoilMapGenerator, for example)
+  // instead of the db. The derived indexes are built the same way. There is no server to verify them against.
+  long PopulateCoilMap(const coil_map &coilRows);
+  // Split version of PopulateCoilMap() for callers that have other queries to run at the same time:
+    // queue the coil map queries on the caller's loader, run the loader, and then call FinishLoad()
+    // to build (and optionally verify) the derived indexes.
+  void AddLoadQueries(ConcurrentQueryLoader &loader);
+  long FinishLoad();
+
+  // feature code conversion
+    // text (as stored in the db) to feature code. Empty or NO_FEATURE_STR text is FC_NONE.
+    // Codes are single letters, so the first letter is the code. Letters without a named constant are kept as is.
+    static FeatureCode FcFromString(const std::string &fcText);
+    // feature code to text, for db and trace output. FC_NONE is NO_FEATURE_STR.
+    static std::string FcToString(FeatureCode fc);
 
   // accessors
     std::string GetErrorText() const;
+    // number of Lb/Ub lookups done on the calling thread, by any coil map. The count is kept per thread
+    // so the lookups of parallel workers sharing a map do not contend; take the difference around a phase.
+    static unsigned long long GetThreadLookupCount();
+    // when true, PopulateCoilMap() checks the derived indexes against the server sprocs
+    void SetVerifyDerivedIndexes(bool verify);
+    // coil geometry. Defaults to the standard coil. Set it before populating the coil map.
+    // Return value is RTN_ERROR, and the geometry is not changed, if the geometry is not valid.
+    long SetGeometry(const CoilGeometry &geometry);
+    const CoilGeometry& GetGeometry() const;
+    // the coil map rows, by coil angle
+    const coil_map& GetRows() const;
+    // add the coil map rows, the odd layer turn 14 transition and joggle angle indexes, and the geometry to a checksum
+    void AddToChecksum(Checksum &checksum) const;
    
     // these accessor functions get property for the row with the specified angle, or 
     // the previous or equal to the passed in angle (i.e. "not after", or the Lower Bound, Hence the Lb ending), 
@@ -112,8 +141,8 @@ public:
     // Get angle after the passed in angle. (i.e. Upper bound, hence the Ub ending)
     double GetAngleUb(double angle) const;
     
-    std::string GetFc(double angle) const;
-    std::string GetFcLb(double angle) const;
+    FeatureCode GetFc(double angle) const;
+    FeatureCode GetFcLb(double angle) const;
     
     long GetHexQuadNumber(double angle) const;
     long GetHexQuadNumberLb(double angle) const;
@@ -142,11 +171,17 @@ public:
 
     bool isExisting(double angle) const; // does angle exist 
 
+    // Get the iterator of the row at or before the angle (Lower Bound, hence the Lb ending),
+    // or the row after the angle (Upper Bound, hence the Ub ending). Uses the angle bucket index.
+    // Same results as mapCoil_.upper_bound() (and decrement if not at the beginning for Lb).
+    cm_cit LbIterator(double angle) const;
+    cm_cit UbIterator(double angle) const;
+
     // Get data from the coil map using iterators
     CoilMap::fhltar GetFhltar(cm_cit cit) const;
     double GetAngle(cm_cit cit) const;
     double GetAngle(cm_crit crit) const;
-    std::string GetFc(cm_cit cit) const; // Feature Code (Fc)
+    FeatureCode GetFc(cm_cit cit) const; // Feature Code (Fc)
     long GetHexQuadNumber(cm_cit cit) const;
     long GetLayer(cm_cit cit) const;
     long GetTurn(cm_cit cit) const;
@@ -195,7 +230,8 @@ public:
       // if previous angle was a transition AND
       // foot angle - angle of previous transition <= the transition window (in the window)
       // then the passed in angle is one where a transition adjustment needs to happen
-    bool isInTransitionLb(double angle, bool &condition, double &degtoPrevTrans) const;
+      // The transition window is transArcDeg degrees (a GenerationParams value when tuning)
+    bool isInTransitionLb(double angle, bool &condition, double &degtoPrevTrans, double transArcDeg= TRANS_ARC_DEG) const;
     
     // determine if a angle corresponds to (is within) a joggle window Lower bound
     bool isInJoggleLb(double angle, bool &condition) const;
@@ -206,8 +242,7 @@ public:
     bool isLastTurnLb(double angle, bool &condition) const;
     
     // determine if the angle or layer corresponds to the last hex/quad layer
-      // Last layer of a hex/quad is when layer
-      // is 6, 12, 18, 22, 28, 34, or 40
+      // Last layer of a hex/quad is a geometry last hex/quad layer (6, 12, 18, 22, 28, 34, or 40 for the standard coil)
       // return value true or false to indicate ok or error (except in long override)
       // condition indicates last layer (true) or not the last layer (false)
     // NOTE: Unlike other boolean tests, return value indicates test result (not status)
@@ -238,27 +273,45 @@ public:
   private:
     // helper functions
       // database functions
-      long DbConnect();
-      long DbDisconnect();
-      long QueryDb(const std::string &sprocName); // executes the specified stored procedure, which is expected to return results (SELECT...) 
-      long MapFeature();
-      long MapCmOlT14FcT(); // maps Coil map rows of Turn 14 odd layers with feature codes of "T". Used for odd layer consolidation.
-      long PopulateJoggleAngleSet();   // Populates a set of joggle angles sorted ascendingly
+      // These read the result set of an executed command. They are called by the ConcurrentQueryLoader
+      // on a worker thread, so they put any error message in the passed in error text, not the member.
+      long MapFeature(SACommand &command, std::string &errorText);
+      // returns the ordinal (1 based) of the named field in the current result set, or 0 if the field is not found.
+      // Used to look up column positions once per result set, instead of by name for every row.
+      int GetFieldOrdinal(SACommand &command, const std::string &fieldName);
+      long MapCmOlT14FcT(SACommand &command, std::string &errorText, layerAngle_map &mapOl14T); // maps Coil map rows of Turn 14 odd layers with feature codes of "T". Used for odd layer consolidation.
+      long PopulateJoggleAngleSet(SACommand &command, std::string &errorText, angle_set &setJoggleAngles);   // Populates a set of joggle angles sorted ascendingly
+      // Build the odd layer turn 14 transition map and the joggle angle set in one pass over the loaded coil map.
+      // These are just filters of the coil map, so there is no need to query for them separately.
+      long BuildDerivedIndexes();
+      // Build the angle bucket index used by LbIterator() and UbIterator(). Call after the coil map is loaded.
+      void BuildBucketIndex();
+      static size_t GetBucket(double angle);
+      // Compare the odd layer turn 14 transitions and joggle angles fetched from the server to the
+      // indexes built by BuildDerivedIndexes(). Returns RTN_ERROR if they do not match.
+      long VerifyDerivedIndexes();
       
     // member variables
       // layer angle map1
       layerAngle_map mapOl14T_;  // Holds the layer (key) and angle of odd layer, turn 14 transitions
       // Set of joggle angles. Given and angle, this set allows the lookup of the angle of the next or previous joggle.
       angle_set setJoggleAngles_;
-      // list of layer numbers when coil measurement and compression are needed
-      layer_container laMeCo_;
-
-      // db objects
-      SAConnection dbConnection_; // create connection object
-      SACommand dbCommand_; // create connection object
+      // coil geometry, including the list of layer numbers when coil measurement and compression are needed
+      CoilGeometry geometry_;
+      // geometry_ is the standard coil, so the StandardGeometry kernel is used for the layer and turn tests
+      bool isStandardGeometry_;
+      // Angle bucket index. Given an angle, jump to its bucket (angle / COIL_MAP_BUCKET_SIZE), which holds
+      // the row number of the first row in the bucket, and scan the few rows of the bucket.
+      // This replaces the binary search for the Lb/Ub lookups, which is what random access callers use.
+      typedef std::vector<size_t> bucket_index;
+      bucket_index bucketIndex_;
+      size_t bucketRowCount_;  // coil map size when the index was built. If the map changes, the index is not used.
+      // check derived indexes against the server when populating
+      bool verifyDerivedIndexes_;
+      // server results of the derived index sprocs, only filled when verifying
+      layerAngle_map serverOl14T_;
+      angle_set serverJoggleAngles_;
 
-      // specify server and db string
-      std::string serverText_;
       // error text
       std::string errorText_;
 
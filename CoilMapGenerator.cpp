@@ -0,0 +1,133 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: CoilMapGenerator.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  The CoilMapGenerator class makes a synthetic coil map from geometry parameters,
+ *            for scale and performance testing without the production db.
+ *
+ * Libraries used:  vector
+ *                  Boost Non-copyable
+ *                  Boost Flat Map Container
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "CoilMapGenerator.hpp"
+
+namespace gaScsData {
+
+// ctors and dtor
+CoilMapGenerator::CoilMapGenerator() :
+    geometry_(),
+    initialRadius_(GEN_INITIAL_RADIUS),
+    turnIndex_(TURN_INDEX_NOMINAL) { }
+
+CoilMapGenerator::~CoilMapGenerator() { }
+
+// accessors
+void CoilMapGenerator::SetGeometry(const CoilGeometry &geometry) { geometry_= geometry; }
+void CoilMapGenerator::SetTurnsPerLayer(long turnsPerLayer) { geometry_.turnsPerLayer= turnsPerLayer; }
+void CoilMapGenerator::SetLayerCount(long layerCount) { geometry_.layersPerCoil= layerCount; }
+void CoilMapGenerator::SetShortTurns(long shortTurns) { geometry_.shortTurns= shortTurns; }
+void CoilMapGenerator::SetLastHqLayers(const layer_list &lastHqLayers) { geometry_.lastHqLayers= lastHqLayers; }
+void CoilMapGenerator::SetInitialRadius(double radius) { initialRadius_= radius; }
+void CoilMapGenerator::SetTurnIndex(double turnIndex) { turnIndex_= turnIndex; }
+
+void CoilMapGenerator::SetScale(long scale) {
+  // repeat the production layer, hex/quad, and measurement layer pattern scale times
+  const long shortTurns= geometry_.shortTurns;
+  geometry_= CoilGeometry();
+  geometry_.shortTurns= shortTurns;
+  geometry_.Scale(scale);
+  }
+
+long CoilMapGenerator::GetLayerCount() const { return geometry_.layersPerCoil; }
+
+long CoilMapGenerator::GetCoilAngleMax() const {
+  // same as COIL_ANGLE_MAX for the production geometry
+  return geometry_.GetCoilAngleMax();
+  }
+
+const CoilGeometry& CoilMapGenerator::GetGeometry() const { return geometry_; }
+
+// public member functions
+long CoilMapGenerator::Generate(CoilMap::coil_map &coilRows) const {
+  // return value indicates success or error
+  std::string errorText;
+  if (RTN_NO_ERROR != geometry_.Validate(errorText)) {
+    std::cout << "Coil map generator: " << errorText << std::endl;
+    return RTN_ERROR;
+    }
+  const long turnsPerLayer= geometry_.turnsPerLayer;
+  const long layerCount= geometry_.layersPerCoil;
+  const long turnCount= layerCount * turnsPerLayer - geometry_.shortTurns;  // total turns in the coil
+
+  coilRows.clear();
+  // nominally one transition per turn, plus a joggle per layer and a few per hex/quad
+  coilRows.reserve(static_cast<size_t>(turnCount + layerCount + 4 * geometry_.lastHqLayers.size() + 1));
+
+  long hqp= 1;
+  bool isNewHqp= true;  // first layer of a hex/quad
+  for (long layer= 1; layer <= layerCount; ++layer) {
+    const bool isOdd= (1 == layer % 2);
+    const bool isLastLayerOfHq= geometry_.isLastHqLayer(layer);
+    for (long k= 0; k < turnsPerLayer; ++k) {
+      const long overallTurn= (layer - 1) * turnsPerLayer + k; // 0 based
+      if (overallTurn >= turnCount)
+        break;  // short last layer
+      // odd layers wind out (turn 1 to 14), even layers wind in (turn 14 to 1)
+      const long turn= isOdd ? k + 1 : turnsPerLayer - k;
+      const double turnStart= static_cast<double>(overallTurn) * 360.0;
+
+      if (0 == k) {
+        // layer start joggle
+        AddRow(coilRows, turnStart, FC_JOGGLE, hqp, layer, turn);
+        if (isNewHqp) {
+          // new hex/quad. Local zero just past the joggle, and the He inlet
+          AddRow(coilRows, turnStart + GEN_LOCAL_ZERO_OFFSET, FC_LOCAL, hqp, layer, turn);
+          AddRow(coilRows, turnStart + GEN_INLET_OFFSET, FC_INLET, hqp, layer, turn);
+          }
+        }
+      // turn to turn transition
+      AddRow(coilRows, turnStart + GEN_TRANSITION_OFFSET, FC_TRANSITION, hqp, layer, turn);
+      // He outlet on the last turn of the hex/quad
+      if (isLastLayerOfHq && turnsPerLayer - 1 == k && overallTurn + 1 < turnCount) {
+        AddRow(coilRows, turnStart + GEN_OUTLET_OFFSET, FC_OUTLET, hqp, layer, turn);
+        }
+      }
+    // set up the next layer
+    isNewHqp= isLastLayerOfHq;
+    if (isLastLayerOfHq)
+      ++hqp;
+    }
+
+  // winding lock at the end of the coil, on the last layer
+  const double endAngle= static_cast<double>(turnCount) * 360.0 - GEN_WINDING_LOCK_OFFSET;
+  CoilMap::cm_crit crit= coilRows.rbegin();
+  if (crit != coilRows.rend()) {
+    const CoilMap::angle_properties &last= crit->second;
+    AddRow(coilRows, endAngle, FC_WINDING_LOCK, last.get<1>(), last.get<2>(), last.get<3>());
+    }
+  return RTN_NO_ERROR;
+  }
+
+// private helper functions
+void CoilMapGenerator::AddRow(CoilMap::coil_map &coilRows, double angle, FeatureCode fc, long hqp, long layer, long turn) const {
+  CoilMap::angle_properties tpAp; // tuple of angle properties
+  tpAp.get<0>()= fc;                                           // feature code
+  tpAp.get<1>()= hqp;                                          // hex/quad pancake number
+  tpAp.get<2>()= layer;                                        // layer
+  tpAp.get<3>()= turn;                                         // turn
+  tpAp.get<4>()= fmod(angle, 360.0);                           // azimuth
+  tpAp.get<5>()= initialRadius_ + (turn - 1) * turnIndex_;     // nominal radius
+  // rows are made in angle order, so this is an append
+  coilRows[angle]= tpAp;
+  }
+
+} // namespace gaScsData
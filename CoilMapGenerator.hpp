@@ -0,0 +1,94 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: CoilMapGenerator.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  The CoilMapGenerator class makes a synthetic coil map from geometry parameters,
+ *            for scale and performance testing without the production db.
+ *            The rows have the same layout as the coil map table (angle key, and the
+ *            feature code, hex/quad pancake, layer, turn, azimuth, nominal radius tuple), and are
+ *            loaded with CoilMap::PopulateCoilMap(const coil_map &) (the local backend).
+ *
+ *            The geometry is a CoilGeometry, and defaults to the standard (production) coil: TURNS_PER_LAYER turns,
+ *            LAYERS_PER_COIL layers, COIL_SHORT_TURNS short on the last layer, and the 6/12/18/22/28/34/40 last hex/quad layers.
+ *            SetScale() repeats the layer pattern to make a coil N times as long. GetGeometry() is the geometry of
+ *            the generated coil, for CoilMap::SetGeometry().
+ *
+ *            Each layer starts with a joggle (J). Odd layers wind turn 1 to 14, even layers 14 to 1, so
+ *            odd to even joggles are on turn 14 and even to odd joggles are on turn 1.
+ *            Every turn has a transition (T). The first layer of each hex/quad starts with a local zero (L)
+ *            just past the joggle, and has a He inlet (I) on its first turn. The last layer of each hex/quad
+ *            has a He outlet (O) on its last turn. There is a winding lock (W) at the end of the coil.
+ *            Radius goes up TURN_INDEX_NOMINAL per turn from the initial radius.
+ *
+ *            NOTE: AxisPositions logic still assumes the six column layout, and is only checked against the
+ *            production turns per layer, so change the turns per layer with care.
+ *
+ * Libraries used:  vector
+ *                  Boost Non-copyable
+ *                  Boost Flat Map Container
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_CoilMapGenerator_H_
+#define GA_CoilMapGenerator_H_
+
+// standard c/c++ libraries
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+#include "CoilMap.hpp"
+#include "CoilGeometry.hpp"
+
+namespace gaScsData {
+
+class CoilMapGenerator : private boost::noncopyable {
+
+public:
+  // typedefs and enums
+    // list of layer numbers
+    typedef CoilGeometry::layer_list layer_list;
+
+  // ctors and dtor
+    // defaults to the production coil geometry
+    CoilMapGenerator();
+    ~CoilMapGenerator();
+
+  // accessors
+    void SetGeometry(const CoilGeometry &geometry);
+    void SetTurnsPerLayer(long turnsPerLayer);
+    void SetLayerCount(long layerCount);
+    void SetShortTurns(long shortTurns);  // turns missing from the last layer
+    void SetLastHqLayers(const layer_list &lastHqLayers);  // last layer of each hex/quad pancake, ascending
+    // Make a coil scale times as long as the production coil, by repeating the production layer,
+    // hex/quad, and measurement layer pattern scale times. Sets the geometry, except the short turns.
+    void SetScale(long scale);
+    void SetInitialRadius(double radius);
+    void SetTurnIndex(double turnIndex);  // radius increase per turn
+
+    long GetLayerCount() const;
+    // last coil angle of the generated coil (same as COIL_ANGLE_MAX for the production geometry)
+    long GetCoilAngleMax() const;
+    // geometry of the generated coil
+    const CoilGeometry& GetGeometry() const;
+
+  // public member functions
+    // generate the coil map rows into the passed in map (cleared first)
+    // return value indicates success or error
+    long Generate(CoilMap::coil_map &coilRows) const;
+
+  private:
+    // helper functions
+      // add a row to the coil map
+      void AddRow(CoilMap::coil_map &coilRows, double angle, FeatureCode fc, long hqp, long layer, long turn) const;
+
+    // member variables
+      CoilGeometry geometry_;
+      double initialRadius_;
+      double turnIndex_;
+};
+
+} // namespace gaScsData
+#endif // GA_CoilMapGenerator_H_
@@ -0,0 +1,324 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: ColumnarExport.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Exports the coil map, SCS positions, and events as .npy columns, written in batches.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  map
+ *                  memory
+ *                  fstream
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <map>
+#include <cstring>
+#include <cstdint>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "ColumnarExport.hpp"
+#include "PositionResolver.hpp"
+#include "TablePublisher.hpp"
+#include "TraceRecorder.hpp"
+#include "Metrics.hpp"
+
+namespace gaScsData {
+
+// column names of the 24 axes are AXIS_COLUMN_NAMES
+static_assert(sizeof(AXIS_COLUMN_NAMES) / sizeof(AXIS_COLUMN_NAMES[0]) == COLUMN_COUNT * 2, "one column name per axis");
+
+// .npy column types
+static const char *NPY_DOUBLE= "<f8";
+static const char *NPY_INT64= "<i8";
+static const char *NPY_INT32= "<i4";
+static const char *NPY_UINT32= "<u4";
+static const char *NPY_BOOL= "|b1";
+
+// .npy version 1.0 header of a one dimension column, padded to EXPORT_NPY_HEADER_BYTES
+static std::string NpyHeader(const std::string &descr, size_t rowCount) {
+  std::ostringstream dictionary;
+  dictionary << "{'descr': '" << descr << "', 'fortran_order': False, 'shape': (" << rowCount << ",), }";
+  std::string header("\x93NUMPY\x01\x00", 8);
+  const size_t dictionaryBytes= EXPORT_NPY_HEADER_BYTES - 10;
+  header.push_back(static_cast<char>(dictionaryBytes & 0xFF));
+  header.push_back(static_cast<char>(dictionaryBytes >> 8));
+  header+= dictionary.str();
+  header.resize(EXPORT_NPY_HEADER_BYTES - 1, ' ');
+  header.push_back('\n');
+  return header;
+  }
+
+// One table being exported. The columns are written in batches, and the .npy headers are
+// written again with the row count when the table is closed.
+class ColumnarExport::Table {
+public:
+  Table(const std::string &prefix, const std::string &name) :
+      prefix_(prefix),
+      name_(name),
+      rowCount_(0),
+      batchRows_(0),
+      isOk_(true) { }
+
+  // add the columns before the first row. Return value is the column number.
+  size_t AddColumn(const std::string &name, const char *descr, bool isDictionary= false) {
+    std::unique_ptr<ColumnTyp> column(new ColumnTyp());
+    column->name= name;
+    column->descr= descr;
+    column->isDictionary= isDictionary;
+    column->fileName= prefix_ + "." + name_ + "." + name + ".npy";
+    column->file.open(column->fileName.c_str(), std::ios::binary | std::ios::trunc);
+    column->file << NpyHeader(descr, 0);  // written again when the row count is known
+    if (!column->file) {
+      std::cout << "Error creating the export column " << column->fileName << "." << std::endl;
+      isOk_= false;
+      }
+    columns_.push_back(std::move(column));
+    return columns_.size() - 1;
+    }
+
+  void AddDouble(size_t column, double value) { Add(column, &value, sizeof(value)); }
+  void AddInt64(size_t column, int64_t value) { Add(column, &value, sizeof(value)); }
+  void AddInt32(size_t column, int32_t value) { Add(column, &value, sizeof(value)); }
+  void AddUInt32(size_t column, uint32_t value) { Add(column, &value, sizeof(value)); }
+  void AddBool(size_t column, bool value) { const char byte= value ? 1 : 0; Add(column, &byte, 1); }
+  // dictionary column. The code is the order the text was first seen.
+  void AddText(size_t column, const std::string &text) {
+    ColumnTyp &col= *columns_[column];
+    std::map<std::string, int32_t>::const_iterator cit= col.codes.find(text);
+    int32_t code;
+    if (cit != col.codes.end())
+      code= cit->second;
+    else {
+      code= static_cast<int32_t>(col.values.size());
+      col.codes.insert(std::make_pair(text, code));
+      col.values.push_back(text);
+      }
+    Add(column, &code, sizeof(code));
+    }
+
+  // call after all the columns of a row are added
+  void EndRow() {
+    ++rowCount_;
+    if (EXPORT_BATCH_ROWS <= ++batchRows_)
+      Flush();
+    }
+
+  // Write the rest of the rows, the headers, and the dictionaries, and make the table schema.
+  // Return value indicates success or error
+  long Close(std::string &schema) {
+    Flush();
+    // file names in the schema are without the folder, so the export can be moved
+    const size_t folderEnd= prefix_.find_last_of("/\\");
+    const size_t nameStart= std::string::npos == folderEnd ? 0 : folderEnd + 1;
+    std::ostringstream json;
+    json << "    { \"name\": \"" << name_ << "\", \"rows\": " << rowCount_ << ", \"columns\": [";
+    for (size_t i= 0; i < columns_.size(); ++i) {
+      ColumnTyp &column= *columns_[i];
+      column.file.seekp(0);
+      column.file << NpyHeader(column.descr, rowCount_);
+      column.file.close();
+      if (column.file.fail())
+        isOk_= false;
+      json << (0 == i ? "" : ",") << std::endl << "      { \"name\": \"" << column.name << "\", \"dtype\": \"" << column.descr
+           << "\", \"file\": \"" << TraceRecorder::JsonEscape(column.fileName.substr(nameStart)) << "\"";
+      if (column.isDictionary) {
+        const std::string dictionaryFile= prefix_ + "." + name_ + "." + column.name + ".dict.json";
+        std::ofstream file(dictionaryFile.c_str(), std::ios::trunc);
+        file << "[";
+        for (size_t code= 0; code < column.values.size(); ++code) {
+          file << (0 == code ? "" : ",") << std::endl << "\"" << TraceRecorder::JsonEscape(column.values[code]) << "\"";
+          }
+        file << std::endl << "]" << std::endl;
+        if (!file)
+          isOk_= false;
+        json << ", \"dictionary\": \"" << TraceRecorder::JsonEscape(dictionaryFile.substr(nameStart)) << "\"";
+        }
+      json << " }";
+      }
+    json << " ] }";
+    schema= json.str();
+    if (!isOk_)
+      std::cout << "Error writing the " << name_ << " export columns." << std::endl;
+    return isOk_ ? RTN_NO_ERROR : RTN_ERROR;
+    }
+
+  size_t GetRowCount() const { return rowCount_; }
+
+private:
+  struct ColumnTyp {
+    std::string name;
+    std::string descr;
+    std::string fileName;
+    std::ofstream file;
+    std::string batch;  // values not written yet
+    bool isDictionary;
+    std::map<std::string, int32_t> codes;  // text to code
+    std::vector<std::string> values;  // code to text
+    };
+
+  // values are little endian, the same as the hosts this runs on
+  void Add(size_t column, const void *value, size_t size) {
+    columns_[column]->batch.append(static_cast<const char*>(value), size);
+    }
+
+  void Flush() {
+    for (size_t i= 0; i < columns_.size(); ++i) {
+      ColumnTyp &column= *columns_[i];
+      column.file.write(column.batch.data(), column.batch.size());
+      column.batch.clear();
+      if (!column.file)
+        isOk_= false;
+      }
+    batchRows_= 0;
+    }
+
+  std::string prefix_;
+  std::string name_;
+  std::vector<std::unique_ptr<ColumnTyp> > columns_;
+  size_t rowCount_;
+  size_t batchRows_;
+  bool isOk_;
+};
+
+// ctors and dtor
+ColumnarExport::ColumnarExport(const std::string &prefix) :
+    prefix_(prefix) { }
+
+ColumnarExport::~ColumnarExport() { }
+
+// public member functions
+long ColumnarExport::ExportCoilMap(const CoilMap &coilMap) {
+  // return value indicates success or error
+  Metrics::ScopedTimer timer("export.coil_map");
+  Table table(prefix_, "coil_map");
+  const size_t angle= table.AddColumn("coil_angle", NPY_DOUBLE);
+  const size_t featureCode= table.AddColumn("feature_code", NPY_INT32, true);
+  const size_t hqp= table.AddColumn("hqp", NPY_INT32);
+  const size_t layer= table.AddColumn("layer", NPY_INT32);
+  const size_t turn= table.AddColumn("turn", NPY_INT32);
+  const size_t azimuth= table.AddColumn("azimuth", NPY_DOUBLE);
+  const size_t radius= table.AddColumn("radius", NPY_DOUBLE);
+
+  const CoilMap::coil_map &rows= coilMap.GetRows();
+  for (CoilMap::cm_cit cit= rows.begin(); cit != rows.end(); ++cit) {
+    table.AddDouble(angle, cit->first);
+    table.AddText(featureCode, CoilMap::FcToString(cit->second.get<0>()));
+    table.AddInt32(hqp, static_cast<int32_t>(cit->second.get<1>()));
+    table.AddInt32(layer, static_cast<int32_t>(cit->second.get<2>()));
+    table.AddInt32(turn, static_cast<int32_t>(cit->second.get<3>()));
+    table.AddDouble(azimuth, cit->second.get<4>());
+    table.AddDouble(radius, cit->second.get<5>());
+    table.EndRow();
+    }
+
+  std::string schema;
+  const long status= table.Close(schema);
+  schemas_.push_back(schema);
+  return status;
+  }
+
+long ColumnarExport::ExportPositions(const AxisPositions::ScsAxesPositionMap &scsRows) {
+  // return value indicates success or error
+  Metrics::ScopedTimer timer("export.positions");
+  Table table(prefix_, "positions");
+  const size_t riaAngle= table.AddColumn("ria_angle", NPY_INT64);
+  const size_t coilAngle= table.AddColumn("coil_angle", NPY_DOUBLE);
+  // one bool column per ScsRecordFlags bit
+  const char *flagNames[]= { "is_selected", "is_absolute", "is_adjust_absolute", "is_transition", "is_joggle",
+                             "is_new_hqp", "is_new_layer", "is_last_turn", "is_last_layer" };
+  const size_t flagCount= sizeof(flagNames) / sizeof(flagNames[0]);
+  const size_t firstFlag= table.AddColumn(flagNames[0], NPY_BOOL);
+  for (size_t i= 1; i < flagCount; ++i) {
+    table.AddColumn(flagNames[i], NPY_BOOL);
+    }
+  const size_t hqpAdjust= table.AddColumn("hqp_adjust", NPY_INT32);
+  const size_t layerAdjust= table.AddColumn("layer_adjust", NPY_INT32);
+  const size_t selectedAxes= table.AddColumn("selected_axes", NPY_UINT32);
+  const size_t selectedDistance= table.AddColumn("selected_distance", NPY_DOUBLE);
+  const size_t firstAxis= table.AddColumn(AXIS_COLUMN_NAMES[0], NPY_DOUBLE);
+  for (long i= 1; i < COLUMN_COUNT * 2; ++i) {
+    table.AddColumn(AXIS_COLUMN_NAMES[i], NPY_DOUBLE);
+    }
+  const size_t action= table.AddColumn("action", NPY_INT32, true);
+  const size_t trace= table.AddColumn("trace", NPY_INT32, true);
+
+  AxisPositions::Positions absolute(COLUMN_COUNT * 2, INITIAL_NO_POSITION);
+  for (AxisPositions::sapm_const_iter cit= scsRows.begin(); cit != scsRows.end(); ++cit) {
+    const AxisPositions::SPosDetail &posDetail= cit->second;
+    table.AddInt64(riaAngle, cit->first);
+    table.AddDouble(coilAngle, posDetail.get<4>().get<8>());
+    const uint32_t flags= GetScsRowFlags(posDetail);
+    for (size_t i= 0; i < flagCount; ++i) {
+      table.AddBool(firstFlag + i, 0 != (flags & (1UL << i)));
+      }
+    table.AddInt32(hqpAdjust, static_cast<int32_t>(posDetail.get<5>().get<0>()));
+    table.AddInt32(layerAdjust, static_cast<int32_t>(posDetail.get<5>().get<1>()));
+    table.AddUInt32(selectedAxes, GetSelectedMask(posDetail));
+    table.AddDouble(selectedDistance, posDetail.get<3>().get<0>());
+    PositionResolver::ApplyRow(posDetail, absolute);
+    for (size_t i= 0; i < absolute.size(); ++i) {
+      table.AddDouble(firstAxis + i, absolute[i]);
+      }
+    // move summary, the same as the action description in the table
+    const std::string &logicTrace= posDetail.get<4>().get<0>();
+    const size_t msPos= logicTrace.find(MS_TOKEN);
+    table.AddText(action, std::string::npos == msPos ? logicTrace : logicTrace.substr(msPos + 1));
+    table.AddText(trace, logicTrace);
+    table.EndRow();
+    }
+
+  std::string schema;
+  const long status= table.Close(schema);
+  schemas_.push_back(schema);
+  return status;
+  }
+
+long ColumnarExport::ExportEvents(const EventMap::EventMapTyp &events) {
+  // return value indicates success or error
+  Metrics::ScopedTimer timer("export.events");
+  Table table(prefix_, "events");
+  const size_t angle= table.AddColumn("angle", NPY_DOUBLE);
+  const size_t eventId= table.AddColumn("event_id", NPY_INT32);
+  const size_t trace= table.AddColumn("trace", NPY_INT32, true);
+
+  for (EventMap::em_const_iter cit= events.begin(); cit != events.end(); ++cit) {
+    table.AddDouble(angle, cit->first);
+    table.AddInt32(eventId, static_cast<int32_t>(cit->second.get<0>()));
+    table.AddText(trace, cit->second.get<1>());
+    table.EndRow();
+    }
+
+  std::string schema;
+  const long status= table.Close(schema);
+  schemas_.push_back(schema);
+  return status;
+  }
+
+long ColumnarExport::WriteSchema() const {
+  // return value indicates success or error
+  const std::string fileName= prefix_ + ".schema.json";
+  std::ofstream file(fileName.c_str(), std::ios::trunc);
+  file << "{" << std::endl << "  \"format\": \"npy\"," << std::endl << "  \"tables\": [";
+  for (size_t i= 0; i < schemas_.size(); ++i) {
+    file << (0 == i ? "" : ",") << std::endl << schemas_[i];
+    }
+  file << std::endl << "  ]" << std::endl << "}" << std::endl;
+  if (!file) {
+    std::cout << "Error writing the export schema " << fileName << "." << std::endl;
+    return RTN_ERROR;
+    }
+  return RTN_NO_ERROR;
+  }
+
+} // namespace gaScsData
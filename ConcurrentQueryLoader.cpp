@@ -0,0 +1,147 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: ConcurrentQueryLoader.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Runs a list of independent SELECT stored procedures at the same time,
+ *            each on its own thread and its own connection.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  functional
+ *                  thread
+ *                  chrono
+ *                  SQLAPI.h
+ *                  Boost Non-copyable
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <thread>
+#include <chrono>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "ConcurrentQueryLoader.hpp"
+#include "Metrics.hpp"
+#include "TraceRecorder.hpp"
+
+namespace gaScsData {
+
+// ctors and dtor
+ConcurrentQueryLoader::ConcurrentQueryLoader() :
+    serverText_(DB_SERVER_NAME + "@" + DB_DATABASE_NAME),
+    errorText_("") { }
+
+ConcurrentQueryLoader::~ConcurrentQueryLoader() { }
+
+void ConcurrentQueryLoader::AddQuery(const std::string &sprocName, FetchFunctionTyp fetchFunction, const std::string &prefetchRows) {
+  QueryTask task;
+  task.sprocName= sprocName;
+  task.fetchFunction= fetchFunction;
+  task.prefetchRows= prefetchRows;
+  task.status= RTN_NO_RESULTS; // not run yet
+  task.errorText= "";
+  task.elapsedMs= 0.0;
+  tasks_.push_back(task);
+  }
+
+long ConcurrentQueryLoader::Run() {
+  // return value indicates success or error
+  errorText_= "";
+
+  // start a thread for each query
+  // The tasks_ vector is not resized while the threads run, so the task references stay valid.
+  std::vector<std::thread> workers;
+  workers.reserve(tasks_.size());
+  for (size_t i= 0; i < tasks_.size(); ++i) {
+    workers.push_back(std::thread(&ConcurrentQueryLoader::RunQuery, this, std::ref(tasks_[i])));
+    }
+  // wait for all of them
+  for (size_t i= 0; i < workers.size(); ++i) {
+    workers[i].join();
+    }
+
+  // report the results after the join so the output of the threads is not interleaved
+  long rtnValue= RTN_NO_ERROR;
+  for (size_t i= 0; i < tasks_.size(); ++i) {
+    std::cout << "  " << tasks_[i].sprocName << ": " << static_cast<long>(tasks_[i].elapsedMs) << " ms";
+    if (RTN_NO_ERROR == tasks_[i].status) {
+      std::cout << std::endl;
+      }
+    else {
+      std::cout << " -- error: " << tasks_[i].errorText << std::endl;
+      errorText_+= tasks_[i].sprocName + ": " + tasks_[i].errorText + "\n";
+      rtnValue= RTN_ERROR;
+      }
+    }
+  return rtnValue;
+  }
+
+// accessor functions
+std::string ConcurrentQueryLoader::GetErrorText() const { return errorText_; }
+size_t ConcurrentQueryLoader::GetQueryCount() const { return tasks_.size(); }
+
+// private helper functions
+
+// connect, execute, fetch, and disconnect for one query. Runs on a worker thread.
+void ConcurrentQueryLoader::RunQuery(QueryTask &task) const {
+  std::chrono::steady_clock::time_point start= std::chrono::steady_clock::now();
+
+  // each thread has its own connection and command objects
+  SAConnection connection;
+  SACommand command;
+  Metrics &metrics= Metrics::Instance();
+  const std::string metricName= "query." + task.sprocName;
+  TraceRecorder::Instance().SetThreadName(metricName);
+  try {
+    // use SQL server native client, ODBC API (same as the single connection classes)
+    {
+      Metrics::ScopedTimer timer(metricName + ".connect");
+      connection.setClient(SA_SQLServer_Client);
+      connection.setOption( "UseAPI" ) = "ODBC";
+      connection.Connect(serverText_.c_str(),     // server_name@database_name
+                         DB_USER_NAME.c_str(),   // user name
+                         DB_PASSWORD.c_str());   // password
+    }
+    command.setConnection(&connection);
+    if (!task.prefetchRows.empty())
+      command.setOption("PreFetchRows")= task.prefetchRows.c_str();
+    command.setCommandText(task.sprocName.c_str(), SA_CmdStoredProc);
+    {
+      Metrics::ScopedTimer timer("sproc." + task.sprocName, Metrics::TK_LATENCY);
+      command.Execute();
+    }
+    // fetch the results into the caller's container
+    {
+      Metrics::ScopedTimer timer(metricName + ".fetch");
+      task.status= task.fetchFunction(command, task.errorText);
+    }
+    {
+      Metrics::ScopedTimer timer(metricName + ".disconnect");
+      connection.Disconnect();
+    }
+    }
+  catch(SAException &ex) {
+    // get error message
+    task.errorText= (const char*)ex.ErrText();
+    // set status to indicate an error
+    task.status= RTN_ERROR;
+    }
+  catch(std::exception &ex) {
+    // an exception must not escape the thread
+    task.errorText= ex.what();
+    task.status= RTN_ERROR;
+    }
+
+  task.elapsedMs= std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  metrics.AddTime(metricName, task.elapsedMs);
+  if (RTN_NO_ERROR != task.status)
+    metrics.AddCount(metricName + ".errors");
+  }
+
+} // namespace gaScsData
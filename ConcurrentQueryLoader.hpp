@@ -0,0 +1,89 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: ConcurrentQueryLoader.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Runs a list of independent SELECT stored procedures at the same time.
+ *            Each query gets its own thread, and its own connection and command object,
+ *            since SQLAPI++ connections are not shared between threads.
+ *            The caller supplies a fetch function per query which is called (on the worker thread)
+ *            with the executed command, and is expected to read the result set into a container
+ *            that no other query touches. Run() waits for all of them, so the total time is the
+ *            slowest query instead of the sum of all of them.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  functional
+ *                  thread
+ *                  chrono
+ *                  SQLAPI.h
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_ConcurrentQueryLoader_H_
+#define GA_ConcurrentQueryLoader_H_
+
+// standard c/c++ libraries
+#include <functional>
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+
+namespace gaScsData {
+
+class ConcurrentQueryLoader : private boost::noncopyable {
+
+public:
+  // typedefs and enums
+
+    // Function called with the executed command to fetch the result set.
+    // The error text reference is where to put an error message. Return value indicates success or error.
+    // NOTE: Called on a worker thread. Only touch data that belongs to this one query.
+      typedef std::function<long(SACommand &command, std::string &errorText)> FetchFunctionTyp;
+
+  // ctors and dtor
+    ConcurrentQueryLoader();
+    ~ConcurrentQueryLoader();
+
+  // public member functions
+    // queue a query. prefetchRows sets the PreFetchRows option on the command (empty -- use the client default)
+    void AddQuery(const std::string &sprocName, FetchFunctionTyp fetchFunction, const std::string &prefetchRows = "");
+    // run all the queued queries concurrently, and wait for them all to finish.
+    // return value indicates success or error. Error if any query had an error.
+    long Run();
+
+  // accessors
+    std::string GetErrorText() const;  // error text of the queries that failed, one per line
+    size_t GetQueryCount() const;
+
+  private:
+    // Everything needed to run one query, and the results of running it.
+    // Each worker thread only touches its own task.
+    struct QueryTask {
+      std::string sprocName;
+      FetchFunctionTyp fetchFunction;
+      std::string prefetchRows;
+      long status;
+      std::string errorText;
+      double elapsedMs; // connect, execute, and fetch time
+      };
+
+    // helper functions
+      // connect, execute, fetch, and disconnect for one query. Runs on a worker thread.
+      void RunQuery(QueryTask &task) const;
+
+    // member variables
+      std::vector<QueryTask> tasks_;
+
+      // specify server and db string
+      std::string serverText_;
+      // error text
+      std::string errorText_;
+};
+
+} // namespace gaScsData
+#endif // GA_ConcurrentQueryLoader_H_
+
@@ -0,0 +1,113 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: DbSchemaCheck.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Checks the db has the procedures and parameters the table writes of this version use.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  SQLAPI.h
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "DbSchemaCheck.hpp"
+
+namespace gaScsData {
+
+// ctors and dtor
+DbSchemaCheck::DbSchemaCheck() :
+    serverText_(DB_SERVER_NAME + "@" + DB_DATABASE_NAME) {
+  // use SQL server native client, with the ODBC API
+  dbConnection_.setClient(SA_SQLServer_Client);
+  dbConnection_.setOption("UseAPI")= "ODBC";
+  dbCommand_.setConnection(&dbConnection_);
+  }
+
+DbSchemaCheck::~DbSchemaCheck() { }
+
+// public member functions
+long DbSchemaCheck::Check() {
+  // return value indicates success or error, or RTN_NO_RESULTS if a procedure or parameter is missing
+  // <procedure, parameter>. An empty parameter is the procedure itself.
+  const std::pair<std::string, std::string> required[]= {
+    std::make_pair(SPNAME_INSERT_WRITE_BATCH, std::string()),
+    std::make_pair(SPNAME_SELECT_WRITE_BATCHES, std::string()),
+    std::make_pair(SPNAME_INSERT_GENERATION, std::string()),
+    std::make_pair(SPNAME_SELECT_GENERATION, std::string()),
+    std::make_pair(SPNAME_DELETE_GENERATION, std::string()),
+    std::make_pair(SPNAME_INSERT_ALL_SCS_POS, WJ_SEQUENCE_PARAM),
+    std::make_pair(SPNAME_INSERT_SEL_SCS_POS, WJ_SEQUENCE_PARAM),
+    std::make_pair(SPNAME_INSERT_SEL_ADJ_ABS_SCS_POS, WJ_SEQUENCE_PARAM),
+    std::make_pair(SPNAME_INSERT_EVENTLIST, WJ_SEQUENCE_PARAM)
+    };
+  missing_.clear();
+  errorText_.clear();
+  long rtnValue= RTN_NO_ERROR;
+  try {
+    dbConnection_.Connect(serverText_.c_str(), DB_USER_NAME.c_str(), DB_PASSWORD.c_str());
+    for (size_t i= 0; i < sizeof(required) / sizeof(required[0]); ++i) {
+      if (!IsInDb(required[i].first, required[i].second))
+        missing_.push_back(required[i].second.empty() ? required[i].first : required[i].first + " @" + required[i].second);
+      }
+    dbConnection_.Disconnect();
+    if (!missing_.empty())
+      rtnValue= RTN_NO_RESULTS;
+    }
+  catch (SAException &ex) {
+    errorText_= (const char*)ex.ErrText();
+    std::cout << errorText_ << std::endl;
+    rtnValue= RTN_ERROR;
+    }
+  return rtnValue;
+  }
+
+const std::vector<std::string>& DbSchemaCheck::GetMissing() const {
+  return missing_;
+  }
+
+const std::string& DbSchemaCheck::GetErrorText() const {
+  return errorText_;
+  }
+
+std::string DbSchemaCheck::GetMessage() const {
+  std::string message;
+  if (!errorText_.empty())
+    message= "Can't check the db for the procedures the table writes use: " + errorText_;
+  else if (!missing_.empty()) {
+    message= "The db is not updated for this version. Missing:";
+    for (size_t i= 0; i < missing_.size(); ++i) {
+      message+= " " + missing_[i] + (i + 1 < missing_.size() ? "," : ".");
+      }
+    message+= " Update the db before running this version (see README.md). Nothing was written.";
+    }
+  return message;
+  }
+
+// private helper functions
+bool DbSchemaCheck::IsInDb(const std::string &procName, const std::string &paramName) {
+  // throws SAException on a db error
+  if (paramName.empty()) {
+    dbCommand_.setCommandText(SQL_SELECT_PROC_COUNT.c_str(), SA_CmdSQLStmt);
+    dbCommand_.Param(SCHEMA_PROC_PARAM.c_str()).setAsString()= procName.c_str();
+    }
+  else {
+    dbCommand_.setCommandText(SQL_SELECT_PROC_PARAM_COUNT.c_str(), SA_CmdSQLStmt);
+    dbCommand_.Param(SCHEMA_PROC_PARAM.c_str()).setAsString()= procName.c_str();
+    dbCommand_.Param(SCHEMA_PARAM_PARAM.c_str()).setAsString()= ("@" + paramName).c_str();
+    }
+  dbCommand_.Execute();
+  long count= 0;
+  while (dbCommand_.FetchNext()) {
+    count= dbCommand_.Field(1).asLong();
+    }
+  return 0 < count;
+  }
+
+} // namespace gaScsData
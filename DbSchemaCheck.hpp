@@ -0,0 +1,67 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: DbSchemaCheck.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Checks the db has the procedures and parameters the table writes of this version use, before
+ *            anything is written. The journaled, multi-connection writes (WriteJournal class) need the write
+ *            batch procedures and the sequenceNum parameter of the insert procedures, and every write needs the
+ *            generation procedures (TableGeneration class). A db without them fails part way through a write,
+ *            so the run stops at the start instead, and names what is missing. See README.md for the order the
+ *            db and the program are updated in.
+ *
+ *            The views ordering by sequenceNum can't be checked this way, so they are part of the update order.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  SQLAPI.h
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_DbSchemaCheck_H_
+#define GA_DbSchemaCheck_H_
+
+// standard c/c++ libraries
+#include <string>
+#include <vector>
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+
+namespace gaScsData {
+
+class DbSchemaCheck : private boost::noncopyable {
+
+public:
+  // ctors and dtor
+    DbSchemaCheck();
+    ~DbSchemaCheck();
+
+  // public member functions
+    // Connect, look for each procedure and parameter, and disconnect.
+    // Return value indicates success, RTN_ERROR if the db can't be read, or RTN_NO_RESULTS if any are missing.
+    long Check();
+    // "<procedure>" or "<procedure> @<parameter>", for each one missing
+    const std::vector<std::string>& GetMissing() const;
+    const std::string& GetErrorText() const;
+    // what the last Check() found, for the console. Empty if everything is there.
+    std::string GetMessage() const;
+
+  private:
+    // helper functions
+      // true if the procedure has the parameter, or exists if the parameter is empty
+      bool IsInDb(const std::string &procName, const std::string &paramName);
+
+    // member variables
+      SAConnection dbConnection_;
+      SACommand dbCommand_;
+      std::string serverText_;  // server_name@database_name
+      std::vector<std::string> missing_;
+      std::string errorText_;
+};
+
+} // namespace gaScsData
+#endif // GA_DbSchemaCheck_H_
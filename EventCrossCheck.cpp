@@ -0,0 +1,285 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: EventCrossCheck.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Checks the event map against the SCS position map, in one merge of the two.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  chrono
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <chrono>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "EventCrossCheck.hpp"
+#include "TraceRecorder.hpp"
+
+namespace gaScsData {
+
+static const char *ISSUE_TYPE_NAMES[]= { "missing_event", "missing_row", "duplicate", "wrong_event", "out_of_order" };
+static_assert(sizeof(ISSUE_TYPE_NAMES) / sizeof(ISSUE_TYPE_NAMES[0]) == EventCrossCheck::ISSUE_NUM_OF_TYPES,
+              "one name per issue type");
+
+static std::string ToString(long value) {
+  return std::to_string(static_cast<long long>(value));
+  }
+
+static bool IsLayerStartEvent(long eventId) {
+  return EventMap::EID_LAYER_INCREMENT == eventId || EventMap::EID_MOVE_ECHAIN == eventId ||
+         EventMap::EID_REMOVE_INNER_STRUTS == eventId;
+  }
+
+static bool IsEndLayerEvent(long eventId) {
+  return EventMap::EID_END_ODD_LAYER == eventId || EventMap::EID_END_EVEN_LAYER == eventId;
+  }
+
+// end of layer event after the start of the layer. It ends the layer before it.
+static long GetEndLayerEventId(long startedLayer) {
+  return 1 == startedLayer % 2 ? EventMap::EID_END_EVEN_LAYER : EventMap::EID_END_ODD_LAYER;
+  }
+
+// ctors and dtor
+EventCrossCheck::EventCrossCheck() :
+    layerStarts_(0),
+    elapsedMs_(0),
+    openLayer_(0),
+    openAngle_(0),
+    isEndMissing_(false) {
+  std::fill(counts_, counts_ + ISSUE_NUM_OF_TYPES, 0);
+  }
+
+EventCrossCheck::~EventCrossCheck() { }
+
+// accessors
+size_t EventCrossCheck::GetIssueCount() const {
+  size_t count= 0;
+  for (long type= 0; type < ISSUE_NUM_OF_TYPES; ++type) {
+    count+= counts_[type];
+    }
+  return count;
+  }
+
+size_t EventCrossCheck::GetIssueCount(IssueTypes type) const {
+  return counts_[type];
+  }
+
+const EventCrossCheck::issue_list& EventCrossCheck::GetIssues() const {
+  return issues_;
+  }
+
+size_t EventCrossCheck::GetLayerStartCount() const {
+  return layerStarts_;
+  }
+
+// public member functions
+long EventCrossCheck::Check(const AxisPositions::ScsAxesPositionMap &scsRows, const CoilMap &coilMap,
+                            const EventMap::EventMapTyp &events) {
+  // return value is RTN_NO_ERROR if there are no issues
+  const std::chrono::steady_clock::time_point start= std::chrono::steady_clock::now();
+  issues_.clear();
+  std::fill(counts_, counts_ + ISSUE_NUM_OF_TYPES, 0);
+  layerStarts_= 0;
+  openLayer_= 0;
+  openAngle_= 0;
+  endEvents_.clear();
+  isEndMissing_= false;
+
+  // merge the rows and the events by angle
+  EventMap::em_const_iter event= events.begin();
+  std::vector<long> rowEventIds;
+  for (AxisPositions::sapm_const_iter row= scsRows.begin(); row != scsRows.end(); ++row) {
+    const AxisPositions::PosAttributes &attributes= row->second.get<4>();
+    if (!attributes.get<4>() && !attributes.get<5>())
+      continue;  // not a new hqp or new layer row. Events at its angle are checked with the events after it.
+    const double rowAngle= static_cast<double>(row->first);
+
+    // events before the row
+    for ( ; event != events.end() && event->first < rowAngle; ++event) {
+      CheckEvent(event->first, event->second.get<0>());
+      }
+    // events at the row
+    rowEventIds.clear();
+    for ( ; event != events.end() && event->first == rowAngle; ++event) {
+      rowEventIds.push_back(event->second.get<0>());
+      }
+    const long layer= coilMap.GetLayerLb(attributes.get<8>()) + row->second.get<5>().get<1>();
+    StartLayer(rowAngle, layer, attributes.get<4>(), attributes.get<5>(), rowEventIds);
+    }
+  // events after the last layer start
+  for ( ; event != events.end(); ++event) {
+    CheckEvent(event->first, event->second.get<0>());
+    }
+  CloseLayer();
+  if (isEndMissing_) {
+    AddIssue(endMissing_.type, endMissing_.angle, endMissing_.eventId, endMissing_.layer, endMissing_.detail);
+    isEndMissing_= false;
+    }
+
+  // a missing end of layer is found at the layer start after it, so sort
+  std::stable_sort(issues_.begin(), issues_.end(), [](const IssueTyp &a, const IssueTyp &b) { return a.angle < b.angle; });
+  if (CROSS_CHECK_MAX_REPORTED < issues_.size())
+    issues_.resize(CROSS_CHECK_MAX_REPORTED);
+
+  elapsedMs_= std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  return 0 == GetIssueCount() ? RTN_NO_ERROR : RTN_ERROR;
+  }
+
+std::string EventCrossCheck::ToJson() const {
+  std::ostringstream json;
+  json << std::fixed;
+  json << "{" << std::endl
+       << "  \"layer_starts\": " << layerStarts_ << ", \"elapsed_ms\": " << elapsedMs_ << "," << std::endl
+       << "  \"issue_count\": " << GetIssueCount() << "," << std::endl
+       << "  \"counts\": {";
+  for (long type= 0; type < ISSUE_NUM_OF_TYPES; ++type) {
+    json << (0 == type ? " " : ", ") << "\"" << ISSUE_TYPE_NAMES[type] << "\": " << counts_[type];
+    }
+  json << " }," << std::endl
+       << "  \"issues\": [";
+  for (size_t i= 0; i < issues_.size(); ++i) {
+    const IssueTyp &issue= issues_[i];
+    json << (0 == i ? "" : ",") << std::endl
+         << "    { \"type\": \"" << ISSUE_TYPE_NAMES[issue.type] << "\", \"angle\": " << issue.angle
+         << ", \"event_id\": " << issue.eventId << ", \"layer\": " << issue.layer
+         << ", \"detail\": \"" << TraceRecorder::JsonEscape(issue.detail) << "\" }";
+    }
+  json << std::endl << "  ]" << std::endl << "}" << std::endl;
+  return json.str();
+  }
+
+long EventCrossCheck::WriteJson(const std::string &fileName) const {
+  // return value indicates success or error
+  std::ofstream output(fileName.c_str());
+  output << ToJson();
+  output.close();
+  if (!output) {
+    std::cout << "Error writing the cross check report to " << fileName << std::endl;
+    return RTN_ERROR;
+    }
+  return RTN_NO_ERROR;
+  }
+
+const char* EventCrossCheck::GetTypeName(IssueTypes type) {
+  return ISSUE_TYPE_NAMES[type];
+  }
+
+// private helper functions
+void EventCrossCheck::CheckEvent(double angle, long eventId) {
+  if (EventMap::EID_HQP_LOAD == eventId)
+    AddIssue(ISSUE_MISSING_ROW, angle, eventId, openLayer_, "HQP load event with no new hqp row at its angle");
+  else if (IsLayerStartEvent(eventId))
+    AddIssue(ISSUE_MISSING_ROW, angle, eventId, openLayer_, "layer start event with no new layer row at its angle");
+  else if (IsEndLayerEvent(eventId)) {
+    if (0 == openLayer_)
+      AddIssue(ISSUE_OUT_OF_ORDER, angle, eventId, 0, "end of layer event before the first layer start");
+    else
+      endEvents_.push_back(std::make_pair(angle, eventId));
+    }
+  }
+
+void EventCrossCheck::StartLayer(double angle, long layer, bool isNewHqp, bool isNewLayer, const std::vector<long> &eventIds) {
+  ++layerStarts_;
+  // end of layer events at the angle of the start are after it, so the open layer is closed first
+  CloseLayer();
+  if (0 != openLayer_) {
+    if (layer == openLayer_)
+      AddIssue(ISSUE_DUPLICATE, angle, 0, layer, "layer " + ToString(layer) + " starts again");
+    else if (layer < openLayer_)
+      AddIssue(ISSUE_OUT_OF_ORDER, angle, 0, layer, "layer " + ToString(layer) + " starts after layer " + ToString(openLayer_));
+    else if (layer > openLayer_ + 1)
+      AddIssue(ISSUE_MISSING_ROW, angle, 0, openLayer_ + 1, "no start row for layer " + ToString(openLayer_ + 1));
+    }
+  openLayer_= layer;
+  openAngle_= angle;
+  endEvents_.clear();
+
+  // events at the row
+  long hqpLoads= 0;
+  long layerEvents= 0;
+  const long expectedId= EventMap::GetLayerStartEventId(layer);
+  for (std::vector<long>::const_iterator cit= eventIds.begin(); cit != eventIds.end(); ++cit) {
+    if (EventMap::EID_HQP_LOAD == *cit) {
+      if (!isNewHqp)
+        AddIssue(ISSUE_MISSING_ROW, angle, *cit, layer, "HQP load event at a row that is not a new hqp");
+      else if (0 < hqpLoads++)
+        AddIssue(ISSUE_DUPLICATE, angle, *cit, layer, "more than one HQP load event");
+      }
+    else if (IsLayerStartEvent(*cit)) {
+      if (!isNewLayer)
+        AddIssue(ISSUE_MISSING_ROW, angle, *cit, layer, "layer start event at a row that is not a new layer");
+      else if (0 < layerEvents++)
+        AddIssue(ISSUE_DUPLICATE, angle, *cit, layer, "more than one layer start event");
+      else if (expectedId != *cit)
+        AddIssue(ISSUE_WRONG_EVENT, angle, *cit, layer, "layer " + ToString(layer) + " should start with event " + ToString(expectedId));
+      }
+    else if (IsEndLayerEvent(*cit))
+      endEvents_.push_back(std::make_pair(angle, *cit));
+    }
+  if (isNewHqp && 0 == hqpLoads)
+    AddIssue(ISSUE_MISSING_EVENT, angle, EventMap::EID_HQP_LOAD, layer, "new hqp row with no HQP load event");
+  if (isNewLayer && 0 == layerEvents)
+    AddIssue(ISSUE_MISSING_EVENT, angle, expectedId, layer, "new layer row with no layer start event");
+  }
+
+void EventCrossCheck::CloseLayer() {
+  if (0 == openLayer_)
+    return;
+  const long expectedId= GetEndLayerEventId(openLayer_);
+  size_t first= 0;
+  if (isEndMissing_) {
+    // The layer before this one had no end of layer event. If this one has two, the first is the late one.
+    if (2 <= endEvents_.size()) {
+      AddIssue(ISSUE_OUT_OF_ORDER, endEvents_[0].first, endEvents_[0].second, endMissing_.layer,
+               "the end of layer event after the start of layer " + ToString(endMissing_.layer) + " is after the next layer start");
+      first= 1;
+      }
+    else
+      AddIssue(endMissing_.type, endMissing_.angle, endMissing_.eventId, endMissing_.layer, endMissing_.detail);
+    isEndMissing_= false;
+    }
+
+  if (endEvents_.size() == first) {
+    // reported when the next layer is closed, unless its first end of layer event is this one
+    isEndMissing_= true;
+    endMissing_.type= ISSUE_MISSING_EVENT;
+    endMissing_.angle= openAngle_;
+    endMissing_.eventId= expectedId;
+    endMissing_.layer= openLayer_;
+    endMissing_.detail= "no end of layer event after the start of layer " + ToString(openLayer_) + ", before the next layer start";
+    }
+  else {
+    if (expectedId != endEvents_[first].second)
+      AddIssue(ISSUE_WRONG_EVENT, endEvents_[first].first, endEvents_[first].second, openLayer_,
+               "end of layer event after the start of layer " + ToString(openLayer_) + " should be " + ToString(expectedId));
+    for (size_t i= first + 1; i < endEvents_.size(); ++i) {
+      AddIssue(ISSUE_DUPLICATE, endEvents_[i].first, endEvents_[i].second, openLayer_,
+               "more than one end of layer event after the start of layer " + ToString(openLayer_));
+      }
+    }
+  endEvents_.clear();
+  }
+
+void EventCrossCheck::AddIssue(IssueTypes type, double angle, long eventId, long layer, const std::string &detail) {
+  ++counts_[type];
+  IssueTyp issue;
+  issue.type= type;
+  issue.angle= angle;
+  issue.eventId= eventId;
+  issue.layer= layer;
+  issue.detail= detail;
+  issues_.push_back(issue);
+  }
+
+} // namespace gaScsData
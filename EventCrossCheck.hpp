@@ -0,0 +1,120 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: EventCrossCheck.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Checks that the event map agrees with the SCS position map, in one merge of the two (both are
+ *            sorted by angle), so a bad regeneration is found before the coil is wound.
+ *            Relationships checked:
+ *              new hqp rows      -- one EID_HQP_LOAD event at the RIA angle of each isNewHqp row, and none elsewhere
+ *              new layer rows    -- one layer start event at the RIA angle of each isNewLayer row, and none elsewhere.
+ *                                   The event is EventMap::GetLayerStartEventId() of the layer (EID_LAYER_INCREMENT,
+ *                                   EID_MOVE_ECHAIN, or EID_REMOVE_INNER_STRUTS).
+ *              layer starts      -- the new hqp and new layer rows start layers 1, 2, 3, ... in order
+ *              end of layer      -- one end of layer event after each layer start, before the next layer start.
+ *                                   The event is at the joggle the new layer starts at, and ends the layer before
+ *                                   it, so it is EID_END_EVEN_LAYER after an odd layer start, and EID_END_ODD_LAYER
+ *                                   after an even layer start (as EventMap::isEventEndOddLayer()).
+ *            The layer of a row is the coil map layer at its coil angle plus its layer adjust, as
+ *            AxisPositions::GetStartAngleSets().
+ *
+ *            Issues:
+ *              missing_event     -- a row has no event it needs, or a layer has no end of layer event
+ *              missing_row       -- an event has no row, or a layer has no start row
+ *              duplicate         -- more than one event for a row or a layer, or a layer started twice
+ *              wrong_event       -- a different event than the one the layer needs
+ *              out_of_order      -- an end of layer event after the next layer start (or before the first one),
+ *                                   or a layer start before the layer it follows
+ *            Issues are listed by angle, the first CROSS_CHECK_MAX_REPORTED of them. All are counted.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_EventCrossCheck_H_
+#define GA_EventCrossCheck_H_
+
+// standard c/c++ libraries
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+#include "CoilMap.hpp"
+#include "AxisPositions.hpp"
+#include "EventMap.hpp"
+
+namespace gaScsData {
+
+class EventCrossCheck : private boost::noncopyable {
+
+public:
+  // typedefs and enums
+    enum IssueTypes {
+      ISSUE_MISSING_EVENT= 0,
+      ISSUE_MISSING_ROW,
+      ISSUE_DUPLICATE,
+      ISSUE_WRONG_EVENT,
+      ISSUE_OUT_OF_ORDER,
+      ISSUE_NUM_OF_TYPES };
+
+    struct IssueTyp {
+      IssueTypes type;
+      double angle;         // RIA angle of the row or event
+      long eventId;         // 0 if the issue is about a row
+      long layer;           // 0 if not known
+      std::string detail;
+      };
+    typedef std::vector<IssueTyp> issue_list;
+
+  // ctors and dtor
+    EventCrossCheck();
+    ~EventCrossCheck();
+
+  // accessors
+    size_t GetIssueCount() const;
+    size_t GetIssueCount(IssueTypes type) const;
+    // the first CROSS_CHECK_MAX_REPORTED issues, by angle
+    const issue_list& GetIssues() const;
+    // new hqp and new layer rows checked
+    size_t GetLayerStartCount() const;
+
+  // public member functions
+    // Check the events against the rows. coilMap is the coil map the rows were calculated from.
+    // Return value is RTN_NO_ERROR if there are no issues, RTN_ERROR if there are.
+    long Check(const AxisPositions::ScsAxesPositionMap &scsRows, const CoilMap &coilMap, const EventMap::EventMapTyp &events);
+    // report as a JSON document
+    std::string ToJson() const;
+    // write ToJson() to the file. Return value indicates success or error
+    long WriteJson(const std::string &fileName) const;
+
+    // type name used in the report
+    static const char* GetTypeName(IssueTypes type);
+
+  private:
+    // an event of the merge, that is not at a layer start row
+    void CheckEvent(double angle, long eventId);
+    // a new hqp or new layer row, and the events at its angle
+    void StartLayer(double angle, long layer, bool isNewHqp, bool isNewLayer, const std::vector<long> &eventIds);
+    // check the end of layer events of the open layer
+    void CloseLayer();
+    void AddIssue(IssueTypes type, double angle, long eventId, long layer, const std::string &detail);
+
+    // member variables
+      issue_list issues_;
+      size_t counts_[ISSUE_NUM_OF_TYPES];
+      size_t layerStarts_;
+      double elapsedMs_;
+
+      // merge state
+      long openLayer_;      // layer of the last layer start row, 0 before the first
+      double openAngle_;    // RIA angle of that row
+      std::vector<std::pair<double, long> > endEvents_;  // end of layer events since it started <angle, event id>
+      bool isEndMissing_;   // the layer before the open one has no end of layer event (yet)
+      IssueTyp endMissing_;
+};
+
+} // namespace gaScsData
+#endif // GA_EventCrossCheck_H_
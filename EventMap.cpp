@@ -15,15 +15,47 @@
 // header file
 #include "gaScsDataConstants.hpp"
 #include "EventMap.hpp"
+#include "Metrics.hpp"
+#include "TraceRecorder.hpp"
+#include "ProgressReporter.hpp"
+#include "Checksum.hpp"
+#include "ConcurrentQueryLoader.hpp"
+#include "WriteJournal.hpp"
+#include "EventCrossCheck.hpp"
 
 namespace gaScsData {
 
 // ctors and dtor
   EventMap::EventMap() : 
-      coilMap_(),
+      ownCoilMap_(),
+      coilMap_(ownCoilMap_),
+      isLocalBackend_(false),
+      isSkipUnchanged_(false),
+      writerConnections_(DB_WRITER_CONNECTIONS),
+      crossCheck_(nullptr),
+      crossCheckRows_(nullptr),
       serverText_(DB_SERVER_NAME + "@" + DB_DATABASE_NAME),
       errorText_("") {
+    Initialize();
+    }
+
+  EventMap::EventMap(const CoilMap &sharedCoilMap) :
+      ownCoilMap_(),
+      coilMap_(sharedCoilMap),
+      isLocalBackend_(false),
+      isSkipUnchanged_(false),
+      writerConnections_(DB_WRITER_CONNECTIONS),
+      crossCheck_(nullptr),
+      crossCheckRows_(nullptr),
+      serverText_(DB_SERVER_NAME + "@" + DB_DATABASE_NAME),
+      errorText_("") {
+    Initialize();
+    }
 
+  EventMap::~EventMap() { }
+
+  // ctor initialization common to both ctors
+  void EventMap::Initialize() {
     // reserve space for the number of Hqp start angles
     hqpStartSet_.reserve(MAX_NUM_OF_HQP_START_ANGLES);
 
@@ -41,9 +73,124 @@ namespace gaScsData {
 
   }
 
-  EventMap::~EventMap() { }
-
 // public accessors
+  // number of events in the event map
+  size_t EventMap::GetEventCount() const {
+    return eventMap_.size();
+    }
+
+  const EventMap::EventMapTyp& EventMap::GetEventMap() const {
+    return eventMap_;
+    }
+
+  const CoilMap& EventMap::GetCoilMap() const {
+    return coilMap_;
+    }
+
+  // record event inserts in memory (true) or write them to the db (false)
+  void EventMap::SetLocalBackend(bool isLocalBackend) {
+    isLocalBackend_= isLocalBackend;
+    localRows_.clear();
+    }
+
+  // number of event inserts recorded by the local backend
+  size_t EventMap::GetLocalRowCount() const {
+    return localRows_.size();
+    }
+
+  // checksum of the event map, in angle order: angle and event id.
+  // The logic trace is diagnostic only, and is not included.
+  std::string EventMap::GetEventChecksum() const {
+    Checksum checksum;
+    for (em_const_iter emci= eventMap_.begin(); emci != eventMap_.end(); ++emci)
+      AddRowToChecksum(checksum, emci->first, emci->second);
+    return checksum.ToHex();
+    }
+
+  void EventMap::AddRowToChecksum(Checksum &checksum, double angle, const EventDataTyp &eventData) {
+    checksum.Add(angle);
+    checksum.Add(eventData.get<0>());
+    }
+
+  uint64_t EventMap::GetInputHash() const {
+    Checksum checksum;
+    checksum.Add(GENERATOR_VERSION);
+    coilMap_.AddToChecksum(checksum);
+    params_.AddToChecksum(checksum);
+    checksum.Add(static_cast<long>(hqpStartSet_.size()));
+    for (as_cit cit= hqpStartSet_.begin(); cit != hqpStartSet_.end(); ++cit) {
+      checksum.Add(cit->first);
+      checksum.Add(cit->second);
+      }
+    checksum.Add(static_cast<long>(layerStartSet_.size()));
+    for (as_cit cit= layerStartSet_.begin(); cit != layerStartSet_.end(); ++cit) {
+      checksum.Add(cit->first);
+      checksum.Add(cit->second);
+      }
+    return checksum.GetValue();
+    }
+
+  void EventMap::SetSkipUnchanged(bool skipUnchanged) {
+    isSkipUnchanged_= skipUnchanged;
+    }
+
+  void EventMap::SetWriterConnections(size_t connections) {
+    writerConnections_= 0 == connections ? 1 : connections;
+    }
+
+  // tunable parameters
+  void EventMap::SetGenerationParams(const GenerationParams &params) {
+    params_= params;
+    }
+
+  const GenerationParams& EventMap::GetGenerationParams() const {
+    return params_;
+    }
+
+  // check of the events against the SCS rows, before they are written
+  void EventMap::SetCrossCheck(EventCrossCheck *crossCheck, const AxisPositions::ScsAxesPositionMap *scsRows) {
+    crossCheck_= crossCheck;
+    crossCheckRows_= scsRows;
+    }
+
+  // coil geometry of the own coil map
+  long EventMap::SetCoilGeometry(const CoilGeometry &geometry) {
+    if (&coilMap_ != &ownCoilMap_) {
+      std::cout << "The coil map is shared, and its geometry can't be set here." << std::endl;
+      return RTN_ERROR;
+      }
+    return ownCoilMap_.SetGeometry(geometry);
+    }
+
+  // spacing between event angles
+  long EventMap::GetEventSpacing(double &minSpacing, double &meanSpacing) const {
+    minSpacing= 0.0;
+    meanSpacing= 0.0;
+    size_t spacingCount= 0;
+    for (em_const_iter emci= eventMap_.begin(); emci != eventMap_.end(); ) {
+      // next distinct angle
+      em_const_iter next= eventMap_.upper_bound(emci->first);
+      if (next == eventMap_.end())
+        break;
+      const double spacing= next->first - emci->first;
+      if (0 == spacingCount || spacing < minSpacing)
+        minSpacing= spacing;
+      ++spacingCount;
+      emci= next;
+      }
+    if (0 == spacingCount)
+      return RTN_NO_RESULTS;
+    meanSpacing= (eventMap_.rbegin()->first - eventMap_.begin()->first) / static_cast<double>(spacingCount);
+    return RTN_NO_ERROR;
+    }
+
+  long EventMap::GetLayerStartEventId(long layer) {
+    if (37 == layer)
+      return EID_MOVE_ECHAIN;
+    else if (38 == layer)
+      return EID_REMOVE_INNER_STRUTS;
+    return EID_LAYER_INCREMENT;
+    }
 
 // public methods
   long EventMap::GenerateEventMapTable() {
@@ -53,110 +200,170 @@ namespace gaScsData {
     long opStatus = 0;  // operation status
     long disconnectStatus = 0;
 
-    // connect to db
-    std::cout << "Connect to Db." << std::endl;
-    connectStatus= DbConnect();
-    if (RTN_NO_ERROR == connectStatus)
-      std::cout << "Connection successful." << std::endl;
-    else
-      std::cout << "Connection error!!" << std::endl;
-
-    // if connect status is okay
-      // 1) populate the coil map
-      // 2) Get the hqp start angles and make a set of them
-      // 3) Get the layer start angles make a set of them
-      // 4) Iterate thru the coil map and calculate the rest of the event instances -- populate the Event Map
-      // 5) The event map is now complete for static events.
-      //    Iterate thru the event map, and insert the events into the DB
-    if (RTN_NO_ERROR == connectStatus) {
-      // if no error (DB connect was sucessful)
-      std::cout << "Populate coil map." << std::endl;
-      opStatus= coilMap_.PopulateCoilMap();
+    if (&coilMap_ != &ownCoilMap_) {
+      std::cout << "The coil map is shared, and can't be populated here." << std::endl;
+      return RTN_ERROR;
       }
 
-    if (RTN_NO_ERROR == opStatus)
-      std::cout << "Populate Coil Map successful." << std::endl;
-    else
-      std::cout << "Populate Coil Map error!!" << std::endl;
+    // 1) populate the coil map
+    // 2) Get the hqp start angles and make a set of them
+    // 3) Get the layer start angles make a set of them
+    // These are independent queries, so run them at the same time, each on its own connection.
+    // The time to get them is the slowest query, instead of the sum of all of them.
+    std::cout << "Populate coil map, get HQP and Layer Start Angles." << std::endl;
+    hqpStartSet_.clear();
+    layerStartSet_.clear();
+    ConcurrentQueryLoader loader;
+    ownCoilMap_.AddLoadQueries(loader);
+    loader.AddQuery(SPNAME_SELECT_HQPSTART_ANGLES,
+                    [this](SACommand &command, std::string &errorText) { return PopulateHqpStartSet(command, errorText); });
+    loader.AddQuery(SPNAME_SELECT_LAYERSTART_ANGLES,
+                    [this](SACommand &command, std::string &errorText) { return PopulateLayerStartSet(command, errorText); });
+    Metrics &metrics= Metrics::Instance();
+    {
+      Metrics::ScopedTimer timer("events.queries");
+      queryStatus= loader.Run();
+    }
+    metrics.AddCount("events.hqp_start_rows", static_cast<long long>(hqpStartSet_.size()));
+    metrics.AddCount("events.layer_start_rows", static_cast<long long>(layerStartSet_.size()));
 
-    // if the connect status and the coil populate status is okay,
-    // continue and get the hqp start angles
-    if (RTN_NO_ERROR == connectStatus &&
-        RTN_NO_ERROR == opStatus) {
-      std::cout << "Get HQP Start Angles." << std::endl;
-      queryStatus= QueryDb(SPNAME_SELECT_HQPSTART_ANGLES);
+    if (RTN_NO_ERROR == queryStatus) {
+      std::cout << "Coil Map, HQP and Layer Start Angles retrieved." << std::endl;
+      // build the coil map indexes now that the rows are loaded
+      opStatus= ownCoilMap_.FinishLoad();
       }
-
-    if (RTN_NO_ERROR == queryStatus)
-      std::cout << "HQP Start Angles retrievd." << std::endl;
-    else
-      std::cout << "HQP Start Angles retrieval error!!" << std::endl;
-
-    // if connect status, previous operation, and previous query were all okay,
-    // continue and make a set of the result (hqp start angles).
-    if (RTN_NO_ERROR == connectStatus &&
-        RTN_NO_ERROR == opStatus &&
-        RTN_NO_ERROR == queryStatus) {
-      std::cout << "Save HQP Start Angles." << std::endl;
-      opStatus= PopulateHqpStartSet();
+    else {
+      errorText_= loader.GetErrorText();
+      std::cout << "Coil Map, HQP and Layer Start Angles retrieval error!!" << std::endl;
       }
 
-    if (RTN_NO_ERROR == opStatus)
-      std::cout << "HQP Start Angles saved." << std::endl;
+    if (RTN_NO_ERROR == queryStatus &&
+        RTN_NO_ERROR == opStatus)
+      std::cout << "Populate Coil Map successful." << std::endl;
     else
-      std::cout << "HQP Start Angles save error!!" << std::endl;
+      std::cout << "Populate Coil Map error!!" << std::endl;
 
-    // if connect status, previous query, and previous operation were all okay,
-    // continue and get the the layer start angles
-    if (RTN_NO_ERROR == connectStatus &&
+    // a write that did not finish is resumed from its journal, if it is of the same inputs
+    WriteJournal journal(WRITE_JOURNAL_TABLE_EVENTS);
+    long journalStatus= RTN_NO_RESULTS;
+    if (RTN_NO_ERROR == queryStatus &&
         RTN_NO_ERROR == opStatus &&
-        RTN_NO_ERROR == queryStatus) {
-      std::cout << "Get Layer Start Angles." << std::endl;
-      queryStatus= QueryDb(SPNAME_SELECT_LAYERSTART_ANGLES);
-      }
+        !isLocalBackend_)
+      journalStatus= OpenJournal(journal);
 
-    if (RTN_NO_ERROR == queryStatus)
-      std::cout << "Layer Start Angles retrievd." << std::endl;
-    else
-      std::cout << "Layer Start Angles retrieval error!!" << std::endl;
+    // if the queries were okay, connect to the db to write the events
+    if (RTN_NO_ERROR == queryStatus &&
+        RTN_NO_ERROR == opStatus) {
+      std::cout << "Connect to Db." << std::endl;
+      Metrics::ScopedTimer timer("events.connect");
+      connectStatus= DbConnect();
+      if (RTN_NO_ERROR == connectStatus)
+        std::cout << "Connection successful." << std::endl;
+      else
+        std::cout << "Connection error!!" << std::endl;
+      }
 
-    // if connect status, previous operation, and previous query were all okay,
-    // continue and make a set of the result (hqp start angles).
+    // the event table in the db was made from the same inputs by this generator version, and was written completely
+    TableGeneration generation(GENERATION_TABLE_EVENTS);
     if (RTN_NO_ERROR == connectStatus &&
         RTN_NO_ERROR == opStatus &&
-        RTN_NO_ERROR == queryStatus) {
-      std::cout << "Save Layer Start Angles." << std::endl;
-      opStatus= PopulateLayerStartSet();
-    }
-
-    if (RTN_NO_ERROR == opStatus)
-      std::cout << "Layer Start Angles saved." << std::endl;
-    else
-      std::cout << "Layer Start Angles save error!!" << std::endl;
+        RTN_NO_RESULTS == journalStatus &&
+        isSkipUnchanged_ &&
+        generation.IsUpToDate(dbCommand_, GetInputHash(), errorText_)) {
+      std::cout << "The coil map, start angles, parameters, and generator version are unchanged. The event table is not remade." << std::endl;
+      DbDisconnect();
+      return RTN_NO_RESULTS;
+      }
 
     // if connect status and previous operation were okay,
-    // continue and create the event map, then put it into the database.
+    // 4) Iterate thru the coil map and calculate the rest of the event instances -- populate the Event Map
+    // 5) The event map is now complete for static events.
+    //    Iterate thru the event map, and insert the events into the DB
     if (RTN_NO_ERROR == connectStatus &&
         RTN_NO_ERROR == opStatus) {
       
-      // create the event map
-      std::cout << std::endl << "Create the event Map." << std::endl;
-      MapEventInstances();
-      std::cout << "Done Creating the event Map." << std::endl;
+      // create the event map, unless it is resumed from the journal
+      if (RTN_NO_ERROR != journalStatus) {
+        std::cout << std::endl << "Create the event Map." << std::endl;
+        const unsigned long long lookupsBefore= CoilMap::GetThreadLookupCount();
+        {
+          Metrics::ScopedTimer timer("events.build");
+          MapEventInstances();
+        }
+        metrics.AddCount("events.events", static_cast<long long>(eventMap_.size()));
+        metrics.AddCount("coilmap.lookups", static_cast<long long>(CoilMap::GetThreadLookupCount() - lookupsBefore));
+        std::cout << "Done Creating the event Map." << std::endl;
+      }
+
+      // The events have to agree with the positions they are made from. They are checked before they are journaled,
+      // and before the old events are deleted, so a failed check leaves the event table (and its generation row) as it was.
+      if (nullptr != crossCheck_ && nullptr != crossCheckRows_) {
+        Metrics::ScopedTimer timer("events.cross_check");
+        if (RTN_NO_ERROR != crossCheck_->Check(*crossCheckRows_, coilMap_, eventMap_)) {
+          std::cout << "The events do not agree with the positions, and are not written." << std::endl;
+          opStatus= RTN_ERROR;
+          }
+      }
+
+      // journal the events before anything is deleted or written, so a write that fails can be resumed
+      if (RTN_NO_ERROR == opStatus && RTN_NO_ERROR != journalStatus && !isLocalBackend_) {
+        Metrics::ScopedTimer timer("events.journal");
+        std::string record;
+        for (em_const_iter emci= eventMap_.begin(); emci != eventMap_.end(); ++emci) {
+          record.clear();
+          WriteJournal::PutDouble(record, emci->first);
+          WriteJournal::PutLong(record, emci->second.get<0>());
+          WriteJournal::PutString(record, emci->second.get<1>());
+          journal.AddRow(record);
+          }
+        opStatus= journal.Create(GetInputHash(), WRITE_JOURNAL_BATCH_ROWS, writerConnections_);
+      }
 
-      // Delete undone events
-      std::cout << "Deleting all undone events before the new events are inserted." << std::endl;
-      DeleteAllUndoneEvents();
+      // none of the journal rows are in the db, so the undone events are deleted first
+      WriteJournal::batch_set dbBatches;
+      if (RTN_NO_ERROR == opStatus && !isLocalBackend_)
+        opStatus= journal.ReadDbBatches(dbCommand_, dbBatches, errorText_);
+      // the journal and the db have to agree on the batches written before anything is deleted
+      if (RTN_NO_ERROR == opStatus && !isLocalBackend_)
+        opStatus= journal.SyncDbBatches(dbBatches);
+      if (RTN_NO_ERROR == opStatus && dbBatches.empty()) {
+        // Delete undone events. If the delete fails, nothing is written, so the new events are not mixed with the old ones.
+        // The generation row goes first, since the table is not up to date until it is written again.
+        std::cout << "Deleting all undone events before the new events are inserted." << std::endl;
+        {
+          Metrics::ScopedTimer timer("events.delete");
+          if (!isLocalBackend_)
+            opStatus= generation.Delete(dbCommand_, errorText_);
+          if (RTN_NO_ERROR == opStatus)
+            opStatus= DeleteAllUndoneEvents();
+        }
+      }
 
       // populate the database
-      std::cout << "Write the event Map to the database." << std::endl;
-      opStatus= InsertIntoDb(SPNAME_INSERT_EVENTLIST);  // iterate thru the event map and insert a db row for each event
-      std::cout << "Done Writing the event Map to the database." << std::endl;
+      if (RTN_NO_ERROR == opStatus) {
+        std::cout << "Write the event Map to the database." << std::endl;
+        {
+          Metrics::ScopedTimer timer("events.insert");
+          // iterate thru the event map (or the journal rows not in the db, a range per connection) and insert a db row for each event
+          opStatus= isLocalBackend_ ? InsertIntoDb(SPNAME_INSERT_EVENTLIST) : InsertIntoDb(journal, SPNAME_INSERT_EVENTLIST);
+        }
+        std::cout << "Done Writing the event Map to the database." << std::endl;
+      }
+
+      // The generation row of the table. The batches are committed on the range connections, so it is committed
+      // on its own after the last of them, and is only in the db when the table is complete.
+      if (RTN_NO_ERROR == opStatus && !isLocalBackend_)
+        opStatus= generation.Write(dbCommand_, GetInputHash(), errorText_);
+
+      // the table is written, so there is nothing to resume
+      if (RTN_NO_ERROR == opStatus && !isLocalBackend_)
+        journal.Remove();
     }
 
     // is connect status is okay (connection was sucessful), disconnect from the db
     if (RTN_NO_ERROR == connectStatus) {
       std::cout << std::endl << "Disconnect from the database" << std::endl;
+      Metrics::ScopedTimer timer("events.disconnect");
       disconnectStatus = DbDisconnect();
       }
 
@@ -174,12 +381,43 @@ namespace gaScsData {
       }
     } //EventMap::GenerateEventMapTable()
 
+  long EventMap::GenerateEventMap(const CoilMap::coil_map &coilRows, const layerAngleSetTyp &hqpStarts, const layerAngleSetTyp &layerStarts) {
+    // return value indicates success or error
+    // local backend -- no db. Populate the coil map and start sets from what is passed in.
+    if (&coilMap_ != &ownCoilMap_) {
+      std::cout << "The coil map is shared, and can't be populated here." << std::endl;
+      return RTN_ERROR;
+      }
+    long opStatus= ownCoilMap_.PopulateCoilMap(coilRows);
+    if (RTN_NO_ERROR != opStatus) {
+      std::cout << "Populate Coil Map error!!" << std::endl;
+      return RTN_ERROR;
+      }
+    return GenerateEventMap(hqpStarts, layerStarts);
+    } // EventMap::GenerateEventMap()
+
+  long EventMap::GenerateEventMap(const layerAngleSetTyp &hqpStarts, const layerAngleSetTyp &layerStarts) {
+    // return value indicates success or error
+    // local backend -- no db. The coil map is already populated.
+    if (coilMap_.mapCoil_.empty()) {
+      std::cout << "The coil map is empty!!" << std::endl;
+      return RTN_ERROR;
+      }
+    hqpStartSet_= hqpStarts;
+    layerStartSet_= layerStarts;
+
+    // create the event map
+    eventMap_.clear();
+    MapEventInstances();
+    return RTN_NO_ERROR;
+    } // EventMap::GenerateEventMap()
+
   bool EventMap::isEventLayerIncrement(CoilMap::cm_cit cit) const {
     CoilMap::fc_pair fcPair= coilMap_.GetCurrentNextFc(cit); // get current and next feature code
     long layerCheck= coilMap_.GetLayer(cit); // get layer
     // Joggle, but not the last joggle of the hex, and not last layer (i.e. not end of the coil)
     // true if FC(current row) = J, FC(next row) <> L and Layer <> next to last (39)
-    return FC_JOGGLE == fcPair.first && FC_LOCAL != fcPair.second && LAYERS_PER_COIL - 1 != layerCheck;
+    return FC_JOGGLE == fcPair.first && FC_LOCAL != fcPair.second && coilMap_.GetGeometry().layersPerCoil - 1 != layerCheck;
     } // EventMap::isEventLayerIncrement(CoilMap::cm_cit cit)
 
   // When the even layer is ending, the odd layer is at the 0U, so the
@@ -206,32 +444,32 @@ namespace gaScsData {
     } // EventMap::isEventHqpLoad(CoilMap::cm_cit cit)
 
   bool EventMap::isEventTeachFiducial(CoilMap::cm_cit cit) const {
-    std::string fc = coilMap_.GetFc(cit);
+    FeatureCode fc = coilMap_.GetFc(cit);
     long hqp = coilMap_.GetHexQuadNumber(cit);
     // At a local zero, but skip the first one (hqp = 1)
     return (FC_LOCAL == fc && 1 != hqp);
     } // EventMap::isEventTeachFiducial(CoilMap::cm_cit cit)
 
   bool EventMap::isEventRemovePlow(CoilMap::cm_cit cit) const {
-    std::string fc= coilMap_.GetFc(cit);
+    FeatureCode fc= coilMap_.GetFc(cit);
     // He inlet or outlet
     return (FC_INLET == fc || FC_OUTLET == fc);
     } // EventMap::isEventRemovePlow(CoilMap::cm_cit cit)
 
   bool EventMap::isEventHePipeInsulation(CoilMap::cm_cit cit) const {
-    std::string fc= coilMap_.GetFc(cit);
+    FeatureCode fc= coilMap_.GetFc(cit);
     // He inlet or outlet
     return (FC_INLET == fc || FC_OUTLET == fc);
     } // EventMap::isEventHePipeInsulation(CoilMap::cm_cit cit)
 
   bool EventMap::isEventHePipeMeasure(CoilMap::cm_cit cit) const {
-    std::string fc = coilMap_.GetFc(cit);
+    FeatureCode fc = coilMap_.GetFc(cit);
     // He outlet
     return (FC_OUTLET == fc);
   } // EventMap::isEventHePipeMeasure(CoilMap::cm_cit cit)
 
   bool EventMap::isEventOpenLandingRoller(CoilMap::cm_cit cit) const{
-    std::string fc= coilMap_.GetFc(cit);
+    FeatureCode fc= coilMap_.GetFc(cit);
     // He inlet or outlet
     return (FC_INLET == fc || FC_OUTLET == fc);
     } // EventMap::isEventOpenLandingRoller(CoilMap::cm_cit cit)
@@ -266,7 +504,7 @@ namespace gaScsData {
     long layerCheck= coilMap_.GetLayer(cit); // get layer
     // Joggle, but not the last joggle of the hex, and on Layer 37 (layers per coil - 3)
     // true if FC(current row) = J, FC(next row) <> L and Layer = 37
-    return FC_JOGGLE == fcPair.first && FC_LOCAL != fcPair.second && LAYERS_PER_COIL - 3 == layerCheck;
+    return FC_JOGGLE == fcPair.first && FC_LOCAL != fcPair.second && coilMap_.GetGeometry().layersPerCoil - 3 == layerCheck;
     } // EventMap::isEventMoveEChain(CoilMap::cm_cit cit)
 
   bool EventMap::isEventRemoveInnerStruts(CoilMap::cm_cit cit) const {
@@ -274,14 +512,14 @@ namespace gaScsData {
     long layerCheck= coilMap_.GetLayer(cit); // get layer
     // Joggle, but not the last joggle of the hex, and on Layer 38 (layers per coil - 2)
     // true if FC(current row) = J, FC(next row) <> L and Layer = 38
-    return FC_JOGGLE == fcPair.first && FC_LOCAL != fcPair.second && LAYERS_PER_COIL - 2 == layerCheck;
+    return FC_JOGGLE == fcPair.first && FC_LOCAL != fcPair.second && coilMap_.GetGeometry().layersPerCoil - 2 == layerCheck;
     } // EventMap::isEventRemoveInnerStruts(CoilMap::cm_cit cit)
 
   bool EventMap::isEventLeadEndgame(CoilMap::cm_cit cit) const {
     bool fcW = (FC_WINDING_LOCK == coilMap_.GetFc(cit) ? true : false); // is winding lock
     long layerCheck= coilMap_.GetLayer(cit); // get layer
     // winding lock and last layer
-    return fcW && LAYERS_PER_COIL == layerCheck;
+    return fcW && coilMap_.GetGeometry().layersPerCoil == layerCheck;
     } // EventMap::isEventLeadEndgame(CoilMap::cm_cit cit)
 
   // Landing roller moves to 40 degree position for inner turns (on the "move to inner" turn).
@@ -334,6 +572,13 @@ namespace gaScsData {
     // keep track of if a particular event is needed or not
     bool eNeeded = false;
 
+    // trace timeline, one span for the start set events, then one per coil map layer
+    TraceRecorder::SpanSequence chunkSpans("map_event_instances");
+    const bool isTracing= TraceRecorder::Instance().IsEnabled();
+    long traceLayer= 0;
+    if (isTracing)
+      chunkSpans.Next("hqp and layer start events");
+
     // Post Mockup Update: Hqp and layer increment events are now inserted at the same
     // angle as is in the Scs Position table, as opposed to calculating an angle for each event
     // in the below for loop as is done for the other events.  For each angle in the member sets
@@ -357,41 +602,39 @@ namespace gaScsData {
       // Most layers are nominal layer increment events EID_LAYER_INCREMENT,
       // but layer 37 is a move FO E-Chain layer (EID_MOVE_ECHAIN), and layer
       // 38 is a remove inner struts layer (EID_REMOVE_INNER_STRUTS).
-      if (37 == (ascit->first)) {
+      const long eventId= GetLayerStartEventId(ascit->first);
+      if (EID_MOVE_ECHAIN == eventId) {
         // layer 37, e-chain event
         logicTrace = "Angle is from Scs Pos Table where isNewLayer is set for layer 37.";
-        AddEventToMap(ascit->second, EID_MOVE_ECHAIN, logicTrace);
         }
-      else if (38 == (ascit->first)) {
+      else if (EID_REMOVE_INNER_STRUTS == eventId) {
         // layer 38, remove inner struts
         logicTrace = "Angle is from Scs Pos Table where isNewLayer is set for layer 38.";
-        AddEventToMap(ascit->second, EID_REMOVE_INNER_STRUTS, logicTrace);
         }
       else {
         // nominal layer
         logicTrace = "Angle is from Scs Pos Table where isNewLayer is set.";
-        AddEventToMap(ascit->second, EID_LAYER_INCREMENT, logicTrace);
         }
+      AddEventToMap(ascit->second, eventId, logicTrace);
       }
 
-    // variables to deal with displaying progress
-    double iterations= static_cast<double>(coilMap_.mapCoil_.size()); // number elements in the coil map -- use double so pctDone does not use interger math
-    long count = 0;  // loop counter for display purposes
-    long pctDone = 0;  // percent done
-
     // display progress 
     std::cout << "Traversing coil map to create events." << std::endl;
-    std::cout << "There are " << static_cast<long>(iterations) << " angles to process between angles " << coilMap_.GetAngle(coilMap_.mapCoil_.begin()) <<
+    std::cout << "There are " << coilMap_.mapCoil_.size() << " angles to process between angles " << coilMap_.GetAngle(coilMap_.mapCoil_.begin()) <<
       " and " << coilMap_.GetAngle(coilMap_.mapCoil_.rbegin()) << std::endl;
 
     // traverse the coil map from beginning to end
     // see which, if any, events need to be mapped for each entry in the coil map
     // if an event needs to be added, then calculate the angle and add it to the map
+    // the loop only counts. The display is redrawn by the reporter at a fixed rate.
+    ProgressReporter progress("Angles", coilMap_.mapCoil_.size());
     for ( cicm= coilMap_.mapCoil_.begin(); cicm != coilMap_.mapCoil_.end(); ++cicm ) {
-      // display progress
-      ++count;
-      pctDone = static_cast<long>(round(100.0 * (count / iterations)));  // truncate fractional percentages
-      std::cout << "On angle " << coilMap_.GetAngle(cicm) << " (" << pctDone << " %)\r" << std::flush; // no linefeed so this line will be overwritten next time thru
+      // count progress
+      progress.Add();
+      if (isTracing && coilMap_.GetLayer(cicm) != traceLayer) {
+        traceLayer= coilMap_.GetLayer(cicm);
+        chunkSpans.Next("layer " + std::to_string(static_cast<long long>(traceLayer)));
+        }
 
       // test for each type of event and add to map if needed
       // Post Mockup Update:  Layer Increment events are now added based on new layer angles
@@ -476,7 +719,7 @@ namespace gaScsData {
       eNeeded = isEventMoveLrInnerTurnPos(cicm); // need to add to map if true
       if (eNeeded) {
         // calc angle = current angle + LR Odd layer offset
-        eventAngle = coilMap_.GetAngle(cicm) + LR_MV_TO_INNER_TURN_OFFSET;
+        eventAngle = coilMap_.GetAngle(cicm) + params_.lrMvToInnerTurnOffset;
         logicTrace = "";
         AddEventToMap(eventAngle, EID_MOVE_LR_TO_INNER_TURN_POS, logicTrace);
         }
@@ -486,7 +729,7 @@ namespace gaScsData {
       eNeeded = isEventMoveLrToOuterTurnPos(cicm); // need to add to map if true
       if (eNeeded) {
         // calc angle = current angle + LR Even layer offset
-        eventAngle = coilMap_.GetAngle(cicm) + LR_MV_TO_OUTER_TURN_OFFSET;
+        eventAngle = coilMap_.GetAngle(cicm) + params_.lrMvToOuterTurnOffset;
         logicTrace = "";
         AddEventToMap(eventAngle, EID_MOVE_LR_TO_OUTER_TURN_POS, logicTrace);
         }
@@ -511,7 +754,7 @@ namespace gaScsData {
         // needs to be laid down past a hardstop before the actions are performed, but
         // the software is not hard stop aware...So, leave the event early, and let
         // the operator decide.
-        eventAngle = coilMap_.GetAngle(cicm) + LR_INNER_TURN_OFFSET - END_LAYER_LR_JOGGLE_NOM_OFFSET;
+        eventAngle = coilMap_.GetAngle(cicm) + params_.lrInnerTurnOffset - END_LAYER_LR_JOGGLE_NOM_OFFSET;
         // add end of layer event to map
         logicTrace = "Used LR inner turn offset";
         AddEventToMap(eventAngle, EID_END_ODD_LAYER, logicTrace);
@@ -551,7 +794,7 @@ namespace gaScsData {
 	    eNeeded = isEventEndEvenLayer(cicm); // need to add to map if true
 	    if (eNeeded) {
         // calc angle = current angle + landing roller offset - joggle offset
-		    eventAngle = coilMap_.GetAngle(cicm) + LR_OUTER_TURN_OFFSET - END_LAYER_LR_JOGGLE_NOM_OFFSET;
+		    eventAngle = coilMap_.GetAngle(cicm) + params_.lrOuterTurnOffset - END_LAYER_LR_JOGGLE_NOM_OFFSET;
 		    // add end of layer event to map
         logicTrace = "Used LR outer turn offset";
         AddEventToMap(eventAngle, EID_END_EVEN_LAYER, logicTrace);
@@ -614,11 +857,11 @@ namespace gaScsData {
         // Determine which LR offset to use by looking  at the turn number
         long turn= coilMap_.GetTurn(cicm);
         if (turn <= LR_MV_TO_OUTER_TURN) { // outer turn 
-          eventAngle= coilMap_.GetAngle(cicm) + LR_OUTER_TURN_OFFSET - ANGLE_OFFSET_SMALL;
+          eventAngle= coilMap_.GetAngle(cicm) + params_.lrOuterTurnOffset - ANGLE_OFFSET_SMALL;
           logicTrace = "Used LR outer turn offset";
           }
         else {// inner turn
-          eventAngle= coilMap_.GetAngle(cicm) + LR_INNER_TURN_OFFSET - ANGLE_OFFSET_SMALL;
+          eventAngle= coilMap_.GetAngle(cicm) + params_.lrInnerTurnOffset - ANGLE_OFFSET_SMALL;
           logicTrace = "Used LR inner turn offset";
           }
         // add event to map
@@ -671,8 +914,9 @@ namespace gaScsData {
 
       } // the for loop, traversing the map
 
-    // end the line and add an extra spece after the output in the for loop.
-    std::cout << std::endl << std::endl;
+    // final progress display, then add an extra line after it.
+    progress.Finish();
+    std::cout << std::endl;
 
     } // EventMap::CalculateEventInstances()
 
@@ -739,59 +983,30 @@ namespace gaScsData {
     return rtnValue;
   } // AxesPositions::DbDisconnect()
 
-  // executes the specified stored procedure, which is expected to return results (SELECT...) 
-  long EventMap::QueryDb(const std::string &sprocName) {
-    // return value indicates success or error
-
-    // query the db using the specified stored procedure, 
-    // presumably a SELECT command to fetch data
-
-    // variable to hold return value
-    long rtnValue = 0;
-
-    // Set the command text of the command object
-    dbCommand_.setCommandText(sprocName.c_str(), SA_CmdStoredProc);
-
-    try {
-      // execute the command
-      dbCommand_.Execute();
-      // set return value for all okay
-      rtnValue = RTN_NO_ERROR;
-    }
-    catch (SAException &ex) {
-      // get error message
-      errorText_ = (const char*)ex.ErrText();
-      // output the error text
-      std::cout << errorText_ << std::endl;
-      // set return value to indicate an error
-      rtnValue = RTN_ERROR;
-    }
-    return rtnValue;
-  } // QueryDb(const std::string &sprocName)
 
   // Get hqp start angles. 
-  // This functions relys on the result set being in the command member object
-  // as a result of  the QueryDb call (do this call before calling this function.)
-  long EventMap::PopulateHqpStartSet() {
+  // This functions relys on the result set being in the passed in command object
+  // as a result of the loader executing the query. Called on a loader worker thread.
+  long EventMap::PopulateHqpStartSet(SACommand &command, std::string &errorText) {
     // Populates a set of hqp start angles from the Scs Position table sorted ascendingly
     // return value indicates success or error
 
-    // QueryDb() is called with the correct stored procedure name prior to this function being called.
+    // The loader executes the correct stored procedure prior to this function being called.
     // The query returns a sorted list of angles which correspond to the start of HQPs
-    // Put the values fetched by the QueryDb() into a set
-    // QueryDb() should return one or more rows.  Map every row returned.
+    // Put the values fetched by the the query into a set
+    // the query should return one or more rows.  Map every row returned.
 
     // variable to hold return value
     long rtnValue = 0;
     try {
-      if (dbCommand_.isResultSet()) {
+      if (command.isResultSet()) {
         // if there is a result set
         LayerAngleTyp laTyp; // local variables for the <layer, angle> pair
-        while (dbCommand_.FetchNext()) {
+        while (command.FetchNext()) {
           // add the layer and associated angle to the map
           // use the end of the set as the insertion hint for optimum performance
-          laTyp.first = dbCommand_.Field(SAP_LAYERNUM_PARAM.c_str()).asLong();    // layer
-          laTyp.second = dbCommand_.Field(SAP_RIAANGLE_PARAM.c_str()).asDouble();  // angle
+          laTyp.first = command.Field(SAP_LAYERNUM_PARAM.c_str()).asLong();    // layer
+          laTyp.second = command.Field(SAP_RIAANGLE_PARAM.c_str()).asDouble();  // angle
           hqpStartSet_.insert(hqpStartSet_.end(), laTyp);  // insert the retreived angle into the set
         }
         // set return value for all okay
@@ -804,9 +1019,8 @@ namespace gaScsData {
     }
     catch (SAException &ex) {
       // get error message
-      errorText_ = (const char*)ex.ErrText();
-      // output the error text
-      std::cout << errorText_ << std::endl;
+      errorText = (const char*)ex.ErrText();
+      // the caller (loader) outputs the error text
       // set return value to indicate an error
       rtnValue = RTN_ERROR;
     }
@@ -814,28 +1028,28 @@ namespace gaScsData {
   }
 
   // Get layer start angles
-  // This functions relys on the result set being in the command member object
-  // as a result of  the QueryDb call (do this call before calling this function.)
-  long EventMap::PopulateLayerStartSet() {
+  // This functions relys on the result set being in the passed in command object
+  // as a result of the loader executing the query. Called on a loader worker thread.
+  long EventMap::PopulateLayerStartSet(SACommand &command, std::string &errorText) {
     // Populates a set of layer start angles from the Scs Position table sorted ascendingly
     // return value indicates success or error
 
-    // QueryDb() is called with the correct stored procedure name prior to this function being called.
+    // The loader executes the correct stored procedure prior to this function being called.
     // The query returns a sorted list of angles which correspond to the start of HQPs
-    // Put the values fetched by the QueryDb() into a set
-    // QueryDb() should return one or more rows.  Map every row returned.
+    // Put the values fetched by the the query into a set
+    // the query should return one or more rows.  Map every row returned.
 
     // variable to hold return value
     long rtnValue = 0;
     try {
-      if (dbCommand_.isResultSet()) {
+      if (command.isResultSet()) {
         // if there is a result set
         LayerAngleTyp laTyp; // local variables for the <layer, angle> pair
-        while (dbCommand_.FetchNext()) {
+        while (command.FetchNext()) {
           // add the layer and associated angle to the map
           // use the end of the set as the insertion hint for optimum performance
-          laTyp.first = dbCommand_.Field(SAP_LAYERNUM_PARAM.c_str()).asLong();    // layer
-          laTyp.second = dbCommand_.Field(SAP_RIAANGLE_PARAM.c_str()).asDouble();  // angle
+          laTyp.first = command.Field(SAP_LAYERNUM_PARAM.c_str()).asLong();    // layer
+          laTyp.second = command.Field(SAP_RIAANGLE_PARAM.c_str()).asDouble();  // angle
           layerStartSet_.insert(layerStartSet_.end(), laTyp);  // insert the retreived angle into the set
         }
         // set return value for all okay
@@ -848,9 +1062,8 @@ namespace gaScsData {
     }
     catch (SAException &ex) {
       // get error message
-      errorText_ = (const char*)ex.ErrText();
-      // output the error text
-      std::cout << errorText_ << std::endl;
+      errorText = (const char*)ex.ErrText();
+      // the caller (loader) outputs the error text
       // set return value to indicate an error
       rtnValue = RTN_ERROR;
     }
@@ -859,37 +1072,57 @@ namespace gaScsData {
   // Insert a row at the angle. Use the passed in event id.
   // Execute the specified stored procedure to do the insert
   // It is assumed the connection is already done, and that sometime after the call a disconnect is performed.
-  long EventMap::InsertIntoDb(double angle, long eventId, const std::string &sprocName, const std::string& trace) {
+  long EventMap::InsertIntoDb(long sequence, double angle, long eventId, const std::string &sprocName, const std::string& trace) {
     // execute the specified stored procedure to do the insert
     // return value indicates success or error
 
+    // local backend, record the row instead of writing it to the db
+    if (isLocalBackend_) {
+      localRows_.push_back(LocalRowTyp(angle, eventId));
+      return RTN_NO_ERROR;
+      }
+
+    const long rtnValue= InsertIntoDb(dbCommand_, sequence, angle, eventId, sprocName, trace, errorText_);
+    // output the error text
+    if (RTN_NO_ERROR != rtnValue)
+      std::cout << errorText_ << std::endl;
+    return rtnValue;
+    } // EventMap::InsertIntoDb(long sequence, double angle, long eventId, const std::string &sprocName, const std::string& trace)
+
+  // Insert a row at the angle with the passed in command. Called from the journal range threads,
+  // so only the command and the error text are changed.
+  // It is assumed the connection is already done, and that sometime after the call a disconnect is performed.
+  long EventMap::InsertIntoDb(SACommand &command, long sequence, double angle, long eventId, const std::string &sprocName,
+                              const std::string& trace, std::string &errorText) const {
+    // return value indicates success or error
+
     // variable to hold return value
     long rtnValue= 0;
 
-    // Set the command text of the command object
-    dbCommand_.setCommandText(sprocName.c_str(), SA_CmdStoredProc);
-
     try {
+      // Set the command text of the command object
+      command.setCommandText(sprocName.c_str(), SA_CmdStoredProc);
+
       // set the input parameters
-      dbCommand_.Param("eventId").setAsLong() = eventId;
-      dbCommand_.Param("angle").setAsDouble() = angle;
-      dbCommand_.Param("logicTrace").setAsString() = trace.c_str();
+      command.Param(WJ_SEQUENCE_PARAM.c_str()).setAsLong() = sequence;
+      command.Param("eventId").setAsLong() = eventId;
+      command.Param("angle").setAsDouble() = angle;
+      command.Param("logicTrace").setAsString() = trace.c_str();
 
       // execute the command
-      dbCommand_.Execute();
+      Metrics::ScopedTimer latency("sproc." + sprocName, Metrics::TK_LATENCY);
+      command.Execute();
       // set return value for all okay
       rtnValue= RTN_NO_ERROR;
       }
     catch(SAException &ex) {
       // get error message
-      errorText_= (const char*)ex.ErrText();
-      // output the error text
-      std::cout << errorText_ << std::endl;
+      errorText= (const char*)ex.ErrText();
       // set return value to indicate an error
       rtnValue= RTN_ERROR;
       }
     return rtnValue;
-    } // EventMap::InsertIntoDb(double angle, const std::string& trace, long EventId)
+    } // EventMap::InsertIntoDb(SACommand &command, long sequence, double angle, long eventId, ...)
 
   // Iterate thru the event map and insert a row for each map entry.
   // Execute the specified stored procedure to do the insert
@@ -899,28 +1132,29 @@ namespace gaScsData {
     bool errorFlag = false;
     // variable to hold return value
     long rtnValue= 0;
-
-    // variables to deal with displaying progress
-    double records = static_cast<double>(eventMap_.size()); // number of records to insert -- use double so pctDone does not use interger math
-    long count = 0;  // loop counter for display purposes
-    double pctDone = 0;  // percent done
-
-    std::cout << "There are " << static_cast<long>(records) << " records to insert." << std::endl;
+    // write order of the rows
+    long sequence= 0;
+
+    std::cout << "There are " << eventMap_.size() << " records to insert." << std::endl;
+    ProgressReporter progress("Records", eventMap_.size());
+    if (isLocalBackend_) {
+      localRows_.clear();
+      localRows_.reserve(eventMap_.size());
+      }
 
     for(EventMap::em_const_iter emci = eventMap_.begin(); emci != eventMap_.end(); ++emci) {
-      // display progress
-      ++count;
-      pctDone = static_cast<long>(100.0 * (count / records));
-      std::cout << "On record " << count << " of " << records << " (" << pctDone << " %)\r" << std::flush;
+      // count progress
+      progress.Add();
 
       // do the insert
-      rtnValue = InsertIntoDb(emci->first, emci->second.get<0>(), sprocName, emci->second.get<1>().c_str());
+      rtnValue = InsertIntoDb(++sequence, emci->first, emci->second.get<0>(), sprocName, emci->second.get<1>().c_str());
       if (rtnValue != RTN_NO_ERROR)
         errorFlag = true;
       } // for loop
 
-    // end the line and add an extra spece after the output in the for loop.
-    std::cout << std::endl << std::endl;
+    // final progress display, then add an extra line after it.
+    progress.Finish();
+    std::cout << std::endl;
 
     if (!errorFlag) // no error flag, return ok
       return RTN_NO_ERROR;
@@ -928,6 +1162,63 @@ namespace gaScsData {
       return RTN_ERROR;
     } // EventMap::InsertIntoDb() 
 
+  // Insert the journal rows of the batches not in the db, in batches, a range per connection.
+  // A journal row is the angle, event id, and logic trace.
+  // It is assumed the connection is already done, and that sometime after the call a disconnect is performed.
+  long EventMap::InsertIntoDb(WriteJournal &journal, const std::string &sprocName) {
+    // return value indicates success or error
+    return journal.WriteBatches(serverText_, dbConnection_, dbCommand_,
+                                [this, &sprocName](SACommand &command, long sequence, const std::string &record, std::string &errorText) {
+                                  WriteJournal::RecordReader reader(record);
+                                  const double angle= reader.GetDouble();
+                                  const long eventId= reader.GetLong();
+                                  const std::string trace= reader.GetString();
+                                  if (!reader.IsOk()) {
+                                    errorText= "Error reading an event write journal row.";
+                                    return RTN_ERROR;
+                                    }
+                                  return InsertIntoDb(command, sequence, angle, eventId, sprocName, trace, errorText);
+                                  },
+                                errorText_);
+    } // EventMap::InsertIntoDb(WriteJournal &journal, const std::string &sprocName)
+
+  // Open the event write journal. Resume it if it is of the same inputs.
+  long EventMap::OpenJournal(WriteJournal &journal) {
+    // return value is RTN_NO_ERROR to resume, RTN_NO_RESULTS if there is no journal, and RTN_ERROR if it can't be resumed
+    const long openStatus= journal.Open();
+    if (RTN_NO_RESULTS == openStatus)
+      return RTN_NO_RESULTS;
+    if (RTN_NO_ERROR != openStatus || journal.GetInputHash() != GetInputHash()) {
+      std::cout << "The event write journal " << journal.GetFileName() << " is of a write that did not finish, with other inputs. "
+                << "The event table is written again." << std::endl;
+      journal.Clear();
+      return RTN_ERROR;
+      }
+
+    eventMap_.clear();
+    for (size_t row= 0; row < journal.GetRowCount(); ++row) {
+      WriteJournal::RecordReader reader(journal.GetRow(row));
+      const double angle= reader.GetDouble();
+      const long eventId= reader.GetLong();
+      const std::string trace= reader.GetString();
+      if (!reader.IsOk()) {
+        std::cout << "Error reading row " << row << " of the event write journal " << journal.GetFileName()
+                  << ". The event table is written again." << std::endl;
+        eventMap_.clear();
+        journal.Clear();
+        return RTN_ERROR;
+        }
+      // journal rows are in map order, so events at the same angle keep their order
+      eventMap_.insert(eventMap_.end(), EventValueTyp(angle, EventDataTyp(eventId, trace)));
+      }
+    std::cout << "Resuming the event write journal " << journal.GetFileName() << ": " << journal.GetRowCount() << " rows, "
+              << journal.GetCommittedCount() << " of " << journal.GetBatchCount() << " batches committed, in "
+              << journal.GetRangeCount() << " ranges. "
+              << "The events are not made again." << std::endl;
+    Metrics::Instance().AddCount("events.events", static_cast<long long>(eventMap_.size()));
+    return RTN_NO_ERROR;
+    }
+
   // delete all rows from event list table
   // that are not referenced in the event history or
   // action history tables (i.e. are not done or partially done)
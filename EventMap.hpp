@@ -16,14 +16,24 @@
 #define GA_ScsData_EventMap_H_
 
 // standard c/c++ libraries
+#include <cstdint>
 
 // GA headers
 #include "gaScsDataConstants.hpp"
 #include "CoilMap.hpp"
+#include "GenerationParams.hpp"
+#include "AxisPositions.hpp"
+#include "TableGeneration.hpp"
+#include "WriteJournal.hpp"
 
 namespace gaScsData {
 
+class Checksum;
+class EventCrossCheck;
+
 class EventMap : private boost::noncopyable { 
+  // the benchmark times the private event and insert functions
+  friend class PipelineBenchmark;
 
 public:
   // typedefs and enums
@@ -51,6 +61,9 @@ public:
       typedef std::pair<long, double> LayerAngleTyp;
       typedef boost::container::flat_set<LayerAngleTyp> layerAngleSetTyp;  // for best performance, reserve size in ctor
       typedef layerAngleSetTyp::const_iterator as_cit;
+
+      // Row recorded by the local (in memory) insert backend: <angle, event id>
+      typedef std::pair<double, long> LocalRowTyp;
  
       // The event ids need to match the event class table in the database.
       // This code does not generate instances of all these event ids.
@@ -89,15 +102,72 @@ public:
 
     // ctors and dtor
     EventMap();
+    // Use a coil map that is already populated, and shared (read only) with other objects, instead of
+    // populating a coil map of our own. Used to evaluate many parameter sets against one coil map.
+    explicit EventMap(const CoilMap &sharedCoilMap);
     ~EventMap();
 
   // accessors
+    // number of events in the event map
+    size_t GetEventCount() const;
+    // the event map, by angle
+    const EventMapTyp& GetEventMap() const;
+    // the coil map the events are made from
+    const CoilMap& GetCoilMap() const;
+    // false (default) -- event inserts are written to the db
+    // true -- event inserts are recorded in memory (local backend). No db connection is needed.
+    void SetLocalBackend(bool isLocalBackend);
+    // number of event inserts recorded by the local backend
+    size_t GetLocalRowCount() const;
+    // checksum of the event map (16 hex digits), to compare the output of two runs
+    std::string GetEventChecksum() const;
+    // add one event to a checksum: the angle and event id (not the logic trace), as GetEventChecksum()
+    static void AddRowToChecksum(Checksum &checksum, double angle, const EventDataTyp &eventData);
+    // hash of the inputs the events are made from: GENERATOR_VERSION, the coil map, the parameters,
+    // and the hqp and layer start angles. The same inputs make the same events.
+    uint64_t GetInputHash() const;
+    // When true, GenerateEventMapTable() reads the generation row of the event table from the db (TableGeneration
+    // class), and makes no events if it was written completely from GetInputHash() by this GENERATOR_VERSION.
+    void SetSkipUnchanged(bool skipUnchanged);
+    // db connections the events are written on at once. Defaults to DB_WRITER_CONNECTIONS. A resumed write
+    // keeps the ranges of its journal.
+    void SetWriterConnections(size_t connections);
+    // tunable parameters. The defaults are the gaScsDataConstants.hpp values.
+    void SetGenerationParams(const GenerationParams &params);
+    const GenerationParams& GetGenerationParams() const;
+    // coil geometry. Defaults to the standard coil. Set it before the coil map is populated.
+    // return value indicates success or error (invalid geometry, or a shared coil map)
+    long SetCoilGeometry(const CoilGeometry &geometry);
+    // GenerateEventMapTable() checks the events against the SCS rows they are made from (EventCrossCheck class)
+    // before they are journaled or written, and writes nothing if they do not agree. The check and the rows are
+    // the caller's, so it can report the issues, and have to outlive the call. nullptr (default) -- no check.
+    void SetCrossCheck(EventCrossCheck *crossCheck, const AxisPositions::ScsAxesPositionMap *scsRows);
+    // spacing (degrees) between event angles. Events at the same angle are not counted as a spacing.
+    // return value is RTN_NO_RESULTS if there are less than two event angles.
+    long GetEventSpacing(double &minSpacing, double &meanSpacing) const;
+    // event id made at the start of a layer: EID_LAYER_INCREMENT, or the e-chain (layer 37) and inner strut (layer 38) events
+    static long GetLayerStartEventId(long layer);
 
   // public methods
+    // The events are journaled (WriteJournal class) before they are written, and written in batches. A write that
+    // did not finish is resumed by the next call, from its journal, if the inputs are the same.
+    // The events are split into RIA angle ranges, and the ranges are written at once, one per connection
+    // (SetWriterConnections()), with the sequence number of a serial write.
+    // return value indicates success or error (including cross check issues, SetCrossCheck()), or RTN_NO_RESULTS if
+    // the inputs are the same as the generation row of the event table in the db (SetSkipUnchanged()), and the event
+    // table was left as it is
     long GenerateEventMapTable();
+    // Create the event map from the passed in coil map rows and hqp/layer start angles, instead of the db (local backend).
+    // Nothing is written to the db. Used with CoilMapGenerator rows and AxisPositions::GetStartAngleSets for scale testing.
+    // return value indicates success or error
+    long GenerateEventMap(const CoilMap::coil_map &coilRows, const layerAngleSetTyp &hqpStarts, const layerAngleSetTyp &layerStarts);
+    // Same, using the shared coil map passed to the ctor
+    long GenerateEventMap(const layerAngleSetTyp &hqpStarts, const layerAngleSetTyp &layerStarts);
 
   private:
     // helper functions
+      // ctor initialization common to both ctors
+      void Initialize();
 
     // event related functions
       // look at the coil map and see when an event should be created.
@@ -127,21 +197,34 @@ public:
 
       long DbConnect();
       long DbDisconnect();
-      // executes the specified stored procedure, which is expected to return results (SELECT...) 
-      long QueryDb(const std::string &sprocName);
 
       // Get hqp and layer start angles. 
-      // These functions rely on the result set being in the command member object
-      // as a result of  the QueryDb call (do this call before calling these functions.)
-      long PopulateHqpStartSet();
-      long PopulateLayerStartSet();
+      // These functions rely on the result set being in the passed in command object
+      // as a result of the ConcurrentQueryLoader executing the query. They are called on a loader
+      // worker thread, so they put any error message in the passed in error text, not the member.
+      long PopulateHqpStartSet(SACommand &command, std::string &errorText);
+      long PopulateLayerStartSet(SACommand &command, std::string &errorText);
 
       // Insert a row at the angle. Use the passed in event id.
       // Execute the specified stored procedure to do the insert
       // It is assumed the connection is already done, and that sometime after the call a disconnect is performed.
-      long InsertIntoDb(double angle, long eventId, const std::string &sprocName, const std::string& trace = "none");
+      // sequence is the write order of the row, 1 for the first row.
+      long InsertIntoDb(long sequence, double angle, long eventId, const std::string &sprocName, const std::string& trace = "none");
+      // The same with the passed in command, so it can be called from the journal range threads. The error
+      // is returned in errorText, not displayed.
+      long InsertIntoDb(SACommand &command, long sequence, double angle, long eventId, const std::string &sprocName,
+                        const std::string& trace, std::string &errorText) const;
       // Iterate thru event map and insert a row for each map entry.
       long InsertIntoDb(const std::string &sprocName); 
+      // Insert the journal rows of the batches not in the db, in batches (one transaction each), using the overload.
+      // The journal ranges are written at once, on their own connections.
+      // return value indicates success or error
+      long InsertIntoDb(WriteJournal &journal, const std::string &sprocName);
+      // Open the event write journal of a write that did not finish. If it is of the same inputs, its rows are
+      // put in the event map, so they are not made again.
+      // return value is RTN_NO_ERROR to resume the journal, RTN_NO_RESULTS if there is none, and RTN_ERROR if it is
+      // of other inputs or can't be read (the event table in the db is partial, and is written again).
+      long OpenJournal(WriteJournal &journal);
 
       // delete all rows from event list table
       // that are not referenced in the event history or
@@ -152,8 +235,11 @@ public:
 
     // member variables
 
-       // coil map
-      CoilMap coilMap_;
+       // coil map. coilMap_ refers to ownCoilMap_, or to a shared coil map passed to the ctor.
+      CoilMap ownCoilMap_;
+      const CoilMap &coilMap_;
+      // tunable parameters
+      GenerationParams params_;
 
       // angle set of the hqp start angles (from the Scs Positon Table)
       layerAngleSetTyp hqpStartSet_;
@@ -163,6 +249,16 @@ public:
 
         // Event map
       EventMapTyp eventMap_;
+      // local backend -- record event inserts here instead of writing them to the db
+      bool isLocalBackend_;
+      std::vector<LocalRowTyp> localRows_;
+      // skip the table if the generation row in the db has the same inputs
+      bool isSkipUnchanged_;
+      // db connections the events are written on
+      size_t writerConnections_;
+      // check of the events against the SCS rows, before they are written
+      EventCrossCheck *crossCheck_;
+      const AxisPositions::ScsAxesPositionMap *crossCheckRows_;
 
       // Event value type
       EventValueTyp eventValue_;
@@ -0,0 +1,260 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: FingerprintDiff.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Compares two generation fingerprints, reading the rows of the changed layers only.
+ *
+ * Libraries used:  string
+ *                  vector
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <sstream>
+#include <fstream>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "FingerprintDiff.hpp"
+
+namespace gaScsData {
+
+static const char *DIFF_TYPE_NAMES[]= { "changed", "added", "removed" };
+static_assert(sizeof(DIFF_TYPE_NAMES) / sizeof(DIFF_TYPE_NAMES[0]) == FingerprintDiff::DIFF_NUM_OF_TYPES,
+              "one name per difference type");
+
+// ctors and dtor
+FingerprintDiff::FingerprintDiff() :
+    layersRead_(0) {
+  for (long table= 0; table < OutputFingerprint::TABLE_NUM_OF_TABLES; ++table) {
+    isTableSame_[table]= true;
+    }
+  for (long type= 0; type < DIFF_NUM_OF_TYPES; ++type) {
+    counts_[type]= 0;
+    }
+  }
+
+FingerprintDiff::~FingerprintDiff() { }
+
+// accessors
+bool FingerprintDiff::IsTableSame(OutputFingerprint::Tables table) const {
+  return isTableSame_[table];
+  }
+
+const FingerprintDiff::layer_diff_list& FingerprintDiff::GetLayerDiffs() const {
+  return layerDiffs_;
+  }
+
+size_t FingerprintDiff::GetRowDiffCount() const {
+  size_t count= 0;
+  for (long type= 0; type < DIFF_NUM_OF_TYPES; ++type) {
+    count+= counts_[type];
+    }
+  return count;
+  }
+
+size_t FingerprintDiff::GetRowDiffCount(DiffTypes type) const {
+  return counts_[type];
+  }
+
+const FingerprintDiff::row_diff_list& FingerprintDiff::GetRowDiffs() const {
+  return rowDiffs_;
+  }
+
+size_t FingerprintDiff::GetLayersRead() const {
+  return layersRead_;
+  }
+
+// public member functions
+long FingerprintDiff::Compare(const OutputFingerprint &before, const OutputFingerprint &after) {
+  // return value is RTN_NO_ERROR if the generations are the same
+  layerDiffs_.clear();
+  rowDiffs_.clear();
+  layersRead_= 0;
+  for (long type= 0; type < DIFF_NUM_OF_TYPES; ++type) {
+    counts_[type]= 0;
+    }
+
+  bool isSame= true;
+  long status= RTN_NO_ERROR;
+  for (long index= 0; index < OutputFingerprint::TABLE_NUM_OF_TABLES; ++index) {
+    const OutputFingerprint::Tables table= static_cast<OutputFingerprint::Tables>(index);
+    hashBefore_[table]= before.IsSet(table) ? before.GetHashHex(table) : "";
+    hashAfter_[table]= after.IsSet(table) ? after.GetHashHex(table) : "";
+    isTableSame_[table]= before.IsSet(table) == after.IsSet(table) && before.GetHash(table) == after.GetHash(table);
+    if (!isTableSame_[table]) {
+      isSame= false;
+      if (RTN_NO_ERROR != CompareTable(before, after, table))
+        status= RTN_ERROR;
+      }
+    }
+  return isSame && RTN_NO_ERROR == status ? RTN_NO_ERROR : RTN_ERROR;
+  }
+
+long FingerprintDiff::CompareFiles(const std::string &beforeFile, const std::string &afterFile) {
+  OutputFingerprint before;
+  OutputFingerprint after;
+  if (RTN_NO_ERROR != before.Open(beforeFile) || RTN_NO_ERROR != after.Open(afterFile))
+    return RTN_ERROR;
+  return Compare(before, after);
+  }
+
+std::string FingerprintDiff::ToJson() const {
+  std::ostringstream json;
+  json << std::fixed;
+  json << "{" << std::endl
+       << "  \"tables\": {";
+  for (long table= 0; table < OutputFingerprint::TABLE_NUM_OF_TABLES; ++table) {
+    json << (0 == table ? "" : ",") << std::endl
+         << "    \"" << OutputFingerprint::GetTableName(static_cast<OutputFingerprint::Tables>(table)) << "\": { \"same\": "
+         << (isTableSame_[table] ? "true" : "false") << ", \"before\": \"" << hashBefore_[table]
+         << "\", \"after\": \"" << hashAfter_[table] << "\" }";
+    }
+  json << std::endl << "  }," << std::endl
+       << "  \"layers_read\": " << layersRead_ << "," << std::endl
+       << "  \"layers\": [";
+  for (size_t i= 0; i < layerDiffs_.size(); ++i) {
+    const LayerDiffTyp &layerDiff= layerDiffs_[i];
+    json << (0 == i ? "" : ",") << std::endl
+         << "    { \"table\": \"" << OutputFingerprint::GetTableName(layerDiff.table) << "\", \"layer\": " << layerDiff.layer
+         << ", \"rows_before\": " << layerDiff.rowsBefore << ", \"rows_after\": " << layerDiff.rowsAfter << " }";
+    }
+  json << std::endl << "  ]," << std::endl
+       << "  \"row_count\": " << GetRowDiffCount() << "," << std::endl
+       << "  \"counts\": {";
+  for (long type= 0; type < DIFF_NUM_OF_TYPES; ++type) {
+    json << (0 == type ? " " : ", ") << "\"" << DIFF_TYPE_NAMES[type] << "\": " << counts_[type];
+    }
+  json << " }," << std::endl
+       << "  \"rows\": [";
+  for (size_t i= 0; i < rowDiffs_.size(); ++i) {
+    const RowDiffTyp &rowDiff= rowDiffs_[i];
+    json << (0 == i ? "" : ",") << std::endl
+         << "    { \"table\": \"" << OutputFingerprint::GetTableName(rowDiff.table) << "\", \"type\": \""
+         << DIFF_TYPE_NAMES[rowDiff.type] << "\", \"layer\": " << rowDiff.layer << ", \"angle\": " << rowDiff.angle << " }";
+    }
+  json << std::endl << "  ]" << std::endl << "}" << std::endl;
+  return json.str();
+  }
+
+long FingerprintDiff::WriteJson(const std::string &fileName) const {
+  // return value indicates success or error
+  std::ofstream output(fileName.c_str());
+  output << ToJson();
+  output.close();
+  if (!output) {
+    std::cout << "Error writing the fingerprint differences to " << fileName << std::endl;
+    return RTN_ERROR;
+    }
+  return RTN_NO_ERROR;
+  }
+
+const char* FingerprintDiff::GetTypeName(DiffTypes type) {
+  return DIFF_TYPE_NAMES[type];
+  }
+
+// private helper functions
+long FingerprintDiff::CompareTable(const OutputFingerprint &before, const OutputFingerprint &after,
+                                   OutputFingerprint::Tables table) {
+  // return value indicates success or error
+  static const OutputFingerprint::layer_list noLayers;
+  const OutputFingerprint::layer_list &layersBefore= before.IsSet(table) ? before.GetLayers(table) : noLayers;
+  const OutputFingerprint::layer_list &layersAfter= after.IsSet(table) ? after.GetLayers(table) : noLayers;
+
+  // both are in layer order. Merge them by layer number.
+  OutputFingerprint::row_list rowsBefore;
+  OutputFingerprint::row_list rowsAfter;
+  size_t b= 0;
+  size_t a= 0;
+  while (b < layersBefore.size() || a < layersAfter.size()) {
+    const bool isInBefore= b < layersBefore.size() && (a == layersAfter.size() || layersBefore[b].layer <= layersAfter[a].layer);
+    const bool isInAfter= a < layersAfter.size() && (b == layersBefore.size() || layersAfter[a].layer <= layersBefore[b].layer);
+    const long layer= isInBefore ? layersBefore[b].layer : layersAfter[a].layer;
+    if (isInBefore && isInAfter && layersBefore[b].hash == layersAfter[a].hash) {
+      ++b;
+      ++a;
+      continue;
+      }
+
+    rowsBefore.clear();
+    rowsAfter.clear();
+    if ((isInBefore && RTN_NO_ERROR != before.ReadRows(table, b, rowsBefore)) ||
+        (isInAfter && RTN_NO_ERROR != after.ReadRows(table, a, rowsAfter)))
+      return RTN_ERROR;
+    ++layersRead_;
+    const LayerDiffTyp layerDiff= { table, layer, rowsBefore.size(), rowsAfter.size() };
+    layerDiffs_.push_back(layerDiff);
+    CompareRows(table, layer, rowsBefore, rowsAfter);
+    if (isInBefore)
+      ++b;
+    if (isInAfter)
+      ++a;
+    }
+  return RTN_NO_ERROR;
+  }
+
+void FingerprintDiff::CompareRows(OutputFingerprint::Tables table, long layer, const OutputFingerprint::row_list &rowsBefore,
+                                  const OutputFingerprint::row_list &rowsAfter) {
+  // rows are in (angle, hash) order. Rows at the same angle with the same hash are the same row.
+  // The others at that angle pair up as changed, and the rest are added or removed.
+  size_t b= 0;
+  size_t a= 0;
+  while (b < rowsBefore.size() || a < rowsAfter.size()) {
+    if (a == rowsAfter.size() || (b < rowsBefore.size() && rowsBefore[b].angle < rowsAfter[a].angle)) {
+      AddRowDiff(table, DIFF_ROW_REMOVED, layer, rowsBefore[b++].angle);
+      continue;
+      }
+    if (b == rowsBefore.size() || rowsAfter[a].angle < rowsBefore[b].angle) {
+      AddRowDiff(table, DIFF_ROW_ADDED, layer, rowsAfter[a++].angle);
+      continue;
+      }
+
+    const double angle= rowsBefore[b].angle;
+    size_t unmatchedBefore= 0;
+    size_t unmatchedAfter= 0;
+    while (b < rowsBefore.size() && a < rowsAfter.size() && angle == rowsBefore[b].angle && angle == rowsAfter[a].angle) {
+      if (rowsBefore[b].hash == rowsAfter[a].hash) {
+        ++b;
+        ++a;
+        }
+      else if (rowsBefore[b].hash < rowsAfter[a].hash) {
+        ++unmatchedBefore;
+        ++b;
+        }
+      else {
+        ++unmatchedAfter;
+        ++a;
+        }
+      }
+    for (; b < rowsBefore.size() && angle == rowsBefore[b].angle; ++b) {
+      ++unmatchedBefore;
+      }
+    for (; a < rowsAfter.size() && angle == rowsAfter[a].angle; ++a) {
+      ++unmatchedAfter;
+      }
+    for (; 0 < unmatchedBefore && 0 < unmatchedAfter; --unmatchedBefore, --unmatchedAfter) {
+      AddRowDiff(table, DIFF_ROW_CHANGED, layer, angle);
+      }
+    for (; 0 < unmatchedBefore; --unmatchedBefore) {
+      AddRowDiff(table, DIFF_ROW_REMOVED, layer, angle);
+      }
+    for (; 0 < unmatchedAfter; --unmatchedAfter) {
+      AddRowDiff(table, DIFF_ROW_ADDED, layer, angle);
+      }
+    }
+  }
+
+void FingerprintDiff::AddRowDiff(OutputFingerprint::Tables table, DiffTypes type, long layer, double angle) {
+  ++counts_[type];
+  if (rowDiffs_.size() < FINGERPRINT_MAX_REPORTED) {
+    const RowDiffTyp rowDiff= { table, type, layer, angle };
+    rowDiffs_.push_back(rowDiff);
+    }
+  }
+
+} // namespace gaScsData
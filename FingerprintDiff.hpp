@@ -0,0 +1,114 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: FingerprintDiff.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Compares two generations by their fingerprints (OutputFingerprint class), and finds the layers and
+ *            rows that differ. The hash trees are compared top down:
+ *              tables with the same hash are the same, and their layers are not looked at
+ *              layers with the same number and hash are the same, and their rows are not read
+ *              rows of the other layers are merged by angle
+ *            So the work is in the changed layers only. A layer is compared by its rows, so a changed row is
+ *            found by its RIA angle, not by its values. The values are in the db or the export of each generation.
+ *
+ *            Differences:
+ *              changed      -- a row at the same angle in both, with other values
+ *              added        -- a row in the after generation only
+ *              removed      -- a row in the before generation only
+ *            Rows are listed by table, layer, and angle, the first FINGERPRINT_MAX_REPORTED of them. All are counted.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_FingerprintDiff_H_
+#define GA_FingerprintDiff_H_
+
+// standard c/c++ libraries
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+#include "OutputFingerprint.hpp"
+
+namespace gaScsData {
+
+class FingerprintDiff : private boost::noncopyable {
+
+public:
+  // typedefs and enums
+    enum DiffTypes {
+      DIFF_ROW_CHANGED= 0,
+      DIFF_ROW_ADDED,
+      DIFF_ROW_REMOVED,
+      DIFF_NUM_OF_TYPES };
+
+    struct RowDiffTyp {
+      OutputFingerprint::Tables table;
+      DiffTypes type;
+      long layer;
+      double angle;         // RIA angle
+      };
+    typedef std::vector<RowDiffTyp> row_diff_list;
+
+    // a layer that differs
+    struct LayerDiffTyp {
+      OutputFingerprint::Tables table;
+      long layer;
+      size_t rowsBefore;    // 0 if the layer is in the after generation only
+      size_t rowsAfter;     // 0 if the layer is in the before generation only
+      };
+    typedef std::vector<LayerDiffTyp> layer_diff_list;
+
+  // ctors and dtor
+    FingerprintDiff();
+    ~FingerprintDiff();
+
+  // accessors
+    bool IsTableSame(OutputFingerprint::Tables table) const;
+    const layer_diff_list& GetLayerDiffs() const;
+    size_t GetRowDiffCount() const;
+    size_t GetRowDiffCount(DiffTypes type) const;
+    // the first FINGERPRINT_MAX_REPORTED row differences
+    const row_diff_list& GetRowDiffs() const;
+    // layers whose rows were read by the last Compare()
+    size_t GetLayersRead() const;
+
+  // public member functions
+    // Compare the generations. A table fingerprinted in one of them only is all added or all removed rows.
+    // Return value is RTN_NO_ERROR if they are the same, RTN_ERROR if they differ or rows can't be read.
+    long Compare(const OutputFingerprint &before, const OutputFingerprint &after);
+    // Open the fingerprint files and compare them.
+    long CompareFiles(const std::string &beforeFile, const std::string &afterFile);
+    // report as a JSON document
+    std::string ToJson() const;
+    // write ToJson() to the file. Return value indicates success or error
+    long WriteJson(const std::string &fileName) const;
+
+    // type name used in the report
+    static const char* GetTypeName(DiffTypes type);
+
+  private:
+    // helper functions
+      // Return value indicates success or error (rows that can't be read)
+      long CompareTable(const OutputFingerprint &before, const OutputFingerprint &after, OutputFingerprint::Tables table);
+      // merge the rows of one layer by angle
+      void CompareRows(OutputFingerprint::Tables table, long layer, const OutputFingerprint::row_list &rowsBefore,
+                       const OutputFingerprint::row_list &rowsAfter);
+      void AddRowDiff(OutputFingerprint::Tables table, DiffTypes type, long layer, double angle);
+
+    // member variables
+      bool isTableSame_[OutputFingerprint::TABLE_NUM_OF_TABLES];
+      std::string hashBefore_[OutputFingerprint::TABLE_NUM_OF_TABLES];
+      std::string hashAfter_[OutputFingerprint::TABLE_NUM_OF_TABLES];
+      layer_diff_list layerDiffs_;
+      row_diff_list rowDiffs_;
+      size_t counts_[DIFF_NUM_OF_TYPES];
+      size_t layersRead_;
+};
+
+} // namespace gaScsData
+#endif // GA_FingerprintDiff_H_
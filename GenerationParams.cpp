@@ -0,0 +1,103 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: GenerationParams.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Tunable position and event generation parameters, as a runtime object.
+ *
+ * Libraries used:  string
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <sstream>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "GenerationParams.hpp"
+#include "Checksum.hpp"
+
+namespace gaScsData {
+
+// parameter names, in report order
+struct ParamNameTyp {
+  const char *name;
+  double GenerationParams::*member;
+  };
+static const ParamNameTyp PARAM_NAMES[]= {
+  { "adv_foot_ria_offset_angle", &GenerationParams::advFootRiaOffsetAngle },
+  { "ret_foot_ria_offset_angle", &GenerationParams::retFootRiaOffsetAngle },
+  { "new_layer_offset", &GenerationParams::newLayerOffset },
+  { "joggle_retract_adj_threshold", &GenerationParams::joggleRetractAdjThreshold },
+  { "joggle_full_retract_threshold", &GenerationParams::joggleFullRetractThreshold },
+  { "joggle_adv_to_first_threshold", &GenerationParams::joggleAdvToFirstThreshold },
+  { "trans_straight_length", &GenerationParams::transStraightLength },
+  { "trans_arc_deg", &GenerationParams::transArcDeg },
+  { "lr_mv_to_inner_turn_offset", &GenerationParams::lrMvToInnerTurnOffset },
+  { "lr_inner_turn_offset", &GenerationParams::lrInnerTurnOffset },
+  { "lr_mv_to_outer_turn_offset", &GenerationParams::lrMvToOuterTurnOffset },
+  { "lr_outer_turn_offset", &GenerationParams::lrOuterTurnOffset } };
+static const size_t NUM_OF_PARAM_NAMES= sizeof(PARAM_NAMES) / sizeof(PARAM_NAMES[0]);
+
+// ctors and dtor
+GenerationParams::GenerationParams() :
+    advFootRiaOffsetAngle(ADV_FOOT_RIA_OFFSET_ANGLE),
+    retFootRiaOffsetAngle(RET_FOOT_RIA_OFFSET_ANGLE),
+    newLayerOffset(NEW_LAYER_OFFSET),
+    joggleRetractAdjThreshold(JOGGLE_RETRACT_ADJ_THRESHOLD),
+    joggleFullRetractThreshold(JOGGLE_FULL_RETRACT_THRESHOLD),
+    joggleAdvToFirstThreshold(JOGGLE_ADV_TO_FIRST_THRESHOLD),
+    transStraightLength(TRANS_STRAIGHT_LENGTH),
+    transArcDeg(TRANS_ARC_DEG),
+    lrMvToInnerTurnOffset(LR_MV_TO_INNER_TURN_OFFSET),
+    lrInnerTurnOffset(LR_INNER_TURN_OFFSET),
+    lrMvToOuterTurnOffset(LR_MV_TO_OUTER_TURN_OFFSET),
+    lrOuterTurnOffset(LR_OUTER_TURN_OFFSET) { }
+
+// public member functions
+double GenerationParams::GetTransRo() const {
+  // same formula as TRANS_Ro
+  return transStraightLength / sin(transArcDeg * DEG_TO_RADIANS);
+  }
+
+long GenerationParams::SetValue(const std::string &name, double value) {
+  for (size_t i= 0; i < NUM_OF_PARAM_NAMES; ++i) {
+    if (name == PARAM_NAMES[i].name) {
+      this->*PARAM_NAMES[i].member= value;
+      return RTN_NO_ERROR;
+      }
+    }
+  return RTN_ERROR;
+  }
+
+long GenerationParams::GetValue(const std::string &name, double &value) const {
+  for (size_t i= 0; i < NUM_OF_PARAM_NAMES; ++i) {
+    if (name == PARAM_NAMES[i].name) {
+      value= this->*PARAM_NAMES[i].member;
+      return RTN_NO_ERROR;
+      }
+    }
+  return RTN_ERROR;
+  }
+
+std::string GenerationParams::ToJson() const {
+  std::ostringstream json;
+  json << "{ ";
+  for (size_t i= 0; i < NUM_OF_PARAM_NAMES; ++i) {
+    json << (0 == i ? "" : ", ") << "\"" << PARAM_NAMES[i].name << "\": " << this->*PARAM_NAMES[i].member;
+    }
+  json << " }";
+  return json.str();
+  }
+
+void GenerationParams::AddToChecksum(Checksum &checksum) const {
+  for (size_t i= 0; i < NUM_OF_PARAM_NAMES; ++i) {
+    checksum.Add(this->*PARAM_NAMES[i].member);
+    }
+  }
+
+} // namespace gaScsData
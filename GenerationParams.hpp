@@ -0,0 +1,69 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: GenerationParams.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Tunable position and event generation parameters, as a runtime object.
+ *            The defaults are the gaScsDataConstants.hpp values, so a default constructed
+ *            GenerationParams gives the same tables as before. AxisPositions and EventMap
+ *            take a copy (SetGenerationParams()), so many parameter sets can be evaluated
+ *            at once without a rebuild (see ParameterSweep).
+ *
+ *            Parameters can also be set by name (the constant name in lower case, like
+ *            "trans_arc_deg"), for the sweep file and reports.
+ *
+ * Libraries used:  string
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_GenerationParams_H_
+#define GA_GenerationParams_H_
+
+// standard c/c++ libraries
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+
+namespace gaScsData {
+
+class Checksum;
+
+struct GenerationParams {
+  // ctors and dtor
+    // the gaScsDataConstants.hpp values
+    GenerationParams();
+
+  // public member functions
+    // transition outer arc radius (TRANS_Ro) from the straight length and arc angle
+    double GetTransRo() const;
+    // set or get a parameter by name. Return value indicates success, or RTN_ERROR for an unknown name.
+    long SetValue(const std::string &name, double value);
+    long GetValue(const std::string &name, double &value) const;
+    // the parameters as a JSON object
+    std::string ToJson() const;
+    // add the parameters to a checksum, in report order
+    void AddToChecksum(Checksum &checksum) const;
+
+  // parameters
+    // RIA foot offsets and the new layer row offset (degrees)
+    double advFootRiaOffsetAngle;       // ADV_FOOT_RIA_OFFSET_ANGLE
+    double retFootRiaOffsetAngle;       // RET_FOOT_RIA_OFFSET_ANGLE
+    double newLayerOffset;              // NEW_LAYER_OFFSET
+    // joggle adjustment thresholds (degrees)
+    double joggleRetractAdjThreshold;   // JOGGLE_RETRACT_ADJ_THRESHOLD
+    double joggleFullRetractThreshold;  // JOGGLE_FULL_RETRACT_THRESHOLD
+    double joggleAdvToFirstThreshold;   // JOGGLE_ADV_TO_FIRST_THRESHOLD
+    // transition geometry
+    double transStraightLength;         // TRANS_STRAIGHT_LENGTH, mm
+    double transArcDeg;                 // TRANS_ARC_DEG, degrees
+    // landing roller event offsets (degrees)
+    double lrMvToInnerTurnOffset;       // LR_MV_TO_INNER_TURN_OFFSET
+    double lrInnerTurnOffset;           // LR_INNER_TURN_OFFSET
+    double lrMvToOuterTurnOffset;       // LR_MV_TO_OUTER_TURN_OFFSET
+    double lrOuterTurnOffset;           // LR_OUTER_TURN_OFFSET
+};
+
+} // namespace gaScsData
+#endif // GA_GenerationParams_H_
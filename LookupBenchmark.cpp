@@ -0,0 +1,118 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: LookupBenchmark.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Times random coil map lower bound (Lb) lookups using a tree,
+ *            a flat map binary search, and the CoilMap angle bucket index.
+ *
+ * Libraries used:  random
+ *                  chrono
+ *                  Boost Non-copyable
+ *                  Boost Map Container
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <random>
+#include <chrono>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "LookupBenchmark.hpp"
+
+namespace gaScsData {
+
+// ctors and dtor
+LookupBenchmark::LookupBenchmark(const CoilMap &coilMap) :
+    coilMap_(coilMap) { }
+
+LookupBenchmark::~LookupBenchmark() { }
+
+long LookupBenchmark::Run(size_t lookupCount) {
+  // return value indicates success or error
+  const CoilMap::coil_map &flatMap= coilMap_.mapCoil_;
+  if (flatMap.empty() || 0 == lookupCount) {
+    std::cout << "Lookup benchmark: coil map is empty, nothing to do." << std::endl;
+    return RTN_NO_RESULTS;
+    }
+
+  // copy the coil map into a tree to compare against
+  typedef boost::container::map<double, CoilMap::angle_properties> tree_map;
+  tree_map treeMap(flatMap.begin(), flatMap.end());
+
+  // random angles over the coil map range, plus a little on each side to exercise the ends.
+  // Fixed seed so runs are repeatable. Generated up front so the generator is not timed.
+  std::vector<double> angles;
+  angles.reserve(lookupCount);
+  std::mt19937 generator(12345);
+  std::uniform_real_distribution<double> distribution(flatMap.begin()->first - COLUMN_INCREMENT,
+                                                      flatMap.rbegin()->first + COLUMN_INCREMENT);
+  for (size_t i= 0; i < lookupCount; ++i) {
+    angles.push_back(distribution(generator));
+    }
+
+  // each method sums the angles of the rows found. The sums must match,
+  // and using the result keeps the optimizer from removing the lookups.
+  typedef std::chrono::steady_clock clock;
+  double treeSum= 0.0;
+  double flatSum= 0.0;
+  double bucketSum= 0.0;
+  size_t mismatches= 0;
+
+  // 1) tree
+  clock::time_point start= clock::now();
+  for (size_t i= 0; i < lookupCount; ++i) {
+    tree_map::const_iterator cit= treeMap.upper_bound(angles[i]);
+    if (cit != treeMap.begin())
+      --cit;
+    treeSum+= cit->first;
+    }
+  const double treeMs= std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+  // 2) flat map binary search
+  start= clock::now();
+  for (size_t i= 0; i < lookupCount; ++i) {
+    CoilMap::cm_cit cit= flatMap.upper_bound(angles[i]);
+    if (cit != flatMap.begin())
+      --cit;
+    flatSum+= cit->first;
+    }
+  const double flatMs= std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+  // 3) bucket index
+  start= clock::now();
+  for (size_t i= 0; i < lookupCount; ++i) {
+    bucketSum+= coilMap_.LbIterator(angles[i])->first;
+    }
+  const double bucketMs= std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+  // check every lookup, not just the sums (untimed)
+  for (size_t i= 0; i < lookupCount; ++i) {
+    CoilMap::cm_cit cit= flatMap.upper_bound(angles[i]);
+    if (cit != flatMap.begin())
+      --cit;
+    if (cit != coilMap_.LbIterator(angles[i]))
+      ++mismatches;
+    }
+
+  // output the results
+  const double nsPerMs= 1000000.0 / static_cast<double>(lookupCount);
+  std::cout << "Lookup benchmark: " << lookupCount << " random Lb lookups over " << flatMap.size() << " coil map rows." << std::endl;
+  std::cout << "  tree (map) upper_bound:      " << treeMs << " ms (" << treeMs * nsPerMs << " ns/lookup)" << std::endl;
+  std::cout << "  flat map upper_bound:        " << flatMs << " ms (" << flatMs * nsPerMs << " ns/lookup)" << std::endl;
+  std::cout << "  bucket index (" << COIL_MAP_BUCKET_SIZE << " deg):     " << bucketMs << " ms (" << bucketMs * nsPerMs << " ns/lookup)" << std::endl;
+
+  if (0 != mismatches || treeSum != flatSum || flatSum != bucketSum) {
+    std::cout << "  Lookup methods disagree! Mismatches: " << mismatches << std::endl;
+    return RTN_ERROR;
+    }
+  std::cout << "  All methods found the same rows." << std::endl;
+  return RTN_NO_ERROR;
+  }
+
+} // namespace gaScsData
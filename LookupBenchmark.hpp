@@ -0,0 +1,53 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: LookupBenchmark.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Times random coil map lower bound (Lb) lookups three ways, and checks
+ *            they all give the same row:
+ *              1) a tree (boost::container::map, what the coil map used to be)
+ *              2) upper_bound binary search of the flat map
+ *              3) the CoilMap angle bucket index (LbIterator)
+ *            The lookup angles are random (fixed seed) over the range of the coil map, which
+ *            is the access pattern of a random access caller that can't walk a cursor forward.
+ *
+ * Libraries used:  random
+ *                  chrono
+ *                  Boost Non-copyable
+ *                  Boost Map Container
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_LookupBenchmark_H_
+#define GA_LookupBenchmark_H_
+
+// standard c/c++ libraries
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+#include "CoilMap.hpp"
+
+namespace gaScsData {
+
+class LookupBenchmark : private boost::noncopyable {
+
+public:
+  // ctors and dtor
+    // the coil map must be populated before Run() is called
+    explicit LookupBenchmark(const CoilMap &coilMap);
+    ~LookupBenchmark();
+
+  // public member functions
+    // time lookupCount random Lb lookups with each method, and output the results.
+    // return value indicates success or error. Error if the methods do not agree, or the coil map is empty.
+    long Run(size_t lookupCount);
+
+  private:
+    // member variables
+      const CoilMap &coilMap_;
+};
+
+} // namespace gaScsData
+#endif // GA_LookupBenchmark_H_
@@ -0,0 +1,547 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: LookupService.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Resident lookup service. Answers position and event queries over a local TCP socket
+ *            from an in memory snapshot of the tables in the db, and reloads the snapshot when the
+ *            db generation rows of the tables change.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  memory
+ *                  SQLAPI.h
+ *                  thread
+ *                  mutex
+ *                  condition_variable
+ *                  chrono
+ *                  Boost Asio
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <limits>
+#include <cctype>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "LookupService.hpp"
+#include "CoilMapGenerator.hpp"
+#include "EventMap.hpp"
+#include "Metrics.hpp"
+#include "ProgressReporter.hpp"
+#include "PositionResolver.hpp"
+#include "TableGeneration.hpp"
+#include "TablePublisher.hpp"
+
+namespace gaScsData {
+
+// One connection. Reads a request line, writes the response, and repeats until the connection is closed.
+class LookupService::Session : public std::enable_shared_from_this<LookupService::Session> {
+public:
+  Session(LookupService &service, boost::asio::ip::tcp::socket socket) :
+      service_(service),
+      socket_(std::move(socket)),
+      request_(LOOKUP_MAX_REQUEST) { }
+
+  void Start() { Read(); }
+
+private:
+  void Read() {
+    std::shared_ptr<Session> self(shared_from_this());
+    boost::asio::async_read_until(socket_, request_, '\n',
+      [this, self](const boost::system::error_code &error, size_t) {
+        if (error)
+          return;  // closed, or the request is too long
+        std::istream in(&request_);
+        std::string line;
+        std::getline(in, line);
+        Write(service_.HandleRequest(line, response_));
+        });
+    }
+
+  void Write(RequestResult result) {
+    std::shared_ptr<Session> self(shared_from_this());
+    boost::asio::async_write(socket_, boost::asio::buffer(response_),
+      [this, self, result](const boost::system::error_code &error, size_t) {
+        if (RR_SHUTDOWN == result)
+          service_.Stop();
+        else if (!error && RR_CONTINUE == result)
+          Read();
+        });
+    }
+
+  LookupService &service_;
+  boost::asio::ip::tcp::socket socket_;
+  boost::asio::streambuf request_;
+  std::string response_;
+};
+
+// ctors and dtor
+LookupService::LookupService(unsigned short port, const std::string &source, const CoilGeometry &geometry) :
+    port_(port),
+    source_(source),
+    geometry_(geometry),
+    publishFile_(PUBLISH_FILE),
+    generation_(0),
+    ioService_(),
+    acceptor_(ioService_),
+    socket_(ioService_),
+    signals_(ioService_, SIGINT, SIGTERM),
+    console_(&std::cout),
+    isReloadRequested_(false),
+    isStopping_(false) {
+  // use SQL server native client, with the ODBC API
+  dbConnection_.setClient(SA_SQLServer_Client);
+  dbConnection_.setOption("UseAPI")= "ODBC";
+  dbCommand_.setConnection(&dbConnection_);
+  }
+
+LookupService::~LookupService() {
+  Stop();
+  if (reloadThread_.joinable())
+    reloadThread_.join();
+  }
+
+// public member functions
+long LookupService::Run() {
+  // return value indicates success or error
+  // Discard the console output of the generation code, and turn off the progress display.
+  // Service messages go to the real console.
+  const bool wasHeadless= ProgressReporter::IsHeadless();
+  ProgressReporter::SetHeadless(true);
+  std::ostream console(std::cout.rdbuf());
+  console_= &console;
+  std::streambuf *coutBuffer= std::cout.rdbuf(nullptr);
+
+  long status= RTN_NO_ERROR;
+  std::unique_ptr<SnapshotTyp> snapshot(new SnapshotTyp());
+  std::string message;
+  if (RTN_NO_ERROR != Load(*snapshot, message)) {
+    console << "Lookup service: error when loading the " << source_ << " coil map, positions, and events. " << message << std::endl;
+    status= RTN_ERROR;
+    }
+  else {
+    if (!message.empty())
+      console << "Lookup service: " << message << std::endl;
+    snapshot->generation= ++generation_;
+    std::atomic_store(&snapshot_, snapshot_ptr(snapshot.release()));
+    try {
+      // local connections only
+      const boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address_v4::loopback(), port_);
+      acceptor_.open(endpoint.protocol());
+      acceptor_.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+      acceptor_.bind(endpoint);
+      acceptor_.listen();
+      }
+    catch (const boost::system::system_error &ex) {
+      console << "Lookup service: can't listen on port " << port_ << ": " << ex.what() << std::endl;
+      status= RTN_ERROR;
+      }
+    }
+
+  if (RTN_NO_ERROR == status) {
+    const snapshot_ptr current= GetSnapshot();
+    console << "Lookup service listening on 127.0.0.1:" << port_ << ". " << current->positions.size() << " positions, "
+            << current->events.size() << " events, loaded in " << current->loadMs << " ms." << std::endl
+            << "Send SHUTDOWN or press ctrl-c to stop." << std::endl;
+    signals_.async_wait([this](const boost::system::error_code &, int) { Stop(); });
+    Accept();
+    reloadThread_= std::thread(&LookupService::ReloadWorker, this);
+
+    // request threads. This thread is one of them.
+    std::vector<std::thread> threads;
+    for (size_t i= 1; i < LOOKUP_SERVICE_THREADS; ++i) {
+      threads.push_back(std::thread([this]() { ioService_.run(); }));
+      }
+    ioService_.run();
+    for (size_t i= 0; i < threads.size(); ++i) {
+      threads[i].join();
+      }
+    reloadThread_.join();
+    console << "Lookup service stopped." << std::endl;
+    }
+
+  // restore console output
+  std::cout.rdbuf(coutBuffer);
+  std::cout.clear();
+  console_= &std::cout;
+  ProgressReporter::SetHeadless(wasHeadless);
+  return status;
+  }
+
+LookupService::RequestResult LookupService::HandleRequest(const std::string &request, std::string &response) {
+  Metrics::ScopedTimer latency("lookup.request", Metrics::TK_LATENCY);
+  const snapshot_ptr snapshot= GetSnapshot();
+  std::istringstream in(request);
+  std::string command;
+  in >> command;
+  std::transform(command.begin(), command.end(), command.begin(), ::toupper);
+
+  std::ostringstream rows;
+  rows.precision(3);
+  rows << std::fixed;
+  size_t rowCount= 0;
+  RequestResult result= RR_CONTINUE;
+  std::string error;
+
+  if (!snapshot)
+    error= "nothing loaded";
+  else if ("RANGE" == command) {
+    double from, to;
+    if (!(in >> from >> to) || to < from)
+      error= "usage: RANGE <from> <to>";
+    else {
+      position_list::const_iterator pFirst= std::lower_bound(snapshot->positions.begin(), snapshot->positions.end(), from,
+        [](const PositionRowTyp &row, double value) { return row.riaAngle < value; });
+      position_list::const_iterator pLast= std::upper_bound(pFirst, snapshot->positions.end(), to,
+        [](double value, const PositionRowTyp &row) { return value < row.riaAngle; });
+      event_list::const_iterator eFirst= std::lower_bound(snapshot->events.begin(), snapshot->events.end(),
+                                                          std::make_pair(from, std::numeric_limits<long>::min()));
+      event_list::const_iterator eLast= std::upper_bound(eFirst, snapshot->events.end(),
+                                                         std::make_pair(to, std::numeric_limits<long>::max()));
+      rowCount= (pLast - pFirst) + (eLast - eFirst);
+      if (LOOKUP_MAX_ROWS < rowCount)
+        error= "more than " + std::to_string(static_cast<unsigned long long>(LOOKUP_MAX_ROWS)) + " rows";
+      for (; error.empty() && pFirst != pLast; ++pFirst) {
+        rows << "P " << pFirst->riaAngle << " " << pFirst->coilAngle << " " << pFirst->isSelected << " " << pFirst->isAbsolute;
+        for (size_t i= 0; i < pFirst->positions.size(); ++i) {
+          rows << " " << pFirst->positions[i];
+          }
+        rows << " " << pFirst->action << "\n";
+        }
+      for (; error.empty() && eFirst != eLast; ++eFirst) {
+        rows << "E " << eFirst->first << " " << eFirst->second << "\n";
+        }
+      }
+    }
+  else if ("NEXT" == command) {
+    double angle;
+    size_t count;
+    if (!(in >> angle >> count) || 0 == count)
+      error= "usage: NEXT <angle> <n>";
+    else {
+      event_list::const_iterator cit= std::lower_bound(snapshot->events.begin(), snapshot->events.end(),
+                                                       std::make_pair(angle, std::numeric_limits<long>::min()));
+      for (; cit != snapshot->events.end() && rowCount < count && rowCount < LOOKUP_MAX_ROWS; ++cit, ++rowCount) {
+        rows << "E " << cit->first << " " << cit->second << "\n";
+        }
+      }
+    }
+  else if ("FEET" == command) {
+    double angle;
+    if (!(in >> angle))
+      error= "usage: FEET <angle>";
+    else {
+      position_list::const_iterator cit= std::upper_bound(snapshot->positions.begin(), snapshot->positions.end(), angle,
+        [](double value, const PositionRowTyp &row) { return value < row.riaAngle; });
+      if (cit == snapshot->positions.begin())
+        error= "no position at or before the angle";
+      else {
+        --cit;
+        rows << "F " << cit->riaAngle;
+        for (size_t i= 0; i < cit->positions.size(); ++i) {
+          rows << " " << cit->positions[i];
+          }
+        rows << "\n";
+        rowCount= 1;
+        }
+      }
+    }
+  else if ("COIL" == command) {
+    double angle;
+    if (!(in >> angle))
+      error= "usage: COIL <angle>";
+    else {
+      const double rowAngle= snapshot->coilMap->GetAngleLb(angle);
+      if (NO_FEATURE == rowAngle)
+        error= "no coil map row at or before the angle";
+      else {
+        const CoilMap::fhltar row= snapshot->coilMap->GetFhltarLb(angle);
+        rows << "C " << rowAngle << " " << CoilMap::FcToString(row.get<0>()) << " " << row.get<1>() << " " << row.get<2>()
+             << " " << row.get<3>() << " " << row.get<4>() << " " << row.get<5>() << "\n";
+        rowCount= 1;
+        }
+      }
+    }
+  else if ("INFO" == command) {
+    rows << "I generation " << snapshot->generation << " source " << source_ << " positions " << snapshot->positions.size()
+         << " events " << snapshot->events.size() << " load_ms " << snapshot->loadMs << "\n";
+    rowCount= 1;
+    }
+  else if ("RELOAD" == command) {
+    std::lock_guard<std::mutex> lock(reloadMutex_);
+    isReloadRequested_= true;
+    reloadCondition_.notify_one();
+    }
+  else if ("QUIT" == command)
+    result= RR_CLOSE;
+  else if ("SHUTDOWN" == command)
+    result= RR_SHUTDOWN;
+  else
+    error= "unknown request \"" + command + "\"";
+
+  if (!error.empty())
+    response= "ERR " + error + "\n";
+  else
+    response= "OK " + std::to_string(static_cast<unsigned long long>(rowCount)) + "\n" + rows.str();
+  return result;
+  }
+
+LookupService::snapshot_ptr LookupService::GetSnapshot() const {
+  return std::atomic_load(&snapshot_);
+  }
+
+void LookupService::SetPublishFile(const std::string &publishFile) {
+  publishFile_= publishFile;
+  }
+
+// private helper functions
+long LookupService::ReadDbGeneration(uint64_t &scsInputHash, uint64_t &eventsInputHash, std::string &stamp) {
+  // return value indicates success or error
+  std::string errorText;
+  try {
+    if (!dbConnection_.isConnected())
+      dbConnection_.Connect((DB_SERVER_NAME + "@" + DB_DATABASE_NAME).c_str(), DB_USER_NAME.c_str(), DB_PASSWORD.c_str());
+    }
+  catch (SAException &ex) {
+    errorText= (const char*)ex.ErrText();
+    std::cout << errorText << std::endl;
+    return RTN_ERROR;
+    }
+
+  std::ostringstream rows;
+  const std::string tableNames[]= { GENERATION_TABLE_SCS, GENERATION_TABLE_EVENTS };
+  uint64_t *inputHashes[]= { &scsInputHash, &eventsInputHash };
+  for (size_t i= 0; i < 2; ++i) {
+    std::string generatorVersion;
+    if (RTN_ERROR == TableGeneration(tableNames[i]).Read(dbCommand_, *inputHashes[i], generatorVersion, errorText)) {
+      // connect again on the next read, in case the connection was lost
+      try {
+        dbConnection_.Disconnect();
+        }
+      catch (SAException &) {
+        }
+      return RTN_ERROR;
+      }
+    rows << tableNames[i] << " " << std::hex << *inputHashes[i] << std::dec << " " << generatorVersion << " ";
+    }
+  stamp= rows.str();
+  return RTN_NO_ERROR;
+  }
+
+long LookupService::Load(SnapshotTyp &snapshot, std::string &message) {
+  // return value indicates success or error
+  const clock::time_point start= clock::now();
+  message.clear();
+  // read the generation rows first, so a regeneration during the load causes another reload
+  uint64_t scsInputHash= 0;
+  uint64_t eventsInputHash= 0;
+  if (BATCH_SOURCE_DB == source_ && RTN_NO_ERROR != ReadDbGeneration(scsInputHash, eventsInputHash, snapshot.stamp)) {
+    message= "Can't read the db generation rows of the tables.";
+    return RTN_ERROR;
+    }
+  snapshot.coilMap.reset(new CoilMap());
+  CoilMap &coilMap= *snapshot.coilMap;
+  long coilAngleMax= geometry_.GetCoilAngleMax();
+  if (RTN_NO_ERROR != coilMap.SetGeometry(geometry_))
+    return RTN_ERROR;
+  if (BATCH_SOURCE_DB == source_) {
+    if (RTN_NO_ERROR != coilMap.PopulateCoilMap())
+      return RTN_ERROR;
+    }
+  else {
+    CoilMapGenerator generator;
+    generator.SetGeometry(geometry_);
+    CoilMap::coil_map coilRows;
+    if (RTN_NO_ERROR != generator.Generate(coilRows) || RTN_NO_ERROR != coilMap.PopulateCoilMap(coilRows))
+      return RTN_ERROR;
+    coilAngleMax= generator.GetCoilAngleMax();
+    }
+
+  // the tables the db has, from the published file
+  AxisPositions::ScsAxesPositionMap publishedRows;
+  bool isScsLoaded= false;
+  bool isEventsLoaded= false;
+  if (BATCH_SOURCE_DB == source_ &&
+      LoadPublished(scsInputHash, eventsInputHash, publishedRows, isScsLoaded, snapshot.events, isEventsLoaded) &&
+      isScsLoaded)
+    ResolvePositions(publishedRows, snapshot.positions);
+
+  // calculate the tables that were not published, with the default parameters
+  if (!isScsLoaded || !isEventsLoaded) {
+    // positions, and the hqp and layer starts for the events
+    AxisPositions::layerAngleSetTyp hqpStarts;
+    AxisPositions::layerAngleSetTyp layerStarts;
+    AxisPositions axPos(coilMap, coilAngleMax);
+    if (RTN_NO_ERROR != axPos.CalculatePositions())
+      return RTN_ERROR;
+    axPos.GetStartAngleSets(hqpStarts, layerStarts);
+
+    EventMap eventMap(coilMap);
+    if (!isEventsLoaded && RTN_NO_ERROR != eventMap.GenerateEventMap(hqpStarts, layerStarts))
+      return RTN_ERROR;
+
+    // a calculated table is only the db table if it was made from the same inputs
+    std::ostringstream notWritten;
+    if (BATCH_SOURCE_DB == source_) {
+      if (!isScsLoaded && 0 != scsInputHash && axPos.GetInputHash() != scsInputHash) {
+        message= "The SCS positions in the db were not made with the default parameters. Publish them with -p -m.";
+        return RTN_ERROR;
+        }
+      if (!isEventsLoaded && 0 != eventsInputHash && eventMap.GetInputHash() != eventsInputHash) {
+        message= "The events in the db were not made with the default parameters. Publish them with -e -m.";
+        return RTN_ERROR;
+        }
+      if (!isScsLoaded && 0 == scsInputHash)
+        notWritten << " SCS positions";
+      if (!isEventsLoaded && 0 == eventsInputHash)
+        notWritten << " events";
+      }
+    if (!notWritten.str().empty())
+      message= "The db has no generation row of the" + notWritten.str() + ". Serving the calculated tables.";
+
+    if (!isScsLoaded)
+      ResolvePositions(axPos.GetScsPositionMap(), snapshot.positions);
+    if (!isEventsLoaded) {
+      snapshot.events.reserve(eventMap.GetEventCount());
+      const EventMap::EventMapTyp &events= eventMap.GetEventMap();
+      for (EventMap::em_const_iter cit= events.begin(); cit != events.end(); ++cit) {
+        snapshot.events.push_back(std::make_pair(cit->first, cit->second.get<0>()));
+        }
+      }
+    }
+  // by angle, then event id, for the range lookups
+  std::sort(snapshot.events.begin(), snapshot.events.end());
+
+  snapshot.loadMs= std::chrono::duration<double, std::milli>(clock::now() - start).count();
+  return RTN_NO_ERROR;
+  }
+
+bool LookupService::LoadPublished(uint64_t scsInputHash, uint64_t eventsInputHash, AxisPositions::ScsAxesPositionMap &scsRows,
+                                  bool &isScsLoaded, event_list &events, bool &isEventsLoaded) const {
+  PublishedTables tables;
+  if (RTN_NO_ERROR != tables.Open(publishFile_))
+    return false;
+  // copy, then make sure the generation did not change while copying
+  for (long attempt= 0; attempt < PUBLISH_READ_ATTEMPTS; ++attempt) {
+    PublishedTables::ViewTyp view;
+    if (!tables.BeginRead(view))
+      continue;
+    isScsLoaded= 0 != scsInputHash && view.scsInputHash == scsInputHash;
+    isEventsLoaded= 0 != eventsInputHash && view.eventsInputHash == eventsInputHash;
+    scsRows.clear();
+    if (isScsLoaded)
+      PublishedTables::GetScsRows(view, scsRows);
+    events.clear();
+    for (size_t i= 0; isEventsLoaded && i < view.eventCount; ++i) {
+      events.push_back(std::make_pair(view.events[i].angle, static_cast<long>(view.events[i].eventId)));
+      }
+    if (tables.isValid(view))
+      return isScsLoaded || isEventsLoaded;
+    }
+  isScsLoaded= false;
+  isEventsLoaded= false;
+  scsRows.clear();
+  events.clear();
+  return false;
+  }
+
+void LookupService::ResolvePositions(const AxisPositions::ScsAxesPositionMap &scsRows, position_list &positions) {
+  // absolute positions after every row, in one pass
+  PositionResolver::position_table absolute;
+  PositionResolver(scsRows).Materialize(absolute);
+  positions.clear();
+  positions.reserve(scsRows.size());
+  PositionResolver::position_table::const_iterator absoluteIt= absolute.begin();
+  for (AxisPositions::sapm_const_iter cit= scsRows.begin(); cit != scsRows.end(); ++cit, ++absoluteIt) {
+    const AxisPositions::SPosDetail &detail= cit->second;
+    PositionRowTyp row;
+    row.riaAngle= cit->first;
+    row.coilAngle= detail.get<4>().get<8>();
+    row.isSelected= detail.get<2>()[0];
+    row.isAbsolute= detail.get<4>().get<1>();
+    row.positions= *absoluteIt;
+    // move summary, the same as the action description written to the table
+    const std::string &trace= detail.get<4>().get<0>();
+    const size_t msPos= trace.find(MS_TOKEN);
+    row.action= std::string::npos != msPos ? trace.substr(msPos + 1) : trace;
+    std::replace(row.action.begin(), row.action.end(), '\n', ' ');
+    positions.push_back(row);
+    }
+  }
+
+void LookupService::ReloadWorker() {
+  std::string triedStamp= GetSnapshot()->stamp;
+  std::unique_lock<std::mutex> lock(reloadMutex_);
+  while (!isStopping_) {
+    reloadCondition_.wait_for(lock, std::chrono::milliseconds(LOOKUP_RELOAD_POLL_MS));
+    if (isStopping_)
+      break;
+    // the generated source has no generation rows, so only reloads when requested
+    std::string stamp= triedStamp;
+    if (BATCH_SOURCE_DB == source_ && !isReloadRequested_) {
+      lock.unlock();
+      uint64_t scsInputHash, eventsInputHash;
+      const long readStatus= ReadDbGeneration(scsInputHash, eventsInputHash, stamp);
+      lock.lock();
+      if (RTN_NO_ERROR != readStatus)
+        continue;  // db not available, try again on the next poll
+      }
+    if (!isReloadRequested_ && stamp == triedStamp)
+      continue;
+    isReloadRequested_= false;
+
+    // load without the lock, so a stop or another reload request is not held up
+    lock.unlock();
+    std::unique_ptr<SnapshotTyp> snapshot(new SnapshotTyp());
+    std::string message;
+    const long status= Load(*snapshot, message);
+    // the stamp the load used, so a failed load is not tried again until the tables change
+    triedStamp= BATCH_SOURCE_DB == source_ ? snapshot->stamp : stamp;
+    {
+      std::lock_guard<std::mutex> consoleLock(consoleMutex_);
+      if (RTN_NO_ERROR == status) {
+        snapshot->generation= ++generation_;
+        *console_ << "Lookup service reloaded: generation " << snapshot->generation << ", " << snapshot->positions.size()
+                  << " positions, " << snapshot->events.size() << " events, " << snapshot->loadMs << " ms." << std::endl;
+        if (!message.empty())
+          *console_ << "Lookup service: " << message << std::endl;
+        std::atomic_store(&snapshot_, snapshot_ptr(snapshot.release()));
+        }
+      else
+        *console_ << "Lookup service: reload error. " << message << " Still serving generation " << generation_ << "." << std::endl;
+    }
+    lock.lock();
+    }
+  }
+
+void LookupService::Accept() {
+  acceptor_.async_accept(socket_, [this](const boost::system::error_code &error) {
+    if (!acceptor_.is_open())
+      return;  // stopped
+    if (!error) {
+      socket_.set_option(boost::asio::ip::tcp::no_delay(true));
+      std::make_shared<Session>(*this, std::move(socket_))->Start();
+      }
+    Accept();
+    });
+  }
+
+void LookupService::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(reloadMutex_);
+    isStopping_= true;
+    reloadCondition_.notify_one();
+  }
+  ioService_.stop();
+  }
+
+} // namespace gaScsData
@@ -0,0 +1,173 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: LookupService.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Resident lookup service. Loads the coil map, the SCS positions and the events into memory, and answers
+ *            position and event queries over a local TCP socket, so downstream tools and the PLC gateway do not need
+ *            to scan the SQL views during winding.
+ *
+ *            The db source serves the tables in the db. Their generation rows (TableGeneration class) have the input
+ *            hash they were made from. A table is loaded from the published file (TablePublisher, -m argument) if it
+ *            was published from the same input hash. If not, it is calculated with the default parameters, and only
+ *            served if that is the same input hash, so tables made with other parameters (a -b scenario, for
+ *            example) are not served wrong. Publish them with -m to serve them. A table with no generation row is
+ *            calculated and served with a warning.
+ *            The generated source calculates the tables from the standard coil, for testing without a db.
+ *
+ *            The loaded data is an immutable snapshot. Requests use the current snapshot, and a reload builds a
+ *            new one in the background and swaps it in, so requests are never blocked by a reload.
+ *            A reload happens when the db generation rows change (any run that writes the tables), or on a RELOAD request.
+ *
+ *            Protocol: one request per line. The response is "OK <row count>" followed by the rows, or "ERR <reason>".
+ *              RANGE <from> <to>   -- positions (P rows) and events (E rows) with RIA angles from..to (inclusive)
+ *              NEXT <angle> <n>    -- the next n events at or after the angle (E rows)
+ *              FEET <angle>        -- absolute axis positions at the angle (F row), from the SCS row at or before it
+ *              COIL <angle>        -- coil map row at or before the coil angle (C row)
+ *              INFO                -- snapshot generation, row counts, and load time (I row)
+ *              RELOAD              -- reload in the background
+ *              QUIT                -- close the connection
+ *              SHUTDOWN            -- stop the service
+ *            Rows:
+ *              P <ria angle> <coil angle> <selected 0/1> <absolute 0/1> <24 absolute positions> <action description>
+ *              E <angle> <event id>
+ *              F <ria angle of the SCS row> <24 absolute positions>
+ *              C <coil angle> <feature code> <hqp> <layer> <turn> <azimuth> <nominal radius>
+ *            The 24 positions are foot A inner to F outer, then column A inner to F outer.
+ *            INITIAL_NO_POSITION is an axis with no absolute position yet.
+ *
+ *            NOTE: CLS positions are calculated by a db procedure from the SCS table, so they are not served here.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  memory
+ *                  SQLAPI.h
+ *                  thread
+ *                  mutex
+ *                  condition_variable
+ *                  atomic
+ *                  chrono
+ *                  Boost Asio
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_LookupService_H_
+#define GA_LookupService_H_
+
+// standard c/c++ libraries
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+// Boost libraries
+#include <boost/asio.hpp>
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+#include "CoilMap.hpp"
+#include "CoilGeometry.hpp"
+#include "AxisPositions.hpp"
+
+namespace gaScsData {
+
+class LookupService : private boost::noncopyable {
+
+public:
+  // typedefs and enums
+    // SCS row, with the absolute axis positions after the row
+    struct PositionRowTyp {
+      long riaAngle;
+      double coilAngle;
+      bool isSelected;
+      bool isAbsolute;
+      AxisPositions::Positions positions;  // 24 axes
+      std::string action;  // move summary
+      };
+    typedef std::vector<PositionRowTyp> position_list;  // by RIA angle
+
+    // <angle, event id>, by angle
+    typedef std::vector<std::pair<double, long> > event_list;
+
+    // Everything a request needs. Not changed once loaded.
+    struct SnapshotTyp {
+      unsigned long generation;
+      std::string stamp;  // db generation rows of the tables when loaded
+      std::unique_ptr<CoilMap> coilMap;
+      position_list positions;
+      event_list events;
+      double loadMs;
+      };
+    typedef std::shared_ptr<const SnapshotTyp> snapshot_ptr;
+
+    // what the connection does after the response
+    enum RequestResult { RR_CONTINUE, RR_CLOSE, RR_SHUTDOWN };
+
+  // ctors and dtor
+    // source is BATCH_SOURCE_DB or BATCH_SOURCE_GENERATED (standard coil, for testing without a db)
+    LookupService(unsigned short port, const std::string &source, const CoilGeometry &geometry);
+    ~LookupService();
+
+  // public member functions
+    // Load the first snapshot, and serve requests until SHUTDOWN or ctrl-c.
+    // Return value indicates success, or RTN_ERROR if the first load or the socket failed.
+    long Run();
+    // Answer one request line. Public so the requests can be timed without a socket.
+    RequestResult HandleRequest(const std::string &request, std::string &response);
+    snapshot_ptr GetSnapshot() const;
+    // published file the db source loads the tables from, if they are the tables in the db (default PUBLISH_FILE)
+    void SetPublishFile(const std::string &publishFile);
+
+  private:
+    class Session;
+    typedef std::chrono::steady_clock clock;
+
+    // helper functions
+      // Read the db generation rows of the SCS and event tables, connecting if needed. The stamp is both rows.
+      // Return value indicates success or error. A table with no generation row has input hash 0.
+      long ReadDbGeneration(uint64_t &scsInputHash, uint64_t &eventsInputHash, std::string &stamp);
+      // build a snapshot from the source. message is the error, or a warning about the loaded tables.
+      // Return value indicates success or error
+      long Load(SnapshotTyp &snapshot, std::string &message);
+      // the tables in the published file that were made from the input hashes. Return value is false if none.
+      bool LoadPublished(uint64_t scsInputHash, uint64_t eventsInputHash, AxisPositions::ScsAxesPositionMap &scsRows,
+                         bool &isScsLoaded, event_list &events, bool &isEventsLoaded) const;
+      // absolute positions after each SCS row (PositionResolver::Materialize())
+      static void ResolvePositions(const AxisPositions::ScsAxesPositionMap &scsRows, position_list &positions);
+      // reload thread. Reloads when the db generation rows change or a reload is requested, until stopped.
+      void ReloadWorker();
+      void Accept();
+      void Stop();
+
+    // member variables
+      unsigned short port_;
+      std::string source_;
+      CoilGeometry geometry_;
+      std::string publishFile_;
+      SAConnection dbConnection_;  // generation rows. Used by one thread at a time (Run(), then ReloadWorker()).
+      SACommand dbCommand_;
+      snapshot_ptr snapshot_;  // current snapshot. Use std::atomic_load/atomic_store.
+      unsigned long generation_;
+
+      boost::asio::io_service ioService_;
+      boost::asio::ip::tcp::acceptor acceptor_;
+      boost::asio::ip::tcp::socket socket_;  // next connection
+      boost::asio::signal_set signals_;
+
+      std::ostream *console_;  // console, while std::cout output is discarded
+      std::mutex consoleMutex_;
+
+      std::thread reloadThread_;
+      std::mutex reloadMutex_;
+      std::condition_variable reloadCondition_;
+      bool isReloadRequested_;
+      bool isStopping_;
+};
+
+} // namespace gaScsData
+#endif // GA_LookupService_H_
@@ -0,0 +1,174 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: Metrics.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Process wide metrics registry of phase timers, counters,
+ *            and latency histograms, with a JSON report.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  mutex
+ *                  chrono
+ *                  Boost Non-copyable
+ *                  Boost Flat Map Container
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "Metrics.hpp"
+#include "TraceRecorder.hpp"
+
+namespace gaScsData {
+
+// ScopedTimer
+Metrics::ScopedTimer::ScopedTimer(const std::string &name, TimerKind kind) :
+    name_(name),
+    kind_(kind),
+    start_(clock::now()) { }
+
+Metrics::ScopedTimer::~ScopedTimer() {
+  const clock::time_point end= clock::now();
+  const double ms= std::chrono::duration<double, std::milli>(end - start_).count();
+  if (TK_LATENCY == kind_)
+    Metrics::Instance().AddLatency(name_, ms);
+  else
+    Metrics::Instance().AddTime(name_, ms);
+  // also a span on the timeline, if tracing
+  TraceRecorder::Instance().AddSpan(name_, TK_LATENCY == kind_ ? "sproc" : "phase", start_, end);
+  }
+
+double Metrics::ScopedTimer::ElapsedMs() const {
+  return std::chrono::duration<double, std::milli>(clock::now() - start_).count();
+  }
+
+// ctors and dtor
+Metrics::Metrics() :
+    start_(clock::now()) { }
+
+Metrics::~Metrics() { }
+
+Metrics& Metrics::Instance() {
+  // constructed on first use. Static local initialization is thread safe.
+  static Metrics metrics;
+  return metrics;
+  }
+
+// public member functions
+void Metrics::AddTime(const std::string &name, double ms) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  timer_map::iterator it= timers_.find(name);
+  if (it == timers_.end()) {
+    TimerStatsTyp stats= { 1, ms, ms, ms };
+    timers_.insert(timer_map::value_type(name, stats));
+    return;
+    }
+  TimerStatsTyp &stats= it->second;
+  ++stats.count;
+  stats.totalMs+= ms;
+  stats.minMs= std::min(stats.minMs, ms);
+  stats.maxMs= std::max(stats.maxMs, ms);
+  }
+
+void Metrics::AddCount(const std::string &name, long long count) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  counters_[name]+= count;
+  }
+
+void Metrics::AddLatency(const std::string &name, double ms) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  HistogramTyp &histogram= histograms_[name];
+  if (histogram.buckets.empty()) {
+    // new histogram. One bucket per bound, plus one for larger than the last bound.
+    histogram.count= 0;
+    histogram.totalMs= 0.0;
+    histogram.maxMs= 0.0;
+    histogram.buckets.assign(METRICS_NUM_OF_HISTOGRAM_BOUNDS + 1, 0);
+    }
+  ++histogram.count;
+  histogram.totalMs+= ms;
+  histogram.maxMs= std::max(histogram.maxMs, ms);
+  size_t bucket= 0;
+  while (bucket < METRICS_NUM_OF_HISTOGRAM_BOUNDS && ms > METRICS_HISTOGRAM_BOUNDS_MS[bucket])
+    ++bucket;
+  ++histogram.buckets[bucket];
+  }
+
+void Metrics::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  timers_.clear();
+  counters_.clear();
+  histograms_.clear();
+  start_= clock::now();
+  }
+
+std::string Metrics::ToJson() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ostringstream json;
+  json.precision(3);
+  json << std::fixed;
+  json << "{" << std::endl
+       << "  \"elapsed_ms\": " << std::chrono::duration<double, std::milli>(clock::now() - start_).count() << "," << std::endl;
+
+  // timers
+  json << "  \"timers\": {";
+  for (timer_map::const_iterator cit= timers_.begin(); cit != timers_.end(); ++cit) {
+    json << (cit == timers_.begin() ? "" : ",") << std::endl
+         << "    \"" << cit->first << "\": { \"count\": " << cit->second.count
+         << ", \"total_ms\": " << cit->second.totalMs << ", \"min_ms\": " << cit->second.minMs
+         << ", \"max_ms\": " << cit->second.maxMs << " }";
+    }
+  json << std::endl << "  }," << std::endl;
+
+  // counters
+  json << "  \"counters\": {";
+  for (counter_map::const_iterator cit= counters_.begin(); cit != counters_.end(); ++cit) {
+    json << (cit == counters_.begin() ? "" : ",") << std::endl
+         << "    \"" << cit->first << "\": " << cit->second;
+    }
+  json << std::endl << "  }," << std::endl;
+
+  // histograms
+  json << "  \"histogram_bounds_ms\": [";
+  for (size_t i= 0; i < METRICS_NUM_OF_HISTOGRAM_BOUNDS; ++i) {
+    json << (0 == i ? "" : ", ") << METRICS_HISTOGRAM_BOUNDS_MS[i];
+    }
+  json << "]," << std::endl;
+  json << "  \"histograms\": {";
+  for (histogram_map::const_iterator cit= histograms_.begin(); cit != histograms_.end(); ++cit) {
+    json << (cit == histograms_.begin() ? "" : ",") << std::endl
+         << "    \"" << cit->first << "\": { \"count\": " << cit->second.count
+         << ", \"total_ms\": " << cit->second.totalMs << ", \"max_ms\": " << cit->second.maxMs
+         << ", \"buckets\": [";
+    for (size_t i= 0; i < cit->second.buckets.size(); ++i) {
+      json << (0 == i ? "" : ", ") << cit->second.buckets[i];
+      }
+    json << "] }";
+    }
+  json << std::endl << "  }" << std::endl << "}" << std::endl;
+  return json.str();
+  }
+
+long Metrics::WriteJson(const std::string &fileName) const {
+  // return value indicates success or error
+  std::ofstream output(fileName.c_str());
+  output << ToJson();
+  output.close();
+  if (!output) {
+    std::cout << "Error writing the metrics report to " << fileName << std::endl;
+    return RTN_ERROR;
+    }
+  return RTN_NO_ERROR;
+  }
+
+} // namespace gaScsData
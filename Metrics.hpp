@@ -0,0 +1,120 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: Metrics.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Process wide metrics registry, to see where the time of a generation run goes.
+ *            Three kinds of metric are kept by name:
+ *              timers -- steady clock time of a phase (connect, query, calculate, insert, ...).
+ *                        Count, total, min, and max ms.
+ *              counters -- rows, calls, lookups, ...
+ *              histograms -- per call latency (one sample per sproc call, for example).
+ *                        Count, total, max ms, and the number of samples in each
+ *                        METRICS_HISTOGRAM_BOUNDS_MS bucket.
+ *            ToJson() / WriteJson() make a JSON report of everything recorded. main writes it at exit.
+ *            When tracing is enabled (TraceRecorder), each ScopedTimer is also a span on the trace timeline.
+ *
+ *            The registry is thread safe (one mutex), so worker threads can record into it. Recording
+ *            takes the lock and a name lookup, so it belongs around phases and db calls, not inside
+ *            tight calculation loops. Hot loops should count locally and add the total once.
+ *
+ *            Usage:
+ *              { Metrics::ScopedTimer timer("positions.calculate_axis_moves"); CalculateAxisMoves(); }
+ *              Metrics::Instance().AddCount("positions.scs_rows", scsAxisPositionMap_.size());
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  mutex
+ *                  chrono
+ *                  Boost Non-copyable
+ *                  Boost Flat Map Container
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_Metrics_H_
+#define GA_Metrics_H_
+
+// standard c/c++ libraries
+#include <mutex>
+#include <chrono>
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+
+namespace gaScsData {
+
+class Metrics : private boost::noncopyable {
+
+public:
+  // typedefs and enums
+    typedef std::chrono::steady_clock clock;
+
+    // phase timer statistics
+    struct TimerStatsTyp {
+      long long count;
+      double totalMs;
+      double minMs;
+      double maxMs;
+      };
+
+    // latency histogram. buckets[i] counts samples <= METRICS_HISTOGRAM_BOUNDS_MS[i],
+    // and the last bucket counts samples larger than the largest bound.
+    struct HistogramTyp {
+      long long count;
+      double totalMs;
+      double maxMs;
+      std::vector<long long> buckets;
+      };
+
+    typedef boost::container::flat_map<std::string, TimerStatsTyp> timer_map;
+    typedef boost::container::flat_map<std::string, long long> counter_map;
+    typedef boost::container::flat_map<std::string, HistogramTyp> histogram_map;
+
+    // What a ScopedTimer records when it goes out of scope
+    enum TimerKind { TK_PHASE,      // AddTime()
+                     TK_LATENCY };  // AddLatency()
+
+    // Time from construction to destruction, recorded under the name.
+    class ScopedTimer : private boost::noncopyable {
+      public:
+        explicit ScopedTimer(const std::string &name, TimerKind kind = TK_PHASE);
+        ~ScopedTimer();
+        double ElapsedMs() const;  // so far
+      private:
+        std::string name_;
+        TimerKind kind_;
+        clock::time_point start_;
+      };
+
+  // ctors and dtor
+    // the one registry
+    static Metrics& Instance();
+    ~Metrics();
+
+  // public member functions
+    void AddTime(const std::string &name, double ms);
+    void AddCount(const std::string &name, long long count = 1);
+    void AddLatency(const std::string &name, double ms);
+    // clear everything, and restart the run clock
+    void Reset();
+
+    // everything recorded so far, as a JSON document
+    std::string ToJson() const;
+    // write ToJson() to the file. return value indicates success or error
+    long WriteJson(const std::string &fileName) const;
+
+  private:
+    Metrics();
+
+    // member variables
+      mutable std::mutex mutex_;  // guards everything below
+      timer_map timers_;
+      counter_map counters_;
+      histogram_map histograms_;
+      clock::time_point start_;  // created or reset
+};
+
+} // namespace gaScsData
+#endif // GA_Metrics_H_
@@ -0,0 +1,399 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: OutputFingerprint.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Row, layer, and table hashes of a generation, and the file they are written to.
+ *
+ * Libraries used:  string
+ *                  vector
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <cstdio> // keep the previous fingerprint file
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "OutputFingerprint.hpp"
+#include "Checksum.hpp"
+
+namespace gaScsData {
+
+static const char *TABLE_NAMES[]= { "scs", "cls", "events" };
+static_assert(sizeof(TABLE_NAMES) / sizeof(TABLE_NAMES[0]) == OutputFingerprint::TABLE_NUM_OF_TABLES,
+              "one name per table");
+
+static const size_t HEADER_BYTES= 16;
+static const size_t DIRECTORY_BYTES= 56;  // per table
+static const size_t LAYER_BYTES= 32;
+static const size_t ROW_BYTES= 16;
+
+static void PutU64(std::string &out, uint64_t value) {
+  char bytes[sizeof(value)];
+  std::memcpy(bytes, &value, sizeof(value));
+  out.append(bytes, sizeof(value));
+  }
+
+static void PutU32(std::string &out, uint32_t value) {
+  char bytes[sizeof(value)];
+  std::memcpy(bytes, &value, sizeof(value));
+  out.append(bytes, sizeof(value));
+  }
+
+static uint64_t GetU64(const char *in) {
+  uint64_t value;
+  std::memcpy(&value, in, sizeof(value));
+  return value;
+  }
+
+static uint32_t GetU32(const char *in) {
+  uint32_t value;
+  std::memcpy(&value, in, sizeof(value));
+  return value;
+  }
+
+// rows by layer, then angle, then hash
+static bool IsLayerRowBefore(const std::pair<long, OutputFingerprint::RowTyp> &lhs,
+                             const std::pair<long, OutputFingerprint::RowTyp> &rhs) {
+  if (lhs.first != rhs.first)
+    return lhs.first < rhs.first;
+  if (lhs.second.angle != rhs.second.angle)
+    return lhs.second.angle < rhs.second.angle;
+  return lhs.second.hash < rhs.second.hash;
+  }
+
+// ctors and dtor
+OutputFingerprint::OutputFingerprint() :
+    isRecorded_(false),
+    hasPrevious_(false) {
+  for (long table= 0; table < TABLE_NUM_OF_TABLES; ++table) {
+    tables_[table].isSet= false;
+    tables_[table].hash= 0;
+    tables_[table].inputHash= 0;
+    tables_[table].rowCount= 0;
+    tables_[table].rowsOffset= 0;
+    }
+  }
+
+OutputFingerprint::~OutputFingerprint() { }
+
+// accessors
+bool OutputFingerprint::IsSet(Tables table) const {
+  return tables_[table].isSet;
+  }
+
+uint64_t OutputFingerprint::GetHash(Tables table) const {
+  return tables_[table].hash;
+  }
+
+std::string OutputFingerprint::GetHashHex(Tables table) const {
+  static const char digits[]= "0123456789abcdef";
+  std::string hex(16, '0');
+  uint64_t value= tables_[table].hash;
+  for (size_t i= 0; i < hex.size(); ++i) {
+    hex[hex.size() - 1 - i]= digits[value & 0xf];
+    value>>= 4;
+    }
+  return hex;
+  }
+
+size_t OutputFingerprint::GetRowCount(Tables table) const {
+  return static_cast<size_t>(tables_[table].rowCount);
+  }
+
+const OutputFingerprint::layer_list& OutputFingerprint::GetLayers(Tables table) const {
+  return tables_[table].layers;
+  }
+
+uint64_t OutputFingerprint::GetInputHash(Tables table) const {
+  return tables_[table].inputHash;
+  }
+
+void OutputFingerprint::SetInputHash(Tables table, uint64_t inputHash) {
+  tables_[table].inputHash= inputHash;
+  }
+
+bool OutputFingerprint::IsRecorded() const {
+  return isRecorded_;
+  }
+
+bool OutputFingerprint::HasPrevious() const {
+  return hasPrevious_;
+  }
+
+bool OutputFingerprint::IsEmpty() const {
+  for (long table= 0; table < TABLE_NUM_OF_TABLES; ++table) {
+    if (tables_[table].isSet)
+      return false;
+    }
+  return true;
+  }
+
+// public member functions
+void OutputFingerprint::SetScsRows(const AxisPositions::ScsAxesPositionMap &scsRows, const CoilMap &coilMap) {
+  layer_row_list scs;
+  layer_row_list cls;
+  scs.reserve(scsRows.size());
+  cls.reserve(scsRows.size());
+  for (AxisPositions::sapm_const_iter cit= scsRows.begin(); cit != scsRows.end(); ++cit) {
+    const AxisPositions::SPosDetail &posDetail= cit->second;
+    const long layer= coilMap.GetLayerLb(static_cast<double>(cit->first));
+    Checksum checksum;
+    AxisPositions::AddRowToChecksum(checksum, cit->first, posDetail);
+    RowTyp row= { static_cast<double>(cit->first), checksum.GetValue() };
+    scs.push_back(std::make_pair(layer, row));
+
+    // CLS source: the selected axes, distance, axis, and adjust flag
+    checksum.Reset();
+    checksum.Add(cit->first);
+    for (AxisPositions::SelectedAxes::const_iterator sit= posDetail.get<2>().begin(); sit != posDetail.get<2>().end(); ++sit)
+      checksum.Add(static_cast<bool>(*sit));
+    checksum.Add(posDetail.get<3>().get<0>());
+    checksum.Add(static_cast<long>(posDetail.get<3>().get<1>()));
+    checksum.Add(posDetail.get<3>().get<2>());
+    row.hash= checksum.GetValue();
+    cls.push_back(std::make_pair(layer, row));
+    }
+  SetTable(TABLE_SCS, scs);
+  SetTable(TABLE_CLS, cls);
+  }
+
+void OutputFingerprint::SetEvents(const EventMap::EventMapTyp &events, const CoilMap &coilMap) {
+  layer_row_list rows;
+  rows.reserve(events.size());
+  for (EventMap::em_const_iter cit= events.begin(); cit != events.end(); ++cit) {
+    Checksum checksum;
+    EventMap::AddRowToChecksum(checksum, cit->first, cit->second);
+    const RowTyp row= { cit->first, checksum.GetValue() };
+    rows.push_back(std::make_pair(coilMap.GetLayerLb(cit->first), row));
+    }
+  SetTable(TABLE_EVENTS, rows);
+  }
+
+long OutputFingerprint::MergeFrom(const std::string &fileName) {
+  std::ifstream exists(fileName.c_str(), std::ios::binary);
+  if (!exists)
+    return RTN_NO_RESULTS;
+  exists.close();
+
+  OutputFingerprint previous;
+  if (RTN_NO_ERROR != previous.Open(fileName))
+    return RTN_ERROR;
+  for (long index= 0; index < TABLE_NUM_OF_TABLES; ++index) {
+    const Tables table= static_cast<Tables>(index);
+    if (tables_[table].isSet || !previous.IsSet(table))
+      continue;
+    TableTyp merged= previous.tables_[table];
+    if (RTN_NO_ERROR != previous.ReadRowBlock(table, 0, merged.rowCount, merged.rows))
+      return RTN_ERROR;
+    merged.rowsOffset= 0;
+    tables_[table]= merged;
+    }
+  return RTN_NO_ERROR;
+  }
+
+long OutputFingerprint::Write(const std::string &fileName) const {
+  // return value indicates success or error
+  std::string data(FINGERPRINT_MAGIC, sizeof(FINGERPRINT_MAGIC));
+  PutU32(data, FINGERPRINT_LAYOUT_VERSION);
+  PutU32(data, TABLE_NUM_OF_TABLES);
+
+  // layers follow the directory, then the rows, table by table
+  uint64_t offset= HEADER_BYTES + DIRECTORY_BYTES * TABLE_NUM_OF_TABLES;
+  for (long table= 0; table < TABLE_NUM_OF_TABLES; ++table) {
+    const TableTyp &entry= tables_[table];
+    const uint64_t layersOffset= offset;
+    const uint64_t rowsOffset= layersOffset + entry.layers.size() * LAYER_BYTES;
+    offset= rowsOffset + entry.rowCount * ROW_BYTES;
+    PutU64(data, entry.isSet ? 1 : 0);
+    PutU64(data, entry.hash);
+    PutU64(data, entry.rowCount);
+    PutU64(data, entry.layers.size());
+    PutU64(data, layersOffset);
+    PutU64(data, rowsOffset);
+    PutU64(data, entry.inputHash);
+    }
+  data.reserve(static_cast<size_t>(offset));
+  for (long table= 0; table < TABLE_NUM_OF_TABLES; ++table) {
+    const TableTyp &entry= tables_[table];
+    for (layer_list::const_iterator cit= entry.layers.begin(); cit != entry.layers.end(); ++cit) {
+      PutU64(data, static_cast<uint64_t>(static_cast<int64_t>(cit->layer)));
+      PutU64(data, cit->hash);
+      PutU64(data, cit->firstRow);
+      PutU64(data, cit->rowCount);
+      }
+    row_list rows;
+    if (RTN_NO_ERROR != ReadRowBlock(static_cast<Tables>(table), 0, entry.rowCount, rows))
+      return RTN_ERROR;
+    for (row_list::const_iterator cit= rows.begin(); cit != rows.end(); ++cit) {
+      uint64_t angleBits;
+      std::memcpy(&angleBits, &cit->angle, sizeof(angleBits));
+      PutU64(data, angleBits);
+      PutU64(data, cit->hash);
+      }
+    }
+
+  std::ofstream file(fileName.c_str(), std::ios::binary | std::ios::trunc);
+  file.write(data.data(), data.size());
+  if (!file) {
+    std::cout << "Error writing the fingerprint to " << fileName << "." << std::endl;
+    return RTN_ERROR;
+    }
+  return RTN_NO_ERROR;
+  }
+
+long OutputFingerprint::Record(const std::string &fileName, const std::string &previousFileName) {
+  // return value indicates success or error
+  if (!isRecorded_) {
+    isRecorded_= true;
+    std::remove(previousFileName.c_str());
+    hasPrevious_= 0 == std::rename(fileName.c_str(), previousFileName.c_str());
+    if (hasPrevious_ && RTN_ERROR == MergeFrom(previousFileName))
+      std::cout << "The previous fingerprint " << previousFileName << " can't be read. Only the tables made are fingerprinted." << std::endl;
+    }
+  return Write(fileName);
+  }
+
+long OutputFingerprint::Open(const std::string &fileName) {
+  // return value indicates success or error
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  file.seekg(0, std::ios::end);
+  const uint64_t fileBytes= file ? static_cast<uint64_t>(file.tellg()) : 0;
+  file.seekg(0, std::ios::beg);
+
+  const size_t directoryBytes= HEADER_BYTES + DIRECTORY_BYTES * TABLE_NUM_OF_TABLES;
+  std::string directory(directoryBytes, '\0');
+  bool isOk= fileBytes >= directoryBytes && file.read(&directory[0], directoryBytes) &&
+             0 == std::memcmp(directory.data(), FINGERPRINT_MAGIC, sizeof(FINGERPRINT_MAGIC)) &&
+             FINGERPRINT_LAYOUT_VERSION == GetU32(directory.data() + 8) &&
+             static_cast<uint32_t>(TABLE_NUM_OF_TABLES) == GetU32(directory.data() + 12);
+
+  TableTyp tables[TABLE_NUM_OF_TABLES];
+  for (long table= 0; isOk && table < TABLE_NUM_OF_TABLES; ++table) {
+    const char *in= directory.data() + HEADER_BYTES + DIRECTORY_BYTES * table;
+    TableTyp &entry= tables[table];
+    entry.isSet= 0 != GetU64(in);
+    entry.hash= GetU64(in + 8);
+    entry.rowCount= GetU64(in + 16);
+    const uint64_t layerCount= GetU64(in + 24);
+    const uint64_t layersOffset= GetU64(in + 32);
+    entry.rowsOffset= GetU64(in + 40);
+    entry.inputHash= GetU64(in + 48);
+    // the sections must be in the file, so a bad count can't make a huge allocation
+    isOk= layersOffset <= fileBytes && layerCount <= (fileBytes - layersOffset) / LAYER_BYTES &&
+          entry.rowsOffset <= fileBytes && entry.rowCount <= (fileBytes - entry.rowsOffset) / ROW_BYTES;
+    if (!isOk)
+      break;
+    std::string layers(static_cast<size_t>(layerCount * LAYER_BYTES), '\0');
+    file.seekg(static_cast<std::streamoff>(layersOffset));
+    isOk= layers.empty() || file.read(&layers[0], layers.size());
+    entry.layers.resize(static_cast<size_t>(layerCount));
+    for (size_t i= 0; isOk && i < entry.layers.size(); ++i) {
+      LayerTyp &layer= entry.layers[i];
+      const char *layerIn= layers.data() + LAYER_BYTES * i;
+      layer.layer= static_cast<long>(static_cast<int64_t>(GetU64(layerIn)));
+      layer.hash= GetU64(layerIn + 8);
+      layer.firstRow= GetU64(layerIn + 16);
+      layer.rowCount= GetU64(layerIn + 24);
+      isOk= layer.firstRow <= entry.rowCount && layer.rowCount <= entry.rowCount - layer.firstRow;
+      }
+    }
+
+  if (!isOk) {
+    std::cout << "Error reading the fingerprint from " << fileName << ": not a fingerprint file of layout version "
+              << FINGERPRINT_LAYOUT_VERSION << ", or it is cut off." << std::endl;
+    return RTN_ERROR;
+    }
+  for (long table= 0; table < TABLE_NUM_OF_TABLES; ++table) {
+    tables_[table]= tables[table];
+    }
+  fileName_= fileName;
+  return RTN_NO_ERROR;
+  }
+
+long OutputFingerprint::ReadRows(Tables table, size_t layerIndex, row_list &rows) const {
+  // return value indicates success or error
+  const LayerTyp &layer= tables_[table].layers.at(layerIndex);
+  return ReadRowBlock(table, layer.firstRow, layer.rowCount, rows);
+  }
+
+const char* OutputFingerprint::GetTableName(Tables table) {
+  return TABLE_NAMES[table];
+  }
+
+// private helper functions
+void OutputFingerprint::SetTable(Tables table, layer_row_list &rows) {
+  std::sort(rows.begin(), rows.end(), IsLayerRowBefore);
+
+  TableTyp &entry= tables_[table];
+  entry.isSet= true;
+  entry.inputHash= 0;
+  entry.rowCount= rows.size();
+  entry.rowsOffset= 0;
+  entry.layers.clear();
+  entry.rows.clear();
+  entry.rows.reserve(rows.size());
+  for (size_t first= 0; first < rows.size(); ) {
+    size_t last= first;
+    Checksum layerChecksum;
+    layerChecksum.Add(rows[first].first);
+    for (; last < rows.size() && rows[last].first == rows[first].first; ++last) {
+      entry.rows.push_back(rows[last].second);
+      }
+    layerChecksum.Add(static_cast<long>(last - first));
+    for (size_t i= first; i < last; ++i) {
+      layerChecksum.Add(&rows[i].second.hash, sizeof(rows[i].second.hash));
+      }
+    const LayerTyp layer= { rows[first].first, layerChecksum.GetValue(), first, last - first };
+    entry.layers.push_back(layer);
+    first= last;
+    }
+
+  Checksum tableChecksum;
+  tableChecksum.Add(std::string(TABLE_NAMES[table]));
+  for (layer_list::const_iterator cit= entry.layers.begin(); cit != entry.layers.end(); ++cit) {
+    tableChecksum.Add(cit->layer);
+    tableChecksum.Add(&cit->hash, sizeof(cit->hash));
+    }
+  entry.hash= tableChecksum.GetValue();
+  }
+
+long OutputFingerprint::ReadRowBlock(Tables table, uint64_t firstRow, uint64_t rowCount, row_list &rows) const {
+  // return value indicates success or error
+  const TableTyp &entry= tables_[table];
+  rows.clear();
+  if (0 == rowCount)
+    return RTN_NO_ERROR;
+  if (firstRow > entry.rowCount || rowCount > entry.rowCount - firstRow)
+    return RTN_ERROR;
+  // made here, or merged from a file
+  if (!entry.rows.empty()) {
+    rows.assign(entry.rows.begin() + static_cast<size_t>(firstRow), entry.rows.begin() + static_cast<size_t>(firstRow + rowCount));
+    return RTN_NO_ERROR;
+    }
+
+  std::ifstream file(fileName_.c_str(), std::ios::binary);
+  std::string data(static_cast<size_t>(rowCount * ROW_BYTES), '\0');
+  file.seekg(static_cast<std::streamoff>(entry.rowsOffset + firstRow * ROW_BYTES));
+  if (fileName_.empty() || !file.read(&data[0], data.size())) {
+    std::cout << "Error reading the " << TABLE_NAMES[table] << " fingerprint rows from " << fileName_ << "." << std::endl;
+    return RTN_ERROR;
+    }
+  rows.resize(static_cast<size_t>(rowCount));
+  for (size_t i= 0; i < rows.size(); ++i) {
+    const uint64_t angleBits= GetU64(data.data() + ROW_BYTES * i);
+    std::memcpy(&rows[i].angle, &angleBits, sizeof(angleBits));
+    rows[i].hash= GetU64(data.data() + ROW_BYTES * i + 8);
+    }
+  return RTN_NO_ERROR;
+  }
+
+} // namespace gaScsData
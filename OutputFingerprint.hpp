@@ -0,0 +1,158 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: OutputFingerprint.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Fingerprint of a generation of the SCS, CLS, and event tables, so two generations can be proven
+ *            the same (or the differences found) without the db. Recorded as each table is committed by the
+ *            table writes (-p, -e, and db batch scenarios, Record()), and written by generated batch scenarios.
+ *            Each table is a tree of hashes (64 bit FNV-1a, Checksum class):
+ *              row    -- hash of the values written to the table (AxisPositions::AddRowToChecksum(),
+ *                        EventMap::AddRowToChecksum()). The logic trace is not included.
+ *              layer  -- hash of the layer number, its row count, and its row hashes, in row order
+ *              table  -- hash of the table name, and the layer numbers and hashes, in layer order
+ *            The layer of a row is the coil map layer at the row angle, so a row is in the same layer in every
+ *            generation made from the same coil map. Rows are in (layer, angle, row hash) order, so events at
+ *            the same angle are in the same order no matter the order they were made in.
+ *            The CLS table is made by a db procedure from the SCS table, so the CLS rows are its source in each
+ *            SCS row: the selected axes, and the selected distance, axis, and adjust flag (as TablePublisher).
+ *            Each table also has the hash of the inputs it was made from (AxisPositions::GetInputHash(),
+ *            EventMap::GetInputHash()), as a local record of the generation. Whether a table is up to
+ *            date is decided by its generation row in the db (TableGeneration class), not by this file.
+ *
+ *            File format (FINGERPRINT_FILE, little endian):
+ *              header, 16 bytes:
+ *                 0  magic               8 bytes, FINGERPRINT_MAGIC
+ *                 8  layout version      uint32, FINGERPRINT_LAYOUT_VERSION
+ *                12  table count         uint32, TABLE_NUM_OF_TABLES
+ *              table directory, 56 bytes per table, in the Tables order:
+ *                 0  is set              uint64, 0 if the table was not fingerprinted
+ *                 8  table hash          uint64
+ *                16  row count           uint64
+ *                24  layer count         uint64
+ *                32  layers offset       uint64, from the start of the file
+ *                40  rows offset         uint64, from the start of the file
+ *                48  input hash          uint64, 0 if not known
+ *              layers, 32 bytes each:    layer int64, layer hash uint64, first row uint64, row count uint64
+ *              rows, 16 bytes each:      angle double, row hash uint64
+ *            Open() reads the directory and the layers only. The rows of a layer are read when they are needed,
+ *            so comparing two files (FingerprintDiff class) reads the rows of the changed layers only.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_OutputFingerprint_H_
+#define GA_OutputFingerprint_H_
+
+// standard c/c++ libraries
+#include <cstdint>
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+#include "CoilMap.hpp"
+#include "AxisPositions.hpp"
+#include "EventMap.hpp"
+
+namespace gaScsData {
+
+class OutputFingerprint : private boost::noncopyable {
+
+public:
+  // typedefs and enums
+    enum Tables {
+      TABLE_SCS= 0,
+      TABLE_CLS,
+      TABLE_EVENTS,
+      TABLE_NUM_OF_TABLES };
+
+    struct RowTyp {
+      double angle;         // RIA angle
+      uint64_t hash;
+      };
+    typedef std::vector<RowTyp> row_list;
+
+    struct LayerTyp {
+      long layer;
+      uint64_t hash;
+      uint64_t firstRow;    // index of the first row of the layer in the table rows
+      uint64_t rowCount;
+      };
+    typedef std::vector<LayerTyp> layer_list;
+
+  // ctors and dtor
+    OutputFingerprint();
+    ~OutputFingerprint();
+
+  // accessors
+    // false if the table was not fingerprinted (not made by the generation)
+    bool IsSet(Tables table) const;
+    uint64_t GetHash(Tables table) const;
+    // the table hash as 16 hex digits
+    std::string GetHashHex(Tables table) const;
+    size_t GetRowCount(Tables table) const;
+    // by layer number
+    const layer_list& GetLayers(Tables table) const;
+    // hash of the inputs the table was made from, 0 if not known
+    uint64_t GetInputHash(Tables table) const;
+    void SetInputHash(Tables table, uint64_t inputHash);
+    // true if no table is set
+    bool IsEmpty() const;
+
+  // public member functions
+    // fingerprint the SCS rows, and the CLS source in them. coilMap is the coil map the rows were calculated from.
+    void SetScsRows(const AxisPositions::ScsAxesPositionMap &scsRows, const CoilMap &coilMap);
+    void SetEvents(const EventMap::EventMapTyp &events, const CoilMap &coilMap);
+    // Read the tables not set here from the file, so a generation of some of the tables has the latest of each.
+    // Return value is RTN_NO_RESULTS if there is no file to read, and RTN_ERROR if it can't be read.
+    long MergeFrom(const std::string &fileName);
+    // Return value indicates success or error
+    long Write(const std::string &fileName) const;
+    // Write the tables set here to fileName, as soon as they are committed, so the file is of the tables in the db
+    // even if a later table or step fails. The first call keeps the file before it as previousFileName, and the
+    // tables not set here are taken from it. Return value indicates success or error
+    long Record(const std::string &fileName, const std::string &previousFileName);
+    // true once Record() was called, and if the first call kept a file before it
+    bool IsRecorded() const;
+    bool HasPrevious() const;
+    // Read the table directory and layers of the file. The rows are read by ReadRows().
+    // Return value indicates success or error
+    long Open(const std::string &fileName);
+    // rows of one layer (index into GetLayers()), from memory or from the open file.
+    // Return value indicates success or error
+    long ReadRows(Tables table, size_t layerIndex, row_list &rows) const;
+
+    static const char* GetTableName(Tables table);
+
+  private:
+    struct TableTyp {
+      bool isSet;
+      uint64_t hash;
+      uint64_t inputHash;
+      uint64_t rowCount;
+      layer_list layers;
+      row_list rows;        // empty if the table is in the open file
+      uint64_t rowsOffset;  // rows in the open file
+      };
+    // <layer, row> of a table, before it is sorted
+    typedef std::vector<std::pair<long, RowTyp> > layer_row_list;
+
+    // helper functions
+      // sort the rows, and make the layer and table hashes
+      void SetTable(Tables table, layer_row_list &rows);
+      // rows [firstRow, firstRow + rowCount) of a table in the open file
+      long ReadRowBlock(Tables table, uint64_t firstRow, uint64_t rowCount, row_list &rows) const;
+
+    // member variables
+      TableTyp tables_[TABLE_NUM_OF_TABLES];
+      std::string fileName_;  // open file, empty if none
+      bool isRecorded_;
+      bool hasPrevious_;      // Record() kept the file before it
+};
+
+} // namespace gaScsData
+#endif // GA_OutputFingerprint_H_
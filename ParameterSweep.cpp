@@ -0,0 +1,319 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: ParameterSweep.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Evaluates many GenerationParams sets at once, against one
+ *            shared coil map, all in memory.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  thread
+ *                  atomic
+ *                  chrono
+ *                  Boost Property Tree (JSON parser)
+ *                  Boost Non-copyable
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <thread>
+#include <sstream>
+#include <fstream>
+
+// boost libraries
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "ParameterSweep.hpp"
+#include "CoilMapGenerator.hpp"
+#include "AxisPositions.hpp"
+#include "EventMap.hpp"
+#include "PositionValidator.hpp"
+#include "EventCrossCheck.hpp"
+#include "TraceRecorder.hpp"
+#include "ProgressReporter.hpp"
+
+namespace gaScsData {
+
+// ctors and dtor
+ParameterSweep::ParameterSweep() :
+    source_(BATCH_SOURCE_GENERATED),
+    scale_(1),
+    workers_(0),
+    coilAngleMax_(COIL_ANGLE_MAX),
+    nextSet_(0),
+    elapsedMs_(0.0) { }
+
+ParameterSweep::~ParameterSweep() { }
+
+// accessors
+void ParameterSweep::SetWorkers(size_t workers) { workers_= workers; }
+void ParameterSweep::SetGeometry(const CoilGeometry &geometry) { geometry_= geometry; }
+const ParameterSweep::set_list& ParameterSweep::GetSets() const { return sets_; }
+const ParameterSweep::result_list& ParameterSweep::GetResults() const { return results_; }
+
+// public member functions
+long ParameterSweep::LoadSweepFile(const std::string &fileName) {
+  // return value indicates success or error
+  typedef boost::property_tree::ptree ptree;
+  sets_.clear();
+  try {
+    ptree sweep;
+    boost::property_tree::read_json(fileName, sweep);
+    source_= sweep.get<std::string>("source", BATCH_SOURCE_GENERATED);
+    scale_= sweep.get<long>("scale", 1);
+    workers_= sweep.get<size_t>("workers", 0);
+    if ((BATCH_SOURCE_DB != source_ && BATCH_SOURCE_GENERATED != source_) || scale_ < 1) {
+      std::cout << "Sweep file " << fileName << ": source must be \"" << BATCH_SOURCE_DB << "\" or \""
+                << BATCH_SOURCE_GENERATED << "\", and scale must be 1 or more." << std::endl;
+      return RTN_ERROR;
+      }
+
+    // base parameters
+    GenerationParams base;
+    if (sweep.get_child_optional("base")) {
+      for (ptree::const_iterator cit= sweep.get_child("base").begin(); cit != sweep.get_child("base").end(); ++cit) {
+        if (RTN_NO_ERROR != base.SetValue(cit->first, cit->second.get_value<double>())) {
+          std::cout << "Sweep file " << fileName << ": unknown parameter \"" << cit->first << "\"." << std::endl;
+          return RTN_ERROR;
+          }
+        }
+      }
+
+    // named sets
+    if (sweep.get_child_optional("sets")) {
+      for (ptree::const_iterator cit= sweep.get_child("sets").begin(); cit != sweep.get_child("sets").end(); ++cit) {
+        SetTyp set;
+        set.name= cit->second.get<std::string>("name", "set " + std::to_string(static_cast<long long>(sets_.size() + 1)));
+        set.params= base;
+        for (ptree::const_iterator pcit= cit->second.begin(); pcit != cit->second.end(); ++pcit) {
+          if ("name" != pcit->first && RTN_NO_ERROR != set.params.SetValue(pcit->first, pcit->second.get_value<double>())) {
+            std::cout << "Sweep file " << fileName << ": unknown parameter \"" << pcit->first << "\"." << std::endl;
+            return RTN_ERROR;
+            }
+          }
+        sets_.push_back(set);
+        }
+      }
+
+    // grid -- every combination of the listed values
+    if (sweep.get_child_optional("grid")) {
+      std::vector<std::pair<std::string, std::vector<double> > > axes;
+      for (ptree::const_iterator cit= sweep.get_child("grid").begin(); cit != sweep.get_child("grid").end(); ++cit) {
+        double check;
+        if (RTN_NO_ERROR != base.GetValue(cit->first, check)) {
+          std::cout << "Sweep file " << fileName << ": unknown parameter \"" << cit->first << "\"." << std::endl;
+          return RTN_ERROR;
+          }
+        std::vector<double> values;
+        for (ptree::const_iterator vcit= cit->second.begin(); vcit != cit->second.end(); ++vcit) {
+          values.push_back(vcit->second.get_value<double>());
+          }
+        if (!values.empty())
+          axes.push_back(std::make_pair(cit->first, values));
+        }
+      // odometer over the value indexes
+      std::vector<size_t> indexes(axes.size(), 0);
+      while (!axes.empty()) {
+        SetTyp set;
+        set.params= base;
+        std::ostringstream name;
+        for (size_t i= 0; i < axes.size(); ++i) {
+          set.params.SetValue(axes[i].first, axes[i].second[indexes[i]]);
+          name << (0 == i ? "" : ", ") << axes[i].first << "=" << axes[i].second[indexes[i]];
+          }
+        set.name= name.str();
+        sets_.push_back(set);
+        size_t axis= 0;
+        while (axis < axes.size() && ++indexes[axis] == axes[axis].second.size()) {
+          indexes[axis]= 0;
+          ++axis;
+          }
+        if (axis == axes.size())
+          break;
+        }
+      }
+
+    if (sets_.empty())
+      AddSet("base", base);
+    }
+  catch (const boost::property_tree::ptree_error &ex) {
+    std::cout << "Error reading the sweep file " << fileName << ": " << ex.what() << std::endl;
+    sets_.clear();
+    return RTN_ERROR;
+    }
+  return RTN_NO_ERROR;
+  }
+
+void ParameterSweep::AddSet(const std::string &name, const GenerationParams &params) {
+  SetTyp set;
+  set.name= name;
+  set.params= params;
+  sets_.push_back(set);
+  }
+
+long ParameterSweep::Run() {
+  // return value is RTN_NO_ERROR if every set was evaluated without error
+  const clock::time_point start= clock::now();
+  results_.clear();
+  if (sets_.empty()) {
+    std::cout << "Parameter sweep: no parameter sets." << std::endl;
+    return RTN_NO_RESULTS;
+    }
+  if (RTN_NO_ERROR != LoadCoilMap()) {
+    std::cout << "Parameter sweep: coil map error!!" << std::endl;
+    return RTN_ERROR;
+    }
+
+  size_t workers= 0 != workers_ ? workers_ : std::thread::hardware_concurrency();
+  if (0 == workers)
+    workers= 1;
+  if (workers > sets_.size())
+    workers= sets_.size();
+  std::cout << "Parameter sweep: " << sets_.size() << " sets on " << workers << " workers, "
+            << coilMap_.mapCoil_.size() << " coil map rows (" << source_ << ")." << std::endl;
+
+  const ResultTyp empty= { RTN_NO_ERROR, 0, 0, 0, 0, 0.0, 0.0, 0.0, 0.0, "", "", 0.0 };
+  results_.assign(sets_.size(), empty);
+  nextSet_.store(0);
+
+  // Discard the console output of the generation code, and turn off the progress display
+  const bool wasHeadless= ProgressReporter::IsHeadless();
+  ProgressReporter::SetHeadless(true);
+  std::streambuf *coutBuffer= std::cout.rdbuf(nullptr);
+
+  std::vector<std::thread> threads;
+  for (size_t i= 0; i < workers; ++i) {
+    threads.push_back(std::thread(&ParameterSweep::Worker, this));
+    }
+  for (size_t i= 0; i < threads.size(); ++i) {
+    threads[i].join();
+    }
+
+  // restore console output
+  std::cout.rdbuf(coutBuffer);
+  std::cout.clear();
+  ProgressReporter::SetHeadless(wasHeadless);
+  elapsedMs_= std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+  bool errorFlag= false;
+  for (size_t i= 0; i < sets_.size(); ++i) {
+    const ResultTyp &result= results_[i];
+    std::cout << "  " << sets_[i].name << ": " << (RTN_NO_ERROR == result.status ? "" : "ERROR, ")
+              << result.positionRows << " positions, " << result.eventRows << " events, max adj "
+              << result.maxTransAdj << "/" << result.maxJoggleAdj << " mm (trans/joggle), min event spacing "
+              << result.minEventSpacing << " deg." << std::endl;
+    if (RTN_NO_ERROR != result.status)
+      errorFlag= true;
+    }
+  std::cout << "Parameter sweep done: " << elapsedMs_ << " ms." << std::endl;
+  return errorFlag ? RTN_ERROR : RTN_NO_ERROR;
+  }
+
+std::string ParameterSweep::ToJson() const {
+  std::ostringstream json;
+  json.precision(3);
+  json << std::fixed;
+  json << "{" << std::endl
+       << "  \"source\": \"" << source_ << "\", \"scale\": " << scale_ << ", \"coil_rows\": " << coilMap_.mapCoil_.size() << "," << std::endl
+       << "  \"elapsed_ms\": " << elapsedMs_ << "," << std::endl
+       << "  \"sets\": [";
+  for (size_t i= 0; i < sets_.size() && i < results_.size(); ++i) {
+    const ResultTyp &result= results_[i];
+    json << (0 == i ? "" : ",") << std::endl
+         << "    { \"name\": \"" << TraceRecorder::JsonEscape(sets_[i].name) << "\", \"status\": \""
+         << (RTN_NO_ERROR == result.status ? "ok" : "error") << "\"," << std::endl
+         << "      \"params\": " << sets_[i].params.ToJson() << "," << std::endl
+         << "      \"position_rows\": " << result.positionRows << ", \"event_rows\": " << result.eventRows
+         << ", \"violations\": " << result.violations << ", \"cross_check_issues\": " << result.crossCheckIssues
+         << ", \"max_trans_adj_mm\": " << result.maxTransAdj << ", \"max_joggle_adj_mm\": " << result.maxJoggleAdj
+         << ", \"min_event_spacing_deg\": " << result.minEventSpacing << ", \"mean_event_spacing_deg\": " << result.meanEventSpacing << "," << std::endl
+         << "      \"position_checksum\": \"" << result.positionChecksum << "\", \"event_checksum\": \"" << result.eventChecksum
+         << "\", \"ms\": " << result.ms << " }";
+    }
+  json << std::endl << "  ]" << std::endl << "}" << std::endl;
+  return json.str();
+  }
+
+long ParameterSweep::WriteJson(const std::string &fileName) const {
+  // return value indicates success or error
+  std::ofstream output(fileName.c_str());
+  output << ToJson();
+  output.close();
+  if (!output) {
+    std::cout << "Error writing the parameter sweep report to " << fileName << std::endl;
+    return RTN_ERROR;
+    }
+  return RTN_NO_ERROR;
+  }
+
+// private helper functions
+long ParameterSweep::LoadCoilMap() {
+  // return value indicates success or error
+  if (BATCH_SOURCE_DB == source_) {
+    if (RTN_NO_ERROR != coilMap_.SetGeometry(geometry_))
+      return RTN_ERROR;
+    coilAngleMax_= geometry_.GetCoilAngleMax();
+    return coilMap_.PopulateCoilMap();
+    }
+  CoilMapGenerator generator;
+  generator.SetScale(scale_);
+  CoilMap::coil_map coilRows;
+  if (RTN_NO_ERROR != generator.Generate(coilRows) || RTN_NO_ERROR != coilMap_.SetGeometry(generator.GetGeometry()))
+    return RTN_ERROR;
+  coilAngleMax_= generator.GetCoilAngleMax();
+  return coilMap_.PopulateCoilMap(coilRows);
+  }
+
+void ParameterSweep::Worker() {
+  TraceRecorder::Instance().SetThreadName("sweep worker");
+  for (size_t next= nextSet_.fetch_add(1); next < sets_.size(); next= nextSet_.fetch_add(1)) {
+    TraceRecorder::ScopedSpan span(sets_[next].name, "sweep");
+    Evaluate(sets_[next], results_[next]);
+    }
+  }
+
+void ParameterSweep::Evaluate(const SetTyp &set, ResultTyp &result) const {
+  const clock::time_point start= clock::now();
+
+  // positions, and the hqp and layer starts for the events
+  AxisPositions::layerAngleSetTyp hqpStarts;
+  AxisPositions::layerAngleSetTyp layerStarts;
+  AxisPositions axPos(coilMap_, coilAngleMax_);
+  axPos.SetGenerationParams(set.params);
+  if (RTN_NO_ERROR != axPos.CalculatePositions())
+    result.status= RTN_ERROR;
+  result.positionRows= axPos.GetScsPositionCount();
+  result.positionChecksum= axPos.GetPositionChecksum();
+  axPos.GetMaxAdjustments(result.maxTransAdj, result.maxJoggleAdj);
+  axPos.GetStartAngleSets(hqpStarts, layerStarts);
+  // the sets are evaluated in parallel already, so the validator uses this thread only
+  PositionValidator validator;
+  validator.SetThreads(1);
+  validator.Validate(axPos.GetScsPositionMap(), axPos.GetKeyCollisions());
+  result.violations= validator.GetViolationCount();
+
+  // events
+  if (RTN_NO_ERROR == result.status) {
+    EventMap eventMap(coilMap_);
+    eventMap.SetGenerationParams(set.params);
+    if (RTN_NO_ERROR != eventMap.GenerateEventMap(hqpStarts, layerStarts))
+      result.status= RTN_ERROR;
+    result.eventRows= eventMap.GetEventCount();
+    result.eventChecksum= eventMap.GetEventChecksum();
+    eventMap.GetEventSpacing(result.minEventSpacing, result.meanEventSpacing);
+    EventCrossCheck crossCheck;
+    crossCheck.Check(axPos.GetScsPositionMap(), coilMap_, eventMap.GetEventMap());
+    result.crossCheckIssues= crossCheck.GetIssueCount();
+    }
+  result.ms= std::chrono::duration<double, std::milli>(clock::now() - start).count();
+  }
+
+} // namespace gaScsData
@@ -0,0 +1,128 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: ParameterSweep.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Evaluates many GenerationParams sets at once, against one shared coil map, all in memory.
+ *            Tuning a parameter used to be a rebuild and a db rewrite per value. Here the coil map is
+ *            loaded once, and each set calculates positions and events on a worker thread using
+ *            AxisPositions and EventMap objects that share the (read only) coil map.
+ *            Nothing is written to the db.
+ *
+ *            Per set summary: position and event row counts, position violations (PositionValidator), event
+ *            cross check issues (EventCrossCheck), largest transition and joggle adjustments, min and mean event
+ *            spacing, output checksums, and time.
+ *
+ *            Sweep file example:
+ *              {
+ *                "source": "generated", "scale": 1, "workers": 4,
+ *                "base": { "trans_straight_length": 220.25 },
+ *                "sets": [ { "name": "wide transition", "trans_arc_deg": 30.0 } ],
+ *                "grid": { "new_layer_offset": [ 4, 5, 6 ], "joggle_retract_adj_threshold": [ 340, 360 ] }
+ *              }
+ *            source -- "db" (coil map from the configured db, read only) or "generated" (default, CoilMapGenerator at scale)
+ *            base -- overrides of the default parameters, used by every set
+ *            sets -- named sets, base plus the listed overrides
+ *            grid -- every combination of the listed values, base plus one value per parameter
+ *            Parameter names are the GenerationParams names. With no sets and no grid, the base set is evaluated.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  thread
+ *                  atomic
+ *                  chrono
+ *                  Boost Property Tree (JSON parser)
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_ParameterSweep_H_
+#define GA_ParameterSweep_H_
+
+// standard c/c++ libraries
+#include <atomic>
+#include <chrono>
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+#include "CoilMap.hpp"
+#include "GenerationParams.hpp"
+
+namespace gaScsData {
+
+class ParameterSweep : private boost::noncopyable {
+
+public:
+  // typedefs and enums
+    struct SetTyp {
+      std::string name;
+      GenerationParams params;
+      };
+    typedef std::vector<SetTyp> set_list;
+
+    // Summary of one set
+    struct ResultTyp {
+      long status;            // RTN_NO_ERROR or RTN_ERROR
+      size_t positionRows;
+      size_t eventRows;
+      size_t violations;      // PositionValidator violations of the positions
+      size_t crossCheckIssues; // EventCrossCheck issues of the events
+      double maxTransAdj;     // mm
+      double maxJoggleAdj;    // mm
+      double minEventSpacing; // degrees, between distinct event angles
+      double meanEventSpacing;
+      std::string positionChecksum;
+      std::string eventChecksum;
+      double ms;
+      };
+    typedef std::vector<ResultTyp> result_list;
+
+  // ctors and dtor
+    ParameterSweep();
+    ~ParameterSweep();
+
+  // accessors
+    void SetWorkers(size_t workers);  // 0 -- one per core
+    // geometry of the db coil map, for the db source. Defaults to the standard coil (-g argument)
+    void SetGeometry(const CoilGeometry &geometry);
+    const set_list& GetSets() const;
+    const result_list& GetResults() const;
+
+  // public member functions
+    // read the coil map source and parameter sets from a JSON sweep file. Return value indicates success or error
+    long LoadSweepFile(const std::string &fileName);
+    void AddSet(const std::string &name, const GenerationParams &params);
+    // load the coil map, and evaluate every set. Return value is RTN_NO_ERROR if every set was evaluated without error
+    long Run();
+    // results as a JSON document
+    std::string ToJson() const;
+    // write ToJson() to the file. return value indicates success or error
+    long WriteJson(const std::string &fileName) const;
+
+  private:
+    typedef std::chrono::steady_clock clock;
+
+    // helper functions
+      // populate coilMap_ from the source. Return value indicates success or error
+      long LoadCoilMap();
+      // worker thread. Evaluates sets until there are none left.
+      void Worker();
+      void Evaluate(const SetTyp &set, ResultTyp &result) const;
+
+    // member variables
+      std::string source_;  // BATCH_SOURCE_DB or BATCH_SOURCE_GENERATED
+      long scale_;          // generated coil size
+      size_t workers_;
+      set_list sets_;
+      result_list results_;  // by set index
+      CoilMap coilMap_;      // shared by every set, read only while the sets are evaluated
+      long coilAngleMax_;
+      CoilGeometry geometry_;  // db coil map
+      std::atomic<size_t> nextSet_;  // next set to evaluate
+      double elapsedMs_;
+};
+
+} // namespace gaScsData
+#endif // GA_ParameterSweep_H_
@@ -0,0 +1,226 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: PipelineBenchmark.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Times the generation pipeline and the CoilMap hot paths against
+ *            a generated coil map and the local (in memory) backends.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  chrono
+ *                  random
+ *                  Boost Non-copyable
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <random>
+#include <chrono>
+#include <sstream>
+#include <algorithm>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "PipelineBenchmark.hpp"
+#include "CoilMapGenerator.hpp"
+#include "AxisPositions.hpp"
+#include "EventMap.hpp"
+#include "ProgressReporter.hpp"
+
+namespace gaScsData {
+
+// ctors and dtor
+PipelineBenchmark::PipelineBenchmark() :
+    scale_(1),
+    repetitions_(BENCHMARK_REPETITIONS),
+    microCount_(BENCHMARK_MICRO_COUNT),
+    coilMapRows_(0) { }
+
+PipelineBenchmark::~PipelineBenchmark() { }
+
+// accessors
+void PipelineBenchmark::SetScale(long scale) { scale_= scale < 1 ? 1 : scale; }
+void PipelineBenchmark::SetRepetitions(long repetitions) { repetitions_= repetitions < 1 ? 1 : repetitions; }
+void PipelineBenchmark::SetMicroCount(size_t microCount) { microCount_= microCount < 1 ? 1 : microCount; }
+const PipelineBenchmark::result_list& PipelineBenchmark::GetResults() const { return results_; }
+
+// public member functions
+long PipelineBenchmark::Run() {
+  // return value indicates success or error
+  results_.clear();
+
+  // generate the coil map
+  CoilMapGenerator generator;
+  generator.SetScale(scale_);
+  CoilMap::coil_map coilRows;
+  if (RTN_NO_ERROR != generator.Generate(coilRows) || coilRows.empty()) {
+    std::cout << "Benchmark: coil map generation error!!" << std::endl;
+    return RTN_ERROR;
+    }
+  coilMapRows_= coilRows.size();
+
+  // the objects under test, populated from the generated rows, writing to the local backends
+  AxisPositions axPos;
+  EventMap eventMap;
+  if (RTN_NO_ERROR != axPos.SetCoilGeometry(generator.GetGeometry()) ||
+      RTN_NO_ERROR != eventMap.SetCoilGeometry(generator.GetGeometry()) ||
+      RTN_NO_ERROR != axPos.GenerateCoilMap(coilRows, generator.GetCoilAngleMax()) ||
+      RTN_NO_ERROR != eventMap.ownCoilMap_.PopulateCoilMap(coilRows)) {
+    std::cout << "Benchmark: populate coil map error!!" << std::endl;
+    return RTN_ERROR;
+    }
+  axPos.SetLocalBackend(true);
+  eventMap.SetLocalBackend(true);
+  const CoilMap &coilMap= axPos.coilMap_;
+
+  // random angles over the coil map range. Fixed seed so runs are comparable.
+  // Generated up front so the generator is not timed.
+  std::vector<double> angles;
+  angles.reserve(microCount_);
+  std::mt19937 generatorRandom(BENCHMARK_SEED);
+  std::uniform_real_distribution<double> distribution(coilRows.begin()->first, coilRows.rbegin()->first);
+  for (size_t i= 0; i < microCount_; ++i) {
+    angles.push_back(distribution(generatorRandom));
+    }
+
+  std::cout << "Benchmark: " << coilMapRows_ << " coil map rows (" << scale_ << "x coil), "
+            << repetitions_ << " repetitions." << std::endl;
+
+  // the timed functions display messages and progress. Turn off the progress display and discard
+  // console output while timing so the results are the calculations, not the console.
+  const bool wasHeadless= ProgressReporter::IsHeadless();
+  ProgressReporter::SetHeadless(true);
+  std::streambuf *coutBuffer= std::cout.rdbuf(nullptr);
+
+  // microbenchmarks. Sum the results so the optimizer can't remove the calls.
+  volatile double sink= 0.0;
+  TimeIt("coilmap_lb", true, angles.size(), [&]() {
+    double sum= 0.0;
+    for (size_t i= 0; i < angles.size(); ++i)
+      sum+= coilMap.LbIterator(angles[i])->first;
+    sink= sum;
+    return static_cast<size_t>(0);
+    });
+  TimeIt("coilmap_ub", true, angles.size(), [&]() {
+    double sum= 0.0;
+    for (size_t i= 0; i < angles.size(); ++i) {
+      CoilMap::cm_cit cit= coilMap.UbIterator(angles[i]);
+      if (cit != coilMap.mapCoil_.end())
+        sum+= cit->first;
+      }
+    sink= sum;
+    return static_cast<size_t>(0);
+    });
+  TimeIt("transition_adjustment", true, angles.size(), [&]() {
+    double sum= 0.0;
+    for (size_t i= 0; i < angles.size(); ++i)
+      sum+= axPos.CalculateTransitionAdjustment(angles[i]);
+    sink= sum;
+    return static_cast<size_t>(0);
+    });
+  TimeIt("joggle_adjustment_type", true, angles.size(), [&]() {
+    double sum= 0.0;
+    double degToNextJoggle, degToPrevJoggle, jAdj;
+    for (size_t i= 0; i < angles.size(); ++i) {
+      sum+= axPos.CalculateJoggleAdjustmentType(angles[i], degToNextJoggle, degToPrevJoggle, jAdj);
+      sum+= jAdj;
+      }
+    sink= sum;
+    return static_cast<size_t>(0);
+    });
+
+  // macrobenchmarks, in pipeline order. Each stage uses what the one before it made.
+  TimeIt("calculate_axis_moves", false, 1, [&]() {
+    axPos.scsAxisPositionMap_.clear();
+    axPos.ClearAllTransAdjust();
+    axPos.CalculateAxisMoves();
+    return axPos.scsAxisPositionMap_.size();
+    });
+  TimeIt("insert_scs_positions", false, 1, [&]() {
+    axPos.InsertIntoScsDb();
+    return axPos.GetLocalRowCount();
+    });
+  axPos.GetStartAngleSets(eventMap.hqpStartSet_, eventMap.layerStartSet_);
+  TimeIt("map_event_instances", false, 1, [&]() {
+    eventMap.eventMap_.clear();
+    eventMap.MapEventInstances();
+    return eventMap.eventMap_.size();
+    });
+  TimeIt("insert_events", false, 1, [&]() {
+    eventMap.InsertIntoDb(SPNAME_INSERT_EVENTLIST);
+    return eventMap.GetLocalRowCount();
+    });
+
+  // restore console output
+  std::cout.rdbuf(coutBuffer);
+  ProgressReporter::SetHeadless(wasHeadless);
+  std::cout.clear();
+
+  for (result_list::const_iterator cit= results_.begin(); cit != results_.end(); ++cit) {
+    std::cout << "  " << cit->name << ": min " << cit->minimum << " " << cit->unit
+              << ", median " << cit->median << " " << cit->unit << ", mean " << cit->mean << " " << cit->unit;
+    if (0 != cit->items)
+      std::cout << " (" << cit->items << " rows)";
+    std::cout << std::endl;
+    }
+  return RTN_NO_ERROR;
+  }
+
+// results as a JSON document
+std::string PipelineBenchmark::ToJson() const {
+  std::ostringstream json;
+  json.precision(6);
+  json << std::fixed;
+  json << "{" << std::endl
+       << "  \"scale\": " << scale_ << "," << std::endl
+       << "  \"coil_map_rows\": " << coilMapRows_ << "," << std::endl
+       << "  \"repetitions\": " << repetitions_ << "," << std::endl
+       << "  \"micro_count\": " << microCount_ << "," << std::endl
+       << "  \"benchmarks\": [";
+  for (result_list::const_iterator cit= results_.begin(); cit != results_.end(); ++cit) {
+    json << (cit == results_.begin() ? "" : ",") << std::endl
+         << "    { \"name\": \"" << cit->name << "\", \"kind\": \"" << cit->kind << "\", \"unit\": \"" << cit->unit << "\""
+         << ", \"operations\": " << cit->operations << ", \"items\": " << cit->items
+         << ", \"min\": " << cit->minimum << ", \"median\": " << cit->median << ", \"mean\": " << cit->mean << " }";
+    }
+  json << std::endl << "  ]" << std::endl << "}" << std::endl;
+  return json.str();
+  }
+
+// private helper functions
+void PipelineBenchmark::TimeIt(const std::string &name, bool isMicro, size_t operations, const std::function<size_t()> &function) {
+  typedef std::chrono::steady_clock clock;
+  // micro -- ns per call, macro -- ms per run
+  const double scale= isMicro ? 1000000.0 / static_cast<double>(operations) : 1.0;
+  std::vector<double> times;
+  times.reserve(repetitions_);
+  size_t items= 0;
+  for (long rep= 0; rep < repetitions_; ++rep) {
+    clock::time_point start= clock::now();
+    items= function();
+    times.push_back(std::chrono::duration<double, std::milli>(clock::now() - start).count() * scale);
+    }
+
+  ResultTyp result;
+  result.name= name;
+  result.kind= isMicro ? "micro" : "macro";
+  result.unit= isMicro ? "ns" : "ms";
+  result.operations= operations;
+  result.items= items;
+  result.repetitions= repetitions_;
+  std::sort(times.begin(), times.end());
+  result.minimum= times.front();
+  result.median= times[times.size() / 2];
+  double sum= 0.0;
+  for (size_t i= 0; i < times.size(); ++i)
+    sum+= times[i];
+  result.mean= sum / static_cast<double>(times.size());
+  results_.push_back(result);
+  }
+
+} // namespace gaScsData
@@ -0,0 +1,100 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: PipelineBenchmark.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Times the generation pipeline, and the CoilMap hot paths it is built on,
+ *            so regressions can be tracked between releases. Used by the ScsBenchmark executable.
+ *
+ *            No db is needed. The coil map comes from CoilMapGenerator, and the inserts use the
+ *            AxisPositions and EventMap local backends (rows are recorded in memory).
+ *
+ *            Microbenchmarks (ns per call, over random angles with a fixed seed):
+ *              coilmap_lb, coilmap_ub -- CoilMap LbIterator / UbIterator
+ *              transition_adjustment -- AxisPositions::CalculateTransitionAdjustment
+ *              joggle_adjustment_type -- AxisPositions::CalculateJoggleAdjustmentType
+ *            Macrobenchmarks (ms per run):
+ *              calculate_axis_moves -- AxisPositions::CalculateAxisMoves
+ *              insert_scs_positions -- AxisPositions::InsertIntoScsDb loop, local backend
+ *              map_event_instances -- EventMap::MapEventInstances
+ *              insert_events -- EventMap::InsertIntoDb loop, local backend
+ *
+ *            Each benchmark is run a number of times, and the min, median, and mean are kept.
+ *            Console output done by the timed functions (progress display) is discarded while timing.
+ *            ToJson() formats the results for machine reading.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  chrono
+ *                  random
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_PipelineBenchmark_H_
+#define GA_PipelineBenchmark_H_
+
+// standard c/c++ libraries
+#include <functional>
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+#include "CoilMap.hpp"
+
+namespace gaScsData {
+
+class PipelineBenchmark : private boost::noncopyable {
+
+public:
+  // typedefs and enums
+    // Results of one benchmark. Times are per operation (micro -- one call, macro -- one run).
+    struct ResultTyp {
+      std::string name;
+      std::string kind;         // "micro" or "macro"
+      std::string unit;         // "ns" or "ms"
+      size_t operations;        // operations per repetition
+      size_t items;             // rows/events produced (macro), 0 for micro
+      long repetitions;
+      double minimum;
+      double median;
+      double mean;
+      };
+    typedef std::vector<ResultTyp> result_list;
+
+  // ctors and dtor
+    PipelineBenchmark();
+    ~PipelineBenchmark();
+
+  // accessors
+    void SetScale(long scale);  // generated coil size, multiples of the production coil
+    void SetRepetitions(long repetitions);
+    void SetMicroCount(size_t microCount);  // random angles per microbenchmark repetition
+    const result_list& GetResults() const;
+
+  // public member functions
+    // Generate the coil map and run all the benchmarks.
+    // return value indicates success or error
+    long Run();
+
+    // results as a JSON document
+    std::string ToJson() const;
+
+  private:
+    // helper functions
+      // Call the function repetitions_ times, and record a result.
+      // operations is the number of calls (micro) or 1 (macro) done by each call of the function.
+      // The function returns the number of items produced.
+      void TimeIt(const std::string &name, bool isMicro, size_t operations, const std::function<size_t()> &function);
+
+    // member variables
+      long scale_;
+      long repetitions_;
+      size_t microCount_;
+      result_list results_;
+      size_t coilMapRows_;  // size of the generated coil map, for the report
+};
+
+} // namespace gaScsData
+#endif // GA_PipelineBenchmark_H_
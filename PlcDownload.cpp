@@ -0,0 +1,218 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: PlcDownload.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Encodes the SCS position sequence into the PLC download file, and decodes it to check it.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  Boost CRC
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <fstream>
+#include <iterator>
+#include <cstring>
+
+// Boost libraries
+#include <boost/crc.hpp>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "PlcDownload.hpp"
+#include "TablePublisher.hpp"
+
+namespace gaScsData {
+
+// little endian writes and reads, so the file is the same from any host
+static void Put16(std::string &out, uint16_t value) {
+  out.push_back(static_cast<char>(value & 0xFF));
+  out.push_back(static_cast<char>(value >> 8));
+  }
+
+static void Put32(std::string &out, uint32_t value) {
+  Put16(out, static_cast<uint16_t>(value & 0xFFFF));
+  Put16(out, static_cast<uint16_t>(value >> 16));
+  }
+
+static void PutDouble(std::string &out, double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  Put32(out, static_cast<uint32_t>(bits & 0xFFFFFFFF));
+  Put32(out, static_cast<uint32_t>(bits >> 32));
+  }
+
+static uint16_t Get16(const char *in) {
+  return static_cast<uint16_t>(static_cast<unsigned char>(in[0]) | (static_cast<unsigned char>(in[1]) << 8));
+  }
+
+static uint32_t Get32(const char *in) {
+  return Get16(in) | (static_cast<uint32_t>(Get16(in + 2)) << 16);
+  }
+
+static double GetDouble(const char *in) {
+  const uint64_t bits= Get32(in) | (static_cast<uint64_t>(Get32(in + 4)) << 32);
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+  }
+
+// CRC of the header without the CRC field, and the records
+static uint32_t GetCrc(const std::string &data) {
+  boost::crc_32_type crc;
+  crc.process_bytes(data.data(), PLC_HEADER_BYTES - 4);
+  crc.process_bytes(data.data() + PLC_HEADER_BYTES, data.size() - PLC_HEADER_BYTES);
+  return crc.checksum();
+  }
+
+// ctors and dtor
+PlcDownload::PlcDownload() :
+    recordCount_(0) { }
+
+PlcDownload::~PlcDownload() { }
+
+// public member functions
+long PlcDownload::Build(const AxisPositions::ScsAxesPositionMap &scsRows) {
+  // return value indicates success or error
+  data_.clear();
+  recordCount_= 0;
+  const long firstAngle= scsRows.empty() ? 0 : scsRows.begin()->first;
+  const long lastAngle= scsRows.empty() ? 0 : scsRows.rbegin()->first;
+
+  std::string records;
+  records.reserve(scsRows.size() * 16);
+  long previousAngle= firstAngle;
+  for (AxisPositions::sapm_const_iter cit= scsRows.begin(); cit != scsRows.end(); ++cit, ++recordCount_) {
+    const AxisPositions::SPosDetail &posDetail= cit->second;
+    const long angleDelta= cit->first - previousAngle;
+    if (PLC_MAX_ANGLE_DELTA < angleDelta) {
+      std::cout << "PLC download: RIA angle " << cit->first << " is more than " << PLC_MAX_ANGLE_DELTA
+                << " after the previous row. It can't be encoded." << std::endl;
+      return RTN_ERROR;
+      }
+    previousAngle= cit->first;
+
+    const uint32_t flags= GetScsRowFlags(posDetail);
+    Put16(records, static_cast<uint16_t>(angleDelta));
+    Put16(records, static_cast<uint16_t>(flags));
+    if (0 != (SRF_SELECTED & flags)) {
+      // selected axes and the one position or distance they use
+      Put32(records, GetSelectedMask(posDetail));
+      PutDouble(records, posDetail.get<3>().get<0>());
+      }
+    else {
+      Put32(records, 0);
+      for (long i= 0; i < COLUMN_COUNT; ++i) {
+        PutDouble(records, posDetail.get<0>()[i]);
+        }
+      for (long i= 0; i < COLUMN_COUNT; ++i) {
+        PutDouble(records, posDetail.get<1>()[i]);
+        }
+      }
+    }
+
+  data_.reserve(PLC_HEADER_BYTES + records.size());
+  data_.append(PLC_MAGIC, 4);
+  Put16(data_, static_cast<uint16_t>(PLC_LAYOUT_VERSION));
+  Put16(data_, static_cast<uint16_t>(PLC_HEADER_BYTES));
+  Put32(data_, static_cast<uint32_t>(recordCount_));
+  Put32(data_, static_cast<uint32_t>(records.size()));
+  Put32(data_, static_cast<uint32_t>(static_cast<int32_t>(firstAngle)));
+  Put32(data_, static_cast<uint32_t>(static_cast<int32_t>(lastAngle)));
+  Put16(data_, static_cast<uint16_t>(COLUMN_COUNT * 2));
+  Put16(data_, 0);
+  Put32(data_, 0);  // CRC, below
+  data_.append(records);
+  const uint32_t crc= GetCrc(data_);
+  std::string crcBytes;
+  Put32(crcBytes, crc);
+  data_.replace(PLC_HEADER_BYTES - 4, 4, crcBytes);
+  return RTN_NO_ERROR;
+  }
+
+long PlcDownload::Write(const std::string &fileName) const {
+  // return value indicates success or error
+  std::ofstream file(fileName.c_str(), std::ios::binary | std::ios::trunc);
+  file.write(data_.data(), data_.size());
+  if (!file) {
+    std::cout << "Error writing the PLC download to " << fileName << "." << std::endl;
+    return RTN_ERROR;
+    }
+  return RTN_NO_ERROR;
+  }
+
+const std::string& PlcDownload::GetData() const {
+  return data_;
+  }
+
+size_t PlcDownload::GetRecordCount() const {
+  return recordCount_;
+  }
+
+long PlcDownload::Read(const std::string &fileName, row_list &rows) {
+  // return value indicates success or error
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  rows.clear();
+
+  std::string error;
+  if (data.size() < PLC_HEADER_BYTES || 0 != data.compare(0, 4, PLC_MAGIC, 4))
+    error= "not a PLC download file";
+  else if (PLC_LAYOUT_VERSION != Get16(&data[4]) || PLC_HEADER_BYTES != Get16(&data[6]) ||
+           static_cast<uint32_t>(COLUMN_COUNT * 2) != Get16(&data[24]))
+    error= "layout version " + std::to_string(static_cast<unsigned long long>(Get16(&data[4]))) + " is not supported";
+  else if (data.size() - PLC_HEADER_BYTES != Get32(&data[12]))
+    error= "the file is cut off";
+  else if (GetCrc(data) != Get32(&data[28]))
+    error= "CRC error";
+
+  const uint32_t recordCount= error.empty() ? Get32(&data[8]) : 0;
+  const size_t allAxesBytes= 8 + COLUMN_COUNT * 2 * sizeof(double);
+  long angle= static_cast<int32_t>(error.empty() ? Get32(&data[16]) : 0);
+  size_t offset= PLC_HEADER_BYTES;
+  rows.reserve(recordCount);
+  for (uint32_t i= 0; error.empty() && i < recordCount; ++i) {
+    if (data.size() - offset < 16) {
+      error= "record " + std::to_string(static_cast<unsigned long long>(i)) + " is cut off";
+      break;
+      }
+    RowTyp row;
+    angle+= Get16(&data[offset]);
+    row.riaAngle= angle;
+    row.flags= Get16(&data[offset + 2]);
+    row.selectedMask= Get32(&data[offset + 4]);
+    if (0 != (SRF_SELECTED & row.flags)) {
+      row.positions.assign(1, GetDouble(&data[offset + 8]));
+      offset+= 16;
+      }
+    else if (data.size() - offset < allAxesBytes) {
+      error= "record " + std::to_string(static_cast<unsigned long long>(i)) + " is cut off";
+      break;
+      }
+    else {
+      row.positions.resize(COLUMN_COUNT * 2);
+      for (long axis= 0; axis < COLUMN_COUNT * 2; ++axis) {
+        row.positions[axis]= GetDouble(&data[offset + 8 + axis * sizeof(double)]);
+        }
+      offset+= allAxesBytes;
+      }
+    rows.push_back(row);
+    }
+  if (error.empty() && data.size() != offset)
+    error= "the records do not match the data size";
+
+  if (!error.empty()) {
+    std::cout << "Error reading the PLC download " << fileName << ": " << error << "." << std::endl;
+    rows.clear();
+    return RTN_ERROR;
+    }
+  return RTN_NO_ERROR;
+  }
+
+} // namespace gaScsData
@@ -0,0 +1,92 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: PlcDownload.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  The SCS position sequence as one small binary file for the PLC, so the PLC loader can get the
+ *            whole coil in one transfer instead of paging through the position views.
+ *            Made directly from the SCS position map, in RIA angle order.
+ *
+ *            File format (little endian):
+ *              header, PLC_HEADER_BYTES long:
+ *                 0  magic               4 bytes, PLC_MAGIC
+ *                 4  layout version      uint16, PLC_LAYOUT_VERSION
+ *                 6  header bytes        uint16, PLC_HEADER_BYTES
+ *                 8  record count        uint32
+ *                12  data bytes          uint32, bytes of records after the header
+ *                16  first RIA angle     int32, the first record angle delta is from this
+ *                20  last RIA angle      int32
+ *                24  axis count          uint16, 24
+ *                26  reserved            uint16, 0
+ *                28  CRC-32              uint32, of header bytes 0 to 27 and the records (CRC-32/ISO-HDLC, as zip)
+ *              records, in RIA angle order. There are two record sizes, by the SRF_SELECTED flag, and no index,
+ *              so a reader reads the flags of a record to find the next one:
+ *                 0  angle delta         uint16, RIA angle minus the previous record RIA angle
+ *                 2  flags               uint16, ScsRecordFlags (TablePublisher.hpp)
+ *                 4  selected axes       uint32, selected rows: bit n is axis index n. 0 for all axes rows.
+ *                 8  positions           selected rows: 1 LREAL, the position or distance of the selected axes.
+ *                                        all axes rows: 24 LREAL, foot A inner to F outer, then column A inner to F outer.
+ *              So a selected row (SRF_SELECTED set) is 16 bytes, and an all axes row is 200 bytes.
+ *              The positions are absolute or relative (distance) as in the SCS table, by the SRF_ABSOLUTE and
+ *              SRF_ADJUST_ABSOLUTE flags. INITIAL_NO_POSITION is an axis the row does not move.
+ *
+ *            NOTE: CLS positions are calculated by a db procedure from the SCS table, so they are not included.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  Boost CRC
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_PlcDownload_H_
+#define GA_PlcDownload_H_
+
+// standard c/c++ libraries
+#include <cstdint>
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+#include "AxisPositions.hpp"
+
+namespace gaScsData {
+
+class PlcDownload : private boost::noncopyable {
+
+public:
+  // typedefs and enums
+    // one decoded record
+    struct RowTyp {
+      long riaAngle;
+      uint32_t flags;
+      uint32_t selectedMask;
+      AxisPositions::Positions positions;  // 1 for selected rows, 24 for all axes rows
+      };
+    typedef std::vector<RowTyp> row_list;
+
+  // ctors and dtor
+    PlcDownload();
+    ~PlcDownload();
+
+  // public member functions
+    // Encode the SCS rows. Return value indicates success, or error if a row can't be encoded.
+    long Build(const AxisPositions::ScsAxesPositionMap &scsRows);
+    // Return value indicates success or error
+    long Write(const std::string &fileName) const;
+    // the encoded file
+    const std::string& GetData() const;
+    size_t GetRecordCount() const;
+
+    // Decode a file, checking the CRC and the layout. Return value indicates success or error
+    static long Read(const std::string &fileName, row_list &rows);
+
+  private:
+    // member variables
+      std::string data_;  // header and records
+      size_t recordCount_;
+};
+
+} // namespace gaScsData
+#endif // GA_PlcDownload_H_
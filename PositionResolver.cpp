@@ -0,0 +1,114 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: PositionResolver.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Absolute axis positions at any RIA angle, from checkpoints of the replayed SCS rows.
+ *
+ * Libraries used:  vector
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <algorithm>
+#include <iterator>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "PositionResolver.hpp"
+
+namespace gaScsData {
+
+// ctors and dtor
+PositionResolver::PositionResolver(const AxisPositions::ScsAxesPositionMap &scsRows, size_t checkpointInterval) :
+    scsRows_(scsRows) {
+  if (0 == checkpointInterval)
+    checkpointInterval= 1;
+  checkpoints_.reserve(scsRows_.size() / checkpointInterval + 1);
+
+  // replay the rows, keeping the positions after row 0, checkpointInterval, 2 * checkpointInterval, ...
+  AxisPositions::Positions current(COLUMN_COUNT * 2, INITIAL_NO_POSITION);
+  size_t rowNumber= 0;
+  for (AxisPositions::sapm_const_iter cit= scsRows_.begin(); cit != scsRows_.end(); ++cit, ++rowNumber) {
+    ApplyRow(cit->second, current);
+    if (0 == rowNumber % checkpointInterval) {
+      CheckpointTyp checkpoint;
+      checkpoint.riaAngle= cit->first;
+      checkpoint.row= cit;
+      checkpoint.positions= current;
+      checkpoints_.push_back(checkpoint);
+      }
+    }
+  }
+
+PositionResolver::~PositionResolver() { }
+
+// public member functions
+long PositionResolver::GetPositions(long riaAngle, AxisPositions::Positions &positions, long &rowAngle) const {
+  // return value indicates success or no results
+  // last checkpoint at or before the angle
+  checkpoint_list::const_iterator checkpoint= std::upper_bound(checkpoints_.begin(), checkpoints_.end(), riaAngle,
+    [](long angle, const CheckpointTyp &value) { return angle < value.riaAngle; });
+  if (checkpoints_.begin() == checkpoint) {
+    positions.assign(COLUMN_COUNT * 2, INITIAL_NO_POSITION);
+    rowAngle= riaAngle;
+    return RTN_NO_RESULTS;
+    }
+  --checkpoint;
+
+  // replay the rows after it, up to the angle
+  positions= checkpoint->positions;
+  rowAngle= checkpoint->riaAngle;
+  for (AxisPositions::sapm_const_iter cit= std::next(checkpoint->row); cit != scsRows_.end() && cit->first <= riaAngle; ++cit) {
+    ApplyRow(cit->second, positions);
+    rowAngle= cit->first;
+    }
+  return RTN_NO_ERROR;
+  }
+
+void PositionResolver::Materialize(position_table &positions) const {
+  positions.clear();
+  positions.reserve(scsRows_.size());
+  AxisPositions::Positions current(COLUMN_COUNT * 2, INITIAL_NO_POSITION);
+  for (AxisPositions::sapm_const_iter cit= scsRows_.begin(); cit != scsRows_.end(); ++cit) {
+    ApplyRow(cit->second, current);
+    positions.push_back(current);
+    }
+  }
+
+size_t PositionResolver::GetCheckpointCount() const {
+  return checkpoints_.size();
+  }
+
+void PositionResolver::ApplyRow(const AxisPositions::SPosDetail &posDetail, AxisPositions::Positions &positions) {
+  // The same as the position table view.
+  // All axes rows set (absolute) or move (relative) every axis. Selected axis rows set or move the selected axes.
+  // Adjust absolute rows move the selected axes from their previous position.
+  const bool isSelected= posDetail.get<2>()[0];
+  const bool isAbsolute= posDetail.get<4>().get<1>();
+  const size_t axisCount= positions.size();
+  for (size_t axis= 0; axis < axisCount; ++axis) {
+    double value;
+    bool isSet= isAbsolute;
+    if (!isSelected)
+      value= axis < static_cast<size_t>(COLUMN_COUNT) ? posDetail.get<0>()[axis] : posDetail.get<1>()[axis - COLUMN_COUNT];
+    else if (posDetail.get<2>()[axis + 1]) {
+      value= posDetail.get<3>().get<0>();
+      isSet= isAbsolute && !posDetail.get<3>().get<2>();
+      }
+    else
+      continue;  // not a selected axis
+    if (INITIAL_NO_POSITION == value || POSITION_NOT_CALCULATED == value)
+      continue;  // no position for this axis
+    if (isSet)
+      positions[axis]= value;
+    else if (INITIAL_NO_POSITION != positions[axis])
+      positions[axis]+= value;
+    }
+  }
+
+} // namespace gaScsData
@@ -0,0 +1,80 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: PositionResolver.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Absolute axis positions at any RIA angle, from the SCS position map.
+ *            The SCS rows are a mix of absolute all axes rows, relative and absolute selected axis rows,
+ *            and adjust absolute selected axis rows (moved from the previous position, IM_ABS_UPDATE_SEL).
+ *            So the position of an axis at an angle is found by replaying the rows from the start,
+ *            which the position table view does in SQL.
+ *
+ *            The resolver replays the rows once, and keeps the 24 axis positions after every
+ *            checkpointInterval rows. A lookup finds the checkpoint at or before the angle, and replays
+ *            at most checkpointInterval rows from it: O(log n + checkpointInterval).
+ *            Materialize() replays every row in one pass, for a full absolute table.
+ *
+ *            Positions are foot A inner to F outer, then column A inner to F outer (the AxisIndexes order).
+ *            INITIAL_NO_POSITION is an axis with no absolute position yet. A relative move of an axis with
+ *            no absolute position leaves it with no position.
+ *
+ *            NOTE: The resolver keeps iterators into the SCS position map, so the map must not change
+ *            while the resolver is used.
+ *
+ * Libraries used:  vector
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_PositionResolver_H_
+#define GA_PositionResolver_H_
+
+// standard c/c++ libraries
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+#include "AxisPositions.hpp"
+
+namespace gaScsData {
+
+class PositionResolver : private boost::noncopyable {
+
+public:
+  // typedefs and enums
+    // absolute positions after each SCS row, in RIA angle order
+    typedef std::vector<AxisPositions::Positions> position_table;
+
+  // ctors and dtor
+    explicit PositionResolver(const AxisPositions::ScsAxesPositionMap &scsRows,
+                              size_t checkpointInterval= RESOLVER_CHECKPOINT_ROWS);
+    ~PositionResolver();
+
+  // public member functions
+    // Absolute positions after the SCS row at or before the RIA angle, and the RIA angle of that row.
+    // Return value is RTN_NO_RESULTS if the angle is before the first row.
+    long GetPositions(long riaAngle, AxisPositions::Positions &positions, long &rowAngle) const;
+    // absolute positions after every row, in one pass
+    void Materialize(position_table &positions) const;
+    size_t GetCheckpointCount() const;
+
+    // Apply one SCS row to the absolute positions
+    static void ApplyRow(const AxisPositions::SPosDetail &posDetail, AxisPositions::Positions &positions);
+
+  private:
+    // positions after the row
+    struct CheckpointTyp {
+      long riaAngle;
+      AxisPositions::sapm_const_iter row;
+      AxisPositions::Positions positions;
+      };
+    typedef std::vector<CheckpointTyp> checkpoint_list;
+
+    // member variables
+      const AxisPositions::ScsAxesPositionMap &scsRows_;
+      checkpoint_list checkpoints_;  // by RIA angle
+};
+
+} // namespace gaScsData
+#endif // GA_PositionResolver_H_
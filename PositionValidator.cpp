@@ -0,0 +1,325 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: PositionValidator.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Checks the SCS position map in parallel chunks, and reports the violations.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  thread
+ *                  atomic
+ *                  chrono
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <thread>
+#include <chrono>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "PositionValidator.hpp"
+#include "PositionResolver.hpp"
+#include "TraceRecorder.hpp"
+
+namespace gaScsData {
+
+static const char *VIOLATION_TYPE_NAMES[]= { "sentinel", "foot_range", "feet_retracted", "key_collision" };
+static_assert(sizeof(VIOLATION_TYPE_NAMES) / sizeof(VIOLATION_TYPE_NAMES[0]) == PositionValidator::VIOLATION_NUM_OF_TYPES,
+              "one name per violation type");
+
+static bool IsSentinel(double value) {
+  return INITIAL_NO_POSITION == value || POSITION_NOT_CALCULATED == value;
+  }
+
+static bool IsRetracted(double position) {
+  return INITIAL_NO_POSITION != position && INITIAL_FULL_RETRACT_POS - VALIDATOR_POSITION_TOLERANCE <= position;
+  }
+
+// ctors and dtor
+PositionValidator::PositionValidator() :
+    threads_(VALIDATOR_THREADS),
+    chunkRows_(VALIDATOR_CHUNK_ROWS),
+    nextChunk_(0),
+    workers_(0),
+    rowCount_(0),
+    elapsedMs_(0) {
+  std::fill(counts_, counts_ + VIOLATION_NUM_OF_TYPES, 0);
+  }
+
+PositionValidator::~PositionValidator() { }
+
+// accessors
+void PositionValidator::SetThreads(size_t threads) {
+  threads_= threads;
+  }
+
+void PositionValidator::SetChunkRows(size_t rows) {
+  chunkRows_= 0 != rows ? rows : 1;
+  }
+
+size_t PositionValidator::GetRowCount() const {
+  return rowCount_;
+  }
+
+size_t PositionValidator::GetChunkCount() const {
+  return chunks_.size();
+  }
+
+size_t PositionValidator::GetViolationCount() const {
+  size_t count= 0;
+  for (long type= 0; type < VIOLATION_NUM_OF_TYPES; ++type) {
+    count+= counts_[type];
+    }
+  return count;
+  }
+
+size_t PositionValidator::GetViolationCount(ViolationTypes type) const {
+  return counts_[type];
+  }
+
+const PositionValidator::violation_list& PositionValidator::GetViolations() const {
+  return violations_;
+  }
+
+// public member functions
+long PositionValidator::Validate(const AxisPositions::ScsAxesPositionMap &scsRows,
+                                 const AxisPositions::key_collision_list &collisions) {
+  // return value is RTN_NO_ERROR if there are no violations
+  const std::chrono::steady_clock::time_point start= std::chrono::steady_clock::now();
+  chunks_.clear();
+  violations_.clear();
+  std::fill(counts_, counts_ + VIOLATION_NUM_OF_TYPES, 0);
+  rowCount_= scsRows.size();
+
+  // chunk boundaries. The map is a tree, so this is one walk over it.
+  chunks_.reserve(rowCount_ / chunkRows_ + 1);
+  size_t rowNumber= 0;
+  for (AxisPositions::sapm_const_iter cit= scsRows.begin(); cit != scsRows.end(); ++cit, ++rowNumber) {
+    if (0 == rowNumber % chunkRows_) {
+      if (!chunks_.empty())
+        chunks_.back().last= cit;
+      chunks_.push_back(ChunkTyp());
+      chunks_.back().first= cit;
+      }
+    }
+  if (!chunks_.empty())
+    chunks_.back().last= scsRows.end();
+
+  workers_= 0 != threads_ ? threads_ : std::thread::hardware_concurrency();
+  if (0 == workers_)
+    workers_= 1;
+  if (workers_ > chunks_.size())
+    workers_= chunks_.size();
+
+  AxisPositions::Positions positions(COLUMN_COUNT * 2, INITIAL_NO_POSITION);
+  if (1 < workers_) {
+    // 1) what each chunk does to each axis
+    RunChunks(&PositionValidator::Summarize);
+
+    // 2) start positions of each chunk, from the one before it
+    for (size_t i= 0; i < chunks_.size(); ++i) {
+      chunks_[i].start= positions;
+      for (size_t axis= 0; axis < positions.size(); ++axis) {
+        if (INITIAL_NO_POSITION != chunks_[i].setPositions[axis])
+          positions[axis]= chunks_[i].setPositions[axis];
+        else if (INITIAL_NO_POSITION != positions[axis])
+          positions[axis]+= chunks_[i].moves[axis];
+        }
+      }
+
+    // 3) check the rows
+    RunChunks(&PositionValidator::Check);
+    }
+  else {
+    // one thread: each chunk starts where the one before it ended, so steps 1 and 2 are not needed
+    for (size_t i= 0; i < chunks_.size(); ++i) {
+      chunks_[i].start= positions;
+      Check(chunks_[i]);
+      positions= chunks_[i].end;
+      }
+    }
+
+  // collisions, by RIA angle
+  ChunkTyp collisionChunk;
+  std::fill(collisionChunk.counts, collisionChunk.counts + VIOLATION_NUM_OF_TYPES, 0);
+  for (AxisPositions::key_collision_list::const_iterator cit= collisions.begin(); cit != collisions.end(); ++cit) {
+    AddViolation(collisionChunk, VIOLATION_KEY_COLLISION, cit->first, -1, static_cast<double>(cit->first), cit->second);
+    }
+  std::stable_sort(collisionChunk.violations.begin(), collisionChunk.violations.end(),
+    [](const ViolationTyp &a, const ViolationTyp &b) { return a.riaAngle < b.riaAngle; });
+
+  // the chunks are in RIA angle order, so their lists join in order. Then merge in the collisions.
+  violation_list rowViolations;
+  for (size_t i= 0; i < chunks_.size(); ++i) {
+    for (long type= 0; type < VIOLATION_NUM_OF_TYPES; ++type) {
+      counts_[type]+= chunks_[i].counts[type];
+      }
+    rowViolations.insert(rowViolations.end(), chunks_[i].violations.begin(), chunks_[i].violations.end());
+    }
+  counts_[VIOLATION_KEY_COLLISION]+= collisionChunk.counts[VIOLATION_KEY_COLLISION];
+  violations_.reserve(rowViolations.size() + collisionChunk.violations.size());
+  std::merge(rowViolations.begin(), rowViolations.end(), collisionChunk.violations.begin(), collisionChunk.violations.end(),
+    std::back_inserter(violations_), [](const ViolationTyp &a, const ViolationTyp &b) { return a.riaAngle < b.riaAngle; });
+  if (VALIDATOR_MAX_REPORTED < violations_.size())
+    violations_.resize(VALIDATOR_MAX_REPORTED);
+
+  elapsedMs_= std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  return 0 == GetViolationCount() ? RTN_NO_ERROR : RTN_ERROR;
+  }
+
+std::string PositionValidator::ToJson() const {
+  std::ostringstream json;
+  json << std::fixed;
+  json << "{" << std::endl
+       << "  \"rows\": " << rowCount_ << ", \"chunks\": " << chunks_.size() << ", \"threads\": " << workers_
+       << ", \"elapsed_ms\": " << elapsedMs_ << "," << std::endl
+       << "  \"violation_count\": " << GetViolationCount() << "," << std::endl
+       << "  \"counts\": {";
+  for (long type= 0; type < VIOLATION_NUM_OF_TYPES; ++type) {
+    json << (0 == type ? " " : ", ") << "\"" << VIOLATION_TYPE_NAMES[type] << "\": " << counts_[type];
+    }
+  json << " }," << std::endl
+       << "  \"violations\": [";
+  for (size_t i= 0; i < violations_.size(); ++i) {
+    const ViolationTyp &violation= violations_[i];
+    json << (0 == i ? "" : ",") << std::endl
+         << "    { \"type\": \"" << VIOLATION_TYPE_NAMES[violation.type] << "\", \"ria_angle\": " << violation.riaAngle
+         << ", \"axis\": \"" << (0 <= violation.axis ? AXIS_COLUMN_NAMES[violation.axis] : "") << "\""
+         << ", \"value\": " << violation.value << ", \"trace\": \"" << TraceRecorder::JsonEscape(violation.trace) << "\" }";
+    }
+  json << std::endl << "  ]" << std::endl << "}" << std::endl;
+  return json.str();
+  }
+
+long PositionValidator::WriteJson(const std::string &fileName) const {
+  // return value indicates success or error
+  std::ofstream output(fileName.c_str());
+  output << ToJson();
+  output.close();
+  if (!output) {
+    std::cout << "Error writing the validation report to " << fileName << std::endl;
+    return RTN_ERROR;
+    }
+  return RTN_NO_ERROR;
+  }
+
+const char* PositionValidator::GetTypeName(ViolationTypes type) {
+  return VIOLATION_TYPE_NAMES[type];
+  }
+
+// private helper functions
+void PositionValidator::RunChunks(chunk_step step) {
+  nextChunk_= 0;
+  std::vector<std::thread> threads;
+  for (size_t i= 1; i < workers_; ++i) {
+    threads.push_back(std::thread(&PositionValidator::Worker, this, step));
+    }
+  // this thread is a worker too
+  Worker(step);
+  for (size_t i= 0; i < threads.size(); ++i) {
+    threads[i].join();
+    }
+  }
+
+void PositionValidator::Worker(chunk_step step) {
+  for (size_t next= nextChunk_.fetch_add(1); next < chunks_.size(); next= nextChunk_.fetch_add(1)) {
+    (this->*step)(chunks_[next]);
+    }
+  }
+
+void PositionValidator::Summarize(ChunkTyp &chunk) {
+  // From no positions, an axis has a position after the chunk only if the chunk sets it (and that is the position).
+  // From 0, an axis the chunk does not set ends at the distance the chunk moves it.
+  chunk.setPositions.assign(COLUMN_COUNT * 2, INITIAL_NO_POSITION);
+  chunk.moves.assign(COLUMN_COUNT * 2, 0.0);
+  for (AxisPositions::sapm_const_iter cit= chunk.first; cit != chunk.last; ++cit) {
+    PositionResolver::ApplyRow(cit->second, chunk.setPositions);
+    PositionResolver::ApplyRow(cit->second, chunk.moves);
+    }
+  }
+
+void PositionValidator::Check(ChunkTyp &chunk) {
+  chunk.violations.clear();
+  std::fill(chunk.counts, chunk.counts + VIOLATION_NUM_OF_TYPES, 0);
+  AxisPositions::Positions positions= chunk.start;
+  AxisPositions::Positions previous;
+
+  for (AxisPositions::sapm_const_iter cit= chunk.first; cit != chunk.last; ++cit) {
+    const long riaAngle= cit->first;
+    const AxisPositions::SPosDetail &posDetail= cit->second;
+    const std::string &trace= posDetail.get<4>().get<0>();
+
+    // sentinels written as positions
+    if (static_cast<long>(round(INITIAL_NO_POSITION)) == riaAngle || static_cast<long>(round(POSITION_NOT_CALCULATED)) == riaAngle)
+      AddViolation(chunk, VIOLATION_SENTINEL, riaAngle, -1, static_cast<double>(riaAngle), trace);
+    if (posDetail.get<2>()[0]) {
+      // selected axes row. The distance is used by every selected axis.
+      const double distance= posDetail.get<3>().get<0>();
+      if (IsSentinel(distance) || !std::isfinite(distance)) {
+        long axis= -1;
+        for (long i= 0; i < COLUMN_COUNT * 2 && -1 == axis; ++i) {
+          if (posDetail.get<2>()[i + 1])
+            axis= i;
+          }
+        AddViolation(chunk, VIOLATION_SENTINEL, riaAngle, axis, distance, trace);
+        }
+      }
+    else {
+      for (long i= 0; i < COLUMN_COUNT; ++i) {
+        if (IsSentinel(posDetail.get<0>()[i]) || !std::isfinite(posDetail.get<0>()[i]))
+          AddViolation(chunk, VIOLATION_SENTINEL, riaAngle, i, posDetail.get<0>()[i], trace);
+        }
+      for (long i= 0; i < COLUMN_COUNT; ++i) {
+        if (INITIAL_NO_POSITION == posDetail.get<1>()[i] || !std::isfinite(posDetail.get<1>()[i]))
+          AddViolation(chunk, VIOLATION_SENTINEL, riaAngle, COLUMN_COUNT + i, posDetail.get<1>()[i], trace);
+        }
+      }
+
+    previous= positions;
+    PositionResolver::ApplyRow(posDetail, positions);
+
+    // feet the row moved
+    for (long axis= 0; axis < COLUMN_COUNT; ++axis) {
+      const double position= positions[axis];
+      if (position == previous[axis] || INITIAL_NO_POSITION == position)
+        continue;
+      if (INITIAL_FULL_EXTEND_POS - VALIDATOR_POSITION_TOLERANCE > position ||
+          INITIAL_FULL_RETRACT_POS + VALIDATOR_POSITION_TOLERANCE < position)
+        AddViolation(chunk, VIOLATION_FOOT_RANGE, riaAngle, axis, position, trace);
+      }
+    // columns the row left with both feet retracted. The inner and outer feet of a column are next to each other.
+    for (long inner= 0; inner < COLUMN_COUNT; inner+= 2) {
+      if (IsRetracted(positions[inner]) && IsRetracted(positions[inner + 1]) &&
+          !(IsRetracted(previous[inner]) && IsRetracted(previous[inner + 1]))) {
+        const long axis= positions[inner + 1] != previous[inner + 1] ? inner + 1 : inner;
+        AddViolation(chunk, VIOLATION_FEET_RETRACTED, riaAngle, axis, positions[axis], trace);
+        }
+      }
+    }
+  chunk.end= positions;
+  }
+
+void PositionValidator::AddViolation(ChunkTyp &chunk, ViolationTypes type, long riaAngle, long axis, double value,
+                                     const std::string &trace) {
+  ++chunk.counts[type];
+  if (VALIDATOR_MAX_REPORTED <= chunk.violations.size())
+    return;  // counted, not listed
+  ViolationTyp violation;
+  violation.type= type;
+  violation.riaAngle= riaAngle;
+  violation.axis= axis;
+  violation.value= value;
+  violation.trace= trace;
+  chunk.violations.push_back(violation);
+  }
+
+} // namespace gaScsData
@@ -0,0 +1,140 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: PositionValidator.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Checks the SCS position map before it is used, in one pass over the rows, and lists what is wrong.
+ *            Violations:
+ *              sentinel         -- a sentinel is written as a position: a foot of an all axes row with no position,
+ *                                  a column of an all axes row with INITIAL_NO_POSITION (POSITION_NOT_CALCULATED is
+ *                                  the run time column position, so it is allowed), the distance of a selected
+ *                                  axis row, or a RIA angle that is a sentinel
+ *              foot_range       -- a row moves a foot outside INITIAL_FULL_EXTEND_POS .. INITIAL_FULL_RETRACT_POS
+ *                                  (absolute position after the row, VALIDATOR_POSITION_TOLERANCE allowed)
+ *              feet_retracted   -- a row leaves both feet of a column (inner and outer) at INITIAL_FULL_RETRACT_POS.
+ *                                  Listed at the row that retracts the second foot.
+ *              key_collision    -- two rows rounded to the same RIA angle, so one replaced the other in the map
+ *                                  (AxisPositions::GetKeyCollisions()). The trace is of the replaced row.
+ *
+ *            The rows are split into chunks of VALIDATOR_CHUNK_ROWS, and the chunks are checked on worker threads.
+ *            The absolute positions at the start of a chunk depend on every row before it, so it is done in
+ *            three steps, each linear in the rows:
+ *              1) each chunk (in parallel) finds what it does to each axis: set to a position, or moved by a distance
+ *              2) the chunk start positions are found from those, in chunk order (one step per chunk)
+ *              3) each chunk (in parallel) replays its rows from its start positions (PositionResolver::ApplyRow())
+ *                 and checks them
+ *            The moves before a chunk are added in another order than a row by row replay, so a start position
+ *            can differ from it in the last bits. That is why the foot limits have a tolerance.
+ *            With one thread (SetThreads(1), or one core), steps 1 and 2 are skipped: each chunk starts at the
+ *            positions the chunk before it ended at, so it is one replay of the rows.
+ *
+ *            Violations are listed by RIA angle, the first VALIDATOR_MAX_REPORTED of them. All are counted.
+ *
+ *            NOTE: The validator keeps iterators into the SCS position map while it checks it, so the map
+ *            must not change during Validate().
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  thread
+ *                  atomic
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_PositionValidator_H_
+#define GA_PositionValidator_H_
+
+// standard c/c++ libraries
+#include <atomic>
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+#include "AxisPositions.hpp"
+
+namespace gaScsData {
+
+class PositionValidator : private boost::noncopyable {
+
+public:
+  // typedefs and enums
+    enum ViolationTypes {
+      VIOLATION_SENTINEL= 0,
+      VIOLATION_FOOT_RANGE,
+      VIOLATION_FEET_RETRACTED,
+      VIOLATION_KEY_COLLISION,
+      VIOLATION_NUM_OF_TYPES };
+
+    struct ViolationTyp {
+      ViolationTypes type;
+      long riaAngle;
+      long axis;            // axis index (0 is foot A inner, as AXIS_COLUMN_NAMES), -1 if not one axis
+      double value;         // position, distance, or sentinel
+      std::string trace;    // logic trace of the row
+      };
+    typedef std::vector<ViolationTyp> violation_list;
+
+  // ctors and dtor
+    PositionValidator();
+    ~PositionValidator();
+
+  // accessors
+    void SetThreads(size_t threads);  // 0 -- one per core
+    void SetChunkRows(size_t rows);
+    size_t GetRowCount() const;
+    size_t GetChunkCount() const;
+    size_t GetViolationCount() const;
+    size_t GetViolationCount(ViolationTypes type) const;
+    // the first VALIDATOR_MAX_REPORTED violations, by RIA angle
+    const violation_list& GetViolations() const;
+
+  // public member functions
+    // Check the rows, and the rows replaced while the map was made.
+    // Return value is RTN_NO_ERROR if there are no violations, RTN_ERROR if there are.
+    long Validate(const AxisPositions::ScsAxesPositionMap &scsRows, const AxisPositions::key_collision_list &collisions);
+    // report as a JSON document
+    std::string ToJson() const;
+    // write ToJson() to the file. Return value indicates success or error
+    long WriteJson(const std::string &fileName) const;
+
+    // type name used in the report
+    static const char* GetTypeName(ViolationTypes type);
+
+  private:
+    // rows [first, last) of the map
+    struct ChunkTyp {
+      AxisPositions::sapm_const_iter first;
+      AxisPositions::sapm_const_iter last;
+      AxisPositions::Positions setPositions;  // step 1: last position set by the chunk, INITIAL_NO_POSITION if none
+      AxisPositions::Positions moves;         // step 1: distance moved by the chunk when nothing is set
+      AxisPositions::Positions start;         // step 2: positions before the first row
+      AxisPositions::Positions end;           // step 3: positions after the last row
+      violation_list violations;              // step 3
+      size_t counts[VIOLATION_NUM_OF_TYPES];
+      };
+    typedef void (PositionValidator::*chunk_step)(ChunkTyp &chunk);
+
+    // helper functions
+      // run the step on every chunk, on the worker threads
+      void RunChunks(chunk_step step);
+      void Worker(chunk_step step);
+      void Summarize(ChunkTyp &chunk);
+      void Check(ChunkTyp &chunk);
+      static void AddViolation(ChunkTyp &chunk, ViolationTypes type, long riaAngle, long axis, double value,
+                               const std::string &trace);
+
+    // member variables
+      size_t threads_;
+      size_t chunkRows_;
+      std::vector<ChunkTyp> chunks_;
+      std::atomic<size_t> nextChunk_;  // next chunk for a worker
+      size_t workers_;                 // used by the last Validate()
+      size_t rowCount_;
+      violation_list violations_;
+      size_t counts_[VIOLATION_NUM_OF_TYPES];
+      double elapsedMs_;
+};
+
+} // namespace gaScsData
+#endif // GA_PositionValidator_H_
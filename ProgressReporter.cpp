@@ -0,0 +1,98 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: ProgressReporter.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Console progress display. Loops bump an atomic counter,
+ *            and a background ticker redraws at a fixed rate.
+ *
+ * Libraries used:  string
+ *                  atomic
+ *                  thread
+ *                  mutex
+ *                  condition_variable
+ *                  chrono
+ *                  Boost Non-copyable
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <chrono>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "ProgressReporter.hpp"
+
+namespace gaScsData {
+
+std::atomic<bool> ProgressReporter::isHeadless_(false);
+
+// ctors and dtor
+ProgressReporter::ProgressReporter(const std::string &label, size_t total) :
+    label_(label),
+    total_(total),
+    count_(0),
+    isFinished_(false) {
+  if (!IsHeadless())
+    ticker_= std::thread(&ProgressReporter::Ticker, this);
+  }
+
+ProgressReporter::~ProgressReporter() {
+  Finish();
+  }
+
+// public member functions
+void ProgressReporter::Add(size_t count) {
+  count_.fetch_add(count, std::memory_order_relaxed);
+  }
+
+void ProgressReporter::Finish() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (isFinished_)
+      return;
+    isFinished_= true;
+  }
+  wake_.notify_one();
+  if (ticker_.joinable()) {
+    ticker_.join();
+    // final count, and end the line
+    Draw();
+    std::cout << std::endl;
+    }
+  }
+
+size_t ProgressReporter::GetCount() const {
+  return count_.load(std::memory_order_relaxed);
+  }
+
+void ProgressReporter::SetHeadless(bool isHeadless) { isHeadless_.store(isHeadless); }
+bool ProgressReporter::IsHeadless() { return isHeadless_.load(); }
+
+// private helper functions
+void ProgressReporter::Ticker() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!isFinished_) {
+    // wait for the redraw period, or until Finish() wakes us up
+    if (wake_.wait_for(lock, std::chrono::milliseconds(PROGRESS_REDRAW_MS), [this] { return isFinished_; }))
+      break;
+    Draw();
+    }
+  }
+
+void ProgressReporter::Draw() const {
+  const size_t count= count_.load(std::memory_order_relaxed);
+  std::cout << "  " << label_ << ": " << count;
+  if (0 != total_) {
+    // use double so the percent does not use integer math. Truncate fractional percentages.
+    const long pctDone= static_cast<long>(100.0 * static_cast<double>(count) / static_cast<double>(total_));
+    std::cout << " of " << total_ << " (" << pctDone << " %)";
+    }
+  std::cout << "   \r" << std::flush; // no linefeed so this line will be overwritten next time
+  }
+
+} // namespace gaScsData
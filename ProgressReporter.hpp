@@ -0,0 +1,85 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: ProgressReporter.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Console progress display that stays out of the hot loops.
+ *            The loop only bumps an atomic counter (Add()). A background ticker thread
+ *            redraws the progress line every PROGRESS_REDRAW_MS, so the console costs the
+ *            same no matter how fast the loop runs. Formatted console output on every
+ *            iteration was a measurable share of loop time on the Windows console.
+ *            Add() can be called from any number of threads.
+ *
+ *            In headless mode (SetHeadless(true), for batch runs) there is no ticker and
+ *            nothing is displayed.
+ *
+ *            Usage:
+ *              ProgressReporter progress("SCS inserts", rowCount);
+ *              for (...) { ...; progress.Add(); }
+ *              progress.Finish();  // or let the destructor do it. Draws the final count and ends the line.
+ *
+ * Libraries used:  string
+ *                  atomic
+ *                  thread
+ *                  mutex
+ *                  condition_variable
+ *                  chrono
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_ProgressReporter_H_
+#define GA_ProgressReporter_H_
+
+// standard c/c++ libraries
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+
+namespace gaScsData {
+
+class ProgressReporter : private boost::noncopyable {
+
+public:
+  // ctors and dtor
+    // label is displayed in front of the count. total is the expected count (0 if not known).
+    ProgressReporter(const std::string &label, size_t total);
+    ~ProgressReporter();
+
+  // public member functions
+    // count progress. Cheap and thread safe -- one relaxed atomic add.
+    void Add(size_t count = 1);
+    // stop the ticker, and draw the final count. Safe to call more than once.
+    void Finish();
+    size_t GetCount() const;
+
+    // headless mode -- no progress display at all (batch runs)
+    static void SetHeadless(bool isHeadless);
+    static bool IsHeadless();
+
+  private:
+    // helper functions
+      // ticker thread. Redraws until Finish().
+      void Ticker();
+      void Draw() const;
+
+    // member variables
+      std::string label_;
+      size_t total_;
+      std::atomic<size_t> count_;
+      bool isFinished_;
+      std::mutex mutex_;  // with wake_, lets Finish() wake the ticker early
+      std::condition_variable wake_;
+      std::thread ticker_;
+
+      static std::atomic<bool> isHeadless_;
+};
+
+} // namespace gaScsData
+#endif // GA_ProgressReporter_H_
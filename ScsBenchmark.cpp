@@ -0,0 +1,90 @@
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <fstream>
+
+// GA classes
+#include "gaScsDataConstants.hpp"
+#include "PipelineBenchmark.hpp"
+
+
+  // display argument usage
+  void static show_usage(std::string name) {  // 'static' limits scope to this translational unit
+    std::cout << "Usage for " << name << ":" << std::endl << std::endl
+      << "Times the SCS position and event generation pipeline, and the coil map lookups it uses," << std::endl
+      << "on a generated coil map. No db is needed and no tables are changed." << std::endl << std::endl
+      << "Command line arguments (all optional):" << std::endl
+      << "\t-h, -H, -?,-help, or -Help will display this usage message" << std::endl
+      << "\t-s <n> generated coil size, multiples of the production coil (default 1)" << std::endl
+      << "\t-r <n> repetitions of each benchmark (default " << gaScsData::BENCHMARK_REPETITIONS << ")" << std::endl
+      << "\t-n <n> random angles per microbenchmark repetition (default " << gaScsData::BENCHMARK_MICRO_COUNT << ")" << std::endl
+      << "\t-o <file> JSON results file (default " << gaScsData::BENCHMARK_OUTPUT_FILE << ")" << std::endl << std::endl
+      << "Valid examples are:" << std::endl
+      << "\t\"\" (1x coil, results in " << gaScsData::BENCHMARK_OUTPUT_FILE << ")" << std::endl
+      << "\t\"-s 10 -r 3 -o release.json\"" << std::endl << std::endl;
+  }
+
+
+  int main(int argc, char* argv[]) {
+    // Look at command line arguments for the benchmark settings. See show_usage().
+    // No getchar() at the end. This is meant to be run from scripts.
+    long scale = 1;
+    long repetitions = gaScsData::BENCHMARK_REPETITIONS;
+    size_t microCount = gaScsData::BENCHMARK_MICRO_COUNT;
+    std::string outputFile = gaScsData::BENCHMARK_OUTPUT_FILE;
+
+    std::string arg; // holding place
+    for (int i = 1; i < argc; ++i) {
+      arg = argv[i];
+      if ("-h" == arg || "-H" == arg || "-?" == arg || "-help" == arg || "-Help" == arg) {
+        show_usage(argv[0]);
+        return 0; // exit okay
+      }
+      else if (("-s" == arg || "-r" == arg || "-n" == arg || "-o" == arg) && i + 1 < argc) {
+        // arguments with a value
+        std::string value = argv[++i];
+        if ("-o" == arg)
+          outputFile = value;
+        else {
+          long number = std::atol(value.c_str());
+          if (number < 1) {
+            std::cout << std::endl << "Invalid value for " << arg << ": \"" << value << "\"" << std::endl;
+            show_usage(argv[0]);
+            return 1; // exit error
+          }
+          if ("-s" == arg)
+            scale = number;
+          else if ("-r" == arg)
+            repetitions = number;
+          else
+            microCount = static_cast<size_t>(number);
+        }
+      }
+      else {  // argument not recognized. Show usage and leave.
+        std::cout << std::endl << "Unrecognized argument: \"" << arg << "\"" << std::endl;
+        show_usage(argv[0]);
+        return 1; // exit error
+      }
+    }
+
+    gaScsData::PipelineBenchmark benchmark;
+    benchmark.SetScale(scale);
+    benchmark.SetRepetitions(repetitions);
+    benchmark.SetMicroCount(microCount);
+    if (gaScsData::RTN_NO_ERROR != benchmark.Run()) {
+      std::cout << "Error when running the benchmark." << std::endl;
+      return 1; // exit error
+    }
+
+    // write the machine readable results
+    std::ofstream output(outputFile.c_str());
+    output << benchmark.ToJson();
+    output.close();
+    if (!output) {
+      std::cout << "Error when writing the results to " << outputFile << std::endl;
+      return 1; // exit error
+    }
+    std::cout << "Results written to " << outputFile << std::endl;
+    return 0;
+  }
@@ -0,0 +1,131 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: TableGeneration.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Generation row of a generated db table: the input hash and generator version of its last complete write.
+ *
+ * Libraries used:  string
+ *                  SQLAPI.h
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <cstdlib>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "TableGeneration.hpp"
+#include "Metrics.hpp"
+
+namespace gaScsData {
+
+// 16 hex digits, the form input hashes have in the db
+static std::string ToHex(uint64_t value) {
+  static const char digits[]= "0123456789abcdef";
+  std::string hex(16, '0');
+  for (size_t i= 0; i < hex.size(); ++i) {
+    hex[hex.size() - 1 - i]= digits[value & 0xf];
+    value>>= 4;
+    }
+  return hex;
+  }
+
+// ctors and dtor
+TableGeneration::TableGeneration(const std::string &tableName) :
+    tableName_(tableName) { }
+
+TableGeneration::~TableGeneration() { }
+
+// public member functions
+const std::string& TableGeneration::GetTableName() const {
+  return tableName_;
+  }
+
+long TableGeneration::Read(SACommand &command, uint64_t &inputHash, std::string &generatorVersion,
+                           std::string &errorText) const {
+  // return value indicates success or error, or RTN_NO_RESULTS if the table has no generation row
+  long rtnValue= RTN_NO_RESULTS;
+  inputHash= 0;
+  generatorVersion.clear();
+  try {
+    command.setCommandText(SPNAME_SELECT_GENERATION.c_str(), SA_CmdStoredProc);
+    command.Param(GEN_TABLE_PARAM.c_str()).setAsString()= tableName_.c_str();
+    {
+      Metrics::ScopedTimer latency("sproc." + SPNAME_SELECT_GENERATION, Metrics::TK_LATENCY);
+      command.Execute();
+    }
+    // one row, or no rows if the table was not written completely since it was deleted
+    if (command.isResultSet()) {
+      while (command.FetchNext()) {
+        const std::string hashText= (const char*)command.Field(GEN_INPUTHASH_PARAM.c_str()).asString();
+        char *end= nullptr;
+        inputHash= std::strtoull(hashText.c_str(), &end, 16);
+        generatorVersion= (const char*)command.Field(GEN_VERSION_PARAM.c_str()).asString();
+        // a row that can't be read is no row, so the table is made again
+        rtnValue= (16 == hashText.size() && '\0' == *end) ? RTN_NO_ERROR : RTN_NO_RESULTS;
+        }
+      }
+    }
+  catch (SAException &ex) {
+    errorText= (const char*)ex.ErrText();
+    std::cout << errorText << std::endl;
+    rtnValue= RTN_ERROR;
+    }
+  return rtnValue;
+  }
+
+long TableGeneration::Write(SACommand &command, uint64_t inputHash, std::string &errorText) const {
+  // return value indicates success or error
+  long rtnValue= RTN_ERROR;
+  try {
+    command.setCommandText(SPNAME_INSERT_GENERATION.c_str(), SA_CmdStoredProc);
+    command.Param(GEN_TABLE_PARAM.c_str()).setAsString()= tableName_.c_str();
+    command.Param(GEN_INPUTHASH_PARAM.c_str()).setAsString()= ToHex(inputHash).c_str();
+    command.Param(GEN_VERSION_PARAM.c_str()).setAsString()= GENERATOR_VERSION.c_str();
+    {
+      Metrics::ScopedTimer latency("sproc." + SPNAME_INSERT_GENERATION, Metrics::TK_LATENCY);
+      command.Execute();
+    }
+    rtnValue= RTN_NO_ERROR;
+    }
+  catch (SAException &ex) {
+    errorText= (const char*)ex.ErrText();
+    std::cout << errorText << std::endl;
+    rtnValue= RTN_ERROR;
+    }
+  return rtnValue;
+  }
+
+long TableGeneration::Delete(SACommand &command, std::string &errorText) const {
+  // return value indicates success or error
+  long rtnValue= RTN_ERROR;
+  try {
+    command.setCommandText(SPNAME_DELETE_GENERATION.c_str(), SA_CmdStoredProc);
+    command.Param(GEN_TABLE_PARAM.c_str()).setAsString()= tableName_.c_str();
+    {
+      Metrics::ScopedTimer latency("sproc." + SPNAME_DELETE_GENERATION, Metrics::TK_LATENCY);
+      command.Execute();
+    }
+    rtnValue= RTN_NO_ERROR;
+    }
+  catch (SAException &ex) {
+    errorText= (const char*)ex.ErrText();
+    std::cout << errorText << std::endl;
+    rtnValue= RTN_ERROR;
+    }
+  return rtnValue;
+  }
+
+bool TableGeneration::IsUpToDate(SACommand &command, uint64_t inputHash, std::string &errorText) const {
+  uint64_t dbInputHash= 0;
+  std::string dbGeneratorVersion;
+  return RTN_NO_ERROR == Read(command, dbInputHash, dbGeneratorVersion, errorText) &&
+         inputHash == dbInputHash && GENERATOR_VERSION == dbGeneratorVersion;
+  }
+
+} // namespace gaScsData
@@ -0,0 +1,61 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: TableGeneration.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Generation row of a generated db table (SCS and CLS positions, or events): the input hash
+ *            (AxisPositions::GetInputHash(), EventMap::GetInputHash()) and GENERATOR_VERSION of its last complete write.
+ *            The row is kept in the db, so a run from any OWS or directory can tell the table is up to date.
+ *            It is deleted before the table is deleted for a new write (and by the table delete procedures),
+ *            and written with the last step of the write, so it is only there when the table is complete.
+ *
+ * Libraries used:  string
+ *                  SQLAPI.h
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_TableGeneration_H_
+#define GA_TableGeneration_H_
+
+// standard c/c++ libraries
+#include <cstdint>
+#include <string>
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+
+namespace gaScsData {
+
+class TableGeneration : private boost::noncopyable {
+
+public:
+  // ctors and dtor
+    // tableName is GENERATION_TABLE_SCS or GENERATION_TABLE_EVENTS
+    explicit TableGeneration(const std::string &tableName);
+    ~TableGeneration();
+
+  // public member functions
+    const std::string& GetTableName() const;
+    // The generation row of the table in the db. Assumes a valid connection has been made.
+    // Return value indicates success or error, or RTN_NO_RESULTS if the table has no generation row.
+    long Read(SACommand &command, uint64_t &inputHash, std::string &generatorVersion, std::string &errorText) const;
+    // Replace the generation row of the table with inputHash and GENERATOR_VERSION. It is not committed here, so the
+    // caller writes it in the same transaction as the last step of the write. Return value indicates success or error
+    long Write(SACommand &command, uint64_t inputHash, std::string &errorText) const;
+    // Delete the generation row of the table, before the table is deleted for a new write.
+    // Return value indicates success or error
+    long Delete(SACommand &command, std::string &errorText) const;
+    // true if the table has a generation row of inputHash and this GENERATOR_VERSION. A row that can't be read is
+    // not up to date, so the table is made again.
+    bool IsUpToDate(SACommand &command, uint64_t inputHash, std::string &errorText) const;
+
+  private:
+    // member variables
+      std::string tableName_;
+};
+
+} // namespace gaScsData
+#endif // GA_TableGeneration_H_
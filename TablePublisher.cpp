@@ -0,0 +1,529 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: TablePublisher.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Publishes the generated tables into a memory mapped file (TablePublisher), and reads them
+ *            back in place (PublishedTables).
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  atomic
+ *                  Boost Interprocess (file mapping)
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <algorithm>
+#include <new>
+
+// Boost libraries
+#include <boost/interprocess/exceptions.hpp>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "TablePublisher.hpp"
+#include "Metrics.hpp"
+
+namespace gaScsData {
+
+// true if the header is a published file header of this layout, and the file holds both slots
+static bool isUsableHeader(const PublishedHeader &header, size_t fileBytes) {
+  return fileBytes >= PUBLISH_HEADER_BYTES && 0 == std::memcmp(header.magic, PUBLISH_MAGIC, sizeof(header.magic)) &&
+         PUBLISH_LAYOUT_VERSION == header.layoutVersion && PUBLISH_HEADER_BYTES == header.headerBytes &&
+         fileBytes >= PUBLISH_HEADER_BYTES + 2 * header.slotBytes;
+  }
+
+static bool isFile(const std::string &fileName) {
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  return file.good();
+  }
+
+// "<file>.<n>", or the published file for version 0
+static std::string GetVersionFileName(const std::string &fileName, uint32_t version) {
+  return 0 == version ? fileName : fileName + "." + std::to_string(static_cast<unsigned long long>(version));
+  }
+
+// section records, if the section is inside the mapping and has the expected record size
+template <typename RecordTyp>
+static const RecordTyp* SectionRecords(const boost::interprocess::mapped_region &region, const PublishedSection &section) {
+  if (sizeof(RecordTyp) != section.recordBytes || section.offset > region.get_size() ||
+      section.count > (region.get_size() - section.offset) / sizeof(RecordTyp))
+    return nullptr;
+  return reinterpret_cast<const RecordTyp*>(static_cast<const char*>(region.get_address()) + section.offset);
+  }
+
+// floor of angle / step, for negative angles too
+static long FloorStep(long angle) {
+  return (angle >= 0 ? angle / PUBLISH_INDEX_STEP : -((-angle + PUBLISH_INDEX_STEP - 1) / PUBLISH_INDEX_STEP)) * PUBLISH_INDEX_STEP;
+  }
+
+uint32_t GetScsRowFlags(const AxisPositions::SPosDetail &posDetail) {
+  const AxisPositions::PosAttributes &attributes= posDetail.get<4>();
+  return (posDetail.get<2>()[0] ? SRF_SELECTED : 0) | (attributes.get<1>() ? SRF_ABSOLUTE : 0) |
+         (posDetail.get<3>().get<2>() ? SRF_ADJUST_ABSOLUTE : 0) | (attributes.get<2>() ? SRF_TRANSITION : 0) |
+         (attributes.get<3>() ? SRF_JOGGLE : 0) | (attributes.get<4>() ? SRF_NEW_HQP : 0) |
+         (attributes.get<5>() ? SRF_NEW_LAYER : 0) | (attributes.get<6>() ? SRF_LAST_TURN : 0) |
+         (attributes.get<7>() ? SRF_LAST_LAYER : 0);
+  }
+
+uint32_t GetSelectedMask(const AxisPositions::SPosDetail &posDetail) {
+  // SelectedAxes element 0 is the selected flag, and element n + 1 is axis index n
+  uint32_t mask= 0;
+  for (size_t i= 1; i < posDetail.get<2>().size() && i <= 32; ++i) {
+    if (posDetail.get<2>()[i])
+      mask|= 1UL << (i - 1);
+    }
+  return mask;
+  }
+
+// PublishedTables class
+// ctors and dtor
+PublishedTables::PublishedTables() :
+    header_(nullptr) { }
+
+PublishedTables::~PublishedTables() { }
+
+// public member functions
+long PublishedTables::Open(const std::string &fileName) {
+  // return value indicates success or error
+  std::string currentFile= fileName;
+  for (long follow= 0; follow < PUBLISH_MAX_FOLLOW; ++follow) {
+    if (RTN_NO_ERROR != Map(currentFile))
+      return RTN_ERROR;
+    if (0 == header_->isRetired)
+      return RTN_NO_ERROR;
+    currentFile= GetVersionFileName(fileName, header_->currentVersion);
+    }
+  header_= nullptr;
+  std::cout << "Error opening the published tables " << fileName << ": it was replaced while it was opened." << std::endl;
+  return RTN_ERROR;
+  }
+
+bool PublishedTables::isOpen() const {
+  return nullptr != header_;
+  }
+
+bool PublishedTables::isRetired() const {
+  return nullptr != header_ && 0 != header_->isRetired;
+  }
+
+bool PublishedTables::BeginRead(ViewTyp &view) const {
+  if (nullptr == header_)
+    return false;
+  view.sequence= header_->sequence.load(std::memory_order_acquire);
+  if (0 != (view.sequence & 1) || 0 != header_->isRetired)
+    return false;  // being published, or replaced
+
+  view.generation= header_->generation;
+  view.scs= SectionRecords<ScsRecord>(region_, header_->scs);
+  view.scsCount= static_cast<size_t>(header_->scs.count);
+  view.index= SectionRecords<IndexRecord>(region_, header_->index);
+  view.indexCount= static_cast<size_t>(header_->index.count);
+  view.events= SectionRecords<EventRecord>(region_, header_->events);
+  view.eventCount= static_cast<size_t>(header_->events.count);
+  view.cls= SectionRecords<ClsRecord>(region_, header_->cls);
+  view.clsCount= static_cast<size_t>(header_->cls.count);
+  view.scsInputHash= header_->scsInputHash;
+  view.eventsInputHash= header_->eventsInputHash;
+  if (nullptr == view.scs || nullptr == view.index || nullptr == view.events || nullptr == view.cls)
+    return false;
+  // the header must not have changed while it was copied
+  return isValid(view);
+  }
+
+bool PublishedTables::isValid(const ViewTyp &view) const {
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return nullptr != header_ && header_->sequence.load(std::memory_order_relaxed) == view.sequence;
+  }
+
+const ScsRecord* PublishedTables::FindScsRow(const ViewTyp &view, long riaAngle) {
+  // rows before first are all before riaAngle, so only first to last is searched
+  size_t first= 0;
+  size_t last= view.scsCount;
+  if (0 < view.indexCount && riaAngle >= view.index[0].riaAngle) {
+    const size_t entry= std::min(static_cast<size_t>((riaAngle - view.index[0].riaAngle) / PUBLISH_INDEX_STEP), view.indexCount - 1);
+    first= view.index[entry].scsRow;
+    if (entry + 1 < view.indexCount)
+      last= view.index[entry + 1].scsRow;
+    }
+  const ScsRecord *row= std::upper_bound(view.scs + first, view.scs + last, riaAngle,
+    [](long angle, const ScsRecord &record) { return angle < record.riaAngle; });
+  return view.scs == row ? nullptr : row - 1;
+  }
+
+void PublishedTables::GetScsRows(const ViewTyp &view, AxisPositions::ScsAxesPositionMap &scsRows) {
+  scsRows.clear();
+  for (size_t row= 0; row < view.scsCount; ++row) {
+    const ScsRecord &record= view.scs[row];
+    AxisPositions::SPosDetail posDetail;
+    posDetail.get<0>().assign(record.foot, record.foot + COLUMN_COUNT);
+    posDetail.get<1>().assign(record.column, record.column + COLUMN_COUNT);
+    // SelectedAxes element 0 is the selected flag, and element n + 1 is axis index n
+    AxisPositions::SelectedAxes &selected= posDetail.get<2>();
+    selected.assign((COLUMN_COUNT * 2) + 1, false);
+    selected[0]= 0 != (record.flags & SRF_SELECTED);
+    for (size_t i= 1; i < selected.size() && i <= 32; ++i) {
+      selected[i]= 0 != (record.selectedMask & (1UL << (i - 1)));
+      }
+    posDetail.get<3>()= AxisPositions::SelectedDetail(record.selectedDistance, static_cast<AxisIndexes>(record.selectedAxis),
+                                                      0 != (record.flags & SRF_ADJUST_ABSOLUTE));
+    const char *actionEnd= std::find(record.action, record.action + PUBLISH_ACTION_CHARS, '\0');
+    posDetail.get<4>()= AxisPositions::PosAttributes(std::string(record.action, actionEnd), 0 != (record.flags & SRF_ABSOLUTE),
+                                                     0 != (record.flags & SRF_TRANSITION), 0 != (record.flags & SRF_JOGGLE),
+                                                     0 != (record.flags & SRF_NEW_HQP), 0 != (record.flags & SRF_NEW_LAYER),
+                                                     0 != (record.flags & SRF_LAST_TURN), 0 != (record.flags & SRF_LAST_LAYER),
+                                                     record.coilAngle);
+    posDetail.get<5>()= AxisPositions::HqpLayerAdj(record.hqpAdjust, record.layerAdjust);
+    scsRows.insert(scsRows.end(), std::make_pair(static_cast<long>(record.riaAngle), posDetail));
+    }
+  }
+
+// private helper functions
+long PublishedTables::Map(const std::string &fileName) {
+  // return value indicates success or error
+  header_= nullptr;
+  try {
+    boost::interprocess::file_mapping file(fileName.c_str(), boost::interprocess::read_only);
+    boost::interprocess::mapped_region region(file, boost::interprocess::read_only);
+    file_.swap(file);
+    region_.swap(region);
+    }
+  catch (const boost::interprocess::interprocess_exception &ex) {
+    std::cout << "Error opening the published tables " << fileName << ": " << ex.what() << std::endl;
+    return RTN_ERROR;
+    }
+
+  const PublishedHeader *header= static_cast<const PublishedHeader*>(region_.get_address());
+  if (!isUsableHeader(*header, region_.get_size())) {
+    std::cout << "Error opening the published tables " << fileName << ": not a published table file of layout version "
+              << PUBLISH_LAYOUT_VERSION << "." << std::endl;
+    return RTN_ERROR;
+    }
+  header_= header;
+  return RTN_NO_ERROR;
+  }
+
+// TablePublisher class
+// ctors and dtor
+TablePublisher::TablePublisher() :
+    isScsSet_(false),
+    isEventsSet_(false),
+    scsInputHash_(0),
+    eventsInputHash_(0),
+    generation_(0) { }
+
+TablePublisher::~TablePublisher() { }
+
+// public member functions
+void TablePublisher::SetScsRows(const AxisPositions::ScsAxesPositionMap &scsRows, uint64_t inputHash) {
+  scs_.clear();
+  scs_.reserve(scsRows.size());
+  for (AxisPositions::sapm_const_iter cit= scsRows.begin(); cit != scsRows.end(); ++cit) {
+    const AxisPositions::SPosDetail &posDetail= cit->second;
+    ScsRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.riaAngle= cit->first;
+    record.coilAngle= posDetail.get<4>().get<8>();
+    for (long i= 0; i < COLUMN_COUNT; ++i) {
+      record.foot[i]= static_cast<size_t>(i) < posDetail.get<0>().size() ? posDetail.get<0>()[i] : INITIAL_NO_POSITION;
+      record.column[i]= static_cast<size_t>(i) < posDetail.get<1>().size() ? posDetail.get<1>()[i] : INITIAL_NO_POSITION;
+      }
+    record.selectedDistance= posDetail.get<3>().get<0>();
+    record.selectedAxis= static_cast<int32_t>(posDetail.get<3>().get<1>());
+    record.selectedMask= GetSelectedMask(posDetail);
+    record.flags= GetScsRowFlags(posDetail);
+    record.hqpAdjust= static_cast<int32_t>(posDetail.get<5>().get<0>());
+    record.layerAdjust= static_cast<int32_t>(posDetail.get<5>().get<1>());
+    // move summary, the same as the action description in the table
+    const std::string &trace= posDetail.get<4>().get<0>();
+    const size_t msPos= trace.find(MS_TOKEN);
+    const std::string action= std::string::npos == msPos ? trace : trace.substr(msPos + 1);
+    action.copy(record.action, PUBLISH_ACTION_CHARS - 1);
+    scs_.push_back(record);
+    }
+  scsInputHash_= inputHash;
+  isScsSet_= true;
+  }
+
+void TablePublisher::SetEvents(const EventMap::EventMapTyp &events, uint64_t inputHash) {
+  events_.clear();
+  events_.reserve(events.size());
+  for (EventMap::em_const_iter cit= events.begin(); cit != events.end(); ++cit) {
+    EventRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.angle= cit->first;
+    record.eventId= static_cast<int32_t>(cit->second.get<0>());
+    events_.push_back(record);
+    }
+  eventsInputHash_= inputHash;
+  isEventsSet_= true;
+  }
+
+long TablePublisher::Publish(const std::string &fileName) {
+  // return value indicates success or error
+  Metrics::ScopedTimer timer("publish.tables");
+  const uint64_t generation= KeepCurrent(fileName);
+  BuildIndex();
+  const uint64_t slotBytesNeeded= GetSlotBytesNeeded();
+
+  // use the current file if the tables fit, otherwise make a bigger one
+  std::string currentFile;
+  uint32_t version= 0;
+  uint64_t currentSlotBytes= 0;
+  const bool isUsable= FindCurrentFile(fileName, currentFile, version, currentSlotBytes);
+  std::string replacedFile;  // the current file, if a bigger one is made
+  uint32_t newVersion= version;
+  if (!isUsable || currentSlotBytes < slotBytesNeeded) {
+    const uint64_t slotBytes= std::max<uint64_t>(1, (slotBytesNeeded * PUBLISH_SLOT_HEADROOM + PUBLISH_SLOT_ROUNDING - 1) /
+                                                    PUBLISH_SLOT_ROUNDING) * PUBLISH_SLOT_ROUNDING;
+    if (!isUsable) {
+      // no file of this layout, so no reader is using it. Make the published file.
+      if (RTN_NO_ERROR != CreateMappedFile(fileName, 0, slotBytes, generation))
+        return RTN_ERROR;
+      currentFile= fileName;
+      }
+    else {
+      // the current file is retired once the tables are in the new one
+      newVersion= version + 1;
+      replacedFile= currentFile;
+      currentFile= GetVersionFileName(fileName, newVersion);
+      if (RTN_NO_ERROR != CreateMappedFile(currentFile, newVersion, slotBytes, generation))
+        return RTN_ERROR;
+      }
+    }
+
+  try {
+    boost::interprocess::file_mapping file(currentFile.c_str(), boost::interprocess::read_write);
+    boost::interprocess::mapped_region region(file, boost::interprocess::read_write);
+    char *base= static_cast<char*>(region.get_address());
+    PublishedHeader *header= reinterpret_cast<PublishedHeader*>(base);
+
+    // write the tables into the slot readers are not using
+    const uint32_t slot= header->activeSlot ^ 1;
+    uint64_t offset= PUBLISH_HEADER_BYTES + slot * header->slotBytes;
+    PublishedSection sections[4];
+    const void *data[4]= { scs_.data(), index_.data(), events_.data(), cls_.data() };
+    const size_t counts[4]= { scs_.size(), index_.size(), events_.size(), cls_.size() };
+    const size_t recordBytes[4]= { sizeof(ScsRecord), sizeof(IndexRecord), sizeof(EventRecord), sizeof(ClsRecord) };
+    for (size_t i= 0; i < 4; ++i) {
+      sections[i].offset= offset;
+      sections[i].count= counts[i];
+      sections[i].recordBytes= static_cast<uint32_t>(recordBytes[i]);
+      sections[i].reserved= 0;
+      if (0 < counts[i])
+        std::memcpy(base + offset, data[i], counts[i] * recordBytes[i]);
+      offset+= counts[i] * recordBytes[i];
+      }
+
+    // switch the header to the slot
+    const uint64_t sequence= header->sequence.load(std::memory_order_relaxed);
+    header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    header->generation= generation + 1;
+    header->activeSlot= slot;
+    header->publishTime= static_cast<int64_t>(time(0));
+    header->scs= sections[0];
+    header->index= sections[1];
+    header->events= sections[2];
+    header->cls= sections[3];
+    header->scsInputHash= scsInputHash_;
+    header->eventsInputHash= eventsInputHash_;
+    header->sequence.store(sequence + 2, std::memory_order_release);
+    generation_= header->generation;
+    region.flush();
+    }
+  catch (const boost::interprocess::interprocess_exception &ex) {
+    std::cout << "Error publishing the tables to " << currentFile << ": " << ex.what() << std::endl;
+    return RTN_ERROR;
+    }
+
+  // The replaced file is not removed, so its readers keep the generation before this one until they open the new
+  // file. The published file is opened first, so it is retired to the new file too.
+  if (!replacedFile.empty()) {
+    if (RTN_NO_ERROR != RetireFile(replacedFile, newVersion) ||
+        (replacedFile != fileName && RTN_NO_ERROR != RetireFile(fileName, newVersion)))
+      return RTN_ERROR;
+    // versions before it that are no longer mapped. One that is still mapped (Windows) is removed next time.
+    for (uint32_t replaced= 1; replaced < newVersion; ++replaced) {
+      std::remove(GetVersionFileName(fileName, replaced).c_str());
+      }
+    }
+
+  std::cout << "Published generation " << generation_ << " to " << fileName << ": " << scs_.size() << " SCS rows, "
+            << events_.size() << " events." << std::endl;
+  return RTN_NO_ERROR;
+  }
+
+uint64_t TablePublisher::GetGeneration() const {
+  return generation_;
+  }
+
+// private helper functions
+uint64_t TablePublisher::KeepCurrent(const std::string &fileName) {
+  if (!isFile(fileName))
+    return 0;
+  PublishedTables tables;
+  if (RTN_NO_ERROR != tables.Open(fileName))
+    return 0;  // a new file is made
+
+  // copy, then make sure the generation did not change while copying
+  for (long attempt= 0; attempt < PUBLISH_READ_ATTEMPTS; ++attempt) {
+    PublishedTables::ViewTyp view;
+    if (!tables.BeginRead(view))
+      continue;
+    if (!isScsSet_) {
+      scs_.assign(view.scs, view.scs + view.scsCount);
+      scsInputHash_= view.scsInputHash;
+      }
+    if (!isEventsSet_) {
+      events_.assign(view.events, view.events + view.eventCount);
+      eventsInputHash_= view.eventsInputHash;
+      }
+    cls_.assign(view.cls, view.cls + view.clsCount);
+    if (tables.isValid(view))
+      return view.generation;
+    }
+  std::cout << "The published tables in " << fileName << " are changing. Tables not regenerated are not kept." << std::endl;
+  return 0;
+  }
+
+void TablePublisher::BuildIndex() {
+  index_.clear();
+  if (scs_.empty() && events_.empty())
+    return;
+  long first= scs_.empty() ? static_cast<long>(std::floor(events_.front().angle)) : static_cast<long>(scs_.front().riaAngle);
+  long last= scs_.empty() ? static_cast<long>(std::floor(events_.back().angle)) : static_cast<long>(scs_.back().riaAngle);
+  if (!events_.empty()) {
+    first= std::min(first, static_cast<long>(std::floor(events_.front().angle)));
+    last= std::max(last, static_cast<long>(std::floor(events_.back().angle)));
+    }
+
+  std::vector<ScsRecord>::const_iterator scsIt= scs_.begin();
+  std::vector<EventRecord>::const_iterator eventIt= events_.begin();
+  for (long angle= FloorStep(first); angle <= last; angle+= PUBLISH_INDEX_STEP) {
+    while (scs_.end() != scsIt && scsIt->riaAngle < angle)
+      ++scsIt;
+    while (events_.end() != eventIt && eventIt->angle < angle)
+      ++eventIt;
+    IndexRecord record;
+    record.riaAngle= angle;
+    record.scsRow= static_cast<uint32_t>(scsIt - scs_.begin());
+    record.eventRow= static_cast<uint32_t>(eventIt - events_.begin());
+    index_.push_back(record);
+    }
+  }
+
+bool TablePublisher::FindCurrentFile(const std::string &fileName, std::string &currentFile, uint32_t &version, uint64_t &slotBytes) {
+  // follow the retired files to the file that replaced them
+  currentFile= fileName;
+  for (long follow= 0; follow < PUBLISH_MAX_FOLLOW && isFile(currentFile); ++follow) {
+    try {
+      boost::interprocess::file_mapping file(currentFile.c_str(), boost::interprocess::read_only);
+      boost::interprocess::mapped_region region(file, boost::interprocess::read_only);
+      const PublishedHeader *header= static_cast<const PublishedHeader*>(region.get_address());
+      if (!isUsableHeader(*header, region.get_size()))
+        return false;
+      if (0 == header->isRetired) {
+        version= header->fileVersion;
+        slotBytes= header->slotBytes;
+        return true;
+        }
+      currentFile= GetVersionFileName(fileName, header->currentVersion);
+      }
+    catch (const boost::interprocess::interprocess_exception&) {
+      return false;  // not usable, replace it
+      }
+    }
+  return false;
+  }
+
+long TablePublisher::CreateMappedFile(const std::string &fileName, uint32_t version, uint64_t slotBytes, uint64_t generation) {
+  // return value indicates success or error
+  const std::string newFileName= fileName + ".new";
+  try {
+    {
+      std::ofstream file(newFileName.c_str(), std::ios::binary | std::ios::trunc);
+      file.seekp(static_cast<std::streamoff>(PUBLISH_HEADER_BYTES + 2 * slotBytes - 1));
+      file.put('\0');
+      if (!file) {
+        std::cout << "Error creating the published table file " << newFileName << "." << std::endl;
+        return RTN_ERROR;
+        }
+    }
+    boost::interprocess::file_mapping file(newFileName.c_str(), boost::interprocess::read_write);
+    boost::interprocess::mapped_region region(file, boost::interprocess::read_write, 0, PUBLISH_HEADER_BYTES);
+    PublishedHeader *header= new (region.get_address()) PublishedHeader();
+    std::memcpy(header->magic, PUBLISH_MAGIC, sizeof(header->magic));
+    header->layoutVersion= PUBLISH_LAYOUT_VERSION;
+    header->headerBytes= PUBLISH_HEADER_BYTES;
+    header->sequence.store(0);
+    header->generation= generation;
+    header->slotBytes= slotBytes;
+    header->activeSlot= 1;  // the first publish uses slot 0
+    header->isRetired= 0;
+    header->fileVersion= version;
+    header->currentVersion= version;
+    header->publishTime= 0;
+    header->scsInputHash= 0;
+    header->eventsInputHash= 0;
+    header->scs= header->index= header->events= header->cls= PublishedSection();
+    region.flush();
+    }
+  catch (const boost::interprocess::interprocess_exception &ex) {
+    std::cout << "Error creating the published table file " << newFileName << ": " << ex.what() << std::endl;
+    return RTN_ERROR;
+    }
+
+  // a file that is still mapped can't be removed on Windows. Only a file no reader can use is replaced here.
+  if (isFile(fileName) && 0 != std::remove(fileName.c_str())) {
+    std::cout << "Error replacing the published table file " << fileName << ". Close the programs reading it." << std::endl;
+    return RTN_ERROR;
+    }
+  if (0 != std::rename(newFileName.c_str(), fileName.c_str())) {
+    std::cout << "Error renaming " << newFileName << " to " << fileName << "." << std::endl;
+    return RTN_ERROR;
+    }
+  return RTN_NO_ERROR;
+  }
+
+long TablePublisher::RetireFile(const std::string &fileName, uint32_t currentVersion) {
+  // return value indicates success or error
+  try {
+    boost::interprocess::file_mapping file(fileName.c_str(), boost::interprocess::read_write);
+    boost::interprocess::mapped_region region(file, boost::interprocess::read_write);
+    PublishedHeader *header= static_cast<PublishedHeader*>(region.get_address());
+    if (!isUsableHeader(*header, region.get_size())) {
+      std::cout << "Error retiring the published table file " << fileName << ": not a published table file." << std::endl;
+      return RTN_ERROR;
+      }
+    // tell its readers to open the file again
+    const uint64_t sequence= header->sequence.load(std::memory_order_relaxed);
+    header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    header->isRetired= 1;
+    header->currentVersion= currentVersion;
+    header->sequence.store(sequence + 2, std::memory_order_release);
+    region.flush();
+    }
+  catch (const boost::interprocess::interprocess_exception &ex) {
+    std::cout << "Error retiring the published table file " << fileName << ": " << ex.what() << std::endl;
+    return RTN_ERROR;
+    }
+  return RTN_NO_ERROR;
+  }
+
+uint64_t TablePublisher::GetSlotBytesNeeded() const {
+  return scs_.size() * sizeof(ScsRecord) + index_.size() * sizeof(IndexRecord) +
+         events_.size() * sizeof(EventRecord) + cls_.size() * sizeof(ClsRecord);
+  }
+
+} // namespace gaScsData
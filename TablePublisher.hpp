@@ -0,0 +1,247 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: TablePublisher.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Publishes the generated SCS rows and event list into a memory mapped file, so other processes on
+ *            the OWS (HMI, gateway, analysis scripts) can read the tables in place instead of querying the db.
+ *
+ *            File layout (all values little endian, fixed size records, 8 byte aligned):
+ *              PublishedHeader                         -- at offset 0, PUBLISH_HEADER_BYTES long
+ *              slot 0, slot 1                          -- each header.slotBytes long
+ *            Each slot holds the sections of one generation, at the offsets in the header:
+ *              ScsRecord   x scs.count                 -- by RIA angle
+ *              IndexRecord x index.count               -- one per PUBLISH_INDEX_STEP of RIA angle
+ *              EventRecord x events.count              -- by angle
+ *              ClsRecord   x cls.count
+ *            A new generation is written into the slot that is not active, then the header is switched
+ *            to it under a seqlock: sequence is odd while the header changes, and even when it is stable.
+ *            Readers (PublishedTables class) read sequence, use the active slot, then check sequence did
+ *            not change. If it did, the data may have been overwritten, so they read again.
+ *            Only one process publishes at a time (this program).
+ *
+ *            Sections that were not set for a publish (-e only, for example) are copied from the
+ *            current generation, so the file always has the latest of each table.
+ *            The header has the input hash of the SCS rows and of the events (AxisPositions::GetInputHash(),
+ *            EventMap::GetInputHash()), so a reader can tell they are the tables in the db (TableGeneration class).
+ *            If the tables outgrow the slots, a bigger file is made next to it, "<file>.<n>" (n = 1, 2, ...).
+ *            Once it is complete, the old file, and the published file (which readers open first), are marked
+ *            retired under the seqlock, with the version n of the new file. Readers open the file again, and
+ *            follow it to the new one. A retired file is not removed while readers may have it mapped (it can't
+ *            be on Windows); the replaced versions are removed by a later replacement, if they are not in use.
+ *
+ *            NOTE: CLS positions are calculated by a db procedure from the SCS table, so the CLS
+ *            section is in the layout but is empty. The CLS move source (the selected axis distance,
+ *            axis, and adjust flag) is in each ScsRecord.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  atomic
+ *                  Boost Interprocess (file mapping)
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_TablePublisher_H_
+#define GA_TablePublisher_H_
+
+// standard c/c++ libraries
+#include <cstdint>
+#include <atomic>
+
+// Boost libraries
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+#include "AxisPositions.hpp"
+#include "EventMap.hpp"
+
+namespace gaScsData {
+
+// fixed layout records
+  // one SCS row
+  struct ScsRecord {
+    int64_t riaAngle;
+    double coilAngle;
+    double foot[COLUMN_COUNT];    // foot A inner to F outer. INITIAL_NO_POSITION if not used by the row.
+    double column[COLUMN_COUNT];  // column A inner to F outer
+    double selectedDistance;      // selected axes rows: position or distance
+    int32_t selectedAxis;         // selected axes rows: axis index
+    uint32_t selectedMask;        // selected axes rows: bit n is axis index n
+    uint32_t flags;               // SRF_ flags
+    int32_t hqpAdjust;
+    int32_t layerAdjust;
+    uint32_t reserved;
+    char action[PUBLISH_ACTION_CHARS];  // move summary, null terminated (cut off if too long)
+  };
+  // ScsRecord flags
+  enum ScsRecordFlags {
+    SRF_SELECTED= 0x001,
+    SRF_ABSOLUTE= 0x002,
+    SRF_ADJUST_ABSOLUTE= 0x004,
+    SRF_TRANSITION= 0x008,
+    SRF_JOGGLE= 0x010,
+    SRF_NEW_HQP= 0x020,
+    SRF_NEW_LAYER= 0x040,
+    SRF_LAST_TURN= 0x080,
+    SRF_LAST_LAYER= 0x100
+  };
+  // ScsRecordFlags of an SCS row. Also used by the PLC download (PlcDownload class).
+  uint32_t GetScsRowFlags(const AxisPositions::SPosDetail &posDetail);
+  // selected axes of an SCS row, bit n is axis index n
+  uint32_t GetSelectedMask(const AxisPositions::SPosDetail &posDetail);
+
+  // first SCS row and first event at or after riaAngle
+  struct IndexRecord {
+    int64_t riaAngle;
+    uint32_t scsRow;
+    uint32_t eventRow;
+  };
+
+  struct EventRecord {
+    double angle;
+    int32_t eventId;
+    uint32_t reserved;
+  };
+
+  // CLS row. See the NOTE above.
+  struct ClsRecord {
+    int64_t riaAngle;
+    double coilAngle;
+    double position[COLUMN_COUNT];
+    uint32_t flags;
+    uint32_t reserved;
+  };
+
+  struct PublishedSection {
+    uint64_t offset;  // from the start of the file
+    uint64_t count;
+    uint32_t recordBytes;
+    uint32_t reserved;
+  };
+
+  struct PublishedHeader {
+    char magic[8];  // PUBLISH_MAGIC
+    uint32_t layoutVersion;  // PUBLISH_LAYOUT_VERSION
+    uint32_t headerBytes;
+    std::atomic<uint64_t> sequence;  // seqlock. Odd while the header is changing.
+    uint64_t generation;  // 1 for the first publish
+    uint64_t slotBytes;
+    uint32_t activeSlot;
+    uint32_t isRetired;  // 1 if a bigger file replaced this one
+    uint32_t fileVersion;  // 0 for the published file, n for "<file>.<n>"
+    uint32_t currentVersion;  // version of the file with the tables. Not this one if it is retired.
+    int64_t publishTime;  // time_t
+    uint64_t scsInputHash;  // input hash of the SCS rows, 0 if not known
+    uint64_t eventsInputHash;  // input hash of the events, 0 if not known
+    PublishedSection scs;
+    PublishedSection index;
+    PublishedSection events;
+    PublishedSection cls;
+  };
+
+  static_assert(0 == sizeof(ScsRecord) % 8 && 0 == sizeof(IndexRecord) % 8 && 0 == sizeof(EventRecord) % 8 &&
+                0 == sizeof(ClsRecord) % 8, "published records must be 8 byte aligned");
+  static_assert(sizeof(PublishedHeader) <= PUBLISH_HEADER_BYTES, "published header is too big");
+
+// Reads a published file. Not thread safe, use one per thread.
+class PublishedTables : private boost::noncopyable {
+
+public:
+  // typedefs and enums
+    // one consistent generation. The pointers are into the mapping, so are only valid while isValid().
+    struct ViewTyp {
+      uint64_t sequence;
+      uint64_t generation;
+      const ScsRecord *scs;
+      size_t scsCount;
+      const IndexRecord *index;
+      size_t indexCount;
+      const EventRecord *events;
+      size_t eventCount;
+      const ClsRecord *cls;
+      size_t clsCount;
+      uint64_t scsInputHash;
+      uint64_t eventsInputHash;
+      };
+
+  // ctors and dtor
+    PublishedTables();
+    ~PublishedTables();
+
+  // public member functions
+    // Map the published file, or the file that replaced it. Return value indicates success or error
+    long Open(const std::string &fileName);
+    bool isOpen() const;
+    // true if a bigger file replaced the mapped one. Open() it again.
+    bool isRetired() const;
+    // Get the current generation. Return value is false if not open, or a publish is in progress (try again).
+    bool BeginRead(ViewTyp &view) const;
+    // true if the generation read with BeginRead() was not changed while it was used
+    bool isValid(const ViewTyp &view) const;
+    // SCS row at or before the RIA angle, using the index. nullptr if before the first row.
+    static const ScsRecord* FindScsRow(const ViewTyp &view, long riaAngle);
+    // The SCS rows of the view as AxisPositions rows (TablePublisher::SetScsRows() in reverse).
+    // The logic trace of a row is its move summary.
+    static void GetScsRows(const ViewTyp &view, AxisPositions::ScsAxesPositionMap &scsRows);
+
+  private:
+    // helper functions
+      // map the file, if it has a header of this layout. Return value indicates success or error
+      long Map(const std::string &fileName);
+
+    // member variables
+      boost::interprocess::file_mapping file_;
+      boost::interprocess::mapped_region region_;
+      const PublishedHeader *header_;  // nullptr if not open
+};
+
+// Writes a published file.
+class TablePublisher : private boost::noncopyable {
+
+public:
+  // ctors and dtor
+    TablePublisher();
+    ~TablePublisher();
+
+  // public member functions
+    // set the tables to publish, and the input hash they were made from. Tables not set are kept from the current generation.
+    void SetScsRows(const AxisPositions::ScsAxesPositionMap &scsRows, uint64_t inputHash);
+    void SetEvents(const EventMap::EventMapTyp &events, uint64_t inputHash);
+    // Write a new generation. Return value indicates success or error
+    long Publish(const std::string &fileName);
+    // generation written by the last Publish(), 0 if none
+    uint64_t GetGeneration() const;
+
+  private:
+    // helper functions
+      // the sections that were not set, from the current generation. Return value is the current generation, or 0.
+      uint64_t KeepCurrent(const std::string &fileName);
+      void BuildIndex();
+      // The file with the current tables: the published file, or the file that replaced it.
+      // Return value is false if there is no file of this layout.
+      static bool FindCurrentFile(const std::string &fileName, std::string &currentFile, uint32_t &version, uint64_t &slotBytes);
+      // create the file with room for the tables. Return value indicates success or error
+      long CreateMappedFile(const std::string &fileName, uint32_t version, uint64_t slotBytes, uint64_t generation);
+      // mark the file retired, replaced by the file version. Return value indicates success or error
+      static long RetireFile(const std::string &fileName, uint32_t currentVersion);
+      uint64_t GetSlotBytesNeeded() const;
+
+    // member variables
+      std::vector<ScsRecord> scs_;
+      std::vector<IndexRecord> index_;
+      std::vector<EventRecord> events_;
+      std::vector<ClsRecord> cls_;
+      bool isScsSet_;
+      bool isEventsSet_;
+      uint64_t scsInputHash_;
+      uint64_t eventsInputHash_;
+      uint64_t generation_;
+};
+
+} // namespace gaScsData
+#endif // GA_TablePublisher_H_
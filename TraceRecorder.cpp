@@ -0,0 +1,193 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: TraceRecorder.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Optional timeline of a generation run, exported in the
+ *            Chrome trace event JSON format.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  mutex
+ *                  atomic
+ *                  thread
+ *                  chrono
+ *                  Boost Non-copyable
+ *                  Boost Flat Map Container
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <sstream>
+#include <fstream>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "TraceRecorder.hpp"
+
+namespace gaScsData {
+
+// ScopedSpan
+TraceRecorder::ScopedSpan::ScopedSpan(const std::string &name, const std::string &category) :
+    isEnabled_(TraceRecorder::Instance().IsEnabled()) {
+  // only keep the names if they will be used
+  if (isEnabled_) {
+    name_= name;
+    category_= category;
+    start_= clock::now();
+    }
+  }
+
+TraceRecorder::ScopedSpan::~ScopedSpan() {
+  if (isEnabled_)
+    TraceRecorder::Instance().AddSpan(name_, category_, start_, clock::now());
+  }
+
+// SpanSequence
+TraceRecorder::SpanSequence::SpanSequence(const std::string &category) :
+    category_(category),
+    isOpen_(false) { }
+
+TraceRecorder::SpanSequence::~SpanSequence() {
+  Close();
+  }
+
+void TraceRecorder::SpanSequence::Next(const std::string &name) {
+  const clock::time_point now= clock::now();
+  if (isOpen_)
+    TraceRecorder::Instance().AddSpan(name_, category_, start_, now);
+  name_= name;
+  start_= now;
+  isOpen_= true;
+  }
+
+void TraceRecorder::SpanSequence::Close() {
+  if (isOpen_)
+    TraceRecorder::Instance().AddSpan(name_, category_, start_, clock::now());
+  isOpen_= false;
+  }
+
+// ctors and dtor
+TraceRecorder::TraceRecorder() :
+    isEnabled_(false),
+    start_(clock::now()) { }
+
+TraceRecorder::~TraceRecorder() { }
+
+TraceRecorder& TraceRecorder::Instance() {
+  // constructed on first use. Static local initialization is thread safe.
+  static TraceRecorder recorder;
+  return recorder;
+  }
+
+// accessors
+void TraceRecorder::SetEnabled(bool isEnabled) { isEnabled_.store(isEnabled); }
+bool TraceRecorder::IsEnabled() const { return isEnabled_.load(std::memory_order_relaxed); }
+
+size_t TraceRecorder::GetSpanCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return spans_.size();
+  }
+
+void TraceRecorder::SetThreadName(const std::string &name) {
+  if (!IsEnabled())
+    return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  threadNames_[GetThreadIndex() - 1]= name;
+  }
+
+// public member functions
+void TraceRecorder::AddSpan(const std::string &name, const std::string &category, clock::time_point start, clock::time_point end) {
+  if (!IsEnabled())
+    return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  SpanTyp span;
+  span.name= name;
+  span.category= category;
+  span.startUs= std::chrono::duration<double, std::micro>(start - start_).count();
+  span.durationUs= std::chrono::duration<double, std::micro>(end - start).count();
+  span.threadIndex= GetThreadIndex();
+  spans_.push_back(span);
+  }
+
+void TraceRecorder::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  spans_.clear();
+  start_= clock::now();
+  }
+
+std::string TraceRecorder::ToJson() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ostringstream json;
+  json.precision(3);
+  json << std::fixed;
+  json << "{" << std::endl << "\"displayTimeUnit\": \"ms\"," << std::endl << "\"traceEvents\": [" << std::endl;
+  // metadata -- process and thread names
+  json << "{ \"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0, \"args\": { \"name\": \"ScsProductionData\" } }";
+  for (size_t i= 0; i < threadNames_.size(); ++i) {
+    std::string threadName= threadNames_[i].empty() ? "thread " + std::to_string(static_cast<long long>(i + 1)) : threadNames_[i];
+    json << "," << std::endl << "{ \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << i + 1
+         << ", \"args\": { \"name\": \"" << JsonEscape(threadName) << "\" } }";
+    }
+  // spans
+  for (std::vector<SpanTyp>::const_iterator cit= spans_.begin(); cit != spans_.end(); ++cit) {
+    json << "," << std::endl << "{ \"name\": \"" << JsonEscape(cit->name) << "\", \"cat\": \"" << JsonEscape(cit->category)
+         << "\", \"ph\": \"X\", \"ts\": " << cit->startUs << ", \"dur\": " << cit->durationUs
+         << ", \"pid\": 1, \"tid\": " << cit->threadIndex << " }";
+    }
+  json << std::endl << "]" << std::endl << "}" << std::endl;
+  return json.str();
+  }
+
+long TraceRecorder::WriteJson(const std::string &fileName) const {
+  // return value indicates success or error
+  std::ofstream output(fileName.c_str());
+  output << ToJson();
+  output.close();
+  if (!output) {
+    std::cout << "Error writing the trace to " << fileName << std::endl;
+    return RTN_ERROR;
+    }
+  return RTN_NO_ERROR;
+  }
+
+// private helper functions
+size_t TraceRecorder::GetThreadIndex() {
+  // call with the lock held
+  const std::thread::id id= std::this_thread::get_id();
+  thread_map::const_iterator cit= threadIndexes_.find(id);
+  if (cit != threadIndexes_.end())
+    return cit->second;
+  threadNames_.push_back("");
+  const size_t index= threadNames_.size();
+  threadIndexes_.insert(thread_map::value_type(id, index));
+  return index;
+  }
+
+std::string TraceRecorder::JsonEscape(const std::string &text) {
+  std::string escaped;
+  escaped.reserve(text.size());
+  for (size_t i= 0; i < text.size(); ++i) {
+    const char c= text[i];
+    if ('"' == c || '\\' == c) {
+      escaped+= '\\';
+      escaped+= c;
+      }
+    else if ('\n' == c) {
+      escaped+= "\\n";  // logic traces are multi line
+      }
+    else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped+= ' ';  // other control characters are not expected
+      }
+    else {
+      escaped+= c;
+      }
+    }
+  return escaped;
+  }
+
+} // namespace gaScsData
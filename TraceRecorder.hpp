@@ -0,0 +1,131 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: TraceRecorder.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Optional timeline of a generation run, exported in the Chrome trace event
+ *            JSON format (open in chrome://tracing or ui.perfetto.dev).
+ *            Each span is a complete ("X") event with a start, duration, and thread, so worker overlap,
+ *            stalls, and db latency spikes can be seen on a timeline instead of only in totals.
+ *
+ *            Spans come from:
+ *              Metrics::ScopedTimer -- every phase and every sproc call (db write) timed for the metrics
+ *                                      report is also a span when tracing is enabled.
+ *              ScopedSpan -- a span around a block.
+ *              SpanSequence -- back to back spans, like one per layer in a calculation loop.
+ *
+ *            Off by default. When off, recording is one atomic flag check.
+ *            When on, recording takes a lock, so spans belong around phases, layers, and db calls,
+ *            not around every iteration of a calculation loop.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  mutex
+ *                  atomic
+ *                  thread
+ *                  chrono
+ *                  Boost Non-copyable
+ *                  Boost Flat Map Container
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_TraceRecorder_H_
+#define GA_TraceRecorder_H_
+
+// standard c/c++ libraries
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+
+namespace gaScsData {
+
+class TraceRecorder : private boost::noncopyable {
+
+public:
+  // typedefs and enums
+    typedef std::chrono::steady_clock clock;
+
+    // Span from construction to destruction
+    class ScopedSpan : private boost::noncopyable {
+      public:
+        ScopedSpan(const std::string &name, const std::string &category);
+        ~ScopedSpan();
+      private:
+        std::string name_;
+        std::string category_;
+        clock::time_point start_;
+        bool isEnabled_;  // tracing was enabled at construction
+      };
+
+    // Back to back spans in one category. Next() ends the current span (if any) and starts another.
+    // The last span ends at Close() or destruction.
+    class SpanSequence : private boost::noncopyable {
+      public:
+        explicit SpanSequence(const std::string &category);
+        ~SpanSequence();
+        void Next(const std::string &name);
+        void Close();
+      private:
+        std::string category_;
+        std::string name_;
+        clock::time_point start_;
+        bool isOpen_;
+      };
+
+  // ctors and dtor
+    // the one recorder
+    static TraceRecorder& Instance();
+    ~TraceRecorder();
+
+  // accessors
+    void SetEnabled(bool isEnabled);
+    bool IsEnabled() const;
+    size_t GetSpanCount() const;
+    // name the calling thread on the timeline
+    void SetThreadName(const std::string &name);
+
+  // public member functions
+    // record a span. Ignored when tracing is not enabled.
+    void AddSpan(const std::string &name, const std::string &category, clock::time_point start, clock::time_point end);
+    // clear the spans and restart the trace clock
+    void Reset();
+    // the spans as a Chrome trace JSON document
+    std::string ToJson() const;
+    // write ToJson() to the file. return value indicates success or error
+    long WriteJson(const std::string &fileName) const;
+    // escape a string for a JSON string value
+    static std::string JsonEscape(const std::string &text);
+
+  private:
+    TraceRecorder();
+
+    struct SpanTyp {
+      std::string name;
+      std::string category;
+      double startUs;     // from the trace start
+      double durationUs;
+      size_t threadIndex;
+      };
+    typedef boost::container::flat_map<std::thread::id, size_t> thread_map;
+
+    // helper functions
+      // small number for the calling thread, 1 for the first thread seen. Call with the lock held.
+      size_t GetThreadIndex();
+
+    // member variables
+      std::atomic<bool> isEnabled_;
+      mutable std::mutex mutex_;  // guards everything below
+      std::vector<SpanTyp> spans_;
+      thread_map threadIndexes_;
+      std::vector<std::string> threadNames_;  // by thread index - 1
+      clock::time_point start_;  // created or reset
+};
+
+} // namespace gaScsData
+#endif // GA_TraceRecorder_H_
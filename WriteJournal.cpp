@@ -0,0 +1,596 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: WriteJournal.cpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Journal file of the rows of a table write, its ranges, and the batch watermark protocol with the db.
+ *            The ranges are written at once, each on its own connection and thread.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  chrono
+ *                  thread
+ *                  mutex
+ *                  SQLAPI.h
+ *******************************************************************/
+
+// Precompiled header
+#include "pch.hpp"
+
+// standard c/c++ libraries
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <system_error>
+
+// header file
+#include "gaScsDataConstants.hpp"
+#include "WriteJournal.hpp"
+#include "Checksum.hpp"
+#include "Metrics.hpp"
+#include "ProgressReporter.hpp"
+#include "TraceRecorder.hpp"
+
+namespace gaScsData {
+
+static const size_t HEADER_BYTES= 56;
+static const size_t WATERMARK_BYTES= 16;
+
+static void PutU64(std::string &out, uint64_t value) {
+  char bytes[sizeof(value)];
+  std::memcpy(bytes, &value, sizeof(value));
+  out.append(bytes, sizeof(value));
+  }
+
+static void PutU32(std::string &out, uint32_t value) {
+  char bytes[sizeof(value)];
+  std::memcpy(bytes, &value, sizeof(value));
+  out.append(bytes, sizeof(value));
+  }
+
+static uint64_t GetU64(const char *in) {
+  uint64_t value;
+  std::memcpy(&value, in, sizeof(value));
+  return value;
+  }
+
+static uint32_t GetU32(const char *in) {
+  uint32_t value;
+  std::memcpy(&value, in, sizeof(value));
+  return value;
+  }
+
+// record reader
+WriteJournal::RecordReader::RecordReader(const std::string &record) :
+    record_(record),
+    pos_(0),
+    isOk_(true) { }
+
+double WriteJournal::RecordReader::GetDouble() {
+  double value= 0.0;
+  Read(&value, sizeof(value));
+  return value;
+  }
+
+long WriteJournal::RecordReader::GetLong() {
+  int64_t value= 0;
+  Read(&value, sizeof(value));
+  return static_cast<long>(value);
+  }
+
+bool WriteJournal::RecordReader::GetBool() {
+  char value= 0;
+  Read(&value, sizeof(value));
+  return 0 != value;
+  }
+
+std::string WriteJournal::RecordReader::GetString() {
+  uint32_t size= 0;
+  if (!Read(&size, sizeof(size)) || size > record_.size() - pos_) {
+    isOk_= false;
+    return std::string();
+    }
+  std::string value(record_, pos_, size);
+  pos_+= size;
+  return value;
+  }
+
+bool WriteJournal::RecordReader::IsOk() const {
+  return isOk_;
+  }
+
+bool WriteJournal::RecordReader::Read(void *data, size_t size) {
+  if (!isOk_ || size > record_.size() - pos_) {
+    isOk_= false;
+    return false;
+    }
+  std::memcpy(data, record_.data() + pos_, size);
+  pos_+= size;
+  return true;
+  }
+
+// ctors and dtor
+WriteJournal::WriteJournal(const std::string &tableName) :
+    tableName_(tableName),
+    fileName_(WRITE_JOURNAL_PREFIX + "." + tableName + ".jnl"),
+    inputHash_(0),
+    journalId_(0),
+    batchRows_(WRITE_JOURNAL_BATCH_ROWS) { }
+
+WriteJournal::~WriteJournal() { }
+
+// accessors
+const std::string& WriteJournal::GetFileName() const {
+  return fileName_;
+  }
+
+uint64_t WriteJournal::GetInputHash() const {
+  return inputHash_;
+  }
+
+std::string WriteJournal::GetJournalId() const {
+  static const char digits[]= "0123456789abcdef";
+  std::string hex(16, '0');
+  uint64_t value= journalId_;
+  for (size_t i= 0; i < hex.size(); ++i) {
+    hex[hex.size() - 1 - i]= digits[value & 0xf];
+    value>>= 4;
+    }
+  return hex;
+  }
+
+size_t WriteJournal::GetRowCount() const {
+  return rows_.size();
+  }
+
+size_t WriteJournal::GetBatchCount() const {
+  return isCommitted_.size();
+  }
+
+size_t WriteJournal::GetRangeCount() const {
+  return rangeFirstRows_.size();
+  }
+
+size_t WriteJournal::GetCommittedCount() const {
+  return static_cast<size_t>(std::count(isCommitted_.begin(), isCommitted_.end(), 1));
+  }
+
+bool WriteJournal::IsComplete() const {
+  return GetCommittedCount() == GetBatchCount();
+  }
+
+const std::string& WriteJournal::GetRow(size_t index) const {
+  return rows_.at(index);
+  }
+
+const WriteJournal::range_list& WriteJournal::GetRanges() const {
+  return ranges_;
+  }
+
+// public member functions
+void WriteJournal::PutDouble(std::string &record, double value) {
+  record.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+void WriteJournal::PutLong(std::string &record, long value) {
+  const int64_t wide= value;
+  record.append(reinterpret_cast<const char*>(&wide), sizeof(wide));
+  }
+
+void WriteJournal::PutBool(std::string &record, bool value) {
+  record.push_back(value ? 1 : 0);
+  }
+
+void WriteJournal::PutString(std::string &record, const std::string &value) {
+  PutU32(record, static_cast<uint32_t>(value.size()));
+  record.append(value);
+  }
+
+void WriteJournal::Clear() {
+  rows_.clear();
+  isRangeStart_.clear();
+  rangeFirstRows_.clear();
+  batchFirstRows_.clear();
+  ranges_.clear();
+  isCommitted_.clear();
+  inputHash_= 0;
+  journalId_= 0;
+  }
+
+void WriteJournal::AddRow(const std::string &record, bool isRangeStart) {
+  rows_.push_back(record);
+  isRangeStart_.push_back(isRangeStart ? 1 : 0);
+  }
+
+long WriteJournal::Create(uint64_t inputHash, size_t batchRows, size_t rangeCount) {
+  // return value indicates success or error
+  inputHash_= inputHash;
+  batchRows_= 0 == batchRows ? 1 : batchRows;
+  // a range starts at the first range start row at or after its share of the rows
+  rangeFirstRows_.assign(1, 0);
+  for (size_t range= 1; range < rangeCount; ++range) {
+    size_t row= std::max(rows_.size() * range / rangeCount, rangeFirstRows_.back() + 1);
+    while (row < rows_.size() && 0 == isRangeStart_[row])
+      ++row;
+    if (row >= rows_.size())
+      break;
+    rangeFirstRows_.push_back(row);
+    }
+  isRangeStart_.clear();
+  MakeBatches();
+  // a new id for each journal, so the batch keys of an earlier write of the same inputs are not taken as this one's
+  Checksum checksum;
+  checksum.Add(tableName_);
+  checksum.Add(&inputHash_, sizeof(inputHash_));
+  checksum.Add(static_cast<long>(rows_.size()));
+  const long long now= static_cast<long long>(std::chrono::system_clock::now().time_since_epoch().count());
+  checksum.Add(&now, sizeof(now));
+  journalId_= checksum.GetValue();
+
+  std::string rows;
+  for (std::vector<std::string>::const_iterator cit= rows_.begin(); cit != rows_.end(); ++cit) {
+    PutU32(rows, static_cast<uint32_t>(cit->size()));
+    rows.append(*cit);
+    }
+  std::string header(WRITE_JOURNAL_MAGIC, sizeof(WRITE_JOURNAL_MAGIC));
+  PutU32(header, WRITE_JOURNAL_LAYOUT_VERSION);
+  PutU32(header, static_cast<uint32_t>(batchRows_));
+  PutU64(header, inputHash_);
+  PutU64(header, journalId_);
+  PutU64(header, rows_.size());
+  PutU64(header, rows.size());
+  PutU64(header, rangeFirstRows_.size());
+  for (std::vector<size_t>::const_iterator cit= rangeFirstRows_.begin(); cit != rangeFirstRows_.end(); ++cit)
+    PutU64(header, *cit);
+
+  std::ofstream file(fileName_.c_str(), std::ios::binary | std::ios::trunc);
+  file.write(header.data(), header.size());
+  file.write(rows.data(), rows.size());
+  file.flush();
+  if (!file) {
+    std::cout << "Error writing the write journal " << fileName_ << "." << std::endl;
+    return RTN_ERROR;
+    }
+  return RTN_NO_ERROR;
+  }
+
+long WriteJournal::Open() {
+  // return value is RTN_NO_RESULTS if there is no journal, and RTN_ERROR if it can't be read
+  std::ifstream file(fileName_.c_str(), std::ios::binary);
+  if (!file)
+    return RTN_NO_RESULTS;
+  const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  bool isOk= data.size() >= HEADER_BYTES &&
+             0 == std::memcmp(data.data(), WRITE_JOURNAL_MAGIC, sizeof(WRITE_JOURNAL_MAGIC)) &&
+             WRITE_JOURNAL_LAYOUT_VERSION == GetU32(data.data() + 8) && 0 != GetU32(data.data() + 12);
+  const uint64_t rowCount= isOk ? GetU64(data.data() + 32) : 0;
+  const uint64_t rowsBytes= isOk ? GetU64(data.data() + 40) : 0;
+  const uint64_t rangeCount= isOk ? GetU64(data.data() + 48) : 0;
+  // the ranges and rows must be in the file, so a bad count can't make a huge allocation
+  isOk= isOk && 0 < rangeCount && rangeCount <= (data.size() - HEADER_BYTES) / sizeof(uint64_t);
+  const size_t rowsStart= HEADER_BYTES + static_cast<size_t>(rangeCount) * sizeof(uint64_t);
+  isOk= isOk && rowsBytes <= data.size() - rowsStart && rowCount <= rowsBytes / sizeof(uint32_t);
+
+  // ranges start at row 0, and are ascending and not empty
+  std::vector<size_t> rangeFirstRows;
+  for (uint64_t i= 0; isOk && i < rangeCount; ++i) {
+    const uint64_t row= GetU64(data.data() + HEADER_BYTES + i * sizeof(uint64_t));
+    isOk= (0 == i && 0 == row) || (0 < i && rangeFirstRows.back() < row && row < rowCount);
+    rangeFirstRows.push_back(static_cast<size_t>(row));
+    }
+
+  std::vector<std::string> rows;
+  rows.reserve(static_cast<size_t>(rowCount));
+  size_t pos= rowsStart;
+  const size_t rowsEnd= rowsStart + static_cast<size_t>(rowsBytes);
+  for (uint64_t i= 0; isOk && i < rowCount; ++i) {
+    isOk= sizeof(uint32_t) <= rowsEnd - pos;
+    const size_t size= isOk ? GetU32(data.data() + pos) : 0;
+    pos+= sizeof(uint32_t);
+    isOk= isOk && size <= rowsEnd - pos;
+    if (isOk) {
+      rows.push_back(data.substr(pos, size));
+      pos+= size;
+      }
+    }
+  isOk= isOk && rowsEnd == pos;
+  if (!isOk) {
+    std::cout << "Error reading the write journal " << fileName_ << ": not a journal of layout version "
+              << WRITE_JOURNAL_LAYOUT_VERSION << ", or it is cut off." << std::endl;
+    return RTN_ERROR;
+    }
+
+  batchRows_= GetU32(data.data() + 12);
+  inputHash_= GetU64(data.data() + 16);
+  journalId_= GetU64(data.data() + 24);
+  rows_.swap(rows);
+  isRangeStart_.clear();
+  rangeFirstRows_.swap(rangeFirstRows);
+  MakeBatches();
+  // the whole watermarks, in the order the ranges committed them. A cut off append is ignored.
+  for (; pos + WATERMARK_BYTES <= data.size(); pos+= WATERMARK_BYTES) {
+    const uint64_t batch= GetU64(data.data() + pos);
+    if (~batch != GetU64(data.data() + pos + 8) || batch >= GetBatchCount())
+      break;
+    isCommitted_[static_cast<size_t>(batch)]= 1;
+    }
+  // cut the rest off, so the watermarks appended from here on are read
+  if (pos != data.size()) {
+    file.close();
+    std::ofstream rewrite(fileName_.c_str(), std::ios::binary | std::ios::trunc);
+    rewrite.write(data.data(), pos);
+    if (!rewrite) {
+      std::cout << "Error rewriting the write journal " << fileName_ << "." << std::endl;
+      return RTN_ERROR;
+      }
+    }
+  return RTN_NO_ERROR;
+  }
+
+long WriteJournal::Remove() {
+  // return value indicates success or error
+  if (0 != std::remove(fileName_.c_str())) {
+    std::cout << "Error removing the write journal " << fileName_ << "." << std::endl;
+    return RTN_ERROR;
+    }
+  return RTN_NO_ERROR;
+  }
+
+long WriteJournal::ReadDbBatches(SACommand &command, batch_set &dbBatches, std::string &errorText) const {
+  // return value indicates success or error
+  long rtnValue= RTN_ERROR;
+  dbBatches.clear();
+  try {
+    command.setCommandText(SPNAME_SELECT_WRITE_BATCHES.c_str(), SA_CmdStoredProc);
+    command.Param(WJ_JOURNALID_PARAM.c_str()).setAsString()= GetJournalId().c_str();
+    command.Param(WJ_TABLE_PARAM.c_str()).setAsString()= tableName_.c_str();
+    command.Execute();
+    // one row for each committed batch, no rows if no batch of the journal was committed
+    if (command.isResultSet()) {
+      while (command.FetchNext()) {
+        dbBatches.insert(command.Field(WJ_BATCH_PARAM.c_str()).asLong());
+        }
+      }
+    rtnValue= RTN_NO_ERROR;
+    }
+  catch (SAException &ex) {
+    errorText= (const char*)ex.ErrText();
+    std::cout << errorText << std::endl;
+    rtnValue= RTN_ERROR;
+    }
+  return rtnValue;
+  }
+
+long WriteJournal::SyncDbBatches(const batch_set &dbBatches) {
+  // return value indicates success or error
+  for (size_t batch= 0; batch < GetBatchCount(); ++batch) {
+    if (0 != isCommitted_[batch] && 0 == dbBatches.count(static_cast<long>(batch))) {
+      std::cout << "The journal has batch " << batch << " of journal " << GetJournalId() << " as committed, but the db does not. The "
+                << tableName_ << " table was deleted or changed by someone else. Remove " << fileName_ << " and write the table again." << std::endl;
+      return RTN_ERROR;
+      }
+    }
+  for (batch_set::const_iterator cit= dbBatches.begin(); cit != dbBatches.end(); ++cit) {
+    if (*cit < 0 || *cit >= static_cast<long>(GetBatchCount())) {
+      std::cout << "The db has batch " << *cit << " of journal " << GetJournalId() << ", but the journal has "
+                << GetBatchCount() << " batches. Remove " << fileName_ << " and write the table again." << std::endl;
+      return RTN_ERROR;
+      }
+    // committed in the db, but the run stopped before the watermark append
+    if (0 == isCommitted_[*cit] && RTN_NO_ERROR != AppendWatermark(*cit)) {
+      std::cout << "Error writing the watermark to the write journal " << fileName_ << "." << std::endl;
+      return RTN_ERROR;
+      }
+    }
+  Metrics::Instance().AddCount("journal." + tableName_ + ".batches_resumed", static_cast<long long>(dbBatches.size()));
+  return RTN_NO_ERROR;
+  }
+
+long WriteJournal::WriteBatches(const std::string &serverText, SAConnection &connection, SACommand &command,
+                                RowWriterTyp writeRow, std::string &errorText) {
+  // return value indicates success or error
+  Metrics &metrics= Metrics::Instance();
+  // the ranges with batches to write
+  ranges_.clear();
+  size_t rowsToWrite= 0;
+  size_t rowsInDb= 0;
+  for (size_t index= 0; index < rangeFirstRows_.size(); ++index) {
+    RangeTyp range;
+    range.firstRow= rangeFirstRows_[index];
+    range.endRow= index + 1 < rangeFirstRows_.size() ? rangeFirstRows_[index + 1] : rows_.size();
+    range.firstBatch= static_cast<long>(std::lower_bound(batchFirstRows_.begin(), batchFirstRows_.end(), range.firstRow) - batchFirstRows_.begin());
+    range.endBatch= static_cast<long>(std::lower_bound(batchFirstRows_.begin(), batchFirstRows_.end(), range.endRow) - batchFirstRows_.begin());
+    range.rowsWritten= 0;
+    range.batchesWritten= 0;
+    range.elapsedMs= 0.0;
+    range.status= RTN_NO_ERROR;
+    size_t rows= 0;
+    for (long batch= range.firstBatch; batch < range.endBatch; ++batch) {
+      const size_t batchRows= batchFirstRows_[batch + 1] - batchFirstRows_[batch];
+      if (0 == isCommitted_[batch])
+        rows+= batchRows;
+      else
+        rowsInDb+= batchRows;
+      }
+    if (0 < rows)
+      ranges_.push_back(range);
+    rowsToWrite+= rows;
+    }
+  std::cout << "There are " << rowsToWrite << " records to insert, on " << ranges_.size() << " connections";
+  if (0 < rowsInDb)
+    std::cout << ", resuming after " << rowsInDb << " records already in the db";
+  std::cout << "." << std::endl;
+  ProgressReporter progress("Records", rowsToWrite);
+
+  // the first range writes on the caller's connection, and the others on their own
+  std::vector<std::thread> threads;
+  threads.reserve(ranges_.size());
+  try {
+    for (size_t index= 0; index < ranges_.size(); ++index) {
+      threads.push_back(std::thread(&WriteJournal::WriteRange, this, std::ref(ranges_[index]), index + 1, std::cref(serverText),
+                                    0 == index ? &connection : nullptr, 0 == index ? &command : nullptr, std::cref(writeRow),
+                                    std::ref(progress)));
+      }
+    }
+  catch (std::system_error &ex) {
+    // the ranges without a thread are not written. They are resumed from the journal.
+    errorText= ex.what();
+    std::cout << "Error starting the " << tableName_ << " table writer threads: " << errorText << std::endl;
+    for (size_t index= threads.size(); index < ranges_.size(); ++index) {
+      ranges_[index].status= RTN_ERROR;
+      ranges_[index].errorText= errorText;
+      }
+    }
+  for (std::vector<std::thread>::iterator it= threads.begin(); it != threads.end(); ++it)
+    it->join();
+  progress.Finish();
+  std::cout << std::endl;
+
+  // throughput of each connection
+  long rtnValue= RTN_NO_ERROR;
+  for (size_t index= 0; index < ranges_.size(); ++index) {
+    const RangeTyp &range= ranges_[index];
+    const std::string metricName= "journal." + tableName_ + ".connection" + std::to_string(index + 1);
+    metrics.AddTime(metricName, range.elapsedMs);
+    metrics.AddCount(metricName + ".rows", static_cast<long long>(range.rowsWritten));
+    metrics.AddCount("journal." + tableName_ + ".batches_written", static_cast<long long>(range.batchesWritten));
+    std::cout << "Connection " << index + 1 << ": rows " << range.firstRow + 1 << " to " << range.endRow << ", "
+              << range.rowsWritten << " rows in " << static_cast<long>(range.elapsedMs) << " ms ("
+              << static_cast<long>(0.0 < range.elapsedMs ? range.rowsWritten * 1000.0 / range.elapsedMs : 0.0) << " rows/s)." << std::endl;
+    if (RTN_NO_ERROR != range.status) {
+      std::cout << range.errorText << std::endl
+                << "Rows " << range.firstRow + 1 << " to " << range.endRow << " of the " << tableName_
+                << " table were not all written. Run again to resume them (" << fileName_ << ")." << std::endl;
+      errorText= range.errorText;
+      rtnValue= RTN_ERROR;
+      }
+    }
+  return rtnValue;
+  }
+
+// private helper functions
+void WriteJournal::MakeBatches() {
+  // batches of batchRows_ rows from the start of each range
+  batchFirstRows_.clear();
+  for (size_t index= 0; index < rangeFirstRows_.size(); ++index) {
+    const size_t endRow= index + 1 < rangeFirstRows_.size() ? rangeFirstRows_[index + 1] : rows_.size();
+    for (size_t row= rangeFirstRows_[index]; row < endRow; row+= batchRows_)
+      batchFirstRows_.push_back(row);
+    }
+  batchFirstRows_.push_back(rows_.size());
+  isCommitted_.assign(batchFirstRows_.size() - 1, 0);
+  ranges_.clear();
+  }
+
+void WriteJournal::WriteRange(RangeTyp &range, size_t connectionNumber, const std::string &serverText, SAConnection *connection,
+                              SACommand *command, const RowWriterTyp &writeRow, ProgressReporter &progress) {
+  std::chrono::steady_clock::time_point start= std::chrono::steady_clock::now();
+  TraceRecorder::Instance().SetThreadName("journal." + tableName_ + ".connection" + std::to_string(connectionNumber));
+
+  // a range after the first has its own connection and command objects
+  SAConnection ownConnection;
+  SACommand ownCommand;
+  SAConnection &rangeConnection= nullptr == connection ? ownConnection : *connection;
+  SACommand &rangeCommand= nullptr == command ? ownCommand : *command;
+  try {
+    if (nullptr == connection) {
+      // use SQL server native client, ODBC API (same as the single connection classes)
+      ownConnection.setClient(SA_SQLServer_Client);
+      ownConnection.setOption( "UseAPI" ) = "ODBC";
+      ownConnection.Connect(serverText.c_str(),     // server_name@database_name
+                            DB_USER_NAME.c_str(),   // user name
+                            DB_PASSWORD.c_str());   // password
+      ownCommand.setConnection(&ownConnection);
+      }
+    rangeConnection.setAutoCommit(SA_AutoCommitOff);
+    }
+  catch (SAException &ex) {
+    range.errorText= (const char*)ex.ErrText();
+    range.status= RTN_ERROR;
+    }
+
+  // batches in row order, so the rows a batch depends on are committed or written before it
+  for (long batch= range.firstBatch; RTN_NO_ERROR == range.status && batch < range.endBatch; ++batch) {
+    if (0 != isCommitted_[batch])
+      continue;
+    const size_t first= batchFirstRows_[batch];
+    const size_t last= batchFirstRows_[batch + 1];
+    for (size_t row= first; RTN_NO_ERROR == range.status && row < last; ++row) {
+      progress.Add();
+      range.status= writeRow(rangeCommand, static_cast<long>(row + 1), rows_[row], range.errorText);
+      }
+    if (RTN_NO_ERROR == range.status)
+      range.status= CommitDbBatch(rangeConnection, rangeCommand, batch, range.errorText);
+    if (RTN_NO_ERROR == range.status) {
+      range.rowsWritten+= last - first;
+      ++range.batchesWritten;
+      range.status= AppendWatermark(batch);
+      if (RTN_NO_ERROR != range.status)
+        range.errorText= "Error writing the watermark to the write journal " + fileName_ + ".";
+      }
+    else {
+      // the rows of the batch are not kept. The range resumes from it.
+      try {
+        rangeConnection.Rollback();
+        }
+      catch (SAException &) {
+        }
+      }
+    }
+
+  try {
+    if (nullptr == connection)
+      ownConnection.Disconnect();
+    else
+      rangeConnection.setAutoCommit(SA_AutoCommitOn);
+    }
+  catch (SAException &) {
+    }
+  range.elapsedMs= std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+long WriteJournal::AppendWatermark(long batch) {
+  // return value indicates success or error
+  std::string data;
+  PutU64(data, static_cast<uint64_t>(batch));
+  PutU64(data, ~static_cast<uint64_t>(batch));
+  std::lock_guard<std::mutex> lock(fileMutex_);
+  std::ofstream file(fileName_.c_str(), std::ios::binary | std::ios::app);
+  file.write(data.data(), data.size());
+  file.flush();
+  if (!file)
+    return RTN_ERROR;
+  isCommitted_[batch]= 1;
+  return RTN_NO_ERROR;
+  }
+
+long WriteJournal::CommitDbBatch(SAConnection &connection, SACommand &command, long batch, std::string &errorText) const {
+  // return value indicates success or error
+  long rtnValue= RTN_ERROR;
+  try {
+    // the batch key is unique, so a batch that is already in the db fails here, and its rows are rolled back
+    command.setCommandText(SPNAME_INSERT_WRITE_BATCH.c_str(), SA_CmdStoredProc);
+    command.Param(WJ_JOURNALID_PARAM.c_str()).setAsString()= GetJournalId().c_str();
+    command.Param(WJ_TABLE_PARAM.c_str()).setAsString()= tableName_.c_str();
+    command.Param(WJ_BATCH_PARAM.c_str()).setAsLong()= batch;
+    {
+      Metrics::ScopedTimer latency("sproc." + SPNAME_INSERT_WRITE_BATCH, Metrics::TK_LATENCY);
+      command.Execute();
+    }
+    connection.Commit();
+    rtnValue= RTN_NO_ERROR;
+    }
+  catch (SAException &ex) {
+    errorText= (const char*)ex.ErrText();
+    rtnValue= RTN_ERROR;
+    }
+  return rtnValue;
+  }
+
+} // namespace gaScsData
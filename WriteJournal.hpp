@@ -0,0 +1,203 @@
+/********************************************************************
+ * COPYRIGHT -- General Atomics
+ ********************************************************************
+ * Library:
+ * File: WriteJournal.hpp
+ * Created: October 16, 2026
+  *******************************************************************
+ * Function:  Local write ahead journal of the rows of one db table (SCS positions or events), so a write that
+ *            fails part way (a network drop, for example) can be finished by the next run, without calculating
+ *            the rows again, and without writing the rows that are already in the db.
+ *
+ *            Protocol:
+ *              1) The rows are calculated, and written to the journal file before the db is touched (Create()).
+ *                 The rows are split into contiguous ranges (RIA angle ranges, since the rows are in angle order),
+ *                 one per db connection. A range starts at a row added as a range start, a row that does not
+ *                 depend on the rows before it.
+ *              2) The ranges are written at once, each on its own connection, in batches of WRITE_JOURNAL_BATCH_ROWS,
+ *                 one transaction per batch. Each row is passed its sequence number (row index + 1), so the order
+ *                 of the rows in the db views is the order of a serial write, whatever order they are committed in.
+ *                 The batch key (journal id, batch number) is inserted in the same transaction
+ *                 (SPNAME_INSERT_WRITE_BATCH). The key is unique in the db, so a batch can't land twice.
+ *              3) When the db commit is done, the batch number is appended to the journal (a watermark).
+ *              4) When the table is written, the journal is removed.
+ *            A run that finds a journal of the same inputs (AxisPositions::GetInputHash(), EventMap::GetInputHash())
+ *            reads the rows and ranges from it, and asks the db for the batches it committed for the journal id
+ *            (SPNAME_SELECT_WRITE_BATCHES). The db batches are the ones used, since a run can stop between the db
+ *            commit and the watermark append (SyncDbBatches()). This is checked before anything in the db is deleted:
+ *            if the db does not have a batch of the local watermarks, the table was deleted or changed by someone
+ *            else, and the write is an error. If the db has no batch of the journal, none of its rows are in the db,
+ *            so the caller deletes the old rows first, as for a new write, and stops if the delete fails. The other
+ *            batches are written, on the ranges of the journal, so the rows a batch depends on are in the db or
+ *            written before it on the same connection.
+ *            The table delete procedures (SPNAME_DELETE_ALL_POS, SPNAME_DELETE_ALL_INC_EVENTS) delete the batch
+ *            keys of their table in the same transaction as the rows. So when anyone deletes or rewrites the table,
+ *            a journal of the same inputs finds none of its batches in the db, and is not resumed onto the new rows.
+ *
+ *            File format (WRITE_JOURNAL_PREFIX.<table>.jnl, little endian):
+ *              header, 56 bytes:
+ *                 0  magic               8 bytes, WRITE_JOURNAL_MAGIC
+ *                 8  layout version      uint32, WRITE_JOURNAL_LAYOUT_VERSION
+ *                12  batch rows          uint32
+ *                16  input hash          uint64
+ *                24  journal id          uint64
+ *                32  row count           uint64
+ *                40  rows bytes          uint64
+ *                48  range count         uint64
+ *              ranges:                   uint64 first row of each range, ascending. The first is row 0.
+ *              rows:                     uint32 byte count, then the record (RecordReader order)
+ *              watermarks, 16 bytes each: batch uint64, then ~batch uint64 (a cut off append is not a watermark)
+ *            Batches are numbered in row order. A batch is in one range. The last batch of a range can be short.
+ *
+ * Libraries used:  string
+ *                  vector
+ *                  functional
+ *                  mutex
+ *                  SQLAPI.h
+ *                  Boost containers
+ *                  Boost Non-copyable
+ *******************************************************************/
+#pragma once
+
+#ifndef GA_WriteJournal_H_
+#define GA_WriteJournal_H_
+
+// standard c/c++ libraries
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+// GA headers
+#include "gaScsDataConstants.hpp"
+
+namespace gaScsData {
+
+class ProgressReporter;
+
+class WriteJournal : private boost::noncopyable {
+
+public:
+  // typedefs and enums
+    // Writes one journal row to the db, with the command of the range's connection, at the sequence number.
+    // Called from the range threads at once, so it must not change shared state. Return value indicates success or error.
+    typedef std::function<long(SACommand &command, long sequence, const std::string &record, std::string &errorText)> RowWriterTyp;
+    typedef boost::container::flat_set<long> batch_set;
+
+    // a range of the rows, written on one connection, and how the last WriteBatches() went
+    struct RangeTyp {
+      size_t firstRow;
+      size_t endRow;          // one past the last row
+      long firstBatch;
+      long endBatch;          // one past the last batch
+      size_t rowsWritten;     // rows of the batches committed
+      size_t batchesWritten;
+      double elapsedMs;       // connect, write, and commit
+      long status;            // RTN_NO_ERROR, or RTN_ERROR if a batch was not written
+      std::string errorText;
+      };
+    typedef std::vector<RangeTyp> range_list;
+
+    // reads the values of a record, in the order they were put
+    class RecordReader {
+    public:
+      explicit RecordReader(const std::string &record);
+      double GetDouble();
+      long GetLong();
+      bool GetBool();
+      std::string GetString();
+      // false if a value was read past the end of the record
+      bool IsOk() const;
+
+    private:
+      bool Read(void *data, size_t size);
+      const std::string &record_;
+      size_t pos_;
+      bool isOk_;
+      };
+
+  // ctors and dtor
+    // tableName is WRITE_JOURNAL_TABLE_SCS or WRITE_JOURNAL_TABLE_EVENTS
+    explicit WriteJournal(const std::string &tableName);
+    ~WriteJournal();
+
+  // accessors
+    const std::string& GetFileName() const;
+    uint64_t GetInputHash() const;
+    // journal id as 16 hex digits, the batch key in the db
+    std::string GetJournalId() const;
+    size_t GetRowCount() const;
+    size_t GetBatchCount() const;
+    size_t GetRangeCount() const;
+    // batches committed by this journal
+    size_t GetCommittedCount() const;
+    bool IsComplete() const;
+    const std::string& GetRow(size_t index) const;
+    // ranges written by the last WriteBatches(), with their throughput
+    const range_list& GetRanges() const;
+
+  // public member functions
+    // record builders. A record is the values of one row, put in order.
+    static void PutDouble(std::string &record, double value);
+    static void PutLong(std::string &record, long value);
+    static void PutBool(std::string &record, bool value);
+    static void PutString(std::string &record, const std::string &value);
+
+    // forget the rows opened, to make a new journal of other rows
+    void Clear();
+    // Add a row before Create(). isRangeStart is true if the row does not depend on the rows before it in the db,
+    // so a range can start with it.
+    void AddRow(const std::string &record, bool isRangeStart = true);
+    // Write the rows added, as a new journal of up to rangeCount ranges of about the same number of rows.
+    // Replaces a journal file that is there. Return value indicates success or error
+    long Create(uint64_t inputHash, size_t batchRows, size_t rangeCount);
+    // Read the journal file.
+    // Return value is RTN_NO_RESULTS if there is no journal, and RTN_ERROR if it can't be read.
+    long Open();
+    // Remove the journal file, when the table is written. Return value indicates success or error
+    long Remove();
+
+    // Batches of this journal committed in the db, empty if none. Assumes a valid connection has been made.
+    // Return value indicates success or error
+    long ReadDbBatches(SACommand &command, batch_set &dbBatches, std::string &errorText) const;
+    // Check the local watermarks against the batches committed in the db (ReadDbBatches()), and take the db batches
+    // as committed. Call it before anything in the db is deleted or written. A watermark the db does not have is an
+    // error, since the table was deleted or rewritten since. Return value indicates success or error
+    long SyncDbBatches(const batch_set &dbBatches);
+    // Write the batches not committed, one transaction each, with writeRow called for each row of the batch.
+    // Each range with batches to write is a thread. The first one uses the caller's connection, and the others
+    // connect to serverText. A range stops at its first batch that fails. It is rolled back, and the journal is
+    // kept to resume from. The throughput of each connection is reported (GetRanges()).
+    // Assumes a valid connection has been made. Return value indicates success or error
+    long WriteBatches(const std::string &serverText, SAConnection &connection, SACommand &command,
+                      RowWriterTyp writeRow, std::string &errorText);
+
+  private:
+    // helper functions
+      // number the batches of the ranges
+      void MakeBatches();
+      // Write the batches of a range that are not committed. Runs on a range thread.
+      // connection is null if the range makes its own connection.
+      void WriteRange(RangeTyp &range, size_t connectionNumber, const std::string &serverText, SAConnection *connection,
+                      SACommand *command, const RowWriterTyp &writeRow, ProgressReporter &progress);
+      // append a watermark to the journal file. Thread safe. Return value indicates success or error
+      long AppendWatermark(long batch);
+      // insert the batch key, and commit the transaction. Return value indicates success or error
+      long CommitDbBatch(SAConnection &connection, SACommand &command, long batch, std::string &errorText) const;
+
+    // member variables
+      std::string tableName_;
+      std::string fileName_;
+      uint64_t inputHash_;
+      uint64_t journalId_;
+      size_t batchRows_;
+      std::vector<std::string> rows_;
+      std::vector<char> isRangeStart_;        // rows added, until Create()
+      std::vector<size_t> rangeFirstRows_;
+      std::vector<size_t> batchFirstRows_;    // and one past the last row
+      range_list ranges_;
+      std::vector<char> isCommitted_;         // one per batch. char, so the range threads can set their own batches.
+      std::mutex fileMutex_;                  // watermark appends
+};
+
+} // namespace gaScsData
+#endif // GA_WriteJournal_H_
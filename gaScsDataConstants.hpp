@@ -41,6 +41,13 @@ namespace gaScsData {
     AXIDX_E_COL_OUT,
     AXIDX_F_COL_IN,
     AXIDX_F_COL_OUT };
+
+  // axis names for files and reports, in the AxisIndexes order without AXIDX_UNKNOWN (0 is foot A inner)
+  const char *const AXIS_COLUMN_NAMES[]= {
+    "foot_a_in", "foot_a_out", "foot_b_in", "foot_b_out", "foot_c_in", "foot_c_out",
+    "foot_d_in", "foot_d_out", "foot_e_in", "foot_e_out", "foot_f_in", "foot_f_out",
+    "column_a_in", "column_a_out", "column_b_in", "column_b_out", "column_c_in", "column_c_out",
+    "column_d_in", "column_d_out", "column_e_in", "column_e_out", "column_f_in", "column_f_out" };
   
 
 // number of columns
@@ -68,10 +75,14 @@ namespace gaScsData {
   const double DEG_TO_RADIANS= PI/180.0;  // convert between degrees and radians for trig functions
   const double RADIANS_TO_DEG= 180.0/PI;
   
+  // standard (production) coil geometry. The runtime geometry (CoilGeometry class) defaults to these.
   const long TURNS_PER_LAYER= 14;
   const long LAYERS_PER_COIL= 40;
-//  const long COIL_ANGLE_MAX= 79560; // mockup
-  const long COIL_ANGLE_MAX= (LAYERS_PER_COIL * TURNS_PER_LAYER * 360) - (360 * 6);	// actual coil length is 6 turns less than a full 14x40 coil
+  const long COIL_SHORT_TURNS= 6; // the coil is this many turns short of a full TURNS_PER_LAYER x LAYERS_PER_COIL coil
+  const long COIL_ANGLE_MAX= (LAYERS_PER_COIL * TURNS_PER_LAYER * 360) - (360 * COIL_SHORT_TURNS);	// actual coil length is 6 turns less than a full 14x40 coil
+  // mockup coil geometry (CoilGeometry::Mockup()). Same turns per layer. 79560 degree coil angle max.
+  const long MOCKUP_LAYERS_PER_COIL= 16;
+  const long MOCKUP_SHORT_TURNS= 3;
   const long COLUMN_INCREMENT= 60;		// degrees. 6 fold symmetry
   const long INITIAL_COLUMN_ANGLE= 30;	// degrees - start at column A
   const double TURN_INDEX_NOMINAL= 53; // mm, nominal turn to turn index
@@ -106,12 +117,18 @@ namespace gaScsData {
   
 
   // feature codes
-  const std::string FC_TRANSITION= "T";
-  const std::string FC_OUTLET= "O";
-  const std::string FC_INLET= "I";
-  const std::string FC_JOGGLE= "J";
-  const std::string FC_WINDING_LOCK= "W";
-  const std::string FC_LOCAL= "L";
+  // The coil map feature codes are single letters. They are decoded once when the coil map is loaded
+  // into this one byte type (the value is the letter), so they can be compared as integers.
+  // Use CoilMap::FcToString() to get the text back for db and trace output.
+  // FC_NONE is the sentinel for no feature (NO_FEATURE_STR as text).
+  enum FeatureCode : char {
+    FC_NONE= '\0',
+    FC_TRANSITION= 'T',
+    FC_OUTLET= 'O',
+    FC_INLET= 'I',
+    FC_JOGGLE= 'J',
+    FC_WINDING_LOCK= 'W',
+    FC_LOCAL= 'L' };
 
 // Event related values
 
@@ -166,17 +183,138 @@ namespace gaScsData {
 
   const long CONSOLIDATION_INTERVAL= 120; // how often to make an odd layer consolidation event
 
+// Synthetic coil map generator defaults (CoilMapGenerator)
+  // The geometry defaults to the standard coil (CoilGeometry class)
+  const double GEN_INITIAL_RADIUS= 1300.0; // mm, nominal radius of turn 1
+  // feature placement, in degrees from the start of the turn
+  const double GEN_LOCAL_ZERO_OFFSET= 5.0; // local zero (new hqp), just after the layer start joggle
+  const double GEN_INLET_OFFSET= 90.0; // He inlet, first turn of a hqp
+  const double GEN_TRANSITION_OFFSET= 180.0; // turn to turn transition, every turn
+  const double GEN_OUTLET_OFFSET= 270.0; // He outlet, last turn of a hqp
+  const double GEN_WINDING_LOCK_OFFSET= 100.0; // winding lock, degrees before the end of the coil
+  // coil sizes (multiples of the production coil) run by the -s scaling option
+  const long GEN_SCALE_FACTORS[]= { 1, 10, 100 };
+  const size_t GEN_NUM_OF_SCALE_FACTORS= sizeof(GEN_SCALE_FACTORS) / sizeof(GEN_SCALE_FACTORS[0]);
+
+// Pipeline benchmark (ScsBenchmark executable) defaults
+  const long BENCHMARK_REPETITIONS= 5; // times each benchmark is run. Min, median, and mean are reported.
+  const size_t BENCHMARK_MICRO_COUNT= 200000; // random angles per microbenchmark repetition
+  const unsigned BENCHMARK_SEED= 12345; // random angle seed, fixed so runs are comparable
+  const std::string BENCHMARK_OUTPUT_FILE= "ScsBenchmark.json"; // default results file
+
+// Metrics registry (Metrics class)
+  const std::string METRICS_REPORT_FILE= "ScsProductionData.metrics.json"; // JSON report written at exit
+  // latency histogram bucket upper bounds (ms). One more bucket counts anything slower.
+  const double METRICS_HISTOGRAM_BOUNDS_MS[]= { 0.1, 0.2, 0.5, 1.0, 2.0, 5.0, 10.0, 20.0, 50.0, 100.0, 200.0, 500.0, 1000.0 };
+  const size_t METRICS_NUM_OF_HISTOGRAM_BOUNDS= sizeof(METRICS_HISTOGRAM_BOUNDS_MS) / sizeof(METRICS_HISTOGRAM_BOUNDS_MS[0]);
+  const std::string TRACE_REPORT_FILE= "ScsProductionData.trace.json"; // Chrome trace timeline written at exit when tracing (-t)
+  const long PROGRESS_REDRAW_MS= 250; // console progress display redraw period
+
+// Batch runs (BatchRunner class, -b argument)
+  const std::string BATCH_REPORT_FILE= "ScsBatchReport.json"; // consolidated results of a batch run
+  const std::string SWEEP_REPORT_FILE= "ScsParameterSweep.json"; // results of a parameter sweep (-w)
+  const std::string BATCH_SOURCE_DB= "db";  // manifest coil map source: the coil map in the configured db. Tables are written.
+  const std::string BATCH_SOURCE_GENERATED= "generated";  // manifest coil map source: generated coil map, in memory. No db access.
+  // exit codes for scripted runs
+  const int EXIT_OK= 0;
+  const int EXIT_SCENARIO_ERROR= 1;  // at least one scenario failed
+  const int EXIT_USAGE_ERROR= 2;  // bad argument or manifest
+  // output checksums (Checksum class), 64 bit FNV-1a
+  const unsigned long long CHECKSUM_FNV_OFFSET_BASIS= 14695981039346656037ULL;
+  const unsigned long long CHECKSUM_FNV_PRIME= 1099511628211ULL;
+
+// Resident lookup service (LookupService class, -r argument)
+  const long LOOKUP_RELOAD_POLL_MS= 1000; // how often the service reads the db generation rows of the tables
+  const size_t LOOKUP_SERVICE_THREADS= 2; // request threads
+  const size_t LOOKUP_MAX_REQUEST= 256; // longest request line (characters)
+  const size_t LOOKUP_MAX_ROWS= 20000; // most rows in one response
+
+// Shared table publication (TablePublisher class, -m argument)
+  const std::string PUBLISH_FILE= "ScsProductionData.tables"; // default memory mapped file
+  const char PUBLISH_MAGIC[8]= "GASCSTB"; // first bytes of the file
+  const unsigned long PUBLISH_LAYOUT_VERSION= 3; // change when a record or the header changes
+  const size_t PUBLISH_HEADER_BYTES= 4096; // header size. The slots start after it.
+  const size_t PUBLISH_ACTION_CHARS= 128; // move summary characters in a published SCS record, including the null
+  const long PUBLISH_INDEX_STEP= 360; // RIA angle between published index entries (one turn)
+  const unsigned long long PUBLISH_SLOT_HEADROOM= 2; // slots are made this many times the size needed, so regenerated tables still fit
+  const unsigned long long PUBLISH_SLOT_ROUNDING= 65536; // slot size is a multiple of this
+  const long PUBLISH_READ_ATTEMPTS= 100; // reads of the current generation tried while it is being published
+  const long PUBLISH_MAX_FOLLOW= 8; // retired files followed to the file that replaced them, when a file is opened
+
+// Absolute position resolver (PositionResolver class)
+  const size_t RESOLVER_CHECKPOINT_ROWS= 16; // SCS rows between saved absolute positions. A lookup replays at most this many rows.
+
+// Per axis trajectory export (AxisTrajectories class, -x argument)
+  const std::string TRAJECTORY_FILE= "ScsTrajectories.trj"; // default file
+  const char TRAJECTORY_MAGIC[8]= "GASCSTJ"; // first bytes of the file
+  const unsigned long TRAJECTORY_LAYOUT_VERSION= 1; // change when the file format changes
+
+// PLC position download (PlcDownload class, -d argument)
+  const std::string PLC_DOWNLOAD_FILE= "ScsPositions.plc"; // default file
+  const char PLC_MAGIC[]= "GAPL"; // first 4 bytes of the file
+  const unsigned long PLC_LAYOUT_VERSION= 1; // change when a record or the header changes. The PLC loader checks it.
+  const size_t PLC_HEADER_BYTES= 32;
+  const long PLC_MAX_ANGLE_DELTA= 65535; // most RIA angle between rows (16 bit record field)
+
+// Columnar analysis export (ColumnarExport class, -c argument)
+  const std::string EXPORT_PREFIX= "ScsExport"; // default start of the export file names
+  const size_t EXPORT_BATCH_ROWS= 4096; // rows kept in memory before they are written
+  const size_t EXPORT_NPY_HEADER_BYTES= 128; // .npy header size. Must be a multiple of 64.
+
+// Generated position validation (PositionValidator class)
+  const std::string VALIDATION_REPORT_FILE= "ScsValidation.json"; // violation report, written when the positions are not written to the db
+  const size_t VALIDATOR_CHUNK_ROWS= 4096; // SCS rows checked by one task
+  const size_t VALIDATOR_THREADS= 0; // 0 -- one per core
+  const double VALIDATOR_POSITION_TOLERANCE= 0.000001; // mm. past a foot limit before it is a violation
+  const size_t VALIDATOR_MAX_REPORTED= 1000; // violations listed in the report. All of them are counted.
+
+// Event and position cross check (EventCrossCheck class)
+  const std::string CROSS_CHECK_REPORT_FILE= "ScsCrossCheck.json"; // issue report, written when the events and positions do not agree
+  const size_t CROSS_CHECK_MAX_REPORTED= 1000; // issues listed in the report. All of them are counted.
+
+// Generation fingerprints (OutputFingerprint and FingerprintDiff classes, -v argument)
+  const std::string FINGERPRINT_FILE= "ScsFingerprint.fpr"; // written with each -p and -e generation
+  const std::string FINGERPRINT_PREVIOUS_FILE= "ScsFingerprint.previous.fpr"; // the generation before it
+  const std::string FINGERPRINT_DIFF_FILE= "ScsFingerprintDiff.json"; // differences found by -v
+  const char FINGERPRINT_MAGIC[8]= "GASCSFP"; // first bytes of the file
+  const unsigned long FINGERPRINT_LAYOUT_VERSION= 2; // change when the file format or a hash changes
+  const size_t FINGERPRINT_MAX_REPORTED= 1000; // rows listed in the differences. All of them are counted.
+
+// Skip unchanged regeneration (AxisPositions and EventMap input hashes, TableGeneration db rows, --force argument)
+  const std::string GENERATOR_VERSION= "2026.10.16"; // change when the position or event logic changes, so tables are remade
+  const std::string GENERATION_TABLE_SCS= "scs"; // generation row of the SCS and CLS position tables
+  const std::string GENERATION_TABLE_EVENTS= "events"; // generation row of the event table
+
+// Write ahead journal of the table writes (WriteJournal class, --connections argument)
+  const std::string WRITE_JOURNAL_PREFIX= "ScsWriteJournal"; // journal file is <prefix>.<table>.jnl, removed when the table is written
+  const std::string WRITE_JOURNAL_TABLE_SCS= "scs";
+  const std::string WRITE_JOURNAL_TABLE_EVENTS= "events";
+  const char WRITE_JOURNAL_MAGIC[8]= "GASCSWJ"; // first bytes of the file
+  const unsigned long WRITE_JOURNAL_LAYOUT_VERSION= 2; // change when the file format or a record changes
+  const size_t WRITE_JOURNAL_BATCH_ROWS= 500; // rows committed to the db in one transaction
+  const size_t DB_WRITER_CONNECTIONS= 4; // db connections writing the ranges of a table at once. 1 -- the serial write.
+  const size_t DB_WRITER_MAX_CONNECTIONS= 16; // most connections allowed by --connections
+
 
   // list of layer numbers where coil measurement and compression take place
-  // mnockup
-  //const long LA_ME_CO[] = { 4, 7, 9, 11, 14, 17 }; // name is from LAyers for MEasurment and COmpression
-  // normal coil
   // Note the values in the list below are 1 higher than the landed turn where the measurement and compression
   // is occurring. This is becasue the event generation is tied in with Ria Angle, which deals with turns
   // being dropped, but the measurement and compression actions are done on landed turns.
   // When turn 4 is being droppped, turn 3 is landed, for example.
-  const long LA_ME_CO[] = { 4, 7, 10, 13, 16, 19, 21, 23, 26, 29, 32, 35, 38, 41 }; // name is from LAyers for MEasurment and COmpression
-  const size_t NUM_OF_LA_ME_CO = sizeof(LA_ME_CO) / sizeof(LA_ME_CO[0]);
+  // constexpr so the standard coil geometry kernel (StandardGeometry) can fold them at compile time
+  constexpr long LA_ME_CO[] = { 4, 7, 10, 13, 16, 19, 21, 23, 26, 29, 32, 35, 38, 41 }; // name is from LAyers for MEasurment and COmpression
+  constexpr size_t NUM_OF_LA_ME_CO = sizeof(LA_ME_CO) / sizeof(LA_ME_CO[0]);
+  // last layer of each hex/quad pancake. Any layer at or past the last layer of the coil is also a last hex/quad layer.
+  constexpr long LAST_HQ_LAYERS[]= { 6, 12, 18, 22, 28, 34, 40 };
+  constexpr size_t NUM_OF_LAST_HQ_LAYERS= sizeof(LAST_HQ_LAYERS) / sizeof(LAST_HQ_LAYERS[0]);
+  // mockup coil
+  const long MOCKUP_LA_ME_CO[] = { 4, 7, 9, 11, 14, 17 };
+  const size_t MOCKUP_NUM_OF_LA_ME_CO = sizeof(MOCKUP_LA_ME_CO) / sizeof(MOCKUP_LA_ME_CO[0]);
+  const long MOCKUP_LAST_HQ_LAYERS[]= { 6, 10, 16 };
+  const size_t MOCKUP_NUM_OF_LAST_HQ_LAYERS= sizeof(MOCKUP_LAST_HQ_LAYERS) / sizeof(MOCKUP_LAST_HQ_LAYERS[0]);
+  // geometry file values (CoilGeometry::Load()) that name a built in geometry instead of a file
+  const std::string GEOMETRY_STANDARD= "standard";
+  const std::string GEOMETRY_MOCKUP= "mockup";
 // db constants
   // test db
   // const std::string DB_SERVER_NAME= "VMUSERHOST\\STN06DEVTEST1"; 
@@ -270,12 +408,20 @@ namespace gaScsData {
   // db stored procedure names
   // coil map related
   const std::string SPNAME_SELECT_COIL_MAP= "coil.sprocSelectCoilMap"; // Select everything from the coil map
+  const size_t MAX_NUM_OF_COIL_MAP_ROWS = 4096; // nominally a few rows per turn (560 turns), reserve generously so the load never reallocates
+  const std::string COIL_MAP_PREFETCH_ROWS= "1000"; // number of rows the client fetches per round trip when loading the coil map
+  const double COIL_MAP_BUCKET_SIZE= 360.0; // degrees. Bucket size of the coil map angle index used by the Lb/Ub lookups (one turn)
+  const size_t LOOKUP_BENCHMARK_COUNT= 1000000; // number of random lookups per method done by the lookup benchmark (-l)
   const std::string SPNAME_SELECT_CMOLT14FCT= "coil.sprocSelectCmOlT14FcT"; // Coil Map Odd Layer Turn 14 Feature Code "T"
   const size_t MAX_NUM_OF_CNOLT14FCT = 21; // nominally the number of odd layers, add 1 just in case
   const std::string SPNAME_SELECT_JOGGLE_ANGLES= "coil.sprocSelectJoggleAngles"; // Coil Map Joggle Angles
   const size_t MAX_NUM_OF_JOGGLE_ANGLES = 41; // nominally the number of layers, add 1 just in case
+  // The joggle angle set and odd layer turn 14 transition map are built from the coil map rows already loaded.
+  // When true, they are also fetched with the two sprocs above and compared against what was built (consistency check).
+  const bool VERIFY_DERIVED_INDEXES= false;
   // Cls and Scs position related
-  const std::string SPNAME_DELETE_ALL_POS= "coil.sprocDeleteAllAxisPositions"; // Delete all rows in the CLS and SCS position tables
+  const std::string SPNAME_DELETE_ALL_POS= "coil.sprocDeleteAllAxisPositions"; // Delete all rows in the CLS and SCS position tables,
+                                                                               // and the SCS write journal batch keys and generation row
   
   const std::string SPNAME_INSERT_ALL_SCS_POS= "coil.sprocInsertPosDistScs"; // insert row for all SCS axes
                                                                              // (absolute position or relative distance)
@@ -286,12 +432,39 @@ namespace gaScsData {
   const std::string SPNAME_CALC_CLS_POS= "coil.sprocCalcClsPosFromScs"; // calculate cls moves from SCS position table
 
   // event list related
-  // Delete all rows in event list table which are not complete and don't have associated completed actions 
+  // Delete all rows in event list table which are not complete and don't have associated completed actions,
+  // and the events write journal batch keys and generation row
   const std::string SPNAME_DELETE_ALL_INC_EVENTS= "events.sprocDeleteUndoneEvents"; 
   const std::string SPNAME_INSERT_EVENTLIST= "events.sprocInsertToEventList"; // Inserts a record into the Event List
   const std::string SPNAME_SELECT_HQPSTART_ANGLES= "events.sprocSelectStartHqpAngles"; // New Hqp start angles from ScsPosTable
   const size_t MAX_NUM_OF_HQP_START_ANGLES = 8; // nominally the number of HQPs, add 1 just in case
   const std::string SPNAME_SELECT_LAYERSTART_ANGLES= "events.sprocSelectStartLayerAngles"; // New Layer start angles from ScsPosTable
   const size_t MAX_NUM_OF_LAYER_START_ANGLES = 41; // nominally the number of layer, add 1 just in case
+
+  // write journal batch keys (WriteJournal class)
+  // The key of each committed batch is inserted in the same transaction as its rows. (journalId, tableName, batchNumber) is unique.
+  // The table delete procedures above delete the keys of their table, so a journal is not resumed onto rows written since.
+  const std::string SPNAME_INSERT_WRITE_BATCH= "coil.sprocInsertWriteBatch"; // record a committed batch
+  const std::string SPNAME_SELECT_WRITE_BATCHES= "coil.sprocSelectWriteBatches"; // committed batches of a journal, one row each
+  const std::string WJ_JOURNALID_PARAM= "journalId";
+  const std::string WJ_TABLE_PARAM= "tableName";
+  const std::string WJ_BATCH_PARAM= "batchNumber";
+  // Write order of a journal row, passed to the SCS and event insert procedures. The ranges of a table are written at once,
+  // so the views order the rows by it, not by the identity column, and an adjust row reads the row before it in this order.
+  const std::string WJ_SEQUENCE_PARAM= "sequenceNum";
+  // Generation row of a table (TableGeneration class): the input hash (16 hex digits) and GENERATOR_VERSION of its last
+  // complete write. A -p or -e run does not remake a table whose generation row has the same inputs, whichever OWS or
+  // directory wrote it.
+  const std::string SPNAME_INSERT_GENERATION= "coil.sprocInsertGeneration"; // replace the generation row of a table
+  const std::string SPNAME_SELECT_GENERATION= "coil.sprocSelectGeneration"; // generation row of a table, no rows if none
+  const std::string SPNAME_DELETE_GENERATION= "coil.sprocDeleteGeneration"; // delete the generation row of a table
+  const std::string GEN_TABLE_PARAM= "tableName";
+  const std::string GEN_INPUTHASH_PARAM= "inputHash";
+  const std::string GEN_VERSION_PARAM= "generatorVersion";
+  // Db schema check (DbSchemaCheck class): the procedures, and the parameters of the procedures, the table writes use
+  const std::string SQL_SELECT_PROC_COUNT= "SELECT COUNT(*) FROM sys.procedures WHERE object_id = OBJECT_ID(:procName)";
+  const std::string SQL_SELECT_PROC_PARAM_COUNT= "SELECT COUNT(*) FROM sys.parameters WHERE object_id = OBJECT_ID(:procName) AND name = :paramName";
+  const std::string SCHEMA_PROC_PARAM= "procName";
+  const std::string SCHEMA_PARAM_PARAM= "paramName";
   }
 #endif  //GA_ScsDataConstants_H_
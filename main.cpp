@@ -3,12 +3,31 @@
 
 // standard c/c++ libraries
 #include <ctime> // get local start and end times, elapsed times. 
+#include <chrono> // scaling run step times
+#include <cstdio> // wait for enter
 #pragma warning(disable : 4996) // _CRT_SECURE_NO_WARNINGS -- disable warnings casued byt ctime
 
 // GA classes
 #include "gaScsDataConstants.hpp"
 #include "EventMap.hpp"
 #include "AxisPositions.hpp"
+#include "LookupBenchmark.hpp"
+#include "CoilMapGenerator.hpp"
+#include "Metrics.hpp"
+#include "TraceRecorder.hpp"
+#include "ProgressReporter.hpp"
+#include "BatchRunner.hpp"
+#include "ParameterSweep.hpp"
+#include "CoilGeometry.hpp"
+#include "LookupService.hpp"
+#include "TablePublisher.hpp"
+#include "AxisTrajectories.hpp"
+#include "PlcDownload.hpp"
+#include "ColumnarExport.hpp"
+#include "EventCrossCheck.hpp"
+#include "OutputFingerprint.hpp"
+#include "FingerprintDiff.hpp"
+#include "DbSchemaCheck.hpp"
 
 
   // display argument usage
@@ -18,6 +37,50 @@
       << "\t-h, -H, -?,-help, or -Help will display this usage message" << std::endl
       << "\t-p or -P will create the SCS and CLS position tables" << std::endl
       << "\t-e or -E will create the Event table" << std::endl
+      << "\t-l or -L will time random coil map lookups (no tables are changed)" << std::endl
+      << "\t-s or -S will time position and event generation on generated coil maps (no db access)" << std::endl
+      << "\t-t or -T will record a timeline of the run to " << gaScsData::TRACE_REPORT_FILE << std::endl
+      << "\t\t(Chrome trace format, open in chrome://tracing or ui.perfetto.dev). Use with the other arguments." << std::endl
+      << "\t-q or -Q will not display the progress counts, and will not wait for enter at exit (for scripted runs)." << std::endl
+      << "\t\tUse with the other arguments." << std::endl
+      << "\t-b or -B <manifest> will run the scenarios in the JSON manifest file, and write the results to " << gaScsData::BATCH_REPORT_FILE << "." << std::endl
+      << "\t\tImplies -q. See BatchRunner.hpp for the manifest format." << std::endl
+      << "\t-w or -W <sweep file> will evaluate the generation parameter sets in the JSON sweep file (no db writes)," << std::endl
+      << "\t\tand write the results to " << gaScsData::SWEEP_REPORT_FILE << ". See ParameterSweep.hpp for the sweep file format." << std::endl
+      << "\t-g or -G <geometry> is the coil geometry of the db coil map for -p, -e, and -l: \"" << gaScsData::GEOMETRY_STANDARD
+      << "\" (default), \"" << gaScsData::GEOMETRY_MOCKUP << "\"," << std::endl
+      << "\t\tor a JSON geometry file. See CoilGeometry.hpp for the geometry file format." << std::endl
+      << "\t-r or -R <port> [" << gaScsData::BATCH_SOURCE_GENERATED << "] will run the resident lookup service on 127.0.0.1:<port>, until a SHUTDOWN request." << std::endl
+      << "\t\tThe positions and events are the tables in the db, from the -m file if they were published (or calculated)." << std::endl
+      << "\t\tThe service reloads when the tables are regenerated. Implies -q. See LookupService.hpp for the requests." << std::endl
+      << "\t-m or -M [file] will publish the tables made by -p and -e to a memory mapped file (default " << gaScsData::PUBLISH_FILE << ")," << std::endl
+      << "\t\tso other programs on this computer can read them without the db. See TablePublisher.hpp for the file layout." << std::endl
+      << "\t-x or -X [file] will write each axis position over RIA angle from -p, as change points (default " << gaScsData::TRAJECTORY_FILE << ")." << std::endl
+      << "\t\tSee AxisTrajectories.hpp for the file format." << std::endl
+      << "\t-d or -D [file] will write the -p SCS positions as the PLC download file (default " << gaScsData::PLC_DOWNLOAD_FILE << ")." << std::endl
+      << "\t\tSee PlcDownload.hpp for the file format." << std::endl
+      << "\t-c or -C [prefix] will export the coil map, positions, and events from -p and -e as .npy columns, for analysis." << std::endl
+      << "\t\tThe file names start with the prefix (default " << gaScsData::EXPORT_PREFIX << "). See ColumnarExport.hpp for the tables." << std::endl
+      << "\t-v or -V <before> <after> will compare two generation fingerprint files, and list the layers and rows that differ." << std::endl
+      << "\t\tThe differences are written to " << gaScsData::FINGERPRINT_DIFF_FILE << ". See OutputFingerprint.hpp for the file format." << std::endl
+      << "Each -p and -e generation writes its fingerprint to " << gaScsData::FINGERPRINT_FILE << ", and keeps the one before it as" << std::endl
+      << "\t" << gaScsData::FINGERPRINT_PREVIOUS_FILE << "." << std::endl
+      << "\t--force will remake the -p and -e tables even if their inputs are unchanged. Without it, a table whose coil map," << std::endl
+      << "\t\tparameters, and generator version (and start angles, for events) are the same as the generation row the last" << std::endl
+      << "\t\tcomplete write left in the db is not calculated or written. Tables are always made with -m, -x, -d, and -c," << std::endl
+      << "\t\twhich need the rows." << std::endl
+      << "The -p and -e rows are journaled to " << gaScsData::WRITE_JOURNAL_PREFIX << ".<table>.jnl before they are written to the db, in batches." << std::endl
+      << "\tA write that fails part way is resumed by the next run, from the batches not committed." << std::endl
+      << "\t--connections <count> is the number of db connections the -p and -e rows are written on at once, 1 to "
+      << gaScsData::DB_WRITER_MAX_CONNECTIONS << " (default " << gaScsData::DB_WRITER_CONNECTIONS << ")." << std::endl
+      << "\t\tEach connection writes a RIA angle range of the rows. The rows are in the order of a serial write." << std::endl
+      << "When -p and -e are used together, the events are cross checked against the positions before they are written. Issues" << std::endl
+      << "\tare written to " << gaScsData::CROSS_CHECK_REPORT_FILE << ", and are a table error: the event table is not written." << std::endl
+      << "\tSee EventCrossCheck.hpp for the checks." << std::endl
+      << "Exit code: " << gaScsData::EXIT_OK << " -- ok, " << gaScsData::EXIT_SCENARIO_ERROR << " -- a table or scenario had an error"
+      << " (or -v fingerprints differ), "
+      << gaScsData::EXIT_USAGE_ERROR << " -- bad argument or manifest." << std::endl
+      << "A timing and counter report is written to " << gaScsData::METRICS_REPORT_FILE << " at exit." << std::endl
       << "If no arguments are included, this help message is displayed." << std::endl
       << "At least one argument must be included, and only the specified tables will be processed." << std::endl
       << "The arguments can be used in any order." << std::endl << std::endl
@@ -30,7 +93,35 @@
       << "Valid examples are:" << std::endl
       << "\t\"-p\" (SCS and CLS position tables only, no event table)" << std::endl
       << "\t\"-P -e\" (SCS and CLS position table and event table)" << std::endl
-      << "\t\"-E\" (Event table only, no SCS or CLS position table)" << std::endl << std::endl;
+      << "\t\"-E\" (Event table only, no SCS or CLS position table)" << std::endl
+      << "\t\"-b coils.json\" (batch run of the scenarios in coils.json)" << std::endl
+      << "\t\"-g mockup -p -e\" (position and event tables of the mockup coil)" << std::endl << std::endl;
+  }
+
+  // true if the run is scripted (-q, -b, or -r), so nothing should wait for the user
+  bool static is_headless(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+      if ("-q" == arg || "-Q" == arg || "-b" == arg || "-B" == arg || "-r" == arg || "-R" == arg)
+        return true;
+    }
+    return false;
+  }
+
+  // keep the console window open until the user is done with it. Not for scripted runs.
+  void static wait_for_enter(bool isHeadless) {
+    if (isHeadless)
+      return;
+    std::cout << "Press enter to exit." << std::endl;
+    std::getchar();
+  }
+
+
+  // record the tables that were just committed in the generation fingerprint. Done per table, so a later table or
+  // step that fails does not leave them unrecorded.
+  // return value indicates success or error
+  long static record_generation(gaScsData::OutputFingerprint &fingerprint) {
+    return fingerprint.Record(gaScsData::FINGERPRINT_FILE, gaScsData::FINGERPRINT_PREVIOUS_FILE);
   }
 
 
@@ -39,6 +130,21 @@
       // -h, -H, -?, -help, or -Help will display a usage message
       // -p or -P will create the SCS and CLS position tables
       // -e or -E will create the Event table
+      // -l or -L will time random coil map lookups (no tables are changed)
+      // -s or -S will time position and event generation on generated coil maps (no db access)
+      // -t or -T will record a timeline of the run (Chrome trace format)
+      // -q or -Q will not display progress counts or wait for enter at exit (scripted runs)
+      // -b or -B <manifest> will run the scenarios in a JSON manifest (scripted, implies -q)
+      // -w or -W <sweep file> will evaluate generation parameter sets in memory (no db writes)
+      // -g or -G <geometry> is the coil geometry of the db coil map (standard, mockup, or a JSON file)
+      // -r or -R <port> [generated] will run the resident lookup service (implies -q)
+      // -m or -M [file] will publish the tables made by -p and -e to a memory mapped file
+      // -x or -X [file] will write the per axis trajectories of the -p positions
+      // -d or -D [file] will write the PLC download file of the -p positions
+      // -c or -C [prefix] will export the coil map, positions, and events as columns for analysis
+      // -v or -V <before> <after> will compare two generation fingerprint files
+      // --force will remake the -p and -e tables even if their inputs are unchanged
+      // --connections <count> is the number of db connections the -p and -e rows are written on at once
     // If none are included, the help message is displayed.
     // The arguments can be used in any order.
     // At least one argument must be included, and only the specified tables will be processed.
@@ -59,15 +165,31 @@
     // keep track of what the arguments are asking us to do
     bool runPos = false;
     bool runEvents = false;
+    bool runLookupBenchmark = false;
+    bool runScaling = false;
+    bool runTrace = false;
+    std::string batchManifest;  // empty if not a batch run
+    std::string sweepFile;  // empty if not a parameter sweep
+    std::string geometrySource = gaScsData::GEOMETRY_STANDARD;  // coil geometry of the db coil map
+    unsigned short servicePort = 0;  // 0 if not running the lookup service
+    std::string serviceSource = gaScsData::BATCH_SOURCE_DB;
+    std::string publishFile;  // empty if the tables are not published
+    std::string trajectoryFile;  // empty if the trajectories are not written
+    std::string plcFile;  // empty if the PLC download is not written
+    std::string exportPrefix;  // empty if nothing is exported
+    std::string fingerprintBefore;  // empty if fingerprints are not compared
+    std::string fingerprintAfter;
+    bool isForced = false;  // remake the tables even if their inputs are unchanged
+    size_t writerConnections = gaScsData::DB_WRITER_CONNECTIONS;  // db connections the tables are written on
+    const bool isHeadless = is_headless(argc, argv);
 
     // process the arguments
     if (1 == argc) { // no arguments, program name only
       // show usage
       std::cout << std::endl << "No arguments found. Need at least 1 argument." << std::endl;
       show_usage(argv[0]);
-      std::cout << "Press enter to exit." << std::endl;
-      std::getchar();
-      return 1; // exit with error
+      wait_for_enter(isHeadless);
+      return gaScsData::EXIT_USAGE_ERROR; // exit with error
     }
     else {  // there is at least 1 argument 
       std::string arg; // holding place
@@ -78,9 +200,8 @@
         if ("-h" == arg || "-H" == arg || "-?" == arg || "-help" == arg || "-Help" == arg) {
           // help argument. Show usage and leave.
           show_usage(argv[0]);
-          std::cout << "Press enter to exit." << std::endl;
-          std::getchar();
-          return 0; // exit okay
+          wait_for_enter(isHeadless);
+          return gaScsData::EXIT_OK; // exit okay
         }
         else if ("-p" == arg || "-P" == arg) {
           // create position tables argument
@@ -90,16 +211,95 @@
           // create event table argument
           runEvents = true;
         }
+        else if ("-l" == arg || "-L" == arg) {
+          // coil map lookup benchmark argument
+          runLookupBenchmark = true;
+        }
+        else if ("-s" == arg || "-S" == arg) {
+          // generated coil map scaling argument
+          runScaling = true;
+        }
+        else if ("-t" == arg || "-T" == arg) {
+          // record a timeline argument
+          runTrace = true;
+        }
+        else if ("-q" == arg || "-Q" == arg) {
+          // scripted run argument. Handled by is_headless().
+        }
+        else if (("-b" == arg || "-B" == arg) && i + 1 < argc) {
+          // batch run argument. The next argument is the manifest file.
+          batchManifest = argv[++i];
+        }
+        else if (("-w" == arg || "-W" == arg) && i + 1 < argc) {
+          // parameter sweep argument. The next argument is the sweep file.
+          sweepFile = argv[++i];
+        }
+        else if (("-g" == arg || "-G" == arg) && i + 1 < argc) {
+          // coil geometry argument. The next argument is the geometry name or file.
+          geometrySource = argv[++i];
+        }
+        else if (("-r" == arg || "-R" == arg) && i + 1 < argc && 0 < atoi(argv[i + 1]) && 65536 > atoi(argv[i + 1])) {
+          // lookup service argument. The next argument is the port, optionally followed by the coil map source.
+          servicePort = static_cast<unsigned short>(atoi(argv[++i]));
+          if (i + 1 < argc && gaScsData::BATCH_SOURCE_GENERATED == argv[i + 1])
+            serviceSource = argv[++i];
+        }
+        else if ("-m" == arg || "-M" == arg) {
+          // publish argument. The next argument is the file, if it is not another argument.
+          publishFile = gaScsData::PUBLISH_FILE;
+          if (i + 1 < argc && '-' != argv[i + 1][0])
+            publishFile = argv[++i];
+        }
+        else if ("-x" == arg || "-X" == arg) {
+          // trajectory argument. The next argument is the file, if it is not another argument.
+          trajectoryFile = gaScsData::TRAJECTORY_FILE;
+          if (i + 1 < argc && '-' != argv[i + 1][0])
+            trajectoryFile = argv[++i];
+        }
+        else if ("-d" == arg || "-D" == arg) {
+          // PLC download argument. The next argument is the file, if it is not another argument.
+          plcFile = gaScsData::PLC_DOWNLOAD_FILE;
+          if (i + 1 < argc && '-' != argv[i + 1][0])
+            plcFile = argv[++i];
+        }
+        else if ("-c" == arg || "-C" == arg) {
+          // columnar export argument. The next argument is the file name prefix, if it is not another argument.
+          exportPrefix = gaScsData::EXPORT_PREFIX;
+          if (i + 1 < argc && '-' != argv[i + 1][0])
+            exportPrefix = argv[++i];
+        }
+        else if (("-v" == arg || "-V" == arg) && i + 2 < argc) {
+          // fingerprint compare argument. The next two arguments are the before and after files.
+          fingerprintBefore = argv[++i];
+          fingerprintAfter = argv[++i];
+        }
+        else if ("--force" == arg) {
+          // remake the tables argument
+          isForced = true;
+        }
+        else if ("--connections" == arg && i + 1 < argc && 0 < atoi(argv[i + 1]) &&
+                 static_cast<int>(gaScsData::DB_WRITER_MAX_CONNECTIONS) >= atoi(argv[i + 1])) {
+          // db writer connections argument. The next argument is the count.
+          writerConnections = static_cast<size_t>(atoi(argv[++i]));
+        }
         else {  // argument not recognized. Show usage and leave.
           std::cout << std::endl << "Unrecognized argument: \"" << arg << "\"" << std::endl;
           show_usage(argv[0]);
-          std::cout << "Press enter to exit." << std::endl;
-          std::getchar();
-          return 1; // exit error
+          wait_for_enter(isHeadless);
+          return gaScsData::EXIT_USAGE_ERROR; // exit error
         }
       }
     }
 
+    // load the coil geometry
+    gaScsData::CoilGeometry geometry;
+    if (gaScsData::RTN_NO_ERROR != geometry.Load(geometrySource)) {
+      wait_for_enter(isHeadless);
+      return gaScsData::EXIT_USAGE_ERROR; // exit error
+    }
+    if (!geometry.isStandard())
+      std::cout << "Coil geometry: " << geometry.ToJson() << std::endl;
+
     /*
       // TROUBLESHOOTING: force to false so we can prevent anything from running while troubleshooting
       // Comment this section out for normal operation
@@ -114,42 +314,327 @@
     struct tm* sStartTime= localtime(&startRawTime);
 
     std::cout << std::endl << "Start time: " << asctime(sStartTime) << std::endl;
+    // start the metrics report run clock
+    gaScsData::Metrics::Instance().Reset();
+    gaScsData::ProgressReporter::SetHeadless(isHeadless);
+    int exitCode = gaScsData::EXIT_OK;
+    if (runTrace) {
+      gaScsData::TraceRecorder::Instance().Reset();
+      gaScsData::TraceRecorder::Instance().SetEnabled(true);
+      gaScsData::TraceRecorder::Instance().SetThreadName("main");
+    }
+
+    // tables to publish and export, if selected
+    gaScsData::TablePublisher publisher;
+    gaScsData::ColumnarExport exporter(exportPrefix);
+    // fingerprint of the tables made
+    gaScsData::OutputFingerprint fingerprint;
+    // positions made by -p, to cross check the -e events against
+    gaScsData::AxisPositions::ScsAxesPositionMap crossCheckRows;
+    // A table whose generation row in the db has the same inputs is not made again, unless --force is used.
+    // The file outputs need the rows, so the tables are always made with them.
+    const bool canSkip = (runPos || runEvents) && !isForced && publishFile.empty() && trajectoryFile.empty() && plcFile.empty() &&
+                         exportPrefix.empty();
+
+    // the table writes need the db procedures of this version. Check for them before anything is written.
+    if (runPos || runEvents) {
+      gaScsData::DbSchemaCheck schemaCheck;
+      if (gaScsData::RTN_NO_ERROR != schemaCheck.Check()) {
+        std::cout << schemaCheck.GetMessage() << std::endl;
+        exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+        runPos = false;
+        runEvents = false;
+      }
+    }
 
     if (runPos) {
+      gaScsData::Metrics::ScopedTimer timer("run.positions");
 
       std::cout << "Creating Axis Position Object." << std::endl;
       gaScsData::AxisPositions axPos;
       std::cout << "Axis Position Object Created." << std::endl << std::endl;
 
       std::cout << "Fetch coil map from db and populate the resident coil map." << std::endl;
-      long status = axPos.GenerateCoilMap();
+      long status = axPos.SetCoilGeometry(geometry);
       if (gaScsData::RTN_NO_ERROR == status)
+        status = axPos.GenerateCoilMap();
+      if (gaScsData::RTN_NO_ERROR == status) {
         std::cout << "Coil Map populated." << std::endl;
+        // export the coil map now, so it is on disk while the positions are calculated
+        if (!exportPrefix.empty() && gaScsData::RTN_NO_ERROR != exporter.ExportCoilMap(axPos.GetCoilMap()))
+          exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+      }
       else
         std::cout << "Error when populating Coil Map." << std::endl;
 
-
-
-      std::cout << "Generating position tables..." << std::endl;
-      status = axPos.GeneratePositionTables();
-      if (gaScsData::RTN_NO_ERROR == status)
+      // the position tables are only generated from a coil map that was populated with its geometry.
+      // Otherwise the status is the error, and the tables are left as they are.
+      if (gaScsData::RTN_NO_ERROR == status) {
+        std::cout << "Generating position tables..." << std::endl;
+        axPos.SetSkipUnchanged(canSkip);
+        axPos.SetWriterConnections(writerConnections);
+        status = axPos.GeneratePositionTables();
+      }
+      if (gaScsData::RTN_NO_RESULTS == status)
+        std::cout << "Position Tables are up to date. Use --force to make them anyway." << std::endl;
+      else if (gaScsData::RTN_NO_ERROR == status) {
         std::cout << "Position Tables Generated." << std::endl;
-      else
+        fingerprint.SetScsRows(axPos.GetScsPositionMap(), axPos.GetCoilMap());
+        fingerprint.SetInputHash(gaScsData::OutputFingerprint::TABLE_SCS, axPos.GetInputHash());
+        fingerprint.SetInputHash(gaScsData::OutputFingerprint::TABLE_CLS, axPos.GetInputHash());
+        if (gaScsData::RTN_NO_ERROR != record_generation(fingerprint))
+          exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+        if (!publishFile.empty())
+          publisher.SetScsRows(axPos.GetScsPositionMap(), axPos.GetInputHash());
+        if (!trajectoryFile.empty()) {
+          gaScsData::AxisTrajectories trajectories;
+          trajectories.Build(axPos.GetScsPositionMap());
+          if (gaScsData::RTN_NO_ERROR == trajectories.Write(trajectoryFile))
+            std::cout << "Axis trajectories written to " << trajectoryFile << ": " << trajectories.GetPointCount()
+                      << " change points from " << trajectories.GetRowCount() << " rows." << std::endl;
+          else
+            exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+        }
+        if (!plcFile.empty()) {
+          gaScsData::PlcDownload download;
+          if (gaScsData::RTN_NO_ERROR == download.Build(axPos.GetScsPositionMap()) &&
+              gaScsData::RTN_NO_ERROR == download.Write(plcFile))
+            std::cout << "PLC download written to " << plcFile << ": " << download.GetRecordCount() << " rows, "
+                      << download.GetData().size() << " bytes." << std::endl;
+          else
+            exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+        }
+        if (!exportPrefix.empty() && gaScsData::RTN_NO_ERROR != exporter.ExportPositions(axPos.GetScsPositionMap()))
+          exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+        if (runEvents)
+          crossCheckRows = axPos.GetScsPositionMap();
+      }
+      else {
         std::cout << "Error when generating position tables." << std::endl;
+        exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+      }
     }
 
     // if selected, run events second, so the scs position is available
     if (runEvents) {
+      gaScsData::Metrics::ScopedTimer timer("run.events");
       std::cout << std::endl << "Creating Event Map Object." << std::endl;
       gaScsData::EventMap eventMap1;
       std::cout << "Event Map Object Created." << std::endl;
 
       std::cout << "Generating Event Map ..." << std::endl;
-      long status = eventMap1.GenerateEventMapTable();
+      long status = eventMap1.SetCoilGeometry(geometry);
+      eventMap1.SetSkipUnchanged(canSkip);
+      eventMap1.SetWriterConnections(writerConnections);
+      // the events are checked against the positions made by this run before they are written
+      gaScsData::EventCrossCheck crossCheck;
+      if (!crossCheckRows.empty())
+        eventMap1.SetCrossCheck(&crossCheck, &crossCheckRows);
       if (gaScsData::RTN_NO_ERROR == status)
+        status = eventMap1.GenerateEventMapTable();
+      if (gaScsData::RTN_NO_RESULTS == status)
+        std::cout << "Event Map is up to date. Use --force to make it anyway." << std::endl;
+      else if (gaScsData::RTN_NO_ERROR == status) {
         std::cout << "Event Map Generated." << std::endl;
-      else
+        fingerprint.SetEvents(eventMap1.GetEventMap(), eventMap1.GetCoilMap());
+        fingerprint.SetInputHash(gaScsData::OutputFingerprint::TABLE_EVENTS, eventMap1.GetInputHash());
+        if (gaScsData::RTN_NO_ERROR != record_generation(fingerprint))
+          exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+        if (!publishFile.empty())
+          publisher.SetEvents(eventMap1.GetEventMap(), eventMap1.GetInputHash());
+        if (!exportPrefix.empty()) {
+          // the coil map is exported with the positions, if they were made
+          if (!runPos && gaScsData::RTN_NO_ERROR != exporter.ExportCoilMap(eventMap1.GetCoilMap()))
+            exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+          if (gaScsData::RTN_NO_ERROR != exporter.ExportEvents(eventMap1.GetEventMap()))
+            exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+        }
+        if (!crossCheckRows.empty())
+          std::cout << "Events cross checked against the positions: " << crossCheck.GetLayerStartCount() << " layer starts, no issues." << std::endl;
+      }
+      else if (0 < crossCheck.GetIssueCount()) {
+        std::cout << "Events and positions do not agree: " << crossCheck.GetIssueCount() << " cross check issues, see "
+                  << gaScsData::CROSS_CHECK_REPORT_FILE << ". The event table was not written." << std::endl;
+        crossCheck.WriteJson(gaScsData::CROSS_CHECK_REPORT_FILE);
+        exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+      }
+      else {
         std::cout << "Error when generating event map." << std::endl;
+        exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+      }
+    }
+
+    // if selected, time the coil map lookups
+    if (runLookupBenchmark) {
+      std::cout << std::endl << "Fetch coil map from db for the lookup benchmark." << std::endl;
+      gaScsData::CoilMap coilMap;
+      long status = coilMap.SetGeometry(geometry);
+      if (gaScsData::RTN_NO_ERROR == status)
+        status = coilMap.PopulateCoilMap();
+      if (gaScsData::RTN_NO_ERROR == status) {
+        gaScsData::LookupBenchmark benchmark(coilMap);
+        status = benchmark.Run(gaScsData::LOOKUP_BENCHMARK_COUNT);
+      }
+      if (gaScsData::RTN_NO_ERROR == status)
+        std::cout << "Lookup benchmark done." << std::endl;
+      else
+        std::cout << "Error when running the lookup benchmark." << std::endl;
+    }
+
+    // if selected, time position and event generation on generated coil maps of increasing size.
+    // Everything is in memory using the local backend, so no db is needed and no tables are changed.
+    if (runScaling) {
+      typedef std::chrono::steady_clock clock;
+      for (size_t i = 0; i < gaScsData::GEN_NUM_OF_SCALE_FACTORS; ++i) {
+        const long scale = gaScsData::GEN_SCALE_FACTORS[i];
+        std::cout << std::endl << "Scaling run: " << scale << "x coil." << std::endl;
+
+        // generate the coil map rows
+        clock::time_point start = clock::now();
+        gaScsData::CoilMapGenerator generator;
+        generator.SetScale(scale);
+        gaScsData::CoilMap::coil_map coilRows;
+        long status = generator.Generate(coilRows);
+        const double generateMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+        // calculate the positions
+        size_t positionCount = 0;
+        gaScsData::AxisPositions::layerAngleSetTyp hqpStarts;
+        gaScsData::AxisPositions::layerAngleSetTyp layerStarts;
+        start = clock::now();
+        if (gaScsData::RTN_NO_ERROR == status) {
+          gaScsData::AxisPositions axPos;
+          status = axPos.SetCoilGeometry(generator.GetGeometry());
+          if (gaScsData::RTN_NO_ERROR == status)
+            status = axPos.GenerateCoilMap(coilRows, generator.GetCoilAngleMax());
+          if (gaScsData::RTN_NO_ERROR == status)
+            status = axPos.CalculatePositions();
+          positionCount = axPos.GetScsPositionCount();
+          axPos.GetStartAngleSets(hqpStarts, layerStarts);
+        }
+        const double positionMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+        // create the events, using the hqp and layer starts from the positions
+        size_t eventCount = 0;
+        start = clock::now();
+        if (gaScsData::RTN_NO_ERROR == status) {
+          gaScsData::EventMap eventMap;
+          status = eventMap.SetCoilGeometry(generator.GetGeometry());
+          if (gaScsData::RTN_NO_ERROR == status)
+            status = eventMap.GenerateEventMap(coilRows, hqpStarts, layerStarts);
+          eventCount = eventMap.GetEventCount();
+        }
+        const double eventMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+        std::cout << "Scaling run " << scale << "x: " << coilRows.size() << " coil map rows (" << generateMs << " ms), "
+                  << positionCount << " positions (" << positionMs << " ms), "
+                  << eventCount << " events (" << eventMs << " ms)." << std::endl;
+        if (gaScsData::RTN_NO_ERROR != status)
+          std::cout << "Error during the " << scale << "x scaling run." << std::endl;
+      }
+    }
+
+    // if selected, run the scenarios in the batch manifest
+    if (!batchManifest.empty()) {
+      gaScsData::Metrics::ScopedTimer timer("run.batch");
+      gaScsData::BatchRunner batch;
+      batch.SetGeometry(geometry);
+      std::cout << std::endl << "Batch run of " << batchManifest << "." << std::endl;
+      if (gaScsData::RTN_NO_ERROR != batch.LoadManifest(batchManifest))
+        exitCode = gaScsData::EXIT_USAGE_ERROR;
+      else {
+        if (gaScsData::RTN_NO_ERROR != batch.Run())
+          exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+        if (gaScsData::RTN_NO_ERROR == batch.WriteJson(gaScsData::BATCH_REPORT_FILE))
+          std::cout << "Batch report written to " << gaScsData::BATCH_REPORT_FILE << std::endl << std::endl;
+        else
+          exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+      }
+    }
+
+    // if selected, evaluate the generation parameter sets
+    if (!sweepFile.empty()) {
+      gaScsData::Metrics::ScopedTimer timer("run.sweep");
+      gaScsData::ParameterSweep sweep;
+      sweep.SetGeometry(geometry);
+      std::cout << std::endl << "Parameter sweep of " << sweepFile << "." << std::endl;
+      if (gaScsData::RTN_NO_ERROR != sweep.LoadSweepFile(sweepFile))
+        exitCode = gaScsData::EXIT_USAGE_ERROR;
+      else {
+        if (gaScsData::RTN_NO_ERROR != sweep.Run())
+          exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+        if (gaScsData::RTN_NO_ERROR == sweep.WriteJson(gaScsData::SWEEP_REPORT_FILE))
+          std::cout << "Parameter sweep report written to " << gaScsData::SWEEP_REPORT_FILE << std::endl << std::endl;
+        else
+          exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+      }
+    }
+
+    // if selected, compare two generations by their fingerprints
+    if (!fingerprintBefore.empty()) {
+      gaScsData::Metrics::ScopedTimer timer("run.fingerprint_diff");
+      gaScsData::FingerprintDiff diff;
+      std::cout << std::endl << "Comparing the fingerprints " << fingerprintBefore << " and " << fingerprintAfter << "." << std::endl;
+      if (gaScsData::RTN_NO_ERROR == diff.CompareFiles(fingerprintBefore, fingerprintAfter))
+        std::cout << "The generations are the same." << std::endl;
+      else {
+        for (long table = 0; table < gaScsData::OutputFingerprint::TABLE_NUM_OF_TABLES; ++table) {
+          const gaScsData::OutputFingerprint::Tables fpTable = static_cast<gaScsData::OutputFingerprint::Tables>(table);
+          std::cout << "  " << gaScsData::OutputFingerprint::GetTableName(fpTable) << ": "
+                    << (diff.IsTableSame(fpTable) ? "same" : "different") << std::endl;
+        }
+        const gaScsData::FingerprintDiff::layer_diff_list &layerDiffs = diff.GetLayerDiffs();
+        for (size_t i = 0; i < layerDiffs.size(); ++i) {
+          std::cout << "  " << gaScsData::OutputFingerprint::GetTableName(layerDiffs[i].table) << " layer " << layerDiffs[i].layer
+                    << ": " << layerDiffs[i].rowsBefore << " rows before, " << layerDiffs[i].rowsAfter << " rows after" << std::endl;
+        }
+        std::cout << "Rows that differ: " << diff.GetRowDiffCount(gaScsData::FingerprintDiff::DIFF_ROW_CHANGED) << " changed, "
+                  << diff.GetRowDiffCount(gaScsData::FingerprintDiff::DIFF_ROW_ADDED) << " added, "
+                  << diff.GetRowDiffCount(gaScsData::FingerprintDiff::DIFF_ROW_REMOVED) << " removed." << std::endl;
+        if (gaScsData::RTN_NO_ERROR == diff.WriteJson(gaScsData::FINGERPRINT_DIFF_FILE))
+          std::cout << "Fingerprint differences written to " << gaScsData::FINGERPRINT_DIFF_FILE << std::endl;
+        exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+      }
+    }
+
+    // if selected, list the exported tables
+    if (!exportPrefix.empty() && (runPos || runEvents)) {
+      if (gaScsData::RTN_NO_ERROR == exporter.WriteSchema())
+        std::cout << "Columnar export written to " << exportPrefix << ".*" << std::endl;
+      else
+        exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+    }
+
+    // if selected, publish the tables that were made, for the programs that read them in place
+    if (!publishFile.empty() && (runPos || runEvents) && gaScsData::EXIT_OK == exitCode) {
+      if (gaScsData::RTN_NO_ERROR != publisher.Publish(publishFile))
+        exitCode = gaScsData::EXIT_SCENARIO_ERROR;
+    }
+
+    // the fingerprint of the generation was recorded as each table was committed. The one before it was kept, and the
+    // tables not made this time were taken from it, so the file is of the tables in the db. If no table was made
+    // (all up to date), the file is left as it is.
+    if (fingerprint.IsRecorded()) {
+      std::cout << "Fingerprint written to " << gaScsData::FINGERPRINT_FILE << ".";
+      gaScsData::FingerprintDiff diff;
+      if (!fingerprint.HasPrevious())
+        std::cout << std::endl;
+      else if (gaScsData::RTN_NO_ERROR == diff.CompareFiles(gaScsData::FINGERPRINT_PREVIOUS_FILE, gaScsData::FINGERPRINT_FILE))
+        std::cout << " Same as the previous generation." << std::endl;
+      else
+        std::cout << " " << diff.GetLayerDiffs().size() << " layers and " << diff.GetRowDiffCount()
+                  << " rows differ from the previous generation (compare with -v " << gaScsData::FINGERPRINT_PREVIOUS_FILE
+                  << " " << gaScsData::FINGERPRINT_FILE << ")." << std::endl;
+    }
+
+    // if selected, run the lookup service until it is shut down
+    if (0 != servicePort) {
+      gaScsData::Metrics::ScopedTimer timer("run.service");
+      gaScsData::LookupService service(servicePort, serviceSource, geometry);
+      if (!publishFile.empty())
+        service.SetPublishFile(publishFile);
+      if (gaScsData::RTN_NO_ERROR != service.Run())
+        exitCode = gaScsData::EXIT_SCENARIO_ERROR;
     }
 
     // get and display end time and elapsed time
@@ -164,7 +649,12 @@
     
     std::cout << "Elapsed time (min:sec): " << minutes << ":" << seconds << std::endl << std::endl;
 
-    std::cout << "Press enter to exit." << std::endl;
-    std::getchar();
-    return 0;
+    // write the timing and counter report
+    if (gaScsData::RTN_NO_ERROR == gaScsData::Metrics::Instance().WriteJson(gaScsData::METRICS_REPORT_FILE))
+      std::cout << "Metrics report written to " << gaScsData::METRICS_REPORT_FILE << std::endl << std::endl;
+    if (runTrace && gaScsData::RTN_NO_ERROR == gaScsData::TraceRecorder::Instance().WriteJson(gaScsData::TRACE_REPORT_FILE))
+      std::cout << "Trace timeline written to " << gaScsData::TRACE_REPORT_FILE << std::endl << std::endl;
+
+    wait_for_enter(isHeadless);
+    return exitCode;
   }